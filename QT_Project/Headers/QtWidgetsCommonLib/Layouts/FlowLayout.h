@@ -1,7 +1,12 @@
 #pragma once
 
+#include <QHash>
 #include <QLayout>
+#include <QList>
+#include <QMargins>
 #include <QRect>
+#include <QSet>
+#include <QSize>
 #include <QStyle>
 #include <QWidgetItem>
 
@@ -15,6 +20,29 @@ namespace QtWidgetsCommonLib
  * @brief A layout that arranges child widgets horizontally and wraps them to new lines as needed.
  *
  * Supports configurable horizontal alignment for each row.
+ *
+ * Layout results (row breaks and item rectangles) are cached per width, so repeated
+ * `heightForWidth()`, `sizeHint()` and `setGeometry()` calls at the same width do not lay out the
+ * items again.
+ *
+ * `invalidate()` (called by Qt whenever an item's size hint changes, and by `addItem()`,
+ * `takeAt()` and all setters) does not drop the cached rows. The next layout pass compares the
+ * item sizes against the previous snapshot and re-flows each cached width only from the row
+ * containing the first changed item onward; appending an item therefore only re-flows the last
+ * row. Changed margins, spacing or alignment discard the cache. `add_items()` and
+ * `add_widgets()` insert a batch with a single invalidation.
+ *
+ * A widget-to-index map kept alongside the item list makes `indexOf()` constant time.
+ * `remove_widgets()` removes a batch in one pass over the list, and `set_visible_subset()` /
+ * `set_widget_hidden()` hide items without removing them: hidden items keep their position in
+ * the list, take no room in the flow and are skipped by the layout pass, so a filter can show
+ * them again without re-inserting anything.
+ *
+ * With `set_animation_enabled(true)`, a reflow of a visible layout moves the items from their
+ * current to their new rectangles over `get_animation_duration()` milliseconds instead of
+ * jumping. All animating layouts share one timer; each frame interpolates the start and end
+ * rectangles kept in contiguous arrays in a single pass. Progress is derived from elapsed time,
+ * so frames that arrive late under load are skipped rather than slowing the animation down.
  */
 class QTWIDGETSCOMMONLIB_API FlowLayout: public QLayout
 {
@@ -30,6 +58,19 @@ class QTWIDGETSCOMMONLIB_API FlowLayout: public QLayout
                         ///< the widest row above
         };
 
+        /**
+         * @struct LayoutResult
+         * @brief Layout of all items for one width, relative to the layout's origin.
+         */
+        struct LayoutResult {
+                /** @brief Final rectangle per item, in item order. */
+                QList<QRect> item_rects;
+                /** @brief Index of the first item of each row. */
+                QList<int> row_starts;
+                /** @brief Height from the top edge to the bottom of the last row. */
+                int height = 0;
+        };
+
         /**
          * @brief Constructs a FlowLayout.
          * @param parent The parent widget.
@@ -52,6 +93,61 @@ class QTWIDGETSCOMMONLIB_API FlowLayout: public QLayout
          */
         void addItem(QLayoutItem* item) override;
 
+        /**
+         * @brief Adds several items, invalidating the layout once after the last one.
+         * @param items The layout items to add; the layout takes ownership.
+         */
+        auto add_items(const QList<QLayoutItem*>& items) -> void;
+
+        /**
+         * @brief Adds several widgets, invalidating the layout once after the last one.
+         * @param widgets The widgets to add.
+         */
+        auto add_widgets(const QList<QWidget*>& widgets) -> void;
+
+        /**
+         * @brief Removes several widgets in one pass, invalidating the layout once.
+         *
+         * Like `QLayout::removeWidget()`, the widgets themselves are not deleted.
+         *
+         * @param widgets The widgets to remove; widgets not in the layout are ignored.
+         * @return The number of removed items.
+         */
+        auto remove_widgets(const QList<QWidget*>& widgets) -> int;
+
+        /**
+         * @brief Shows exactly the given widgets and hides all other widget items.
+         *
+         * Items without a widget (e.g. spacers) are not affected. Only widgets whose state
+         * changes are shown or hidden, and the layout is invalidated once.
+         *
+         * @param visible_widgets The widgets to show.
+         */
+        auto set_visible_subset(const QSet<const QWidget*>& visible_widgets) -> void;
+
+        /**
+         * @brief Hides or shows a widget without removing it from the layout.
+         * @param widget The widget; ignored if it is not in the layout.
+         * @param hidden If true, the widget is hidden and skipped by the layout.
+         */
+        auto set_widget_hidden(QWidget* widget, bool hidden) -> void;
+
+        /**
+         * @brief Returns whether a widget is hidden by `set_widget_hidden()` or
+         * `set_visible_subset()`.
+         * @param widget The widget.
+         */
+        [[nodiscard]] auto is_widget_hidden(const QWidget* widget) const -> bool;
+
+        using QLayout::indexOf;
+
+        /**
+         * @brief Returns the index of a widget's item in constant time.
+         * @param widget The widget.
+         * @return The index, or -1 if the widget is not in the layout.
+         */
+        [[nodiscard]] auto indexOf(const QWidget* widget) const -> int override;
+
         /**
          * @brief Returns the number of items in the layout.
          */
@@ -80,12 +176,31 @@ class QTWIDGETSCOMMONLIB_API FlowLayout: public QLayout
          */
         [[nodiscard]] auto minimumSize() const -> QSize override;
 
+        /**
+         * @brief Returns true: the height of a flow layout depends on its width.
+         */
+        [[nodiscard]] auto hasHeightForWidth() const -> bool override;
+
+        /**
+         * @brief Returns the height needed to show all rows at the given width.
+         * @param width The available width, including the contents margins.
+         * @return The total height, including the contents margins.
+         */
+        [[nodiscard]] auto heightForWidth(int width) const -> int override;
+
         /**
          * @brief Sets the geometry of the layout.
          * @param rect The rectangle to set.
          */
         void setGeometry(const QRect& rect) override;
 
+        /**
+         * @brief Marks the item sizes and size hints as outdated.
+         *
+         * Cached rows are kept and re-flowed from the first changed item on the next pass.
+         */
+        void invalidate() override;
+
         /**
          * @brief Returns the horizontal spacing between items.
          */
@@ -118,18 +233,155 @@ class QTWIDGETSCOMMONLIB_API FlowLayout: public QLayout
          */
         [[nodiscard]] auto get_expand_to_show_all_rows() const -> bool;
 
-    private:
         /**
-         * @brief Performs the layout of items.
-         * @param rect The rectangle to layout within.
-         * @param test_only If true, only calculates layout size, does not set geometry.
-         * @return The total height used.
+         * @brief Enables or disables animated reflow.
+         *
+         * Disabling finishes a running animation immediately.
+         *
+         * @param enabled If true, reflows of a visible layout are animated.
+         */
+        auto set_animation_enabled(bool enabled) -> void;
+
+        /**
+         * @brief Returns whether animated reflow is enabled.
+         */
+        [[nodiscard]] auto get_animation_enabled() const -> bool;
+
+        /**
+         * @brief Sets the duration of a reflow animation.
+         * @param msecs The duration in milliseconds.
+         */
+        auto set_animation_duration(int msecs) -> void;
+
+        /**
+         * @brief Returns the duration of a reflow animation in milliseconds.
+         */
+        [[nodiscard]] auto get_animation_duration() const -> int;
+
+        /**
+         * @brief Returns whether a reflow animation is currently running.
+         */
+        [[nodiscard]] auto is_animating() const -> bool;
+
+        /**
+         * @brief Computes row breaks and item rectangles for items of the given sizes.
+         *
+         * This is the row-breaking engine used by the layout itself. It only needs the item
+         * sizes, so views that position items without a `QLayoutItem` per entry (see
+         * `VirtualFlowView`) share the exact same flow and alignment rules.
+         *
+         * @param item_sizes The size of each item, in item order.
+         * @param width The width of the layout rectangle.
+         * @param margins The contents margins.
+         * @param h_spacing The horizontal spacing between items (not negative).
+         * @param v_spacing The vertical spacing between rows (not negative).
+         * @param alignment The row alignment.
+         * @return The layout result, relative to the origin (0, 0).
          *
          * RowAlignment::Left: rows are left-aligned.
          * RowAlignment::Center: rows are always centered.
          * RowAlignment::CenterLeft: all rows are centered, but rows with fewer items are
          * left-aligned with the widest row above.
          */
+        [[nodiscard]] static auto compute_geometry(const QList<QSize>& item_sizes, int width,
+                                                   const QMargins& margins, int h_spacing,
+                                                   int v_spacing, RowAlignment alignment)
+            -> LayoutResult;
+
+    private:
+        /**
+         * @struct LayoutParameters
+         * @brief Everything besides the item sizes that a layout result depends on.
+         */
+        struct LayoutParameters {
+                QMargins margins;
+                int h_spacing = -1;
+                int v_spacing = -1;
+                RowAlignment alignment = RowAlignment::Left;
+
+                auto operator==(const LayoutParameters& other) const -> bool = default;
+        };
+
+        /**
+         * @struct CachedLayout
+         * @brief Layout result for one width and how many leading items it is still valid for.
+         */
+        struct CachedLayout {
+                LayoutResult layout;
+                int valid_items = 0;
+        };
+
+        /**
+         * @brief Re-flows a layout result from a row onward (row-breaking engine).
+         * @param result The result to update; rows before first_row are kept.
+         * @param first_row The first row to lay out again (0 lays out everything).
+         * @param item_sizes The size of each item, in item order.
+         * @param width The width of the layout rectangle.
+         * @param parameters The margins, spacing and alignment.
+         */
+        static auto update_geometry_from_row(LayoutResult& result, int first_row,
+                                             const QList<QSize>& item_sizes, int width,
+                                             const LayoutParameters& parameters) -> void;
+
+        /**
+         * @brief Returns the first row that may change when items from an index on change.
+         * @param layout The cached layout result.
+         * @param first_changed_item The index of the first changed item.
+         * @return The row to re-flow from.
+         */
+        [[nodiscard]] static auto get_resume_row(const LayoutResult& layout,
+                                                 int first_changed_item) -> int;
+
+        /**
+         * @brief Updates the widget indices of the items from an index to the end of the list.
+         * @param first_index The first index whose item may have moved.
+         */
+        auto update_widget_indices(int first_index) -> void;
+
+        /**
+         * @brief Hides or shows the item of a widget without invalidating the layout.
+         * @param index The index of the widget's item.
+         * @param hidden If true, the item is hidden.
+         * @return true if the state changed.
+         */
+        auto set_item_hidden(int index, bool hidden) -> bool;
+
+        /**
+         * @brief Refreshes the item size snapshot after `invalidate()`.
+         */
+        auto sync_item_sizes() const -> void;
+
+        /**
+         * @brief Returns the cached layout for a width, computing or re-flowing it as needed.
+         * @param width The width of the layout rectangle.
+         * @return The layout result for that width.
+         */
+        [[nodiscard]] auto get_layout_for_width(int width) const -> const LayoutResult&;
+
+        /**
+         * @brief Starts (or retargets) the reflow animation towards the layout of a rectangle.
+         * @param rect The rectangle to layout within.
+         */
+        auto start_animation(const QRect& rect) -> void;
+
+        /**
+         * @brief Applies one animation frame.
+         * @param now_msecs The shared animation clock time in milliseconds.
+         * @return true while the animation is still running, false once it finished.
+         */
+        auto advance_animation(qint64 now_msecs) -> bool;
+
+        /**
+         * @brief Finishes a running animation by moving all items to their final rectangles.
+         */
+        auto stop_animation() -> void;
+
+        /**
+         * @brief Performs the layout of items.
+         * @param rect The rectangle to layout within.
+         * @param test_only If true, only calculates layout size, does not set geometry.
+         * @return The total height used.
+         */
         auto do_layout(const QRect& rect, bool test_only) const -> int;
 
         /**
@@ -140,6 +392,8 @@ class QTWIDGETSCOMMONLIB_API FlowLayout: public QLayout
 
     private:
         QList<QLayoutItem*> m_item_list;
+        QHash<const QWidget*, int> m_widget_indices;  ///< Index in m_item_list per widget item
+        QSet<const QLayoutItem*> m_hidden_items;
         int m_h_space;
         int m_v_space;
         RowAlignment m_row_alignment;
@@ -148,6 +402,25 @@ class QTWIDGETSCOMMONLIB_API FlowLayout: public QLayout
          * height.
          */
         bool m_expand_to_show_all_rows = false;
+
+        int m_batch_depth = 0;
+
+        bool m_animation_enabled = false;
+        int m_animation_duration = 150;
+        qint64 m_animation_start = 0;
+        QList<QLayoutItem*> m_animated_items;
+        QList<QRect> m_animation_from;
+        QList<QRect> m_animation_to;
+
+        mutable QHash<int, CachedLayout> m_layout_cache;
+        mutable QList<QSize> m_item_sizes;  ///< Sizes of the laid out (not hidden) items
+        mutable QList<QLayoutItem*> m_laid_out_items;  ///< Not hidden items, matching m_item_sizes
+        mutable LayoutParameters m_layout_parameters;
+        mutable bool m_item_sizes_dirty = true;
+        mutable QSize m_cached_size_hint;
+        mutable bool m_has_cached_size_hint = false;
+        mutable QSize m_cached_minimum_size;
+        mutable bool m_has_cached_minimum_size = false;
 };
 
 }  // namespace QtWidgetsCommonLib
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <QByteArray>
+#include <QObject>
+#include <QTimer>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+#include "QtWidgetsCommonLib/Services/Preferences/IMainWindowStatePersistence.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @class BatchedMainWindowStatePersistence
+ * @brief Decorator that coalesces main window state writes to another persistence.
+ *
+ * Setters only update an in-memory snapshot; the values are written to the target by `flush()`,
+ * which runs after a short delay or explicitly (e.g. on close):
+ *  - All changed values are written together, inside one transaction when the target also
+ *    implements `IPreferencesTransaction`.
+ *  - Values equal to what the target already holds are not written at all.
+ *  - With a snapshot interval, `snapshotRequested()` is emitted periodically so the owner can
+ *    store its current state, which is then flushed; crash recovery does not depend on a clean
+ *    close.
+ *
+ * Pending changes are not written on destruction, since the target may already be gone then;
+ * owners call `flush()` while it is still alive (AppMainWindow does so on close).
+ *
+ * Getters read the target once and are then served from the snapshot. All calls, including the
+ * writes to the target, happen on the thread the decorator lives in, since preference stores are
+ * not required to be thread-safe.
+ */
+class QTWIDGETSCOMMONLIB_API BatchedMainWindowStatePersistence: public QObject,
+                                                                public IMainWindowStatePersistence
+{
+        Q_OBJECT
+        Q_INTERFACES(QtWidgetsCommonLib::IMainWindowStatePersistence)
+
+    public:
+        /**
+         * @brief Constructs the decorator.
+         * @param target The persistence the values are written to; must outlive the decorator.
+         * @param parent The parent QObject, or nullptr.
+         */
+        explicit BatchedMainWindowStatePersistence(IMainWindowStatePersistence* target,
+                                                   QObject* parent = nullptr);
+
+        /**
+         * @brief Returns the main window geometry (position and size).
+         * @return The geometry data.
+         */
+        [[nodiscard]] auto get_mainwindow_geometry() -> QByteArray override;
+
+        /**
+         * @brief Sets the main window geometry; written on the next flush if it changed.
+         * @param geometry The geometry data.
+         */
+        auto set_mainwindow_geometry(const QByteArray& geometry) -> void override;
+
+        /**
+         * @brief Returns the main window state.
+         * @return The state data.
+         */
+        [[nodiscard]] auto get_mainwindow_state() -> QByteArray override;
+
+        /**
+         * @brief Sets the main window state; written on the next flush if it changed.
+         * @param state The state data.
+         */
+        auto set_mainwindow_state(const QByteArray& state) -> void override;
+
+        /**
+         * @brief Returns the main window window state.
+         * @return The window state as an integer.
+         */
+        [[nodiscard]] auto get_mainwindow_windowstate() -> int override;
+
+        /**
+         * @brief Sets the main window window state; written on the next flush if it changed.
+         * @param state The window state as an integer.
+         */
+        auto set_mainwindow_windowstate(int state) -> void override;
+
+        /**
+         * @brief Writes all changed values to the target.
+         * @return true if anything was written, false if nothing had changed.
+         */
+        auto flush() -> bool;
+
+        /**
+         * @brief Returns whether values differ from what the target holds.
+         * @return true if a flush would write something.
+         */
+        [[nodiscard]] auto has_pending_writes() const -> bool;
+
+        /**
+         * @brief Sets the delay between a change and the automatic flush.
+         * @param msec The delay in milliseconds; negative values disable the automatic flush.
+         */
+        auto set_flush_delay(int msec) -> void;
+
+        /**
+         * @brief Returns the delay between a change and the automatic flush.
+         * @return The delay in milliseconds, or a negative value if disabled.
+         */
+        [[nodiscard]] auto get_flush_delay() const -> int;
+
+        /**
+         * @brief Sets the interval of periodic snapshots.
+         * @param msec The interval in milliseconds; 0 or less disables snapshots.
+         */
+        auto set_snapshot_interval(int msec) -> void;
+
+        /**
+         * @brief Returns the interval of periodic snapshots.
+         * @return The interval in milliseconds, or 0 if disabled.
+         */
+        [[nodiscard]] auto get_snapshot_interval() const -> int;
+
+        /**
+         * @brief Returns the number of flushes that wrote to the target.
+         * @return The number of write batches.
+         */
+        [[nodiscard]] auto get_write_batch_count() const -> int;
+
+    signals:
+        /**
+         * @brief Emitted periodically; the owner stores its current state via the setters.
+         *
+         * The decorator flushes right after the connected slots returned.
+         */
+        void snapshotRequested();
+
+    private:
+        /**
+         * @struct WindowState
+         * @brief Values of one main window state snapshot.
+         */
+        struct WindowState {
+                QByteArray geometry;
+                QByteArray state;
+                int window_state = 0;
+        };
+
+        /**
+         * @brief Reads the target's values once, before the first get or set.
+         */
+        auto ensure_loaded() -> void;
+
+        /**
+         * @brief Starts the flush timer if values changed and the automatic flush is enabled.
+         */
+        auto schedule_flush() -> void;
+
+    private:
+        IMainWindowStatePersistence* m_target = nullptr;
+        WindowState m_pending;
+        WindowState m_persisted;  ///< Values the target is known to hold
+        bool m_loaded = false;
+        int m_flush_delay = 1000;
+        int m_write_batch_count = 0;
+        QTimer m_flush_timer;
+        QTimer m_snapshot_timer;
+};
+
+}  // namespace QtWidgetsCommonLib
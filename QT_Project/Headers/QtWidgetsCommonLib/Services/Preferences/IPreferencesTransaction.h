@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QtPlugin>
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @class IPreferencesTransaction
+ * @brief Optional interface for preference stores that can group several writes.
+ *
+ * Stores that flush to disk on every setter (e.g. calling `QSettings::sync()`) implement this
+ * to write all values set between `begin_transaction()` and `commit_transaction()` at once.
+ */
+class IPreferencesTransaction
+{
+    public:
+        /**
+         * @brief Virtual destructor for safe polymorphic use.
+         */
+        virtual ~IPreferencesTransaction() = default;
+
+        /**
+         * @brief Starts a group of writes; setters may defer their disk writes until commit.
+         */
+        virtual auto begin_transaction() -> void = 0;
+
+        /**
+         * @brief Writes all values set since `begin_transaction()`.
+         */
+        virtual auto commit_transaction() -> void = 0;
+};
+
+}  // namespace QtWidgetsCommonLib
+
+Q_DECLARE_INTERFACE(QtWidgetsCommonLib::IPreferencesTransaction,
+                    "de.adrianhelbig.IPreferencesTransaction")
@@ -1,13 +1,24 @@
 #pragma once
 
+#include <QByteArray>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QList>
 #include <QLocale>
 #include <QMap>
 #include <QObject>
+#include <QPointer>
 #include <QString>
 #include <QStringList>
 #include <QTranslator>
+#include <memory>
+#include <utility>
 
 #include "QtWidgetsCommonLib/ApiMacro.h"
+#include "QtWidgetsCommonLib/Utils/SharedRegistry.h"
+
+class QFileSystemWatcher;
+class QWidget;
 
 namespace QtWidgetsCommonLib
 {
@@ -15,6 +26,17 @@ namespace QtWidgetsCommonLib
 /**
  * @file Translator.h
  * @brief Provides translation functionality for the application.
+ *
+ * Loaded translator pairs (Qt and application) are kept in a small least-recently-used cache
+ * keyed by locale, so switching back to a recently used language only removes and installs
+ * translators instead of reading and parsing the .qm files again. The file contents live in a
+ * process-wide registry keyed by translations path and locale, so several Translator instances
+ * (e.g. one per main window) read each locale once; every instance parses them into translators
+ * of its own, which it installs and removes independently of the others.
+ *
+ * Translations compiled into the application under ":/translations", or in a resource archive
+ * registered with register_translations_archive(), are loaded straight from the resource data
+ * without copying the .qm files.
  */
 class QTWIDGETSCOMMONLIB_API Translator: public QObject
 {
@@ -24,7 +46,9 @@ class QTWIDGETSCOMMONLIB_API Translator: public QObject
         /**
          * @brief Constructs a Translator object.
          *
-         * Initializes the translation system and sets up the translations directory.
+         * Initializes the translation system and sets up the translations directory: the
+         * ":/translations" resource directory when present, otherwise the "translations"
+         * directory next to the executable.
          *
          * @param parent The parent QObject, or nullptr.
          */
@@ -50,7 +74,8 @@ class QTWIDGETSCOMMONLIB_API Translator: public QObject
         /**
          * @brief Loads the language translations for the specified locale.
          *
-         * Loads both Qt and application translation files for the given locale.
+         * Loads both Qt and application translation files for the given locale. Pending
+         * load_translation_async() requests are superseded: their results are only cached.
          *
          * @param locale The QLocale to load translations for.
          * @return True if the translations were loaded successfully, false otherwise.
@@ -66,6 +91,139 @@ class QTWIDGETSCOMMONLIB_API Translator: public QObject
          */
         Q_INVOKABLE bool load_default_translation();
 
+        /**
+         * @brief Loads the translations for a language code without blocking the GUI thread.
+         *
+         * @param language_code The language code to load (e.g. "en", "de").
+         * @see load_translation_async(const QLocale&)
+         */
+        Q_INVOKABLE void load_translation_async(const QString& language_code);
+
+        /**
+         * @brief Loads the translations for a locale without blocking the GUI thread.
+         *
+         * A cached locale is installed right away. Otherwise both .qm files are read on a worker
+         * thread and the translators are installed on the GUI thread once they are available,
+         * followed by languageChanged(). Failures fall back to the default translation like
+         * load_translation(). A newer request supersedes a pending one; the superseded result is
+         * only cached. translationLoadFinished() reports the outcome.
+         *
+         * @param locale The QLocale to load translations for.
+         */
+        Q_INVOKABLE void load_translation_async(const QLocale& locale);
+
+        /**
+         * @brief Returns whether an asynchronous load is still pending.
+         *
+         * @return True while load_translation_async() waits for a worker thread.
+         */
+        [[nodiscard]] Q_INVOKABLE bool is_loading_translation() const;
+
+        /**
+         * @brief Blocks until the pending asynchronous loads finished and installs their results.
+         *
+         * Waits on the worker threads without running an event loop, e.g. to install a startup
+         * translation before a window is polished. translationLoadFinished() is emitted from
+         * within this call.
+         */
+        Q_INVOKABLE void wait_for_translation_load();
+
+        /**
+         * @brief Enables or disables staged delivery of retranslation events.
+         *
+         * When enabled, installing translators no longer retranslates all windows in one go:
+         * visible windows receive LanguageChange first, hidden windows one per event loop turn.
+         *
+         * @param enabled True to stage retranslation.
+         */
+        Q_INVOKABLE void set_staged_retranslation(bool enabled);
+
+        /**
+         * @brief Returns whether retranslation events are staged.
+         *
+         * @return True if staged retranslation is enabled (default false).
+         */
+        [[nodiscard]] Q_INVOKABLE bool get_staged_retranslation() const;
+
+        /**
+         * @brief Returns how many windows still wait for their staged LanguageChange event.
+         *
+         * @return The number of pending windows.
+         */
+        [[nodiscard]] Q_INVOKABLE int get_pending_retranslation_count() const;
+
+        /**
+         * @brief Sets the directory or resource path the translations are loaded from.
+         *
+         * The translator cache is cleared; the installed translators stay in use until the next
+         * load. The language catalog is rebuilt.
+         *
+         * @param path A directory, or a resource path such as ":/translations".
+         */
+        Q_INVOKABLE void set_translations_path(const QString& path);
+
+        /**
+         * @brief Returns the directory or resource path the translations are loaded from.
+         *
+         * @return The translations path.
+         */
+        [[nodiscard]] Q_INVOKABLE QString get_translations_path() const;
+
+        /**
+         * @brief Registers a packed resource archive (.rcc) and loads translations from it.
+         *
+         * The archive is memory-mapped where the platform supports it and stays registered for
+         * the lifetime of the process.
+         *
+         * @param archive_path The path of the .rcc file.
+         * @param resource_path The resource directory of the translations inside the archive.
+         * @return True if the archive was registered, false otherwise (the path is unchanged).
+         */
+        Q_INVOKABLE bool register_translations_archive(
+            const QString& archive_path, const QString& resource_path = ":/translations");
+
+        /**
+         * @brief Loads the translations for a locale into the cache without installing them.
+         *
+         * A later load_translation() for that locale is then served from the cache.
+         *
+         * @param locale The QLocale to preload translations for.
+         * @return True if the translations are cached (loaded now or before), false otherwise.
+         */
+        Q_INVOKABLE bool preload_translation(const QLocale& locale);
+
+        /**
+         * @brief Preloads the default language translations used as fallback.
+         *
+         * @return True if the translations are cached (loaded now or before), false otherwise.
+         */
+        Q_INVOKABLE bool preload_default_translation();
+
+        /**
+         * @brief Returns whether the translations for a locale are in the cache.
+         *
+         * @param locale The locale to check.
+         * @return True if a loaded translator pair for the locale is cached.
+         */
+        [[nodiscard]] Q_INVOKABLE bool is_translation_cached(const QLocale& locale) const;
+
+        /**
+         * @brief Sets how many loaded translator pairs are kept (including the installed one).
+         *
+         * Least recently used pairs beyond the capacity are released; the installed pair is
+         * never released.
+         *
+         * @param capacity The maximum number of cached locales; values < 1 are clamped to 1.
+         */
+        Q_INVOKABLE void set_cache_capacity(int capacity);
+
+        /**
+         * @brief Returns the maximum number of cached translator pairs.
+         *
+         * @return The cache capacity (default 4).
+         */
+        [[nodiscard]] Q_INVOKABLE int get_cache_capacity() const;
+
         /**
          * @brief Returns the current language code.
          *
@@ -92,9 +250,130 @@ class QTWIDGETSCOMMONLIB_API Translator: public QObject
          */
         [[nodiscard]] Q_INVOKABLE QMap<QString, QString> get_language_code_name_map() const;
 
+        /**
+         * @brief Returns the native names of the available languages, in code order.
+         * @return A QStringList of native language names (e.g. "English", "Deutsch").
+         */
+        [[nodiscard]] Q_INVOKABLE QStringList get_available_native_language_names() const;
+
+        /**
+         * @brief Returns the English name of an available language.
+         * @param language_code The language code (e.g. "de").
+         * @return The language name (e.g. "German"), or an empty string if not available.
+         */
+        [[nodiscard]] Q_INVOKABLE QString get_language_name(const QString& language_code) const;
+
+        /**
+         * @brief Returns the native name of an available language.
+         * @param language_code The language code (e.g. "de").
+         * @return The native language name (e.g. "Deutsch"), or an empty string if not available.
+         */
+        [[nodiscard]] Q_INVOKABLE QString
+        get_native_language_name(const QString& language_code) const;
+
+        /**
+         * @brief Returns the code of an available language from its English or native name.
+         * @param language_name The language name, compared case-insensitively.
+         * @return The language code, or an empty string if no available language has that name.
+         */
+        [[nodiscard]] Q_INVOKABLE QString get_language_code(const QString& language_name) const;
+
+        /**
+         * @brief Re-indexes the translations directory.
+         *
+         * Needed only when .qm files are added while the directory is not watched, e.g. when it
+         * did not exist at construction. Emits availableLanguagesChanged() if the catalog changed.
+         */
+        Q_INVOKABLE void refresh_language_catalog();
+
         // NOLINTEND(modernize-use-trailing-return-type)
 
+        /**
+         * @brief Returns how many locales are currently loaded, shared by all Translator instances.
+         * @return The number of locales whose .qm file contents are in use.
+         */
+        [[nodiscard]] static auto get_shared_translation_count() -> qsizetype;
+
+    protected:
+        /**
+         * @brief Holds back LanguageChange events of widgets during staged retranslation.
+         * @param watched The object receiving the event.
+         * @param event The event being filtered.
+         * @return true if the event was held back; false otherwise.
+         */
+        bool eventFilter(QObject* watched, QEvent* event) override;
+
     private:
+        /**
+         * @struct TranslationData
+         * @brief Paths and immutable contents of the Qt and application .qm files of one locale.
+         */
+        struct TranslationData {
+                QString qt_path;
+                QString app_path;
+                QByteArray qt_data;
+                QByteArray app_data;
+        };
+
+        /**
+         * @struct CachedTranslators
+         * @brief Loaded Qt and application translators of one locale, owned by one instance.
+         */
+        struct CachedTranslators {
+                QLocale locale;
+                /** @brief Shared file contents the translators read from (null for resources). */
+                std::shared_ptr<const TranslationData> data;
+                std::shared_ptr<QTranslator> qt_translator;
+                std::shared_ptr<QTranslator> app_translator;
+        };
+
+        using TranslationRegistry = SharedRegistry<std::pair<QString, QLocale>, TranslationData>;
+
+        /**
+         * @struct AsyncLoad
+         * @brief A load_translation_async() request waiting for its worker thread.
+         */
+        struct AsyncLoad {
+                QFutureWatcher<std::shared_ptr<TranslationData>>* watcher = nullptr;
+                QLocale locale;
+                quint64 generation = 0;
+                QString path;  ///< Translations path at the time of the request
+        };
+
+        /**
+         * @struct LanguageCatalog
+         * @brief Index of the languages available in the translations directory.
+         */
+        struct LanguageCatalog {
+                QStringList codes;
+                QStringList names;
+                QStringList native_names;
+                QMap<QString, QString> code_name_map;
+                QHash<QString, QString> native_name_by_code;
+                /** @brief Lower-cased English and native names to codes. */
+                QHash<QString, QString> code_by_name;
+                bool valid = false;
+        };
+
+        /**
+         * @brief Watches a translations directory for changes; resource paths need no watcher.
+         *
+         * Logs once per process when the directory does not exist.
+         */
+        auto watch_translations_path() -> void;
+
+        /**
+         * @brief Returns the language catalog, indexing the translations directory if needed.
+         * @return The current catalog.
+         */
+        [[nodiscard]] auto get_catalog() const -> const LanguageCatalog&;
+
+        /**
+         * @brief Builds a catalog from the app_*.qm files in the translations directory.
+         * @return The new catalog.
+         */
+        [[nodiscard]] auto build_catalog() const -> LanguageCatalog;
+
         /**
          * @brief Removes installed translators if they are not empty.
          *
@@ -102,11 +381,100 @@ class QTWIDGETSCOMMONLIB_API Translator: public QObject
          */
         auto remove_none_empty_translators() -> void;
 
+        /**
+         * @brief Returns the cache index of a locale's translators.
+         *
+         * @param locale The locale to look up.
+         * @return The index in the cache, or -1 if the locale is not cached.
+         */
+        [[nodiscard]] auto find_cached(const QLocale& locale) const -> qsizetype;
+
+        /**
+         * @brief Makes a locale's translators available in the cache as most recently used.
+         *
+         * Loads both .qm files from disk only when the locale is not cached yet.
+         *
+         * @param locale The locale to load translations for.
+         * @return True if both translators are loaded, false otherwise.
+         */
+        auto cache_translators(const QLocale& locale) -> bool;
+
+        /**
+         * @brief Loads both translators of a locale from the translations path.
+         *
+         * File contents another instance already read for the same path are reused.
+         *
+         * @param locale The locale to load translations for.
+         * @return The loaded pair, or nullptr if either translator failed to load.
+         */
+        [[nodiscard]] auto create_translators(const QLocale& locale)
+            -> std::shared_ptr<CachedTranslators>;
+
+        /**
+         * @brief Parses shared file contents into a translator pair of this instance.
+         * @param locale The locale of the contents.
+         * @param data The file contents; nullptr fails.
+         * @return The loaded pair, or nullptr if either translator failed to load.
+         */
+        [[nodiscard]] static auto create_translators(const QLocale& locale,
+                                                     std::shared_ptr<const TranslationData> data)
+            -> std::shared_ptr<CachedTranslators>;
+
+        /**
+         * @brief Reads the Qt and application .qm files of a locale (runs on a worker thread).
+         * @param locale The locale.
+         * @param directory The translations directory.
+         * @return The file contents, or nullptr if the Qt file is missing.
+         */
+        [[nodiscard]] static auto read_translation_data(const QLocale& locale,
+                                                        const QString& directory)
+            -> std::shared_ptr<TranslationData>;
+
+        /**
+         * @brief Returns the process-wide .qm file contents, keyed by translations path and locale.
+         * @return The registry.
+         */
+        [[nodiscard]] static auto get_registry() -> TranslationRegistry&;
+
+        /**
+         * @brief Installs the result of an asynchronous load on the GUI thread.
+         * @param load The finished request.
+         */
+        auto finish_async_load(const AsyncLoad& load) -> void;
+
+        /**
+         * @brief Installs the most recently used cached translators and emits languageChanged.
+         *
+         * @param locale The locale of the translators at the front of the cache.
+         */
+        auto install_front_translators(const QLocale& locale) -> void;
+
+        /**
+         * @brief Delivers held back LanguageChange events: all visible windows, else one hidden.
+         *
+         * @param allow_finish If true, the event filter is removed once nothing is pending.
+         */
+        auto deliver_retranslation_step(bool allow_finish) -> void;
+
+        /**
+         * @brief Sends one LanguageChange event to a window and its children.
+         * @param window The top-level window.
+         */
+        auto deliver_retranslation(QWidget* window) -> void;
+
+        /**
+         * @brief Releases least recently used translator pairs beyond the cache capacity.
+         *
+         * The installed translators are never released.
+         */
+        auto trim_cache() -> void;
+
         /**
          * @brief Loads the translations for the specified locale and filename into the given
          * translator.
          *
-         * Attempts to load the translation file for the given locale and filename.
+         * Only used for resource translation paths (`:/...`); catalogs on disk go through the
+         * shared translation data.
          *
          * @param locale The QLocale to load translations for.
          * @param filename The base filename of the translation file.
@@ -122,11 +490,33 @@ class QTWIDGETSCOMMONLIB_API Translator: public QObject
          */
         void languageChanged();
 
+        /**
+         * @brief Emitted when the set of available languages changed after a re-index.
+         */
+        void availableLanguagesChanged();
+
+        /**
+         * @brief Emitted when a load_translation_async() request finished.
+         * @param success True if the requested (or fallback) translations were installed.
+         */
+        void translationLoadFinished(bool success);
+
     private:
-        QTranslator m_qt_translator;
-        QTranslator m_app_translator;
+        QList<std::shared_ptr<CachedTranslators>> m_cache;  ///< Most recently used first
+        int m_cache_capacity = 4;
+        std::shared_ptr<QTranslator> m_qt_translator;
+        std::shared_ptr<QTranslator> m_app_translator;
+        std::shared_ptr<const TranslationData> m_installed_data;  ///< Read by the installed pair
         QString m_translations_path;
         QLocale m_current_locale;
+        mutable LanguageCatalog m_catalog;
+        QFileSystemWatcher* m_catalog_watcher = nullptr;
+        quint64 m_async_generation = 0;  ///< Identifies the latest asynchronous request
+        QList<AsyncLoad> m_async_loads;  ///< Oldest first
+        bool m_staged_retranslation = false;
+        bool m_retranslation_filter_installed = false;
+        bool m_delivering_retranslation = false;
+        QList<QPointer<QWidget>> m_pending_retranslation;
 };
 
 }  // namespace QtWidgetsCommonLib
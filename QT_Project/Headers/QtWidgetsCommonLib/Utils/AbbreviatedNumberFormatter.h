@@ -0,0 +1,180 @@
+#pragma once
+
+#include <QList>
+#include <QLocale>
+#include <QMetaObject>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <span>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+
+namespace QtWidgetsCommonLib
+{
+
+class Translator;
+
+/**
+ * @struct AbbreviatedNumberOptions
+ * @brief Precision and suffix set of an `AbbreviatedNumberFormatter`.
+ */
+struct AbbreviatedNumberOptions {
+        /** @brief Decimals of fractional unscaled values and of scaled values below 10. */
+        int decimals = 1;
+        /** @brief Factor between two consecutive suffixes (e.g. 1000 or 1024). */
+        double base = 1000.0;
+        /** @brief Suffixes for base^0, base^1, ...; the first one is used for unscaled values. */
+        QStringList suffixes = {QString(), QStringLiteral("K"), QStringLiteral("M"),
+                                QStringLiteral("B"), QStringLiteral("T")};
+};
+
+/**
+ * @class AbbreviatedNumberFormatter
+ * @brief Reusable, locale-aware abbreviated number formatter (e.g. "1,5K", "3.2 MiB").
+ *
+ * Follows the rules of `NumberFormatUtils::format_number_abbreviated()` with a configurable
+ * precision and suffix set. The thresholds, suffixes and the locale's decimal point, negative
+ * sign and zero digit are computed once when the locale or the options change, so formatting
+ * a value is a threshold lookup, one `std::to_chars` call and a copy. Group separators are not
+ * used.
+ *
+ * A formatter bound with `follow_translator()` switches to the translator's locale whenever the
+ * language changes and emits `formatChanged()`, so views can repaint.
+ */
+class QTWIDGETSCOMMONLIB_API AbbreviatedNumberFormatter: public QObject
+{
+        Q_OBJECT
+
+    public:
+        /**
+         * @brief Constructs a formatter.
+         * @param locale The locale providing decimal point, negative sign and digits.
+         * @param options The precision and suffix set.
+         * @param parent The parent QObject, or nullptr.
+         */
+        explicit AbbreviatedNumberFormatter(const QLocale& locale = QLocale(),
+                                            const AbbreviatedNumberOptions& options = {},
+                                            QObject* parent = nullptr);
+
+        /**
+         * @brief Returns the options for K/M/B/T suffixes with base 1000.
+         * @return The metric options.
+         */
+        [[nodiscard]] static auto metric_options() -> AbbreviatedNumberOptions;
+
+        /**
+         * @brief Returns the options for binary byte units (B, KiB, MiB, ...) with base 1024.
+         * @return The byte options.
+         */
+        [[nodiscard]] static auto byte_options() -> AbbreviatedNumberOptions;
+
+        /**
+         * @brief Formats a number.
+         * @param value The number to format.
+         * @return The abbreviated text.
+         */
+        [[nodiscard]] auto format(double value) const -> QString;
+
+        /**
+         * @brief Writes the abbreviation of a number into a caller-provided buffer.
+         *
+         * The text is not null-terminated; `QStringView(buffer.data(), length)` views it.
+         *
+         * @param value The number to format.
+         * @param buffer The destination buffer.
+         * @return The number of code units written, or -1 if the buffer is too small.
+         */
+        [[nodiscard]] auto format(double value, std::span<char16_t> buffer) const -> qsizetype;
+
+        /**
+         * @brief Sets the locale and rebuilds the cached symbols.
+         * @param locale The new locale.
+         */
+        auto set_locale(const QLocale& locale) -> void;
+
+        /**
+         * @brief Returns the locale.
+         * @return The current locale.
+         */
+        [[nodiscard]] auto get_locale() const -> QLocale;
+
+        /**
+         * @brief Sets the precision and suffix set and rebuilds the thresholds.
+         *
+         * Decimals are clamped to [0, 6]; a base below 2 falls back to 1000 and an empty suffix
+         * list to a single empty suffix.
+         *
+         * @param options The new options.
+         */
+        auto set_options(const AbbreviatedNumberOptions& options) -> void;
+
+        /**
+         * @brief Returns the precision and suffix set.
+         * @return The current options.
+         */
+        [[nodiscard]] auto get_options() const -> AbbreviatedNumberOptions;
+
+        /**
+         * @brief Follows the language of a translator.
+         *
+         * Applies the translator's current language right away and again whenever it emits
+         * `languageChanged()`. Passing nullptr stops following.
+         *
+         * @param translator The translator to follow, or nullptr.
+         */
+        auto follow_translator(Translator* translator) -> void;
+
+    signals:
+        /**
+         * @brief Emitted when the locale or the options changed.
+         */
+        void formatChanged();
+
+    private:
+        /**
+         * @brief Recomputes the locale symbols from the current locale.
+         */
+        auto rebuild_symbols() -> void;
+
+        /**
+         * @brief Writes the rounded absolute value in ASCII ('0'-'9', '.').
+         * @param value The number to format.
+         * @param digits Receives the text.
+         * @param suffix_index Receives the index of the suffix to append.
+         * @return The length of the text.
+         */
+        [[nodiscard]] auto to_digits(double value, std::span<char> digits, int& suffix_index) const
+            -> qsizetype;
+
+        /**
+         * @brief Returns the length of the localized text.
+         * @param digits The ASCII text from `to_digits()`.
+         * @param negative Whether the value is negative.
+         * @param suffix_index The suffix index from `to_digits()`.
+         * @return The number of UTF-16 code units.
+         */
+        [[nodiscard]] auto get_text_length(std::span<const char> digits, bool negative,
+                                           int suffix_index) const -> qsizetype;
+
+        /**
+         * @brief Writes the localized text.
+         * @param digits The ASCII text from `to_digits()`.
+         * @param negative Whether the value is negative.
+         * @param suffix_index The suffix index from `to_digits()`.
+         * @param out The destination, at least `get_text_length()` code units long.
+         */
+        auto write_text(std::span<const char> digits, bool negative, int suffix_index,
+                        char16_t* out) const -> void;
+
+    private:
+        QLocale m_locale;
+        AbbreviatedNumberOptions m_options;
+        QList<double> m_thresholds;  ///< base^i for every suffix, ascending
+        QString m_negative_sign;
+        QString m_decimal_point;
+        char16_t m_zero_digit = u'0';
+        QMetaObject::Connection m_translator_connection;
+};
+
+}  // namespace QtWidgetsCommonLib
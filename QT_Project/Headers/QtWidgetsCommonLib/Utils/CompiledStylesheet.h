@@ -0,0 +1,238 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <utility>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @struct VariableResolution
+ * @brief Result of resolving references between variables, including diagnostics.
+ */
+struct VariableResolution {
+        /** @brief Fully resolved value per variable name. */
+        QMap<QString, QString> values;
+        /** @brief Each detected reference cycle as a sorted list of the variables involved. */
+        QList<QStringList> cycles;
+        /** @brief Referenced variable names that are not defined, sorted and unique. */
+        QStringList undefined_references;
+};
+
+/**
+ * @struct UnresolvedVariable
+ * @brief A `@name` reference in the stylesheet body for which no variable value exists.
+ */
+struct UnresolvedVariable {
+        /** @brief Variable name (without '@'). */
+        QString name;
+        /** @brief 1-based line of the reference, in `file` if set, else in the source text. */
+        int line = 0;
+        /** @brief File the reference is in; empty for stylesheets not composed from files. */
+        QString file;
+
+        auto operator==(const UnresolvedVariable& other) const -> bool = default;
+};
+
+/**
+ * @struct SourceOrigin
+ * @brief Where one part of a concatenated stylesheet comes from.
+ */
+struct SourceOrigin {
+        /** @brief The file the part was read from. */
+        QString file;
+        /** @brief 1-based line of the part's first character in the file. */
+        int first_line = 1;
+
+        auto operator==(const SourceOrigin& other) const -> bool = default;
+};
+
+/**
+ * @class CompiledStylesheet
+ * @brief Pre-parsed form of a raw QSS stylesheet with @Variables support.
+ *
+ * The raw text is parsed exactly once on construction:
+ *  - All @Variables blocks are extracted into per-theme variable tables (default block merged
+ *    with the theme block, values still unresolved).
+ *  - The remaining text is split into literal segments and variable slots, one slot per
+ *    `@name` occurrence.
+ *
+ * Rendering with a set of variable values then only fills the slots and joins the segments,
+ * so switching themes or changing a single variable does not re-parse the source.
+ */
+class QTWIDGETSCOMMONLIB_API CompiledStylesheet
+{
+    public:
+        /**
+         * @brief Constructs an empty compiled stylesheet.
+         */
+        CompiledStylesheet() = default;
+
+        /**
+         * @brief Parses the raw stylesheet into variable tables and a slot template.
+         * @param raw_stylesheet The raw QSS input including @Variables blocks.
+         */
+        explicit CompiledStylesheet(const QString& raw_stylesheet);
+
+        /**
+         * @brief Returns whether no source has been compiled.
+         * @return true if the source text is empty, false otherwise.
+         */
+        [[nodiscard]] auto is_empty() const -> bool;
+
+        /**
+         * @brief Returns the raw source text this template was compiled from.
+         * @return The raw QSS input.
+         */
+        [[nodiscard]] auto get_source() const -> const QString&;
+
+        /**
+         * @brief Returns the theme names declared in the source ("Default" for an unnamed block).
+         * @return A QStringList of theme names.
+         */
+        [[nodiscard]] auto get_available_themes() const -> QStringList;
+
+        /**
+         * @brief Returns the unresolved variables for a theme.
+         *
+         * The default block is the base; the first block with the given name overrides it.
+         * Unknown or empty theme names yield the default block only.
+         *
+         * @param theme_name The theme name, or empty for the default block.
+         * @return A QMap of variable name to raw (unresolved) value.
+         */
+        [[nodiscard]] auto get_theme_variables(const QString& theme_name) const
+            -> QMap<QString, QString>;
+
+        /**
+         * @brief Returns the distinct variable names referenced by the stylesheet body.
+         * @return A QStringList of variable names (without '@') in order of first use.
+         */
+        [[nodiscard]] auto get_slot_names() const -> const QStringList&;
+
+        /**
+         * @brief Returns whether the stylesheet body references a variable.
+         *
+         * Changes to variables that are not referenced cannot alter the rendered output.
+         *
+         * @param name The variable name (without '@').
+         * @return true if at least one slot uses the variable, false otherwise.
+         */
+        [[nodiscard]] auto references_variable(const QString& name) const -> bool;
+
+        /**
+         * @brief Renders the stylesheet body by filling every slot with its variable value.
+         *
+         * Slots without a matching variable keep their `@name` placeholder; they are reported in
+         * the same pass, so checking the output for leftover references needs no extra scan.
+         *
+         * @param variables The variable values to insert.
+         * @param unresolved If not nullptr, receives every slot without a value, in source order.
+         * @return The final stylesheet text without @Variables blocks.
+         */
+        [[nodiscard]] auto render(const QMap<QString, QString>& variables,
+                                  QList<UnresolvedVariable>* unresolved = nullptr) const -> QString;
+
+        /**
+         * @brief Resolves references between variables (e.g. `@Accent: @ColorPrimary;`).
+         *
+         * Every variable is resolved exactly once: the reference graph is walked iteratively
+         * with Tarjan's algorithm, which completes variables in dependency order so each result
+         * is reused by all of its dependents. Variables that are part of a cycle resolve to an
+         * empty string and are reported in `VariableResolution::cycles`; references to undefined
+         * variables are replaced by an empty string and reported in
+         * `VariableResolution::undefined_references`.
+         *
+         * @param variables The raw variable values, possibly referencing each other.
+         * @return The resolved values and diagnostics.
+         */
+        [[nodiscard]] static auto resolve_variables(const QMap<QString, QString>& variables)
+            -> VariableResolution;
+
+        /**
+         * @brief Joins several compiled stylesheets into one, as if their sources were
+         * concatenated.
+         *
+         * Only the compiled forms are merged (variable tables, theme names and slot templates),
+         * so composing a stylesheet out of separately compiled files does not re-parse any of
+         * them. The result equals compiling the concatenated source text, provided no
+         * @Variables block or `@name` token spans a part boundary.
+         *
+         * Without origins, the slot lines of the result refer to the concatenated text. With one
+         * origin per part, every slot keeps the file and line it has in that part's file.
+         *
+         * @param parts The compiled parts in source order.
+         * @param origins The origin of each part, or empty.
+         * @return The compiled stylesheet of the concatenated sources.
+         */
+        [[nodiscard]] static auto concatenate(const QList<CompiledStylesheet>& parts,
+                                              const QList<SourceOrigin>& origins = {})
+            -> CompiledStylesheet;
+
+    private:
+        /**
+         * @brief Splits the stylesheet body into literal segments and variable slots.
+         * @param body The stylesheet text with all @Variables blocks removed.
+         * @param body_to_source Start offsets (body, source) of the body pieces, ascending.
+         */
+        auto compile_template(const QString& body,
+                              const QList<std::pair<qsizetype, qsizetype>>& body_to_source)
+            -> void;
+
+        /**
+         * @brief Returns the slot name index of a variable, registering the name on first use.
+         * @param name The variable name (without '@').
+         * @return The index into the distinct slot names.
+         */
+        auto add_slot_name(const QString& name) -> qsizetype;
+
+        /**
+         * @brief Rebuilds the available theme list from the named themes and the default marker.
+         */
+        auto update_available_themes() -> void;
+
+        /**
+         * @brief Rebuilds the per-theme variable tables (defaults overridden by each theme block).
+         */
+        auto update_theme_variables() -> void;
+
+        /**
+         * @brief Parses variables from a variables block and fills the variables map.
+         * @param variables_block The content of the variables block.
+         * @param variables The map to fill with variable name/value pairs.
+         */
+        static void parse_variables_block(const QString& variables_block,
+                                          QMap<QString, QString>& variables);
+
+        /**
+         * @brief Parses the names of all named @Variables blocks from the raw stylesheet.
+         * @param stylesheet The raw QSS stylesheet.
+         * @return A QStringList of distinct theme names in order of first appearance.
+         */
+        [[nodiscard]] static auto parse_named_themes(const QString& stylesheet) -> QStringList;
+
+    private:
+        QString m_source;
+        QStringList m_available_themes;
+        QStringList m_named_themes;
+        bool m_has_default_marker = false;
+        bool m_has_default_block = false;
+        QMap<QString, QString> m_default_variables;
+        QHash<QString, QMap<QString, QString>> m_theme_overrides;
+        QHash<QString, QMap<QString, QString>> m_theme_variables;
+        QStringList m_segments;
+        QList<qsizetype> m_slot_refs;
+        QList<int> m_slot_lines;  ///< Source line per slot, parallel to m_slot_refs
+        QStringList m_slot_files;  ///< Source file per slot (empty if unknown), parallel too
+        QStringList m_slot_names;
+        QHash<QString, qsizetype> m_slot_name_indices;
+        qsizetype m_literal_length = 0;
+};
+
+}  // namespace QtWidgetsCommonLib
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QtGlobal>
+#include <optional>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @class DwmAttributeState
+ * @brief Desired and last applied DWM attributes of one frameless window.
+ *
+ * Every DWM call crosses into the compositor and may recompose a frame, so `AppWindow` only
+ * applies the attributes that differ from the snapshot of the last applied values. The owner
+ * sets the desired values, asks for the pending changes, applies them and then marks them
+ * applied. `invalidate()` forgets the snapshot when DWM may have reset the window (composition
+ * change, frame change), so everything is applied again.
+ *
+ * The class only holds state; it makes no platform calls.
+ */
+class QTWIDGETSCOMMONLIB_API DwmAttributeState
+{
+    public:
+        /**
+         * @struct Attributes
+         * @brief Values of the managed DWM attributes.
+         */
+        struct Attributes {
+                /** @brief Frame extended 1px into the client area (or drop shadow fallback). */
+                bool extend_frame = true;
+                /** @brief DWMWA_WINDOW_CORNER_PREFERENCE: rounded or do-not-round. */
+                bool rounded_corners = true;
+                /** @brief DWMWA_USE_IMMERSIVE_DARK_MODE (border color fallback). */
+                bool dark_mode = true;
+                /** @brief DWMWA_SYSTEMBACKDROP_TYPE main window or none (legacy Mica fallback). */
+                bool mica = false;
+
+                auto operator==(const Attributes& other) const -> bool = default;
+        };
+
+        /**
+         * @struct Changes
+         * @brief Attributes whose desired value differs from the applied one.
+         */
+        struct Changes {
+                bool frame = false;
+                bool corner_preference = false;
+                bool dark_mode = false;
+                bool backdrop = false;
+
+                /**
+                 * @brief Returns whether any attribute changed.
+                 * @return true if at least one attribute has to be applied.
+                 */
+                [[nodiscard]] auto any() const -> bool;
+        };
+
+        /**
+         * @brief Sets the desired attributes.
+         * @param attributes The values to apply with the next update.
+         */
+        auto set_desired(const Attributes& attributes) -> void;
+
+        /**
+         * @brief Returns the desired attributes.
+         * @return The values the next update applies.
+         */
+        [[nodiscard]] auto get_desired() const -> Attributes;
+
+        /**
+         * @brief Returns the last applied attributes.
+         * @return The snapshot, or std::nullopt if nothing was applied since the last invalidate.
+         */
+        [[nodiscard]] auto get_applied() const -> std::optional<Attributes>;
+
+        /**
+         * @brief Returns the attributes that have to be applied.
+         * @return Every attribute after `invalidate()`, otherwise only the changed ones.
+         */
+        [[nodiscard]] auto get_pending_changes() const -> Changes;
+
+        /**
+         * @brief Records the desired attributes as applied.
+         * @param changes The attributes that were applied, as counted by `get_applied_count()`.
+         */
+        auto mark_applied(const Changes& changes) -> void;
+
+        /**
+         * @brief Forgets the applied snapshot, so the next update applies every attribute.
+         */
+        auto invalidate() -> void;
+
+        /**
+         * @brief Returns how many attributes were applied since construction.
+         * @return The number of applied attributes (one per attribute and update).
+         */
+        [[nodiscard]] auto get_applied_count() const -> qint64;
+
+    private:
+        Attributes m_desired;
+        std::optional<Attributes> m_applied;
+        qint64 m_applied_count = 0;
+};
+
+}  // namespace QtWidgetsCommonLib
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QList>
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @class HitTestRegionMap
+ * @brief Precomputed non-client hit-test regions of a frameless window.
+ *
+ * Holds the rectangles that decide a hit test (resize borders, caption area and the interactive
+ * areas inside it, such as window buttons, menubar actions and custom widgets) so that a hit test
+ * is only a few integer comparisons. The owner rebuilds the map when the window is resized, its
+ * title bar layout changes or its DPI changes, instead of querying the widgets on every mouse
+ * move.
+ *
+ * All coordinates are relative to the window's top-left corner and in the same unit as the
+ * tested points (native pixels for `AppWindow`).
+ *
+ * Rules, in order:
+ *  - A point inside the caption rectangle and neither on a resize border nor over an interactive
+ *    rectangle is `Caption`.
+ *  - A point on a resize border is the matching edge or corner, unless resizing is disabled
+ *    (e.g. while maximized).
+ *  - Everything else is `Client`.
+ */
+class QTWIDGETSCOMMONLIB_API HitTestRegionMap
+{
+    public:
+        /**
+         * @brief Result of a hit test.
+         */
+        enum class Region
+        {
+            Client,       ///< Regular client area, handled by Qt
+            Caption,      ///< Draggable caption area
+            Left,         ///< Left resize border
+            Right,        ///< Right resize border
+            Top,          ///< Top resize border
+            Bottom,       ///< Bottom resize border
+            TopLeft,      ///< Top-left resize corner
+            TopRight,     ///< Top-right resize corner
+            BottomLeft,   ///< Bottom-left resize corner
+            BottomRight   ///< Bottom-right resize corner
+        };
+
+        /**
+         * @brief Replaces all regions.
+         * @param window_size The size of the window.
+         * @param resize_border The thickness of the resize borders; 0 or less disables resizing.
+         * @param caption_rect The caption (title bar) area.
+         * @param interactive_rects Areas inside the caption that must stay client area.
+         */
+        auto update(const QSize& window_size, int resize_border, const QRect& caption_rect,
+                    const QList<QRect>& interactive_rects) -> void;
+
+        /**
+         * @brief Marks the map as outdated; the owner rebuilds it before the next hit test.
+         */
+        auto invalidate() -> void;
+
+        /**
+         * @brief Returns whether the map reflects the current window state.
+         * @return true after update() and until invalidate().
+         */
+        [[nodiscard]] auto is_valid() const -> bool;
+
+        /**
+         * @brief Returns the region at a point.
+         * @param pos The point, relative to the window's top-left corner.
+         * @return The region under the point.
+         */
+        [[nodiscard]] auto hit_test(const QPoint& pos) const -> Region;
+
+        /**
+         * @brief Returns the number of interactive rectangles in the map.
+         * @return The interactive rectangle count.
+         */
+        [[nodiscard]] auto get_interactive_rect_count() const -> int;
+
+    private:
+        /**
+         * @brief Returns the resize region at a point, or Client when not on a border.
+         * @param pos The point, relative to the window's top-left corner.
+         * @return The resize region, or Region::Client.
+         */
+        [[nodiscard]] auto resize_region(const QPoint& pos) const -> Region;
+
+    private:
+        int m_width = 0;
+        int m_height = 0;
+        int m_resize_border = 0;
+        QRect m_caption_rect;
+        QList<QRect> m_interactive_rects;
+        bool m_valid = false;
+};
+
+}  // namespace QtWidgetsCommonLib
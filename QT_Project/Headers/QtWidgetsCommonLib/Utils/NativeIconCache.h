@@ -0,0 +1,151 @@
+#pragma once
+
+#include <QHash>
+#include <QIcon>
+#include <QList>
+#include <QPixmap>
+#include <QString>
+#include <functional>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @class NativeIconCache
+ * @brief Reference-counted cache of native icon handles (HICON on Windows).
+ *
+ * Handles are keyed by the `QIcon::cacheKey()`, the icon size in physical pixels and the DPI, so
+ * every window showing the same icon at the same DPI shares one handle instead of building its
+ * own. `acquire()` creates a handle on a miss and adds a reference; `release()` removes one.
+ * Handles without references stay cached for a few icons (e.g. toggling an unread badge on and
+ * off), after which the oldest are destroyed.
+ *
+ * Creating and destroying handles is delegated to two functions, so the cache logic does not
+ * depend on the platform. `shared()` uses `CreateIconIndirect` / `DestroyIcon` on Windows; on
+ * other platforms it creates no handles.
+ *
+ * Like `QPixmap`, the cache is meant for the GUI thread.
+ */
+class QTWIDGETSCOMMONLIB_API NativeIconCache
+{
+    public:
+        /**
+         * @brief Opaque native icon handle (an HICON on Windows).
+         */
+        using Handle = void*;
+
+        /**
+         * @brief Creates a handle from a pixmap in physical pixels, or returns nullptr.
+         */
+        using CreateFunction = std::function<Handle(const QPixmap& pixmap)>;
+
+        /**
+         * @brief Destroys a handle created by the matching `CreateFunction`.
+         */
+        using DestroyFunction = std::function<void(Handle handle)>;
+
+        /**
+         * @brief Constructs a cache.
+         * @param create_function Creates the handles.
+         * @param destroy_function Destroys the handles.
+         */
+        NativeIconCache(CreateFunction create_function, DestroyFunction destroy_function);
+
+        /**
+         * @brief Destroys all cached handles, including referenced ones.
+         */
+        ~NativeIconCache();
+
+        NativeIconCache(const NativeIconCache&) = delete;
+        auto operator=(const NativeIconCache&) -> NativeIconCache& = delete;
+
+        /**
+         * @brief Returns the process-wide cache using the platform's native icon functions.
+         * @return The shared cache.
+         */
+        [[nodiscard]] static auto shared() -> NativeIconCache&;
+
+        /**
+         * @brief Returns the handle of an icon, creating it on a miss, and adds a reference.
+         *
+         * @param icon The icon.
+         * @param size The icon size in physical pixels (square).
+         * @param dpi The DPI the handle is created for.
+         * @return The handle, or nullptr if the icon is null or no handle could be created.
+         */
+        [[nodiscard]] auto acquire(const QIcon& icon, int size, int dpi) -> Handle;
+
+        /**
+         * @brief Removes a reference added by `acquire()`.
+         *
+         * Unreferenced handles stay cached up to the unused capacity; beyond that the oldest are
+         * destroyed. nullptr and unknown handles are ignored.
+         *
+         * @param handle The handle to release.
+         */
+        auto release(Handle handle) -> void;
+
+        /**
+         * @brief Sets how many unreferenced handles are kept for reuse.
+         * @param capacity The maximum number of unreferenced handles (default: 8).
+         */
+        auto set_unused_capacity(int capacity) -> void;
+
+        /**
+         * @brief Returns how many unreferenced handles are kept for reuse.
+         * @return The unused capacity.
+         */
+        [[nodiscard]] auto get_unused_capacity() const -> int;
+
+        /**
+         * @brief Returns the number of cached handles, referenced or not.
+         * @return The entry count.
+         */
+        [[nodiscard]] auto get_entry_count() const -> qsizetype;
+
+        /**
+         * @brief Returns the number of references to a handle.
+         * @param handle The handle.
+         * @return The reference count, or 0 if the handle is unknown or unreferenced.
+         */
+        [[nodiscard]] auto get_reference_count(Handle handle) const -> int;
+
+        /**
+         * @brief Returns how many handles were created since construction.
+         * @return The number of created handles.
+         */
+        [[nodiscard]] auto get_created_count() const -> qint64;
+
+        /**
+         * @brief Destroys all unreferenced handles.
+         */
+        auto clear_unused() -> void;
+
+    private:
+        /**
+         * @struct Entry
+         * @brief One cached handle.
+         */
+        struct Entry {
+                Handle handle = nullptr;
+                int references = 0;
+        };
+
+        /**
+         * @brief Destroys the oldest unreferenced handles beyond the unused capacity.
+         */
+        auto trim_unused() -> void;
+
+    private:
+        CreateFunction m_create_function;
+        DestroyFunction m_destroy_function;
+        QHash<QString, Entry> m_entries;
+        QHash<Handle, QString> m_keys;  ///< Reverse lookup for release()
+        QList<QString> m_unused;        ///< Unreferenced entries, oldest first
+        int m_unused_capacity = 8;
+        qint64 m_created_count = 0;
+};
+
+}  // namespace QtWidgetsCommonLib
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QString>
+#include <QStringList>
+#include <span>
 
 namespace QtWidgetsCommonLib
 {
@@ -8,10 +10,21 @@ namespace QtWidgetsCommonLib
 /**
  * @class NumberFormatUtils
  * @brief Utility class for formatting numbers for UI display.
+ *
+ * Besides the `QString` overloads, values can be written into a caller-provided UTF-16 buffer
+ * without any allocation, or formatted in batches (e.g. one column of a table model) with a
+ * single allocation per result.
  */
 class NumberFormatUtils
 {
     public:
+        /**
+         * @brief Buffer size (in UTF-16 code units) that holds the abbreviation of any double.
+         *
+         * Values below 1e15 in magnitude need at most 6 code units.
+         */
+        static constexpr qsizetype kMaxAbbreviatedLength = 320;
+
         /**
          * @brief Formats a number with abbreviated suffixes (e.g., 1.2K, 3M).
          *
@@ -35,6 +48,45 @@ class NumberFormatUtils
          * @return Abbreviated string representation.
          */
         [[nodiscard]] static auto format_number_abbreviated(int value) -> QString;
+
+        /**
+         * @brief Writes the abbreviation of a number into a caller-provided buffer.
+         *
+         * Produces the same text as the `QString` overload without allocating. The text is not
+         * null-terminated; `QStringView(buffer.data(), length)` views it.
+         *
+         * @param value The number to format.
+         * @param buffer The destination buffer.
+         * @return The number of code units written, or -1 if the buffer is too small.
+         */
+        [[nodiscard]] static auto format_number_abbreviated(double value,
+                                                            std::span<char16_t> buffer)
+            -> qsizetype;
+
+        /**
+         * @brief Writes the abbreviation of an integer into a caller-provided buffer.
+         * @param value The integer to format.
+         * @param buffer The destination buffer.
+         * @return The number of code units written, or -1 if the buffer is too small.
+         */
+        [[nodiscard]] static auto format_number_abbreviated(int value, std::span<char16_t> buffer)
+            -> qsizetype;
+
+        /**
+         * @brief Formats a span of numbers with abbreviated suffixes.
+         * @param values The numbers to format.
+         * @return One abbreviated string per value, in order.
+         */
+        [[nodiscard]] static auto format_numbers_abbreviated(std::span<const double> values)
+            -> QStringList;
+
+        /**
+         * @brief Formats a span of integers with abbreviated suffixes.
+         * @param values The integers to format.
+         * @return One abbreviated string per value, in order.
+         */
+        [[nodiscard]] static auto format_numbers_abbreviated(std::span<const int> values)
+            -> QStringList;
 };
 
 }  // namespace QtWidgetsCommonLib
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QtGlobal>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @class SharedRegistry
+ * @brief Process-wide table of reference-counted values, shared by everyone using the same key.
+ *
+ * The registry only holds weak references: a value lives as long as at least one user keeps the
+ * `std::shared_ptr` returned by `acquire()` or `insert()`, and is created again on the next
+ * acquire after the last user released it. This lets several windows share parsed stylesheets
+ * and loaded translations without a global cache that grows forever.
+ *
+ * All functions are thread-safe. The create function runs without holding the lock, so two
+ * threads may create the same value concurrently; the first one inserted wins and both receive
+ * it.
+ *
+ * @tparam Key The key type; needs `operator==` and `qHash()`.
+ * @tparam Value The shared value type (may be const).
+ */
+template <typename Key, typename Value>
+class SharedRegistry
+{
+    public:
+        /**
+         * @brief Creates the value for a key on a miss, or returns nullptr on failure.
+         */
+        using CreateFunction = std::function<std::shared_ptr<Value>()>;
+
+        /**
+         * @brief Returns the shared value of a key, creating it on a miss.
+         *
+         * Failures (nullptr) are not stored, so the next acquire tries again.
+         *
+         * @param key The key.
+         * @param create_function Creates the value if the key has no living value.
+         * @return The shared value, or nullptr if it could not be created.
+         */
+        [[nodiscard]] auto acquire(const Key& key,
+                                   const CreateFunction& create_function) -> std::shared_ptr<Value>
+        {
+            std::shared_ptr<Value> result = find(key);
+
+            if (result == nullptr)
+            {
+                std::shared_ptr<Value> created = create_function();
+
+                if (created != nullptr)
+                {
+                    result = insert(key, std::move(created));
+                }
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Shares a value created elsewhere (e.g. on a worker thread).
+         *
+         * @param key The key.
+         * @param value The value to share; ignored if the key already has a living value.
+         * @return The living value of the key: the existing one, or `value`.
+         */
+        auto insert(const Key& key, std::shared_ptr<Value> value) -> std::shared_ptr<Value>
+        {
+            const QMutexLocker locker(&m_mutex);
+            std::shared_ptr<Value> result = m_entries.value(key).lock();
+
+            if (result == nullptr && value != nullptr)
+            {
+                remove_expired();
+                m_entries.insert(key, value);
+                ++m_created_count;
+                result = std::move(value);
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Returns the living value of a key without creating it.
+         * @param key The key.
+         * @return The shared value, or nullptr if nobody holds it.
+         */
+        [[nodiscard]] auto find(const Key& key) const -> std::shared_ptr<Value>
+        {
+            const QMutexLocker locker(&m_mutex);
+            return m_entries.value(key).lock();
+        }
+
+        /**
+         * @brief Returns whether a key has a living value.
+         * @param key The key.
+         * @return true if at least one user holds the value of the key.
+         */
+        [[nodiscard]] auto contains(const Key& key) const -> bool
+        {
+            return find(key) != nullptr;
+        }
+
+        /**
+         * @brief Returns the number of values that are currently in use.
+         * @return The count of keys with a living value.
+         */
+        [[nodiscard]] auto get_entry_count() const -> qsizetype
+        {
+            const QMutexLocker locker(&m_mutex);
+            qsizetype result = 0;
+
+            for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+            {
+                result += it.value().expired() ? 0 : 1;
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Returns how many values were stored since construction.
+         * @return The number of values created on a miss or inserted.
+         */
+        [[nodiscard]] auto get_created_count() const -> qint64
+        {
+            const QMutexLocker locker(&m_mutex);
+            return m_created_count;
+        }
+
+    private:
+        /**
+         * @brief Drops the keys whose values were released by all users; expects the lock held.
+         */
+        auto remove_expired() -> void
+        {
+            auto it = m_entries.begin();
+
+            while (it != m_entries.end())
+            {
+                it = it.value().expired() ? m_entries.erase(it) : std::next(it);
+            }
+        }
+
+    private:
+        mutable QMutex m_mutex;
+        QHash<Key, std::weak_ptr<Value>> m_entries;
+        qint64 m_created_count = 0;
+};
+
+}  // namespace QtWidgetsCommonLib
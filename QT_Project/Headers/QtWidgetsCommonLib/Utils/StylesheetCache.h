@@ -0,0 +1,140 @@
+#pragma once
+
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+#include "QtWidgetsCommonLib/Utils/CompiledStylesheet.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @struct StylesheetCacheEntry
+ * @brief Fully resolved result of loading a stylesheet with a given theme.
+ */
+struct StylesheetCacheEntry {
+        QString stylesheet;
+        QStringList available_themes;
+        QMap<QString, QString> variables;
+        bool has_unresolved_variables = false;
+        QList<QStringList> variable_cycles;
+        QStringList undefined_references;
+        QList<UnresolvedVariable> unresolved_variables;
+};
+
+/**
+ * @class StylesheetCache
+ * @brief Persists fully resolved stylesheets on disk, keyed by source content hash and theme.
+ *
+ * Each entry is stored in its own binary file (`<key>.qsscache`) written atomically via
+ * `QSaveFile`. Entries are read back by memory-mapping the file, so a cache hit costs one file
+ * open and a `QDataStream` decode instead of parsing and resolving the QSS source.
+ *
+ * The key is a SHA-1 over the digest of the source text and the theme name, so any edit to the
+ * source (or a different theme) naturally misses the cache; stale entries are simply never read
+ * again. The directory keeps a limited number of entries (`set_max_entry_count()`); each write
+ * removes the entries beyond it with the oldest modification time.
+ */
+class QTWIDGETSCOMMONLIB_API StylesheetCache
+{
+    public:
+        /**
+         * @brief Constructs a cache rooted at the given directory.
+         * @param directory The cache directory, or empty for
+         * `QStandardPaths::CacheLocation` + "/stylesheets".
+         */
+        explicit StylesheetCache(const QString& directory = QString());
+
+        /**
+         * @brief Returns the directory the cache files are stored in.
+         * @return The absolute cache directory path.
+         */
+        [[nodiscard]] auto get_directory() const -> QString;
+
+        /**
+         * @brief Sets how many entries the cache directory keeps.
+         * @param count The maximum number of entries; values < 1 are clamped to 1.
+         */
+        auto set_max_entry_count(int count) -> void;
+
+        /**
+         * @brief Returns how many entries the cache directory keeps.
+         * @return The maximum number of entries (default 32).
+         */
+        [[nodiscard]] auto get_max_entry_count() const -> int;
+
+        /**
+         * @brief Computes the digest of a source text, the part of the cache key shared by all
+         * themes.
+         * @param source The raw QSS source text.
+         * @param origins The files the source was composed from, if any
+         *                (`StylesheetImportGraph::get_origins()`).
+         * @return A hex-encoded hash of the source and its origins.
+         */
+        [[nodiscard]] static auto make_source_key(const QString& source,
+                                                  const QList<SourceOrigin>& origins = {})
+            -> QString;
+
+        /**
+         * @brief Computes the cache key for a source digest and theme without hashing the source.
+         * @param source_key The digest returned by `make_source_key()`.
+         * @param theme_name The theme name, or empty for the default block.
+         * @return A hex-encoded hash usable as file name; equal to `make_key()` of the source.
+         */
+        [[nodiscard]] static auto make_theme_key(const QString& source_key,
+                                                 const QString& theme_name) -> QString;
+
+        /**
+         * @brief Computes the cache key for a source text and theme.
+         * @param source The raw QSS source text.
+         * @param theme_name The theme name, or empty for the default block.
+         * @return A hex-encoded hash usable as file name.
+         */
+        [[nodiscard]] static auto make_key(const QString& source,
+                                           const QString& theme_name) -> QString;
+
+        /**
+         * @brief Reads a cache entry.
+         * @param key The key returned by `make_key()`.
+         * @param entry Receives the cached entry on success.
+         * @return true if a valid entry was found and read, false otherwise.
+         */
+        [[nodiscard]] auto load(const QString& key, StylesheetCacheEntry& entry) const -> bool;
+
+        /**
+         * @brief Writes a cache entry, replacing an existing one with the same key.
+         * @param key The key returned by `make_key()`.
+         * @param entry The entry to store.
+         * @return true if the entry was written, false otherwise.
+         */
+        auto store(const QString& key, const StylesheetCacheEntry& entry) const -> bool;
+
+        /**
+         * @brief Removes all cache files from the cache directory.
+         * @return true if all cache files were removed, false otherwise.
+         */
+        auto clear() const -> bool;
+
+    private:
+        /**
+         * @brief Returns the file path for a cache key.
+         * @param key The cache key.
+         * @return The absolute file path of the entry.
+         */
+        [[nodiscard]] auto get_entry_path(const QString& key) const -> QString;
+
+        /**
+         * @brief Removes the entries beyond the maximum entry count, oldest first.
+         * @param kept_key The key of the entry just written; it is always kept.
+         */
+        auto remove_oldest_entries(const QString& kept_key) const -> void;
+
+    private:
+        QString m_directory;
+        int m_max_entry_count = 32;
+};
+
+}  // namespace QtWidgetsCommonLib
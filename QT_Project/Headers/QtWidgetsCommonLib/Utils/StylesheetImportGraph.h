@@ -0,0 +1,181 @@
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+#include "QtWidgetsCommonLib/Utils/CompiledStylesheet.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @class StylesheetImportGraph
+ * @brief Composes a stylesheet from a root file and its `@import "file.qss";` dependencies.
+ *
+ * Every file of the graph is cached separately in parsed form: its text split at the import
+ * directives, the resolved import paths and, once needed, one `CompiledStylesheet` per chunk.
+ * Loading again only re-reads files that were invalidated or whose size or modification time
+ * changed; all other files are reused, so editing one file costs one file parse plus a merge of
+ * the already compiled chunks (`CompiledStylesheet::concatenate()`).
+ *
+ * Composition rules:
+ *  - Import paths are resolved relative to the importing file (resource paths work as well).
+ *  - A file imported more than once is included at its first import only.
+ *  - Import cycles and unreadable imports are skipped with a warning.
+ *  - Directives inside `/* ... */` comments are inert and stay in the text as comments.
+ *  - The composed source is the expanded text with all import directives removed.
+ *
+ * The graph is a value type built from implicitly shared containers, so a copy can be updated on
+ * a worker thread and handed back.
+ */
+class QTWIDGETSCOMMONLIB_API StylesheetImportGraph
+{
+    public:
+        /**
+         * @brief Constructs an empty graph.
+         */
+        StylesheetImportGraph() = default;
+
+        /**
+         * @brief Loads a root file and all files it imports.
+         *
+         * Cached files are reused unless they were invalidated or changed on disk.
+         *
+         * @param root_path The path to the root QSS file.
+         * @return true if the root file could be read, false otherwise (the graph keeps its
+         * previous state).
+         */
+        auto load(const QString& root_path) -> bool;
+
+        /**
+         * @brief Returns whether no root file has been loaded.
+         * @return true if the graph is empty, false otherwise.
+         */
+        [[nodiscard]] auto is_empty() const -> bool;
+
+        /**
+         * @brief Returns the normalized path of the root file.
+         * @return The absolute root file path, or empty if nothing was loaded.
+         */
+        [[nodiscard]] auto get_root_path() const -> QString;
+
+        /**
+         * @brief Returns the composed source of the last load.
+         * @return The expanded QSS text without import directives.
+         */
+        [[nodiscard]] auto get_source() const -> const QString&;
+
+        /**
+         * @brief Compiles the composed source from the per-file compiled chunks.
+         *
+         * Chunks of files that have not changed since their last compilation are reused. Slot
+         * lines refer to the file each chunk was read from, not to the composed source.
+         *
+         * @return The compiled stylesheet of the composed source.
+         */
+        [[nodiscard]] auto compile() -> CompiledStylesheet;
+
+        /**
+         * @brief Returns where each chunk of the composed source comes from.
+         * @return One origin per chunk in composition order; empty if nothing was loaded.
+         */
+        [[nodiscard]] auto get_origins() const -> QList<SourceOrigin>;
+
+        /**
+         * @brief Returns all files of the graph.
+         * @return The normalized file paths in include order, root first.
+         */
+        [[nodiscard]] auto get_files() const -> QStringList;
+
+        /**
+         * @brief Returns whether a file is part of the graph.
+         * @param file_path The file path to look up.
+         * @return true if the file was included by the last load, false otherwise.
+         */
+        [[nodiscard]] auto contains(const QString& file_path) const -> bool;
+
+        /**
+         * @brief Returns the files that were (re-)read by the last load.
+         * @return The normalized paths of all files parsed during the last `load()`.
+         */
+        [[nodiscard]] auto get_reparsed_files() const -> QStringList;
+
+        /**
+         * @brief Returns the error of the last failed file read.
+         * @return A human-readable error message, or empty if no read failed.
+         */
+        [[nodiscard]] auto get_error_string() const -> QString;
+
+        /**
+         * @brief Drops the cached parse of a file so the next load reads it again.
+         * @param file_path The file that changed.
+         */
+        auto invalidate(const QString& file_path) -> void;
+
+        /**
+         * @brief Removes all files and the composed source.
+         */
+        auto clear() -> void;
+
+        /**
+         * @brief Returns the canonical form of a path used as key inside the graph.
+         * @param file_path The file path to normalize.
+         * @return The cleaned absolute file path.
+         */
+        [[nodiscard]] static auto normalize_path(const QString& file_path) -> QString;
+
+    private:
+        /**
+         * @struct ParsedFile
+         * @brief Cached parsed form of one file of the graph.
+         */
+        struct ParsedFile {
+                QStringList chunks;
+                QList<int> chunk_lines;  ///< 1-based line of each chunk's start in the file
+                QStringList imports;
+                QList<CompiledStylesheet> compiled;
+                QDateTime last_modified;
+                qint64 size = 0;
+        };
+
+        /**
+         * @struct ChunkRef
+         * @brief Position of one chunk of the composed source.
+         */
+        struct ChunkRef {
+                QString file;
+                qsizetype chunk = 0;
+        };
+
+        /**
+         * @brief Makes sure a file is parsed and its cached form is up to date.
+         * @param file_path The normalized file path.
+         * @return true if the file is available, false if it could not be read.
+         */
+        auto ensure_parsed(const QString& file_path) -> bool;
+
+        /**
+         * @brief Appends a file and, recursively, its imports to the composition.
+         * @param file_path The normalized file path.
+         * @param import_stack The files currently being expanded (cycle detection).
+         * @param included The files already part of the composition.
+         */
+        auto expand(const QString& file_path, QStringList& import_stack,
+                    QSet<QString>& included) -> void;
+
+    private:
+        QString m_root_path;
+        QString m_source;
+        QString m_error_string;
+        QHash<QString, ParsedFile> m_files;
+        QStringList m_file_order;
+        QList<ChunkRef> m_composition;
+        QStringList m_reparsed_files;
+};
+
+}  // namespace QtWidgetsCommonLib
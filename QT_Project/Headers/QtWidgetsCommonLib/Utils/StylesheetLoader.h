@@ -1,14 +1,25 @@
 #pragma once
 
 #include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QImage>
+#include <QList>
 #include <QMap>
 #include <QObject>
-#include <QSet>
+#include <QPointer>
 #include <QString>
 #include <QStringList>
 #include <QTimer>
+#include <QWidget>
+#include <memory>
+#include <utility>
 
 #include "QtWidgetsCommonLib/ApiMacro.h"
+#include "QtWidgetsCommonLib/Utils/CompiledStylesheet.h"
+#include "QtWidgetsCommonLib/Utils/SharedRegistry.h"
+#include "QtWidgetsCommonLib/Utils/StylesheetCache.h"
+#include "QtWidgetsCommonLib/Utils/StylesheetImportGraph.h"
 
 namespace QtWidgetsCommonLib
 {
@@ -24,10 +35,19 @@ namespace QtWidgetsCommonLib
  * Precedence:
  *  - Default block is parsed first.
  *  - Theme block (if provided) overrides default variables.
- *  - Variables can reference others (e.g. @Accent: @ColorPrimary;), resolved recursively.
+ *  - Variables can reference others (e.g. @Accent: @ColorPrimary;). Each variable is resolved
+ *    once in dependency order; cycles and undefined references resolve to empty strings and are
+ *    reported via `get_variable_cycles()` and `get_undefined_variable_references()`.
+ *
+ * Imports:
+ *  - File-based stylesheets may include other files via `@import "file.qss";` (relative to the
+ *    importing file). Each file of the import graph is cached in parsed and compiled form, so a
+ *    change to one file only re-parses that file (see `StylesheetImportGraph`).
+ *  - In-memory stylesheets (`load_stylesheet_from_data()`) do not resolve imports.
  *
  * Auto-reload:
- *  - When __Enable Auto Reload__ is active, `QFileSystemWatcher` observes the loaded file.
+ *  - When __Enable Auto Reload__ is active, `QFileSystemWatcher` observes the loaded file and
+ *    every file it imports.
  *  - File change notifications start a single-shot debounce `QTimer` to avoid reentrancy and
  *    to coalesce multiple quick write events before calling `reload_stylesheet()`.
  *
@@ -39,8 +59,50 @@ namespace QtWidgetsCommonLib
  *      - If no default block exists, variables stay unresolved and a warning is logged.
  *    This class does not auto-switch themes on reload; callers can use `set_theme()` if desired.
  *
- * Warnings:
- *  - If unresolved variables remain after substitution, a warning is logged.
+ * Compilation:
+ *  - The raw text is parsed once into a `CompiledStylesheet` (literal segments, variable slots
+ *    and per-theme variable tables). Loading identical text again skips the parse.
+ *  - `set_theme()`, `set_variable()` and `remove_variable()` only refill the slots and join the
+ *    segments; they never re-parse the source.
+ *
+ * Sharing between loaders:
+ *  - Compiled stylesheets (by source digest) and resolved themes (by source digest and theme)
+ *    live in process-wide `SharedRegistry` tables. Loaders of several windows that load the same
+ *    stylesheet parse and resolve it once and hold implicitly shared copies of the result; a
+ *    compiled stylesheet is released when the last loader stops using it.
+ *
+ * Disk cache:
+ *  - `enable_disk_cache()` persists the fully resolved stylesheet per (source hash, theme) so the
+ *    next start can apply it without parsing; the source is compiled lazily when first needed.
+ *
+ * Apply target:
+ *  - By default the stylesheet is applied application-wide via `qApp->setStyleSheet()`.
+ *  - `set_apply_target()` restricts it to a widget subtree, so only that subtree is re-polished.
+ *  - Changes to variables not referenced by the stylesheet, or changes that render to the text
+ *    already applied, do not trigger a re-apply at all.
+ *
+ * Batched updates:
+ *  - `set_variables()` updates variables immediately but defers the rebuild/apply to the next
+ *    event-loop turn via a zero-interval single-shot `QTimer`, so many updates cost one re-polish.
+ *  - Any immediate operation (load, theme change, `set_variable()`) supersedes a pending apply.
+ *
+ * Asynchronous loading:
+ *  - `load_stylesheet_async()` does file reading, parsing and resolution on a worker thread and
+ *    marshals only the final apply to the GUI thread; stale results are dropped.
+ *  - `enable_async_reload()` routes auto-reload through the asynchronous path.
+ *
+ * Theme previews:
+ *  - `render_theme_previews()` renders a preview widget offscreen under several themes into
+ *    `QImage`s without changing the applied stylesheet. The themes are resolved in parallel.
+ *    The images are cached process-wide by source hash, theme, preview and size, so a theme
+ *    picker that opens again gets them without rendering.
+ *
+ * Diagnostics:
+ *  - Rendering collects every `@name` reference without a value, with its source line, in the
+ *    same pass; `get_unresolved_variables()` returns them and a warning lists them once per
+ *    load or theme switch.
+ *  - `get_current_stylesheet()` returns the cached text. After `set_variables()` it is rendered
+ *    once on first request and reused until the inputs change again.
  */
 class QTWIDGETSCOMMONLIB_API StylesheetLoader: public QObject
 {
@@ -56,6 +118,10 @@ class QTWIDGETSCOMMONLIB_API StylesheetLoader: public QObject
         /**
          * @brief Loads a stylesheet file, parses variables (default and theme), resolves them
          * recursively, and applies it to the application. Logs success or failure.
+         *
+         * `@import "file.qss";` directives are expanded; unchanged files of the import graph are
+         * reused from the previous load.
+         *
          * @param file_path The path to the QSS file.
          * @param theme_name The theme name to use, or empty for default.
          * @return true if loading and applying succeeded, false otherwise.
@@ -72,6 +138,34 @@ class QTWIDGETSCOMMONLIB_API StylesheetLoader: public QObject
         auto load_stylesheet_from_data(const QString& stylesheet,
                                        const QString& theme_name = QString()) -> bool;
 
+        /**
+         * @brief Loads a stylesheet file on a worker thread and applies it when ready.
+         *
+         * Reading, parsing, variable resolution and rendering run via `QtConcurrent`; only the
+         * final state update and `setStyleSheet` happen on the GUI thread. Each load (sync or
+         * async) starts a new generation, so results of superseded async loads are dropped.
+         * `stylesheetReady()` is emitted once the result has been applied (or failed).
+         *
+         * @param file_path The path to the QSS file.
+         * @param theme_name The theme name to use, or empty for default.
+         */
+        auto load_stylesheet_async(const QString& file_path,
+                                   const QString& theme_name = QString()) -> void;
+
+        /**
+         * @brief Returns whether asynchronous loads are still running.
+         * @return true if at least one async load has not delivered its result yet.
+         */
+        [[nodiscard]] auto is_loading() const -> bool;
+
+        /**
+         * @brief Blocks until the asynchronous loads in flight finished and applies their results.
+         *
+         * Waits on the worker threads without running an event loop, e.g. to apply a startup
+         * load before a window is polished. `stylesheetReady()` is emitted from within this call.
+         */
+        auto wait_for_async_loads() -> void;
+
         /**
          * @brief Reloads the last successfully loaded stylesheet path with the current theme.
          * @return true if reloading and applying succeeded, false otherwise.
@@ -80,7 +174,7 @@ class QTWIDGETSCOMMONLIB_API StylesheetLoader: public QObject
         auto reload_stylesheet() -> bool;
 
         /**
-         * @brief Changes the current theme and reapplies the stylesheet.
+         * @brief Changes the current theme and reapplies the stylesheet without re-parsing.
          * @param theme_name The theme to set. Empty uses the default @Variables block.
          * @return true if the theme exists (or empty default) and was applied, false otherwise.
          */
@@ -88,6 +182,9 @@ class QTWIDGETSCOMMONLIB_API StylesheetLoader: public QObject
 
         /**
          * @brief Returns the current stylesheet as a QString (with variables substituted).
+         *
+         * Includes pending changes from `set_variables()` even if they were not applied yet.
+         *
          * @return The current stylesheet with variables replaced.
          */
         [[nodiscard]] auto get_current_stylesheet() const -> QString;
@@ -117,6 +214,34 @@ class QTWIDGETSCOMMONLIB_API StylesheetLoader: public QObject
          */
         [[nodiscard]] auto has_variable(const QString& name) const -> bool;
 
+        /**
+         * @brief Returns the variable reference cycles detected for the current theme.
+         *
+         * Variables in a cycle (e.g. `@A: @B; @B: @A;`) resolve to an empty string.
+         *
+         * @return One sorted list of variable names per cycle; empty if there are no cycles.
+         */
+        [[nodiscard]] auto get_variable_cycles() const -> QList<QStringList>;
+
+        /**
+         * @brief Returns the undefined variables referenced by variable values of the current
+         * theme. Such references resolve to an empty string.
+         * @return Sorted, unique variable names (without '@').
+         */
+        [[nodiscard]] auto get_undefined_variable_references() const -> QStringList;
+
+        /**
+         * @brief Returns the variable references in the stylesheet body that have no value.
+         *
+         * Collected while rendering, so it costs no extra scan of the stylesheet. Includes pending
+         * changes from `set_variables()`. For file-based loads every reference carries the file
+         * it is written in and its line there, also inside `@import`ed files; for data-based
+         * loads the file is empty and the line refers to the data.
+         *
+         * @return The unresolved references in source order; empty if every slot has a value.
+         */
+        [[nodiscard]] auto get_unresolved_variables() const -> QList<UnresolvedVariable>;
+
         /**
          * @brief Removes a variable and reapplies the stylesheet.
          * @param name The variable name (without '@').
@@ -131,6 +256,29 @@ class QTWIDGETSCOMMONLIB_API StylesheetLoader: public QObject
          */
         auto set_variable(const QString& name, const QString& value) -> void;
 
+        /**
+         * @brief Sets or overrides several variables and schedules a single deferred reapply.
+         *
+         * The variables are updated immediately, but the stylesheet is rebuilt and applied only
+         * once when control returns to the event loop. Repeated calls within the same event-loop
+         * turn (e.g. while dragging a color picker) are coalesced into one apply.
+         *
+         * @param variables The variable names (without '@') and values to set.
+         */
+        auto set_variables(const QMap<QString, QString>& variables) -> void;
+
+        /**
+         * @brief Applies pending changes from `set_variables()` immediately.
+         * @return true if pending changes were applied, false if nothing was pending.
+         */
+        auto flush_pending_changes() -> bool;
+
+        /**
+         * @brief Returns whether changes from `set_variables()` are waiting to be applied.
+         * @return true if a deferred apply is scheduled, false otherwise.
+         */
+        [[nodiscard]] auto has_pending_changes() const -> bool;
+
         /**
          * @brief Enables automatic reloading when the loaded stylesheet file changes.
          * @param enabled True to enable, false to disable.
@@ -138,6 +286,96 @@ class QTWIDGETSCOMMONLIB_API StylesheetLoader: public QObject
          */
         auto enable_auto_reload(bool enabled) -> bool;
 
+        /**
+         * @brief Makes auto-reload parse the changed file on a worker thread.
+         * @param enabled True to reload via `load_stylesheet_async()`, false to reload
+         * synchronously.
+         */
+        auto enable_async_reload(bool enabled) -> void;
+
+        /**
+         * @brief Enables or disables the on-disk cache of resolved stylesheets.
+         *
+         * When enabled, loading a source that differs from the last compiled one first looks up
+         * the fully resolved stylesheet by (content hash, theme) and applies it without parsing.
+         * Misses are parsed as usual and written back to the cache, which keeps at most
+         * `StylesheetCache::get_max_entry_count()` entries. Disabled by default.
+         *
+         * @param enabled True to enable, false to disable.
+         * @param directory The cache directory, or empty for `QStandardPaths::CacheLocation`.
+         */
+        auto enable_disk_cache(bool enabled, const QString& directory = QString()) -> void;
+
+        /**
+         * @brief Returns whether the on-disk cache is enabled.
+         * @return true if loads consult and fill the disk cache, false otherwise.
+         */
+        [[nodiscard]] auto is_disk_cache_enabled() const -> bool;
+
+        /**
+         * @brief Sets the widget whose subtree receives the stylesheet instead of the application.
+         *
+         * Applying to a widget only re-polishes that widget and its children; other top-level
+         * windows are left alone. The current stylesheet is applied to the new target right away.
+         * The previous target keeps its stylesheet.
+         *
+         * @param target The widget to style, or nullptr to apply application-wide again.
+         */
+        auto set_apply_target(QWidget* target) -> void;
+
+        /**
+         * @brief Returns the widget the stylesheet is applied to.
+         * @return The target widget, or nullptr when applying application-wide.
+         */
+        [[nodiscard]] auto get_apply_target() const -> QWidget*;
+
+        /**
+         * @brief Renders a widget offscreen under several themes of the loaded stylesheet.
+         *
+         * Neither the application's nor the apply target's stylesheet is changed. The preview
+         * should be a hidden, parentless widget resized to the thumbnail size; its own
+         * stylesheet is restored afterwards. The application stylesheet, if any, still
+         * cascades into the preview.
+         *
+         * @param preview The widget to render.
+         * @param theme_names The themes to render, or empty for all available themes.
+         * @return One image per available theme in `theme_names`; unknown themes are skipped.
+         */
+        [[nodiscard]] auto render_theme_previews(QWidget* preview,
+                                                 const QStringList& theme_names = QStringList())
+            -> QHash<QString, QImage>;
+
+        /**
+         * @brief Renders a widget offscreen under one theme; see `render_theme_previews()`.
+         * @param preview The widget to render.
+         * @param theme_name The theme to render.
+         * @return The image, or a null image if the theme is not available.
+         */
+        [[nodiscard]] auto render_theme_preview(QWidget* preview,
+                                                const QString& theme_name) -> QImage;
+
+        /**
+         * @brief Drops all cached theme preview images.
+         */
+        static auto clear_theme_preview_cache() -> void;
+
+        /**
+         * @brief Returns how many compiled stylesheets are currently shared by all loaders.
+         *
+         * Loaders with the same source share one compiled stylesheet, so the count does not grow
+         * with the number of windows.
+         *
+         * @return The number of compiled stylesheets in use.
+         */
+        [[nodiscard]] static auto get_shared_stylesheet_count() -> qsizetype;
+
+    signals:
+        /**
+         * @brief Emitted when an asynchronous load finished and its result was applied.
+         * @param success true if the stylesheet was loaded and applied, false on failure.
+         */
+        void stylesheetReady(bool success);
+
     private slots:
         /**
          * @brief Slot invoked when the watched stylesheet file changes.
@@ -150,11 +388,29 @@ class QTWIDGETSCOMMONLIB_API StylesheetLoader: public QObject
         void on_stylesheet_file_changed(const QString& changed_path);
 
     private:
+        struct PreparedStylesheet;
+
+        using CompiledRegistry = SharedRegistry<QString, const CompiledStylesheet>;
+        using ThemeRegistry =
+            SharedRegistry<std::pair<QString, QString>, const StylesheetCacheEntry>;
+
+        /**
+         * @brief Returns the process-wide compiled stylesheets, keyed by source digest.
+         * @return The registry.
+         */
+        [[nodiscard]] static auto get_compiled_registry() -> CompiledRegistry&;
+
+        /**
+         * @brief Returns the process-wide resolved themes, keyed by source digest and theme name.
+         * @return The registry.
+         */
+        [[nodiscard]] static auto get_theme_registry() -> ThemeRegistry&;
+
         /**
          * @brief Common parsing/apply routine used by both file and in-memory loading.
          *
-         * Parses available themes and variables, resolves recursively, removes @Variables blocks,
-         * substitutes variables, applies the stylesheet, and updates internal state.
+         * Compiles the raw text (skipped when unchanged since the last load), activates the
+         * requested theme, applies the stylesheet, and updates internal state.
          *
          * @param raw_stylesheet The raw QSS input.
          * @param theme_name The requested theme (empty means default block only).
@@ -168,73 +424,143 @@ class QTWIDGETSCOMMONLIB_API StylesheetLoader: public QObject
                                           bool configure_watcher) -> bool;
 
         /**
-         * @brief Replaces all variable placeholders in the stylesheet with their values.
-         * @param stylesheet The stylesheet string to process.
-         * @return The stylesheet with variables substituted.
+         * @brief Activates the variables of a theme and reapplies the stylesheet.
+         *
+         * Resolves the theme's variable table from the compiled template and refills its slots;
+         * the raw source is not parsed again.
+         *
+         * @param theme_name The theme to activate, or empty for the default block.
          */
-        [[nodiscard]] auto substitute_variables(const QString& stylesheet) const -> QString;
+        auto activate_theme(const QString& theme_name) -> void;
 
         /**
-         * @brief Applies the given stylesheet to the QApplication.
-         * @param stylesheet The stylesheet string to apply.
+         * @brief Returns the shared resolved state of a theme of the current source.
+         *
+         * Resolves the theme only if no loader holds it yet; expects the source to be compiled.
+         *
+         * @param theme_name The theme to resolve, or empty for the default block.
+         * @return The resolved state.
          */
-        auto apply_stylesheet(const QString& stylesheet) -> void;
+        [[nodiscard]] auto resolve_theme(const QString& theme_name)
+            -> std::shared_ptr<const StylesheetCacheEntry>;
 
         /**
-         * @brief Extracts the @Variables block for a given theme name, or the default block if not
-         * found.
-         * @param stylesheet The full QSS stylesheet.
-         * @param theme_name The theme name to look for.
-         * @return The content of the variables block, or an empty string if not found.
+         * @brief Resolves a theme of a compiled stylesheet and renders the final text.
+         *
+         * Pure function of its inputs, so it is safe to call from worker threads.
+         *
+         * @param compiled The compiled stylesheet.
+         * @param theme_name The theme to resolve, or empty for the default block.
+         * @return The resolved state (stylesheet, themes, variables and diagnostics).
          */
-        static auto extract_variables_block(const QString& stylesheet,
-                                            const QString& theme_name) -> QString;
+        [[nodiscard]] static auto build_entry(const CompiledStylesheet& compiled,
+                                              const QString& theme_name) -> StylesheetCacheEntry;
 
         /**
-         * @brief Parses variables from a variables block and fills the variables map.
-         * @param variables_block The content of the variables block.
-         * @param variables The map to fill with variable name/value pairs.
+         * @brief Takes over a resolved state as the current one, logs its diagnostics and
+         * applies it.
+         * @param entry The resolved state (shared with other loaders).
+         * @param theme_name The theme the state was resolved for.
          */
-        static void parse_variables_block(const QString& variables_block,
-                                          QMap<QString, QString>& variables);
+        auto install_entry(const std::shared_ptr<const StylesheetCacheEntry>& entry,
+                           const QString& theme_name) -> void;
 
         /**
-         * @brief Parses all available theme names from the raw stylesheet.
-         * @param stylesheet The raw QSS stylesheet.
-         * @return A QStringList of theme names.
+         * @brief Re-targets the file watcher at all files of the current import graph.
+         * @param configure_watcher If false, all watched paths are cleared (in-memory loads).
+         * @return true if at least one file is watched, false otherwise.
+         */
+        auto update_watched_paths(bool configure_watcher) -> bool;
+
+        /**
+         * @brief Reads, compiles and resolves a stylesheet file; runs on a worker thread.
+         *
+         * Only touches its arguments and the thread-safe shared registries (no loader state), so
+         * it is safe off the GUI thread.
+         *
+         * @param generation The load generation the result belongs to.
+         * @param file_path The path to the QSS file.
+         * @param theme_name The theme to resolve.
+         * @param use_cache Whether to consult and fill the disk cache.
+         * @param cache The disk cache to use.
+         * @param import_graph A copy of the current import graph; only changed files are re-read.
+         * @return The prepared result, ready to be installed on the GUI thread.
+         */
+        [[nodiscard]] static auto prepare_stylesheet(quint64 generation, const QString& file_path,
+                                                     const QString& theme_name, bool use_cache,
+                                                     const StylesheetCache& cache,
+                                                     StylesheetImportGraph import_graph)
+            -> PreparedStylesheet;
+
+        /**
+         * @brief Installs the result of an asynchronous load on the GUI thread.
+         *
+         * Results of loads that were superseded by a newer load are dropped.
+         *
+         * @param prepared The prepared result from the worker thread.
+         */
+        auto finish_async_load(const PreparedStylesheet& prepared) -> void;
+
+        /**
+         * @brief Renders the compiled template with the current variables and applies the result.
+         */
+        auto refresh_stylesheet() -> void;
+
+        /**
+         * @brief Applies the current stylesheet text and cancels any pending deferred apply.
+         */
+        auto apply_current_stylesheet() -> void;
+
+        /**
+         * @brief Renders the current stylesheet and its unresolved references if inputs changed.
          */
-        [[nodiscard]] static auto parse_available_themes(const QString& stylesheet) -> QStringList;
+        auto ensure_rendered() const -> void;
 
         /**
-         * @brief Removes all @Variables blocks from the given stylesheet string.
-         * @param stylesheet The stylesheet string to process.
-         * @return The stylesheet with all @Variables blocks removed.
+         * @brief Compiles the current source if it changed since the last compilation.
          */
-        [[nodiscard]] static auto remove_variables_blocks(const QString& stylesheet) -> QString;
+        auto ensure_compiled() -> void;
 
         /**
-         * @brief Recursively resolves a variable to its final value, following references to other
-         * variables. Prevents infinite recursion by tracking visited names.
-         * @param name The variable name to resolve (without '@').
-         * @param variables The map of all available variables.
-         * @param seen A set of variable names already visited in this resolution chain (to prevent
-         * cycles).
-         * @return The fully resolved value of the variable, or an empty string if not found or
-         * cyclic.
+         * @brief Applies the given stylesheet to the apply target (or the QApplication).
+         *
+         * Skips the call when the target already has exactly this stylesheet, avoiding a
+         * needless re-polish of the widget tree.
+         *
+         * @param stylesheet The stylesheet string to apply.
          */
-        [[nodiscard]] static auto resolve_variable(const QString& name,
-                                                   const QMap<QString, QString>& variables,
-                                                   QSet<QString>& seen) -> QString;
+        auto apply_stylesheet(const QString& stylesheet) -> void;
 
     private:
         QMap<QString, QString> m_variables;
-        QString m_raw_stylesheet;
+        QList<QStringList> m_variable_cycles;
+        QStringList m_undefined_variable_references;
+        mutable QList<UnresolvedVariable> m_unresolved_variables;
+        QString m_source;
+        QList<SourceOrigin> m_source_origins;  ///< Files m_source is composed from, if any
+        QString m_source_key;  ///< `StylesheetCache::make_source_key()` of m_source and origins
+        std::shared_ptr<const CompiledStylesheet> m_compiled =
+            std::make_shared<const CompiledStylesheet>();
+        std::shared_ptr<const StylesheetCacheEntry> m_theme_entry;
+        StylesheetImportGraph m_import_graph;
+        bool m_compile_pending = false;
+        mutable QString m_current_stylesheet;
+        mutable bool m_render_pending = false;  ///< Variables changed since the last render
         QString m_current_stylesheet_path;
         QStringList m_available_themes;
         QString m_current_theme_name;
         QFileSystemWatcher m_watcher;
         bool m_auto_reload_enabled = false;
         QTimer m_reload_timer;
+        QTimer m_apply_timer;
+        bool m_apply_pending = false;
+        QPointer<QWidget> m_apply_target;
+        bool m_has_apply_target = false;
+        StylesheetCache m_disk_cache;
+        bool m_disk_cache_enabled = false;
+        quint64 m_load_generation = 0;
+        QList<QFutureWatcher<PreparedStylesheet>*> m_async_watchers;  ///< Oldest first
+        bool m_async_reload_enabled = false;
 };
 
 }  // namespace QtWidgetsCommonLib
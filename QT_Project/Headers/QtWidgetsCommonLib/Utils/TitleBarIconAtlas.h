@@ -0,0 +1,79 @@
+#pragma once
+
+#include <QColor>
+#include <QIcon>
+#include <QPixmap>
+#include <QRect>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @class TitleBarIconAtlas
+ * @brief Process-wide atlas of the window title bar button glyphs.
+ *
+ * For each color and icon size, all glyphs (minimize, maximize, restore, close) are rendered in
+ * a single pass into one atlas pixmap per screen device pixel ratio, laid out side by side. The
+ * glyph icons are cut from these atlases once and then shared by every `WindowTitleBar`, so
+ * opening more windows does not render or store the glyphs again, and switching between
+ * maximize and restore only swaps one shared icon for another.
+ *
+ * Like `QPixmap`, the atlas is meant for the GUI thread.
+ */
+class QTWIDGETSCOMMONLIB_API TitleBarIconAtlas
+{
+    public:
+        /**
+         * @brief Glyphs contained in the atlas, in atlas order.
+         */
+        enum class Glyph
+        {
+            Minimize,
+            Maximize,
+            Restore,
+            Close
+        };
+
+        /**
+         * @brief Returns the shared icon of a glyph, building the atlas on first use.
+         * @param glyph The glyph.
+         * @param color The glyph color.
+         * @param icon_px The logical icon size in pixels (square).
+         * @return The icon, with one pixmap per screen device pixel ratio.
+         */
+        [[nodiscard]] static auto get_icon(Glyph glyph, const QColor& color, int icon_px)
+            -> QIcon;
+
+        /**
+         * @brief Returns the atlas pixmap for a color, size and device pixel ratio.
+         * @param color The glyph color.
+         * @param icon_px The logical icon size in pixels (square).
+         * @param device_pixel_ratio One of the screen device pixel ratios.
+         * @return The atlas, or a null pixmap if no atlas exists for that ratio.
+         */
+        [[nodiscard]] static auto get_atlas(const QColor& color, int icon_px,
+                                            qreal device_pixel_ratio) -> QPixmap;
+
+        /**
+         * @brief Returns the logical rectangle of a glyph inside an atlas.
+         * @param glyph The glyph.
+         * @param icon_px The logical icon size in pixels (square).
+         * @return The source rectangle of the glyph.
+         */
+        [[nodiscard]] static auto get_glyph_rect(Glyph glyph, int icon_px) -> QRect;
+
+        /**
+         * @brief Returns the number of color and size combinations currently cached.
+         * @return The number of atlas entries.
+         */
+        [[nodiscard]] static auto get_entry_count() -> int;
+
+        /**
+         * @brief Removes all atlases and glyph icons.
+         */
+        static auto clear() -> void;
+};
+
+}  // namespace QtWidgetsCommonLib
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QtGlobal>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+
+/**
+ * @file Trace.h
+ * @brief Lightweight scoped tracing for the library's startup and hot paths.
+ *
+ * `QTWIDGETSCOMMONLIB_TRACE_SCOPE(category, name)` measures the enclosing scope. The macro is
+ * only compiled in when `QTWIDGETSCOMMONLIB_ENABLE_TRACING` is defined (CMake option
+ * `<project>_ENABLE_TRACING`); otherwise it expands to nothing and costs nothing.
+ *
+ * When compiled in, every scope updates an aggregated counter (count, total, min and max
+ * duration) per category and name; `Tracer::get_counters()` returns them for telemetry. With
+ * `Tracer::set_event_recording(true)` each scope is also kept as an event, which
+ * `Tracer::to_chrome_trace_json()` exports in the Chrome trace-event format that both
+ * chrome://tracing and the Perfetto UI open.
+ *
+ * Category and name must be string literals (or otherwise outlive the tracer), since only the
+ * pointers are stored. Recording is thread-safe.
+ */
+
+#define QTWIDGETSCOMMONLIB_TRACE_CONCAT_IMPL(a, b) a##b
+#define QTWIDGETSCOMMONLIB_TRACE_CONCAT(a, b) QTWIDGETSCOMMONLIB_TRACE_CONCAT_IMPL(a, b)
+
+#if defined(QTWIDGETSCOMMONLIB_ENABLE_TRACING)
+#define QTWIDGETSCOMMONLIB_TRACE_SCOPE(category, name)                                         \
+    const QtWidgetsCommonLib::TraceScope QTWIDGETSCOMMONLIB_TRACE_CONCAT(trace_scope_, __LINE__)( \
+        category, name)
+#else
+#define QTWIDGETSCOMMONLIB_TRACE_SCOPE(category, name) static_cast<void>(0)
+#endif
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @struct TraceCounter
+ * @brief Aggregated durations of one traced scope.
+ */
+struct TraceCounter {
+        QString category;
+        QString name;
+        qint64 count = 0;
+        qint64 total_ns = 0;
+        qint64 min_ns = 0;
+        qint64 max_ns = 0;
+};
+
+/**
+ * @class Tracer
+ * @brief Process-wide collector of trace counters and events.
+ */
+class QTWIDGETSCOMMONLIB_API Tracer
+{
+    public:
+        /**
+         * @brief Returns whether the trace macros are compiled into this build.
+         * @return true if `QTWIDGETSCOMMONLIB_ENABLE_TRACING` is defined.
+         */
+        [[nodiscard]] static auto is_compiled_in() -> bool;
+
+        /**
+         * @brief Enables or disables recording at runtime.
+         * @param enabled false makes every scope a single atomic load (default: true).
+         */
+        static auto set_enabled(bool enabled) -> void;
+
+        /**
+         * @brief Returns whether recording is enabled at runtime.
+         * @return true if scopes are recorded.
+         */
+        [[nodiscard]] static auto is_enabled() -> bool;
+
+        /**
+         * @brief Enables or disables keeping individual events for the trace export.
+         * @param enabled true to keep events, up to the event capacity (default: false).
+         */
+        static auto set_event_recording(bool enabled) -> void;
+
+        /**
+         * @brief Returns whether individual events are kept.
+         * @return true if events are recorded.
+         */
+        [[nodiscard]] static auto is_event_recording() -> bool;
+
+        /**
+         * @brief Sets the maximum number of kept events; later events are only counted.
+         * @param capacity The maximum number of events (default: 100000).
+         */
+        static auto set_event_capacity(qsizetype capacity) -> void;
+
+        /**
+         * @brief Returns the nanoseconds since the tracer's epoch (first use in the process).
+         * @return The monotonic timestamp in nanoseconds.
+         */
+        [[nodiscard]] static auto now_ns() -> qint64;
+
+        /**
+         * @brief Records one measured scope.
+         * @param category The category literal (e.g. "stylesheet").
+         * @param name The name literal (e.g. "StylesheetLoader::load_stylesheet").
+         * @param start_ns The start timestamp from `now_ns()`.
+         * @param duration_ns The duration in nanoseconds.
+         */
+        static auto record(const char* category, const char* name, qint64 start_ns,
+                           qint64 duration_ns) -> void;
+
+        /**
+         * @brief Returns the aggregated counters, sorted by category and name.
+         * @return One counter per traced scope.
+         */
+        [[nodiscard]] static auto get_counters() -> QList<TraceCounter>;
+
+        /**
+         * @brief Returns the number of kept events.
+         * @return The event count.
+         */
+        [[nodiscard]] static auto get_event_count() -> qsizetype;
+
+        /**
+         * @brief Exports the kept events as Chrome trace-event JSON ("X" complete events).
+         * @return The JSON document.
+         */
+        [[nodiscard]] static auto to_chrome_trace_json() -> QByteArray;
+
+        /**
+         * @brief Writes the Chrome trace-event JSON to a file.
+         * @param file_path The destination file.
+         * @return true if the file was written, false otherwise.
+         */
+        static auto write_chrome_trace(const QString& file_path) -> bool;
+
+        /**
+         * @brief Clears all counters and events.
+         */
+        static auto reset() -> void;
+};
+
+/**
+ * @class TraceScope
+ * @brief Measures its own lifetime and records it with `Tracer::record()`.
+ *
+ * Use through `QTWIDGETSCOMMONLIB_TRACE_SCOPE` so the measurement is compiled out by default.
+ */
+class QTWIDGETSCOMMONLIB_API TraceScope
+{
+    public:
+        /**
+         * @brief Starts the measurement if recording is enabled.
+         * @param category The category literal.
+         * @param name The name literal.
+         */
+        TraceScope(const char* category, const char* name);
+
+        /**
+         * @brief Records the measured duration.
+         */
+        ~TraceScope();
+
+        TraceScope(const TraceScope&) = delete;
+        auto operator=(const TraceScope&) -> TraceScope& = delete;
+
+    private:
+        const char* m_category = nullptr;
+        const char* m_name = nullptr;
+        qint64 m_start_ns = -1;  ///< -1 while recording is disabled
+};
+
+}  // namespace QtWidgetsCommonLib
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+#include "QtWidgetsCommonLib/Utils/Trace.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @struct TraceRate
+ * @brief Activity of one traced scope during the last sampling interval.
+ */
+struct TraceRate {
+        QString category;
+        QString name;
+        /** @brief Scopes per second. */
+        double count_per_second = 0.0;
+        /** @brief Average duration of one scope in milliseconds. */
+        double average_ms = 0.0;
+        /** @brief Milliseconds spent in the scope per second (time share). */
+        double busy_ms_per_second = 0.0;
+};
+
+/**
+ * @class TraceRateSampler
+ * @brief Turns the cumulative trace counters into per-second rates.
+ *
+ * `Tracer` only aggregates totals since start (or the last `Tracer::reset()`). Each `sample()`
+ * compares a counter snapshot with the previous one, so `get_rates()` describes the interval
+ * between the last two samples: how often each scope ran, how long it took on average and how
+ * much of each second it used. Scopes that did not run in the interval are left out.
+ *
+ * The sampler reads no global state; `PerformanceOverlay` feeds it `Tracer::get_counters()`.
+ */
+class QTWIDGETSCOMMONLIB_API TraceRateSampler
+{
+    public:
+        /**
+         * @brief Takes a snapshot and computes the rates since the previous one.
+         *
+         * The first sample (and the first after `reset()`) only records the baseline. Counters
+         * that went backwards (after `Tracer::reset()`) are measured from zero.
+         *
+         * @param counters The cumulative counters, e.g. from `Tracer::get_counters()`.
+         * @param now_ns The snapshot time in nanoseconds, e.g. from `Tracer::now_ns()`.
+         */
+        auto sample(const QList<TraceCounter>& counters, qint64 now_ns) -> void;
+
+        /**
+         * @brief Returns the rates of the last interval, sorted by category and name.
+         * @return One rate per scope that ran in the interval.
+         */
+        [[nodiscard]] auto get_rates() const -> QList<TraceRate>;
+
+        /**
+         * @brief Returns the rate of one scope in the last interval.
+         * @param category The trace category.
+         * @param name The trace name.
+         * @return The rate, or a zero rate if the scope did not run.
+         */
+        [[nodiscard]] auto get_rate(const QString& category, const QString& name) const
+            -> TraceRate;
+
+        /**
+         * @brief Returns the length of the last interval.
+         * @return The interval in milliseconds, or 0 before the second sample.
+         */
+        [[nodiscard]] auto get_interval_ms() const -> double;
+
+        /**
+         * @brief Formats the rates as text lines, grouped by category.
+         * @return A header line per category followed by one line per scope.
+         */
+        [[nodiscard]] auto to_lines() const -> QStringList;
+
+        /**
+         * @brief Forgets the baseline and the rates.
+         */
+        auto reset() -> void;
+
+    private:
+        QHash<QString, TraceCounter> m_previous;  ///< Keyed by "category/name"
+        qint64 m_previous_ns = -1;                ///< -1 before the first sample
+        double m_interval_ms = 0.0;
+        QList<TraceRate> m_rates;
+};
+
+}  // namespace QtWidgetsCommonLib
@@ -6,9 +6,13 @@
 #pragma once
 
 #include <QColor>
+#include <QIcon>
+#include <QList>
+#include <QObject>
 #include <QPixmap>
 #include <QSize>
 #include <QString>
+#include <functional>
 
 #include "QtWidgetsCommonLib/ApiMacro.h"
 
@@ -21,23 +25,116 @@ namespace QtWidgetsCommonLib
  *
  * This class offers utility functions to create colored QPixmaps from SVG files,
  * suitable for use in Qt widgets and actions.
+ *
+ * Rendered icons are cached process-wide in `QPixmapCache` (and thus share its byte budget),
+ * keyed by path, color, size and device pixel ratio. Parsed `QSvgRenderer` instances are cached
+ * per path, so re-coloring an icon does not parse the SVG again. The caches are meant for the
+ * GUI thread, like `QPixmap` itself.
+ *
+ * `colored_svg_icons()` renders a batch of requests into one `QIcon` each, with a pixmap per
+ * device pixel ratio of the connected screens, so Qt never upscales a low-resolution pixmap.
+ * `colored_svg_icons_async()` does the rendering into `QImage`s on a worker thread and only
+ * converts them to pixmaps on the GUI thread.
  */
 class QTWIDGETSCOMMONLIB_API UiUtils
 {
     public:
+        /**
+         * @struct IconCacheStats
+         * @brief Hit and miss counters of the icon caches.
+         */
+        struct IconCacheStats {
+                /** @brief Icons served from the pixmap cache. */
+                quint64 pixmap_hits = 0;
+                /** @brief Icons that had to be rendered. */
+                quint64 pixmap_misses = 0;
+                /** @brief Renders that reused a parsed SVG. */
+                quint64 renderer_hits = 0;
+                /** @brief Renders that had to parse the SVG file. */
+                quint64 renderer_misses = 0;
+        };
+
+        /**
+         * @struct IconRequest
+         * @brief One icon of a batch: SVG path, overlay color and logical size.
+         */
+        struct IconRequest {
+                QString svg_path;
+                QColor color;
+                QSize size = QSize(24, 24);
+        };
+
+        /**
+         * @brief Callback receiving the icons of an asynchronous batch, in request order.
+         */
+        using IconsReadyCallback = std::function<void(const QList<QIcon>& icons)>;
+
         /**
          * @brief Renders an SVG file to a QPixmap and applies a color overlay.
          *
          * This method loads the SVG at the given path, renders it to a pixmap of the specified
-         * size, and applies the given color using source-in composition.
+         * size, and applies the given color using source-in composition. Results are cached.
          *
          * @param svg_path The path to the SVG resource.
          * @param color The color to apply to the SVG.
          * @param size The desired size of the resulting pixmap (default: 24x24).
+         * @param device_pixel_ratio The device pixel ratio to render for (default: 1.0); the
+         * pixmap has `size * device_pixel_ratio` pixels.
          * @return A QPixmap containing the colored SVG.
          */
         [[nodiscard]] static auto colored_svg_icon(const QString& svg_path, const QColor& color,
-                                                   QSize size = QSize(24, 24)) -> QPixmap;
+                                                   QSize size = QSize(24, 24),
+                                                   qreal device_pixel_ratio = 1.0) -> QPixmap;
+
+        /**
+         * @brief Returns the distinct device pixel ratios of all connected screens.
+         * @return The ratios in ascending order; at least 1.0 if there is no screen.
+         */
+        [[nodiscard]] static auto get_screen_device_pixel_ratios() -> QList<qreal>;
+
+        /**
+         * @brief Renders a batch of colored icons for all screen device pixel ratios.
+         *
+         * Pixmaps come from (and go into) the icon cache.
+         *
+         * @param requests The icons to render.
+         * @return One icon per request, in request order.
+         */
+        [[nodiscard]] static auto colored_svg_icons(const QList<IconRequest>& requests)
+            -> QList<QIcon>;
+
+        /**
+         * @brief Renders a batch of colored icons on a worker thread.
+         *
+         * The SVGs are parsed and rendered into `QImage`s on the worker; the conversion to
+         * pixmaps, cache insertion and the callback run on the thread of `context`, which must be
+         * the GUI thread. If `context` is destroyed first, the callback is not called; a null
+         * `context` is rejected with a warning and nothing is rendered.
+         *
+         * @param requests The icons to render.
+         * @param context The object whose thread and lifetime the callback is bound to.
+         * @param callback Receives one icon per request, in request order.
+         */
+        static auto colored_svg_icons_async(const QList<IconRequest>& requests, QObject* context,
+                                            IconsReadyCallback callback) -> void;
+
+        /**
+         * @brief Returns the hit and miss counters of the icon caches.
+         * @return The counters since the last reset.
+         */
+        [[nodiscard]] static auto get_icon_cache_stats() -> IconCacheStats;
+
+        /**
+         * @brief Resets the hit and miss counters of the icon caches.
+         */
+        static auto reset_icon_cache_stats() -> void;
+
+        /**
+         * @brief Removes all cached icons and parsed SVGs (e.g. after SVG files changed).
+         *
+         * Cached pixmaps are invalidated at once and freed by `QPixmapCache` as it evicts them.
+         */
+        static auto clear_icon_cache() -> void;
 };
 
 }  // namespace QtWidgetsCommonLib
@@ -6,6 +6,7 @@
 
 namespace QtWidgetsCommonLib
 {
+class BatchedMainWindowStatePersistence;
 class IUiPreferences;
 class StylesheetLoader;
 class Translator;
@@ -15,6 +16,13 @@ class Translator;
  * @brief Base class for main windows in the application.
  *
  * This class provides basic functionality for managing application settings and stylesheets.
+ *
+ * Startup: the constructor starts loading the stylesheet (see `set_stylesheet_path()`) and the
+ * translation from the preferences' theme and language on worker threads. Both are applied when
+ * the window is polished, before its first paint, so the initial show does not polish twice.
+ *
+ * Window geometry and state are written through a `BatchedMainWindowStatePersistence`, which
+ * groups them into one write, skips unchanged values and snapshots the state every 30 seconds.
  */
 class QTWIDGETSCOMMONLIB_API AppMainWindow: public QMainWindow
 {
@@ -59,9 +67,53 @@ class QTWIDGETSCOMMONLIB_API AppMainWindow: public QMainWindow
          */
         [[nodiscard]] auto get_translator() const -> Translator*;
 
+        /**
+         * @brief Gets the batching window state persistence.
+         *
+         * Use it to change the flush delay or the snapshot interval.
+         *
+         * @return Pointer to the persistence, or nullptr without preferences.
+         */
+        [[nodiscard]] auto get_window_state_persistence() const
+            -> BatchedMainWindowStatePersistence*;
+
+        /**
+         * @brief Sets the stylesheet file loaded with the preferences' theme.
+         *
+         * Before the window is first polished, this restarts the startup load with the new file;
+         * afterwards the file is loaded right away.
+         *
+         * @param file_path The path of the QSS file (default ":/Resources/style.qss").
+         */
+        auto set_stylesheet_path(const QString& file_path) -> void;
+
+        /**
+         * @brief Returns the stylesheet file loaded with the preferences' theme.
+         * @return The path of the QSS file.
+         */
+        [[nodiscard]] auto get_stylesheet_path() const -> QString;
+
+        /**
+         * @brief Enables or disables the on-disk cache of resolved stylesheets (default: off).
+         *
+         * Before the window is first polished, this restarts the startup load so it already uses
+         * the cache.
+         *
+         * @param enabled True to enable, false to disable.
+         * @param directory The cache directory, or empty for `QStandardPaths::CacheLocation`.
+         */
+        auto set_stylesheet_disk_cache_enabled(bool enabled,
+                                               const QString& directory = QString()) -> void;
+
+        /**
+         * @brief Returns whether the on-disk cache of resolved stylesheets is enabled.
+         * @return true if stylesheet loads consult and fill the disk cache, false otherwise.
+         */
+        [[nodiscard]] auto is_stylesheet_disk_cache_enabled() const -> bool;
+
     protected:
         /**
-         * @brief Saves the main window geometry, state, and window state to preferences.
+         * @brief Stores the main window geometry, state, and window state for the next flush.
          */
         auto save_window_settings() -> void;
 
@@ -71,10 +123,17 @@ class QTWIDGETSCOMMONLIB_API AppMainWindow: public QMainWindow
         auto restore_window_settings() -> void;
 
         /**
-         * @brief Handles the show event to apply the current theme.
+         * @brief Finishes the startup loads when the window is polished, before its first paint.
+         * @param event The event.
+         * @return true if the event was recognized; false otherwise.
+         */
+        bool event(QEvent* event) override;
+
+        /**
+         * @brief Handles the show event to restore the window settings.
          *
-         * This method is called when the main window is shown. It applies the current theme if it
-         * has not been applied yet.
+         * This method is called when the main window is shown. It restores the saved geometry and
+         * state once.
          *
          * @param event The show event.
          */
@@ -118,22 +177,50 @@ class QTWIDGETSCOMMONLIB_API AppMainWindow: public QMainWindow
          */
         void onLanguageNameChanged(const QString& language_name);
 
+    private:
+        /**
+         * @brief Starts loading the stylesheet with the preferences' theme on a worker thread.
+         */
+        auto start_stylesheet_load() -> void;
+
+        /**
+         * @brief Applies the startup stylesheet and translation loads before the first polish.
+         *
+         * Waits on the worker threads without running an event loop.
+         */
+        auto finish_startup() -> void;
+
     private:
         /**
          * @brief Pointer to the Settings object used for managing application settings.
          */
         IUiPreferences* m_ui_preferences;
 
+        /**
+         * @brief Batching decorator around the window state part of the preferences.
+         */
+        BatchedMainWindowStatePersistence* m_window_state_persistence = nullptr;
+
         /**
          * @brief Pointer to the StylesheetLoader object used for managing application stylesheets.
          */
         StylesheetLoader* m_stylesheet_loader;
 
         /**
-         * @brief Indicates whether the theme has been applied.
+         * @brief Stylesheet file loaded with the preferences' theme.
+         */
+        QString m_stylesheet_path;
+
+        /**
+         * @brief Indicates whether the startup stylesheet load has finished.
          */
         bool m_theme_applied = false;
 
+        /**
+         * @brief Indicates whether the startup loads were applied (or given up on).
+         */
+        bool m_startup_finished = false;
+
         /**
          * @brief Indicates whether the window settings have been restored.
          */
@@ -145,7 +232,7 @@ class QTWIDGETSCOMMONLIB_API AppMainWindow: public QMainWindow
         Translator* m_translator = nullptr;
 
         /**
-         * @brief Indicates whether the language has been applied.
+         * @brief Indicates whether the startup translation load has finished.
          */
         bool m_language_applied = false;
 };
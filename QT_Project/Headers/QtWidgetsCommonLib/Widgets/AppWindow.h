@@ -19,10 +19,13 @@
 
 #include <QCloseEvent>
 #include <QIcon>
+#include <QKeySequence>
 #include <QPointer>
 #include <QWidget>
 
 #include "QtWidgetsCommonLib/ApiMacro.h"
+#include "QtWidgetsCommonLib/Utils/DwmAttributeState.h"
+#include "QtWidgetsCommonLib/Utils/HitTestRegionMap.h"
 #include "QtWidgetsCommonLib/Widgets/WindowTitleBar.h"
 
 #ifdef Q_OS_WIN
@@ -30,10 +33,14 @@
 #endif
 
 class QMenu;
+class QShortcut;
+class QTimer;
 
 namespace QtWidgetsCommonLib
 {
 
+class PerformanceOverlay;
+
 class QTWIDGETSCOMMONLIB_API AppWindow: public QWidget
 {
         Q_OBJECT
@@ -41,6 +48,17 @@ class QTWIDGETSCOMMONLIB_API AppWindow: public QWidget
         Q_DISABLE_COPY_MOVE(AppWindow)
 
     public:
+        /**
+         * @struct LiveResizeStats
+         * @brief Content frames of throttled live resizes (see set_live_resize_throttling()).
+         */
+        struct LiveResizeStats {
+                /** @brief Content relayouts applied during live resizes, including the last. */
+                int frames_rendered = 0;
+                /** @brief WM_SIZE steps coalesced into a later frame instead of laid out. */
+                int frames_dropped = 0;
+        };
+
         /**
          * @brief Constructs an AppWindow.
          *
@@ -86,7 +104,9 @@ class QTWIDGETSCOMMONLIB_API AppWindow: public QWidget
          * @brief Set the application / window icon.
          *
          * On Windows this will set both the Qt window icon and the native HWND icons
-         * (small and big) so the taskbar shows the correct icon immediately.
+         * (small and big) so the taskbar shows the correct icon immediately. The native handles
+         * are shared with other windows through `NativeIconCache` and rebuilt only when the
+         * window DPI changes.
          *
          * @param icon QIcon to use for the window.
          */
@@ -135,6 +155,70 @@ class QTWIDGETSCOMMONLIB_API AppWindow: public QWidget
          */
         [[nodiscard]] auto get_use_rounded_corners() const noexcept -> bool;
 
+        /**
+         * @brief Enable/disable throttled content relayout while the user resizes the window.
+         *
+         * When enabled, the central widget is detached from the window layout between
+         * WM_ENTERSIZEMOVE and WM_EXITSIZEMOVE and resized at most once per display refresh,
+         * while the title bar keeps following every size step. Leaving the size/move loop lays
+         * out the content once more at the final size. Does nothing on non-Windows platforms.
+         *
+         * @param enabled True to throttle content relayout during live resize.
+         */
+        auto set_live_resize_throttling(bool enabled) -> void;
+
+        /**
+         * @brief Query whether live resize throttling is enabled.
+         *
+         * @return bool True if throttling is enabled, false otherwise.
+         */
+        [[nodiscard]] auto get_live_resize_throttling() const noexcept -> bool;
+
+        /**
+         * @brief Returns the rendered and dropped content frames of throttled live resizes.
+         *
+         * @return LiveResizeStats Counters accumulated since construction or the last reset.
+         */
+        [[nodiscard]] auto get_live_resize_stats() const noexcept -> LiveResizeStats;
+
+        /**
+         * @brief Reset the live resize frame counters to zero.
+         */
+        auto reset_live_resize_stats() -> void;
+
+        /**
+         * @brief Show or hide the performance overlay in the bottom-right corner.
+         *
+         * The overlay shows the frame time, the repaint rate, native message rates by type and
+         * the time spent in stylesheet application and layouts, taken from the library's trace
+         * counters (see `PerformanceOverlay`). It is only created while enabled.
+         *
+         * @param enabled True to show the overlay, false to delete it.
+         */
+        auto set_performance_overlay_enabled(bool enabled) -> void;
+
+        /**
+         * @brief Query whether the performance overlay is shown.
+         *
+         * @return bool True if the overlay is enabled, false otherwise.
+         */
+        [[nodiscard]] auto get_performance_overlay_enabled() const noexcept -> bool;
+
+        /**
+         * @brief Set a window shortcut that toggles the performance overlay.
+         *
+         * @param shortcut The key sequence, or an empty sequence to remove the shortcut
+         *                 (default).
+         */
+        auto set_performance_overlay_shortcut(const QKeySequence& shortcut) -> void;
+
+        /**
+         * @brief Returns the shortcut that toggles the performance overlay.
+         *
+         * @return QKeySequence The key sequence, empty if none is set.
+         */
+        [[nodiscard]] auto get_performance_overlay_shortcut() const -> QKeySequence;
+
         /**
          * @brief Returns the WindowTitleBar instance.
          *
@@ -198,6 +282,30 @@ class QTWIDGETSCOMMONLIB_API AppWindow: public QWidget
          */
         auto closeEvent(QCloseEvent* event) -> void override;
 
+        /**
+         * @brief Trace the window's repaint passes.
+         *
+         * An update request repaints and flushes all dirty widgets of the window, so its
+         * duration is the frame time shown by the performance overlay.
+         *
+         * @param event The event.
+         * @return bool The result of QWidget::event().
+         */
+        auto event(QEvent* event) -> bool override;
+
+#ifdef Q_OS_WIN
+        /**
+         * @brief Marks the hit-test regions as outdated when title bar widgets move or change.
+         *
+         * Installed on the title bar, its window buttons, the menubar and the custom widget.
+         *
+         * @param watched The watched widget.
+         * @param event The event being filtered.
+         * @return The result of QWidget::eventFilter(); events are never consumed.
+         */
+        auto eventFilter(QObject* watched, QEvent* event) -> bool override;
+#endif
+
     private:  // private methods (cross-platform)
         /**
          * @brief Adopt the central widget's QMenuBar into the title bar according to current flags.
@@ -222,7 +330,8 @@ class QTWIDGETSCOMMONLIB_API AppWindow: public QWidget
         /**
          * @brief Returns the system resize border thickness in pixels (DPI-aware).
          *
-         * Uses SM_CXSIZEFRAME + SM_CXPADDEDBORDER scaled for the window's DPI.
+         * SM_CXSIZEFRAME + SM_CXPADDEDBORDER scaled for the window's DPI, taken from the cached
+         * non-client metrics.
          *
          * @return int Total border width in pixels for the current DPI.
          */
@@ -231,16 +340,34 @@ class QTWIDGETSCOMMONLIB_API AppWindow: public QWidget
         /**
          * @brief Returns the system caption (titlebar) height in pixels (DPI-aware).
          *
-         * Uses SM_CYCAPTION scaled for the window's DPI.
+         * SM_CYCAPTION scaled for the window's DPI, taken from the cached non-client metrics.
          *
          * @return int Caption height in pixels for the current DPI.
          */
         [[nodiscard]] auto system_caption_height() const noexcept -> int;
 
+        /**
+         * @brief Re-read the window DPI and the DPI-scaled system metrics.
+         *
+         * Called once the native window exists and again on WM_DPICHANGED, WM_SETTINGCHANGE and
+         * when the window moves to another screen. Also marks the hit-test regions as outdated.
+         */
+        auto refresh_non_client_metrics() -> void;
+
+        /**
+         * @brief Set the native small and big icons from `m_app_icon` for the window DPI.
+         *
+         * The handles come from the shared `NativeIconCache`, so windows showing the same icon at
+         * the same DPI share them. Called by set_app_icon() and on WM_DPICHANGED when the DPI
+         * differs from the one the icons were made for.
+         */
+        auto update_native_icons() -> void;
+
         /**
          * @brief Perform custom hit-testing for frameless window.
          *
-         * Returns HT* values for caption dragging, client controls and resize edges.
+         * Returns HT* values for caption dragging, client controls and resize edges. The point is
+         * looked up in the cached hit-test regions, which are rebuilt first when outdated.
          *
          * Notes:
          *  - To allow resizing near the edges while using a custom title bar, points that fall
@@ -294,19 +421,77 @@ class QTWIDGETSCOMMONLIB_API AppWindow: public QWidget
          * Applies rounded corners and optional Mica backdrop, gated by runtime availability and
          * the user preferences set via set_use_mica() and set_use_rounded_corners().
          * Also attempts to enable immersive dark mode for borders/caption where supported.
+         *
+         * @param changes The attributes to apply; all others are left untouched.
+         */
+        auto enable_win11_features(const DwmAttributeState::Changes& changes) -> void;
+
+        /**
+         * @brief Apply the DWM attributes that differ from the last applied snapshot.
+         *
+         * Cancels a scheduled update; does nothing if no attribute changed.
+         */
+        auto apply_dwm_attributes() -> void;
+
+        /**
+         * @brief Apply the DWM attributes at the end of the current event loop turn.
+         *
+         * Several preference setters running in the same turn result in a single update.
+         */
+        auto schedule_dwm_update() -> void;
+
+        /**
+         * @brief Rebuild the cached hit-test regions from the current window and widget geometry.
+         *
+         * Collects the resize border (none while maximized), the title bar rectangle and the
+         * interactive rectangles inside it (window buttons, menubar actions, custom widget) in
+         * native pixels relative to the window, and starts watching these widgets for changes.
          */
-        auto enable_win11_features() -> void;
+        auto rebuild_hit_test_regions() -> void;
 
         /**
-         * @brief Map a global (screen) point to local coordinates relative to titlebar.
+         * @brief Detach the central widget from the layout and start the frame timer.
          *
-         * @param global_x Global X coordinate in screen space.
-         * @param global_y Global Y coordinate in screen space.
-         * @return QPoint Local coordinates relative to the title bar (or sentinel negative point).
+         * Called on the first WM_SIZE of a size/move loop, so plain moves are not affected.
+         */
+        auto begin_live_resize() -> void;
+
+        /**
+         * @brief Apply the pending size steps to the central widget as one frame.
+         */
+        auto apply_live_resize_frame() -> void;
+
+        /**
+         * @brief Stop the frame timer and return the central widget to the layout.
          */
-        [[nodiscard]] auto map_global_to_titlebar_local(int global_x, int global_y) const -> QPoint;
+        auto end_live_resize() -> void;
+
+        /**
+         * @brief Map a rectangle of a descendant widget to native window pixels.
+         *
+         * @param widget The widget the rectangle is relative to (this window or a descendant).
+         * @param rect The rectangle in the widget's logical coordinates.
+         * @return QRect The rectangle relative to the window's top-left corner, in native pixels.
+         */
+        [[nodiscard]] auto to_native_window_rect(const QWidget* widget,
+                                                 const QRect& rect) const -> QRect;
 #endif  // Q_OS_WIN
 
+#ifdef Q_OS_WIN
+        /**
+         * @struct NonClientMetrics
+         * @brief DPI-dependent values shared by all non-client message handlers.
+         */
+        struct NonClientMetrics {
+                /** @brief The window DPI (96 when GetDpiForWindow is unavailable). */
+                UINT dpi = 96u;
+                /** @brief SM_CXSIZEFRAME + SM_CXPADDEDBORDER for the DPI. */
+                int resize_border_width = 0;
+                /** @brief SM_CYCAPTION for the DPI. */
+                int caption_height = 0;
+        };
+#endif
+
     private:  // private members (all platforms)
         /**
          * @brief Pointer to the custom title bar widget.
@@ -342,20 +527,106 @@ class QTWIDGETSCOMMONLIB_API AppWindow: public QWidget
          */
         WindowTitleBar::RowPosition m_menubar_row = WindowTitleBar::RowPosition::Top;
 
+        /**
+         * @brief User preference: throttle content relayout during live resize (Windows only).
+         */
+        bool m_live_resize_throttling = false;
+
+        /**
+         * @brief Frame counters of throttled live resizes.
+         */
+        LiveResizeStats m_live_resize_stats;
+
+        /**
+         * @brief The performance overlay while enabled; see set_performance_overlay_enabled().
+         */
+        QPointer<PerformanceOverlay> m_performance_overlay;
+
+        /**
+         * @brief Shortcut toggling the performance overlay (nullptr if none is set).
+         */
+        QShortcut* m_performance_overlay_shortcut = nullptr;
+
 #ifdef Q_OS_WIN
         /**
          * @brief Native small icon handle (ICON_SMALL).
          *
-         * Created when set_app_icon is called. Destroyed in the destructor.
+         * A reference into `NativeIconCache::shared()`, released when replaced and in the
+         * destructor.
          */
         HICON m_hicon_small = nullptr;
 
         /**
          * @brief Native big icon handle (ICON_BIG).
          *
-         * Created when set_app_icon is called. Destroyed in the destructor.
+         * A reference into `NativeIconCache::shared()`, released when replaced and in the
+         * destructor.
          */
         HICON m_hicon_big = nullptr;
+
+        /**
+         * @brief The icon passed to set_app_icon(), kept to rebuild the handles on DPI change.
+         */
+        QIcon m_app_icon;
+
+        /**
+         * @brief The DPI the native icon handles were made for (0 before set_app_icon()).
+         */
+        UINT m_icon_dpi = 0u;
+
+        /**
+         * @brief Cached DPI-dependent metrics; see refresh_non_client_metrics().
+         */
+        NonClientMetrics m_non_client_metrics;
+
+        /**
+         * @brief Desired and last applied DWM attributes; see apply_dwm_attributes().
+         */
+        DwmAttributeState m_dwm_state;
+
+        /**
+         * @brief Zero-interval single-shot timer batching DWM updates; see schedule_dwm_update().
+         */
+        QTimer* m_dwm_update_timer = nullptr;
+
+        /**
+         * @brief Cached hit-test regions, rebuilt on resize, layout or DPI change.
+         */
+        HitTestRegionMap m_hit_test_regions;
+
+        /**
+         * @brief Screen position of the window's top-left corner in native pixels.
+         *
+         * Updated on WM_MOVE so moving the window does not invalidate the hit-test regions.
+         */
+        QPoint m_window_origin;
+
+        /**
+         * @brief Fires once per display refresh while a throttled live resize is running.
+         */
+        QTimer* m_live_resize_timer = nullptr;
+
+        /**
+         * @brief Whether the window is inside a WM_ENTERSIZEMOVE / WM_EXITSIZEMOVE loop.
+         */
+        bool m_in_size_move = false;
+
+        /**
+         * @brief Whether the central widget is currently detached for a throttled live resize.
+         */
+        bool m_in_live_resize = false;
+
+        /**
+         * @brief WM_SIZE steps received since the last applied live resize frame.
+         */
+        int m_pending_resize_steps = 0;
+
+        /**
+         * @brief minimumSize() before the central widget was detached for a live resize.
+         *
+         * Kept as minimum track size, since the layout minimum shrinks while it is detached.
+         */
+        QSize m_live_resize_minimum_size;
 #endif
 };
 
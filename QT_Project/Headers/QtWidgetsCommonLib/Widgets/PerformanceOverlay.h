@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QStringList>
+#include <QWidget>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+#include "QtWidgetsCommonLib/Utils/TraceRateSampler.h"
+
+class QTimer;
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @class PerformanceOverlay
+ * @brief Debug overlay showing the per-second activity of the library's traced scopes.
+ *
+ * The overlay is a mouse-transparent child pinned to the bottom-right corner of its parent. Once
+ * per update interval it samples `Tracer::get_counters()` through a `TraceRateSampler` and shows
+ * the frame time and repaint rate of the window, followed by every traced scope that ran in the
+ * interval, grouped by category: native messages by type, stylesheet application, layouts,
+ * translations and icons. It adds no counters of its own, so the numbers cost nothing unless
+ * tracing is compiled in (`QTWIDGETSCOMMONLIB_ENABLE_TRACING`); without it the overlay says so
+ * and only shows scopes the application records itself.
+ *
+ * Repainting the overlay itself adds one frame per update interval.
+ */
+class QTWIDGETSCOMMONLIB_API PerformanceOverlay: public QWidget
+{
+        Q_OBJECT
+
+    public:
+        /**
+         * @brief Constructs the overlay and takes the first (baseline) sample.
+         * @param parent The widget to overlay; the overlay follows its size.
+         */
+        explicit PerformanceOverlay(QWidget* parent);
+
+        /**
+         * @brief Sets how often the counters are sampled and the overlay repainted.
+         * @param msecs The update interval in milliseconds (default: 1000).
+         */
+        auto set_update_interval(int msecs) -> void;
+
+        /**
+         * @brief Returns the update interval in milliseconds.
+         */
+        [[nodiscard]] auto get_update_interval() const -> int;
+
+        /**
+         * @brief Returns the text lines currently shown.
+         */
+        [[nodiscard]] auto get_lines() const -> QStringList;
+
+        /**
+         * @brief Samples the trace counters now and updates the shown lines.
+         */
+        auto update_sample() -> void;
+
+    protected:
+        /**
+         * @brief Paints the lines on a translucent background.
+         * @param event The paint event.
+         */
+        auto paintEvent(QPaintEvent* event) -> void override;
+
+        /**
+         * @brief Keeps the overlay in the bottom-right corner when the parent is resized.
+         * @param watched The watched object (the parent).
+         * @param event The event being filtered.
+         * @return The result of QWidget::eventFilter(); events are never consumed.
+         */
+        auto eventFilter(QObject* watched, QEvent* event) -> bool override;
+
+    private:
+        /**
+         * @brief Resizes the overlay to its lines and moves it to the parent's corner.
+         */
+        auto update_geometry() -> void;
+
+    private:
+        TraceRateSampler m_sampler;
+        QTimer* m_update_timer = nullptr;
+        QStringList m_lines;
+};
+
+}  // namespace QtWidgetsCommonLib
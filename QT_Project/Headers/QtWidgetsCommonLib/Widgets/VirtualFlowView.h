@@ -0,0 +1,299 @@
+#pragma once
+
+#include <QAbstractScrollArea>
+#include <QHash>
+#include <QList>
+#include <QRect>
+#include <QSize>
+#include <functional>
+
+#include "QtWidgetsCommonLib/ApiMacro.h"
+#include "QtWidgetsCommonLib/Layouts/FlowLayout.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @class VirtualFlowView
+ * @brief Scrollable flow of a large number of items that only keeps widgets for visible items.
+ *
+ * Items are identified by index and described by their size only; rows are broken and aligned
+ * with `FlowLayout::compute_geometry()`, so the result matches a `FlowLayout` with the same
+ * sizes, spacing and `FlowLayout::RowAlignment`.
+ *
+ * Widgets are created on demand by a factory and filled by a binder for the items intersecting
+ * the viewport plus an overscan margin. Widgets of items that scroll out of that range are
+ * hidden and kept in a pool, then re-bound to items scrolling in. The number of live widgets
+ * therefore depends on the viewport size, not on the item count; a resize only repositions those
+ * widgets.
+ *
+ * Without a size provider all items share one size, so the rows follow from the width in closed
+ * form: nothing per item is stored and a width change costs the same for any item count. With a
+ * size provider the row breaking re-runs (widget-free) over the cached item sizes.
+ */
+class QTWIDGETSCOMMONLIB_API VirtualFlowView: public QAbstractScrollArea
+{
+        Q_OBJECT
+
+    public:
+        /**
+         * @brief Creates a new item widget; the view takes ownership.
+         */
+        using WidgetFactory = std::function<QWidget*(QWidget* parent)>;
+
+        /**
+         * @brief Fills a (new or recycled) widget with the data of an item.
+         */
+        using WidgetBinder = std::function<void(QWidget* widget, int index)>;
+
+        /**
+         * @brief Returns the size of an item.
+         */
+        using SizeProvider = std::function<QSize(int index)>;
+
+        /**
+         * @brief Constructs an empty VirtualFlowView.
+         * @param parent The parent widget, or nullptr.
+         */
+        explicit VirtualFlowView(QWidget* parent = nullptr);
+
+        /**
+         * @brief Sets the factory used to create item widgets.
+         * @param factory The widget factory.
+         */
+        auto set_widget_factory(WidgetFactory factory) -> void;
+
+        /**
+         * @brief Sets the binder that fills a widget with the data of an item.
+         * @param binder The widget binder.
+         */
+        auto set_widget_binder(WidgetBinder binder) -> void;
+
+        /**
+         * @brief Sets a per-item size provider; overrides the uniform item size.
+         *
+         * Each size is queried once and cached until `invalidate_item_sizes()` or
+         * `set_item_count()` is called.
+         *
+         * @param provider The size provider, or an empty function to use the uniform size.
+         */
+        auto set_size_provider(SizeProvider provider) -> void;
+
+        /**
+         * @brief Sets the size used for all items when no size provider is set.
+         * @param size The uniform item size.
+         */
+        auto set_item_size(const QSize& size) -> void;
+
+        /**
+         * @brief Returns the uniform item size.
+         * @return The size used when no size provider is set.
+         */
+        [[nodiscard]] auto get_item_size() const -> QSize;
+
+        /**
+         * @brief Sets the number of items; all visible widgets are re-bound.
+         * @param count The number of items.
+         */
+        auto set_item_count(int count) -> void;
+
+        /**
+         * @brief Returns the number of items.
+         * @return The item count.
+         */
+        [[nodiscard]] auto get_item_count() const -> int;
+
+        /**
+         * @brief Sets the row alignment.
+         * @param alignment The desired row alignment.
+         */
+        auto set_row_alignment(FlowLayout::RowAlignment alignment) -> void;
+
+        /**
+         * @brief Returns the row alignment.
+         * @return The current row alignment.
+         */
+        [[nodiscard]] auto get_row_alignment() const -> FlowLayout::RowAlignment;
+
+        /**
+         * @brief Sets the spacing between items and rows.
+         * @param horizontal The horizontal spacing between items.
+         * @param vertical The vertical spacing between rows.
+         */
+        auto set_spacing(int horizontal, int vertical) -> void;
+
+        /**
+         * @brief Returns the horizontal spacing between items.
+         * @return The horizontal spacing.
+         */
+        [[nodiscard]] auto get_horizontal_spacing() const -> int;
+
+        /**
+         * @brief Returns the vertical spacing between rows.
+         * @return The vertical spacing.
+         */
+        [[nodiscard]] auto get_vertical_spacing() const -> int;
+
+        /**
+         * @brief Sets how far beyond the viewport (in pixels) widgets are kept materialized.
+         * @param pixels The margin above and below the viewport.
+         */
+        auto set_overscan(int pixels) -> void;
+
+        /**
+         * @brief Returns the overscan margin.
+         * @return The margin above and below the viewport in pixels.
+         */
+        [[nodiscard]] auto get_overscan() const -> int;
+
+        /**
+         * @brief Re-queries all item sizes from the size provider and lays out again.
+         */
+        auto invalidate_item_sizes() -> void;
+
+        /**
+         * @brief Re-binds all materialized widgets (e.g. after the item data changed).
+         */
+        auto refresh_items() -> void;
+
+        /**
+         * @brief Returns the rectangle of an item in content coordinates.
+         * @param index The item index.
+         * @return The item rectangle, or an invalid rectangle for an invalid index.
+         */
+        [[nodiscard]] auto get_item_rect(int index) -> QRect;
+
+        /**
+         * @brief Returns the widget currently showing an item.
+         * @param index The item index.
+         * @return The widget, or nullptr if the item is not materialized.
+         */
+        [[nodiscard]] auto get_widget(int index) const -> QWidget*;
+
+        /**
+         * @brief Returns the number of widgets currently bound to items.
+         * @return The number of materialized widgets.
+         */
+        [[nodiscard]] auto get_materialized_count() const -> int;
+
+        /**
+         * @brief Returns the number of hidden widgets waiting to be recycled.
+         * @return The pool size.
+         */
+        [[nodiscard]] auto get_pooled_count() const -> int;
+
+        /**
+         * @brief Scrolls so that an item is fully visible.
+         * @param index The item index.
+         */
+        auto scroll_to_index(int index) -> void;
+
+    protected:
+        /**
+         * @brief Re-flows the items for the new viewport size.
+         * @param event The resize event.
+         */
+        void resizeEvent(QResizeEvent* event) override;
+
+        /**
+         * @brief Repositions and recycles widgets after scrolling.
+         * @param dx The horizontal scroll delta.
+         * @param dy The vertical scroll delta.
+         */
+        void scrollContentsBy(int dx, int dy) override;
+
+    private:
+        /**
+         * @brief Marks the flow geometry as outdated and updates the widgets.
+         */
+        auto invalidate_geometry() -> void;
+
+        /**
+         * @brief Recomputes the flow geometry if it is outdated or the viewport width changed.
+         */
+        auto ensure_geometry() -> void;
+
+        /**
+         * @brief Computes the rows of uniformly sized items for a width.
+         * @param width The viewport width.
+         */
+        auto update_uniform_rows(int width) -> void;
+
+        /**
+         * @brief Returns the number of rows of the current geometry.
+         * @return The row count.
+         */
+        [[nodiscard]] auto get_row_count() const -> int;
+
+        /**
+         * @brief Returns the index of the first item of a row.
+         * @param row The row, in [0, get_row_count()].
+         * @return The first item index; the item count for the row past the last one.
+         */
+        [[nodiscard]] auto get_row_start(int row) const -> int;
+
+        /**
+         * @brief Returns the top edge of a row in content coordinates.
+         * @param row The row.
+         * @return The top edge.
+         */
+        [[nodiscard]] auto get_row_top(int row) const -> int;
+
+        /**
+         * @brief Returns the rectangle of an item of the current geometry.
+         * @param index The item index (valid).
+         * @return The item rectangle in content coordinates.
+         */
+        [[nodiscard]] auto compute_item_rect(int index) const -> QRect;
+
+        /**
+         * @brief Materializes, recycles and positions widgets for the visible range.
+         */
+        auto update_visible_widgets() -> void;
+
+        /**
+         * @brief Hides all materialized widgets and moves them to the pool.
+         */
+        auto recycle_all_widgets() -> void;
+
+        /**
+         * @brief Returns a widget from the pool or creates a new one.
+         * @return The widget, or nullptr if no factory is set.
+         */
+        auto acquire_widget() -> QWidget*;
+
+    private:
+        /**
+         * @struct UniformRows
+         * @brief Row breaking of uniformly sized items, equal to `FlowLayout::compute_geometry()`.
+         */
+        struct UniformRows {
+                int items_per_row = 1;
+                int row_count = 0;
+                int row_offset = 0;       ///< Alignment offset of all rows but the last
+                int last_row_offset = 0;  ///< Alignment offset of the last row
+        };
+
+        WidgetFactory m_widget_factory;
+        WidgetBinder m_widget_binder;
+        SizeProvider m_size_provider;
+        QSize m_item_size = QSize(80, 24);
+        int m_item_count = 0;
+        FlowLayout::RowAlignment m_row_alignment = FlowLayout::RowAlignment::Left;
+        int m_h_spacing = 6;
+        int m_v_spacing = 6;
+        int m_overscan = 200;
+
+        QList<QSize> m_item_sizes;  ///< Only filled with a size provider
+        bool m_item_sizes_dirty = true;
+        FlowLayout::LayoutResult m_geometry;  ///< Rects and rows only filled with a size provider
+        UniformRows m_uniform_rows;
+        int m_geometry_width = -1;
+        bool m_geometry_dirty = true;
+        bool m_updating = false;
+
+        QHash<int, QWidget*> m_active_widgets;
+        QList<QWidget*> m_widget_pool;
+};
+
+}  // namespace QtWidgetsCommonLib
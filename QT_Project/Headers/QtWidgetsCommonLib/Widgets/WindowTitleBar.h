@@ -103,6 +103,16 @@ class QTWIDGETSCOMMONLIB_API WindowTitleBar: public QWidget
          */
         auto set_custom_widget_row(RowPosition row) -> void;
 
+        /**
+         * @brief Applies pending menubar/custom widget placement changes immediately.
+         *
+         * `set_menubar()`, `set_menubar_row()`, `set_custom_widget()` and
+         * `set_custom_widget_row()` only schedule a layout update, so several calls in the same
+         * event loop turn are applied together. Call this when the final placement is needed
+         * before control returns to the event loop.
+         */
+        auto apply_pending_layout() -> void;
+
         /**
          * @brief Returns the embedded menubar if set.
          * @return QMenuBar* Pointer to the menubar or nullptr.
@@ -203,6 +213,19 @@ class QTWIDGETSCOMMONLIB_API WindowTitleBar: public QWidget
          */
         auto rebuild_layout() -> void;
 
+        /**
+         * @brief Schedules one layout update for the next event loop turn.
+         */
+        auto schedule_layout_update() -> void;
+
+        /**
+         * @brief Moves a widget to an index of a row unless it is already there.
+         * @param widget The menubar or custom widget.
+         * @param row The target row layout.
+         * @param index The target index within the row.
+         */
+        auto place_widget(QWidget* widget, QHBoxLayout* row, int index) -> void;
+
         /**
          * @brief Apply the current icon size to all window buttons.
          */
@@ -263,6 +286,7 @@ class QTWIDGETSCOMMONLIB_API WindowTitleBar: public QWidget
 
         RowPosition m_menubar_row = RowPosition::Top;
         RowPosition m_custom_row = RowPosition::Top;
+        bool m_layout_update_pending = false;
 
         QColor m_window_button_color = QColor("#000000");
         int m_window_button_icon_px = 18;  ///< Default icon size in pixels
@@ -8,10 +8,158 @@
 
 #include "QtWidgetsCommonLib/Layouts/FlowLayout.h"
 
+#include <QCoreApplication>
+#include <QEasingCurve>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QLayoutItem>
+#include <QPointer>
 #include <QStyle>
+#include <QTimer>
 #include <QWidget>
+#include <QtAlgorithms>
 #include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "QtWidgetsCommonLib/Utils/Trace.h"
+
+namespace
+{
+
+/**
+ * @brief Maximum number of widths whose layout results are kept at the same time.
+ *
+ * A resize drag produces a new width per frame; the bound keeps the cache small while still
+ * covering the alternating widths queried for `sizeHint()`, `heightForWidth()` and `setGeometry()`.
+ */
+constexpr int kMaxCachedWidths = 8;
+
+/**
+ * @brief Interval of the shared animation clock (about 60 frames per second).
+ */
+constexpr int kAnimationFrameIntervalMs = 16;
+
+/**
+ * @class AnimationClock
+ * @brief Process-wide timer driving the reflow animations of all FlowLayouts.
+ *
+ * Layouts subscribe while they animate; the timer only runs while there are subscribers. Each
+ * tick passes the same clock time to every subscriber.
+ */
+class AnimationClock
+{
+    public:
+        /**
+         * @brief Frame callback; receives the clock time and returns whether to keep running.
+         */
+        using FrameCallback = std::function<bool(qint64 now_msecs)>;
+
+        /**
+         * @brief Returns the shared clock.
+         * @return The clock instance.
+         */
+        static auto instance() -> AnimationClock&
+        {
+            static AnimationClock clock;
+            return clock;
+        }
+
+        /**
+         * @brief Returns the current clock time.
+         * @return Milliseconds since the clock was created.
+         */
+        [[nodiscard]] auto get_time() const -> qint64
+        {
+            return m_elapsed.elapsed();
+        }
+
+        /**
+         * @brief Registers (or replaces) the frame callback of an owner and starts the timer.
+         * @param owner The subscribing object.
+         * @param callback The frame callback.
+         */
+        auto subscribe(const void* owner, FrameCallback callback) -> void
+        {
+            m_subscribers.insert(owner, std::move(callback));
+
+            if (m_timer.isNull() && QCoreApplication::instance() != nullptr)
+            {
+                // Parented to the application so it never outlives the event dispatcher
+                m_timer = new QTimer(QCoreApplication::instance());
+                m_timer->setTimerType(Qt::PreciseTimer);
+                m_timer->setInterval(kAnimationFrameIntervalMs);
+                QObject::connect(m_timer, &QTimer::timeout, m_timer, [this]() { tick(); });
+            }
+
+            if (!m_timer.isNull() && !m_timer->isActive())
+            {
+                m_timer->start();
+            }
+        }
+
+        /**
+         * @brief Removes the frame callback of an owner.
+         * @param owner The subscribed object.
+         */
+        auto unsubscribe(const void* owner) -> void
+        {
+            m_subscribers.remove(owner);
+
+            if (m_subscribers.isEmpty() && !m_timer.isNull())
+            {
+                m_timer->stop();
+            }
+        }
+
+    private:
+        AnimationClock()
+        {
+            m_elapsed.start();
+        }
+
+        /**
+         * @brief Advances all subscribers by one frame.
+         *
+         * Callbacks may subscribe or unsubscribe, so a snapshot of the owners is iterated and
+         * each callback is copied before it is invoked.
+         */
+        auto tick() -> void
+        {
+            const qint64 now = get_time();
+            const QList<const void*> owners = m_subscribers.keys();
+
+            for (const void* owner: owners)
+            {
+                const FrameCallback callback = m_subscribers.value(owner);
+
+                if (callback && !callback(now))
+                {
+                    unsubscribe(owner);
+                }
+            }
+        }
+
+        QElapsedTimer m_elapsed;
+        QPointer<QTimer> m_timer;
+        QHash<const void*, FrameCallback> m_subscribers;
+};
+
+/**
+ * @brief Linearly interpolates between two rectangles.
+ * @param from The start rectangle.
+ * @param to The end rectangle.
+ * @param progress The progress from 0.0 (from) to 1.0 (to).
+ * @return The interpolated rectangle.
+ */
+auto interpolate_rect(const QRect& from, const QRect& to, qreal progress) -> QRect
+{
+    const auto lerp = [progress](int a, int b) { return a + qRound((b - a) * progress); };
+    return QRect(lerp(from.x(), to.x()), lerp(from.y(), to.y()), lerp(from.width(), to.width()),
+                 lerp(from.height(), to.height()));
+}
+
+}  // namespace
 
 namespace QtWidgetsCommonLib
 {
@@ -36,10 +184,8 @@ FlowLayout::FlowLayout(QWidget* parent, int margin, int h_spacing, int v_spacing
  */
 FlowLayout::~FlowLayout()
 {
-    while (!m_item_list.isEmpty())
-    {
-        delete m_item_list.takeFirst();
-    }
+    AnimationClock::instance().unsubscribe(this);
+    qDeleteAll(m_item_list);
 }
 
 /**
@@ -49,6 +195,176 @@ FlowLayout::~FlowLayout()
 void FlowLayout::addItem(QLayoutItem* item)
 {
     m_item_list.append(item);
+
+    if (const QWidget* widget = item->widget(); widget != nullptr)
+    {
+        m_widget_indices.insert(widget, m_item_list.size() - 1);
+    }
+
+    invalidate();
+}
+
+/**
+ * @brief Adds several items, invalidating the layout once after the last one.
+ * @param items The layout items to add; the layout takes ownership.
+ */
+auto FlowLayout::add_items(const QList<QLayoutItem*>& items) -> void
+{
+    ++m_batch_depth;
+
+    for (QLayoutItem* item: items)
+    {
+        addItem(item);
+    }
+
+    --m_batch_depth;
+    invalidate();
+}
+
+/**
+ * @brief Adds several widgets, invalidating the layout once after the last one.
+ * @param widgets The widgets to add.
+ */
+auto FlowLayout::add_widgets(const QList<QWidget*>& widgets) -> void
+{
+    ++m_batch_depth;
+
+    for (QWidget* widget: widgets)
+    {
+        addWidget(widget);
+    }
+
+    --m_batch_depth;
+    invalidate();
+}
+
+/**
+ * @brief Removes several widgets in one pass, invalidating the layout once.
+ *
+ * The items to remove are found through the widget index map; the list is then compacted from
+ * the first removed item onward, so the items after it are moved and re-indexed only once
+ * instead of once per removed widget. Like `QLayout::removeWidget()`, the widgets themselves are
+ * not deleted.
+ *
+ * @param widgets The widgets to remove; widgets not in the layout are ignored.
+ * @return The number of removed items.
+ */
+auto FlowLayout::remove_widgets(const QList<QWidget*>& widgets) -> int
+{
+    QSet<const QLayoutItem*> removed_items;
+    int first_removed = static_cast<int>(m_item_list.size());
+
+    for (const QWidget* widget: widgets)
+    {
+        const int index = m_widget_indices.value(widget, -1);
+
+        if (index >= 0)
+        {
+            removed_items.insert(m_item_list.at(index));
+            first_removed = std::min(first_removed, index);
+        }
+    }
+
+    if (!removed_items.isEmpty())
+    {
+        // The removed items are deleted, so they must not stay in the animation
+        stop_animation();
+        int kept_count = first_removed;
+
+        for (int i = first_removed; i < m_item_list.size(); ++i)
+        {
+            QLayoutItem* item = m_item_list.at(i);
+
+            if (removed_items.contains(item))
+            {
+                m_widget_indices.remove(item->widget());
+                m_hidden_items.remove(item);
+                delete item;
+            }
+            else
+            {
+                m_item_list[kept_count] = item;
+                ++kept_count;
+            }
+        }
+
+        m_item_list.resize(kept_count);
+        update_widget_indices(first_removed);
+        invalidate();
+    }
+
+    return static_cast<int>(removed_items.size());
+}
+
+/**
+ * @brief Shows exactly the given widgets and hides all other widget items.
+ *
+ * Items without a widget (e.g. spacers) are not affected. Only widgets whose state changes are
+ * shown or hidden, and the layout is invalidated once.
+ *
+ * @param visible_widgets The widgets to show.
+ */
+auto FlowLayout::set_visible_subset(const QSet<const QWidget*>& visible_widgets) -> void
+{
+    bool changed = false;
+
+    for (int i = 0; i < m_item_list.size(); ++i)
+    {
+        const QWidget* widget = m_item_list.at(i)->widget();
+
+        if (widget != nullptr)
+        {
+            changed = set_item_hidden(i, !visible_widgets.contains(widget)) || changed;
+        }
+    }
+
+    if (changed)
+    {
+        invalidate();
+    }
+}
+
+/**
+ * @brief Hides or shows a widget without removing it from the layout.
+ *
+ * A hidden item keeps its index but takes no room in the flow; the widget itself is hidden too,
+ * so it is not left visible at its previous position.
+ *
+ * @param widget The widget; ignored if it is not in the layout.
+ * @param hidden If true, the widget is hidden and skipped by the layout.
+ */
+auto FlowLayout::set_widget_hidden(QWidget* widget, bool hidden) -> void
+{
+    const int index = indexOf(widget);
+
+    if (index >= 0 && set_item_hidden(index, hidden))
+    {
+        invalidate();
+    }
+}
+
+/**
+ * @brief Returns whether a widget is hidden by `set_widget_hidden()` or `set_visible_subset()`.
+ * @param widget The widget.
+ * @return true if the widget's item is hidden; false if it is laid out or not in the layout.
+ */
+auto FlowLayout::is_widget_hidden(const QWidget* widget) const -> bool
+{
+    const int index = indexOf(widget);
+    return index >= 0 && m_hidden_items.contains(m_item_list.at(index));
+}
+
+/**
+ * @brief Returns the index of a widget's item in constant time.
+ *
+ * Replaces the linear `QLayout::indexOf()` scan with a lookup in the widget index map.
+ *
+ * @param widget The widget.
+ * @return The index, or -1 if the widget is not in the layout.
+ */
+auto FlowLayout::indexOf(const QWidget* widget) const -> int
+{
+    return m_widget_indices.value(widget, -1);
 }
 
 /**
@@ -57,7 +373,7 @@ void FlowLayout::addItem(QLayoutItem* item)
  */
 auto FlowLayout::count() const -> int
 {
-    return m_item_list.size();
+    return static_cast<int>(m_item_list.size());
 }
 
 /**
@@ -88,7 +404,13 @@ auto FlowLayout::takeAt(int index) -> QLayoutItem*
 
     if (index >= 0 && index < m_item_list.size())
     {
+        // The caller usually deletes the item, so it must not stay in the animation
+        stop_animation();
         result = m_item_list.takeAt(index);
+        m_widget_indices.remove(result->widget());
+        m_hidden_items.remove(result);
+        update_widget_indices(index);
+        invalidate();
     }
 
     return result;
@@ -97,48 +419,85 @@ auto FlowLayout::takeAt(int index) -> QLayoutItem*
 /**
  * @brief Returns the preferred size for the layout.
  * If m_expand_to_show_all_rows is true, height is calculated to fit all rows.
+ * The result is cached until the next `invalidate()`.
  */
 auto FlowLayout::sizeHint() const -> QSize
 {
-    QSize size;
-
-    for (const QLayoutItem* item: m_item_list)
+    if (!m_has_cached_size_hint)
     {
-        size = size.expandedTo(item->sizeHint());
-    }
+        QSize size;
+        sync_item_sizes();
 
-    int left = 0, top = 0, right = 0, bottom = 0;
-    getContentsMargins(&left, &top, &right, &bottom);
+        for (const QSize& item_size: std::as_const(m_item_sizes))
+        {
+            size = size.expandedTo(item_size);
+        }
 
-    if (m_expand_to_show_all_rows)
-    {
-        // Calculate the full height needed for all rows
-        QRect dummy_rect(0, 0, size.width(), 10000);  // Large height to force all rows
-        int total_height = do_layout(dummy_rect, true);
-        size.setHeight(total_height);
+        int left = 0, top = 0, right = 0, bottom = 0;
+        getContentsMargins(&left, &top, &right, &bottom);
+
+        if (m_expand_to_show_all_rows)
+        {
+            // Calculate the full height needed for all rows
+            size.setHeight(get_layout_for_width(size.width()).height);
+        }
+
+        size += QSize(left + right, top + bottom);
+        m_cached_size_hint = size;
+        m_has_cached_size_hint = true;
     }
 
-    size += QSize(left + right, top + bottom);
-    return size;
+    return m_cached_size_hint;
 }
 
 /**
  * @brief Returns the minimum size for the layout.
+ * The result is cached until the next `invalidate()`.
  * @return The minimum size.
  */
 auto FlowLayout::minimumSize() const -> QSize
 {
-    QSize size;
-
-    for (const QLayoutItem* item: m_item_list)
+    if (!m_has_cached_minimum_size)
     {
-        size = size.expandedTo(item->minimumSize());
+        QSize size;
+
+        for (const QLayoutItem* item: m_item_list)
+        {
+            if (!m_hidden_items.contains(item))
+            {
+                size = size.expandedTo(item->minimumSize());
+            }
+        }
+
+        int left = 0, top = 0, right = 0, bottom = 0;
+        getContentsMargins(&left, &top, &right, &bottom);
+        size += QSize(left + right, top + bottom);
+        m_cached_minimum_size = size;
+        m_has_cached_minimum_size = true;
     }
 
+    return m_cached_minimum_size;
+}
+
+/**
+ * @brief Returns true: the height of a flow layout depends on its width.
+ * @return Always true.
+ */
+auto FlowLayout::hasHeightForWidth() const -> bool
+{
+    return true;
+}
+
+/**
+ * @brief Returns the height needed to show all rows at the given width.
+ * @param width The available width, including the contents margins.
+ * @return The total height, including the contents margins.
+ */
+auto FlowLayout::heightForWidth(int width) const -> int
+{
     int left = 0, top = 0, right = 0, bottom = 0;
     getContentsMargins(&left, &top, &right, &bottom);
-    size += QSize(left + right, top + bottom);
-    return size;
+    return get_layout_for_width(width).height + bottom;
 }
 
 /**
@@ -148,7 +507,88 @@ auto FlowLayout::minimumSize() const -> QSize
 void FlowLayout::setGeometry(const QRect& rect)
 {
     QLayout::setGeometry(rect);
-    do_layout(rect, false);
+    const QWidget* parent = parentWidget();
+
+    if (m_animation_enabled && parent != nullptr && parent->isVisible())
+    {
+        start_animation(rect);
+    }
+    else
+    {
+        stop_animation();
+        do_layout(rect, false);
+    }
+}
+
+/**
+ * @brief Marks the item sizes and size hints as outdated.
+ *
+ * Cached rows are kept and re-flowed from the first changed item on the next pass. Inside
+ * `add_items()` / `add_widgets()` the base invalidation (which schedules a relayout of the parent)
+ * is deferred to the end of the batch.
+ */
+void FlowLayout::invalidate()
+{
+    m_item_sizes_dirty = true;
+    m_has_cached_size_hint = false;
+    m_has_cached_minimum_size = false;
+
+    if (m_batch_depth == 0)
+    {
+        QLayout::invalidate();
+    }
+}
+
+/**
+ * @brief Updates the widget indices of the items from an index to the end of the list.
+ *
+ * Called after items were removed; only the items behind the first removed one have moved.
+ *
+ * @param first_index The first index whose item may have moved.
+ */
+auto FlowLayout::update_widget_indices(int first_index) -> void
+{
+    for (int i = first_index; i < m_item_list.size(); ++i)
+    {
+        if (const QWidget* widget = m_item_list.at(i)->widget(); widget != nullptr)
+        {
+            m_widget_indices.insert(widget, i);
+        }
+    }
+}
+
+/**
+ * @brief Hides or shows the item of a widget without invalidating the layout.
+ *
+ * The invalidation triggered by showing or hiding the widget is deferred like in a batch, so
+ * the caller invalidates once after all changes.
+ *
+ * @param index The index of the widget's item.
+ * @param hidden If true, the item is hidden.
+ * @return true if the state changed.
+ */
+auto FlowLayout::set_item_hidden(int index, bool hidden) -> bool
+{
+    QLayoutItem* item = m_item_list.at(index);
+    const bool result = m_hidden_items.contains(item) != hidden;
+
+    if (result)
+    {
+        if (hidden)
+        {
+            m_hidden_items.insert(item);
+        }
+        else
+        {
+            m_hidden_items.remove(item);
+        }
+
+        ++m_batch_depth;
+        item->widget()->setVisible(!hidden);
+        --m_batch_depth;
+    }
+
+    return result;
 }
 
 /**
@@ -231,132 +671,479 @@ auto FlowLayout::get_expand_to_show_all_rows() const -> bool
 }
 
 /**
- * @brief Performs the layout of items.
- * @param rect The rectangle to layout within.
- * @param test_only If true, only calculates layout size, does not set geometry.
- * @return The total height used.
+ * @brief Enables or disables animated reflow.
  *
- * RowAlignment::Left: rows are left-aligned.
- * RowAlignment::Center: rows are always centered.
- * RowAlignment::CenterLeft: all rows are centered, but rows with fewer items are left-aligned with
- * the widest row above.
+ * Disabling finishes a running animation immediately.
+ *
+ * @param enabled If true, reflows of a visible layout are animated.
  */
-auto FlowLayout::do_layout(const QRect& rect, bool test_only) const -> int
+auto FlowLayout::set_animation_enabled(bool enabled) -> void
 {
-    int left = 0, top = 0, right = 0, bottom = 0;
-    getContentsMargins(&left, &top, &right, &bottom);
+    m_animation_enabled = enabled;
 
-    int x = rect.x() + left;
-    int y = rect.y() + top;
-    int line_height = 0;
-    int start_x = x;
-    int max_width = rect.width() - left - right;
+    if (!enabled)
+    {
+        stop_animation();
+    }
+}
 
-    QList<QLayoutItem*> line_items;
-    int line_width = 0;
+/**
+ * @brief Returns whether animated reflow is enabled.
+ * @return true if reflows are animated, false otherwise.
+ */
+auto FlowLayout::get_animation_enabled() const -> bool
+{
+    return m_animation_enabled;
+}
 
-    // Track the left edge of the first centered row
-    int first_row_left_x = -1;
-    bool is_first_row = true;
+/**
+ * @brief Sets the duration of a reflow animation.
+ * @param msecs The duration in milliseconds.
+ */
+auto FlowLayout::set_animation_duration(int msecs) -> void
+{
+    m_animation_duration = std::max(0, msecs);
+}
 
-    for (int i = 0; i < m_item_list.size(); ++i)
+/**
+ * @brief Returns the duration of a reflow animation in milliseconds.
+ * @return The animation duration.
+ */
+auto FlowLayout::get_animation_duration() const -> int
+{
+    return m_animation_duration;
+}
+
+/**
+ * @brief Returns whether a reflow animation is currently running.
+ * @return true while items are moving, false otherwise.
+ */
+auto FlowLayout::is_animating() const -> bool
+{
+    return !m_animated_items.isEmpty();
+}
+
+/**
+ * @brief Refreshes the item size snapshot after `invalidate()`.
+ *
+ * Spacing and all item size hints are read once per pass (spacing may go through
+ * `QStyle::pixelMetric()`, size hints through style and font metrics), so row breaking only reads
+ * a contiguous array. The new sizes are compared with the previous snapshot: every cached width
+ * stays valid up to the first changed item. Changed margins, spacing or alignment invalidate all
+ * cached widths.
+ *
+ * Hidden items are left out of both the sizes and the matching list of laid out items, so
+ * hiding an item re-flows from its position as if it had been removed.
+ */
+auto FlowLayout::sync_item_sizes() const -> void
+{
+    if (m_item_sizes_dirty)
     {
-        QLayoutItem* item = m_item_list.at(i);
-        int space_x = horizontal_spacing();
-        int space_y = vertical_spacing();
-        int item_width = item->sizeHint().width();
-        int item_height = item->sizeHint().height();
-        int next_x = x + item_width + space_x;
+        const LayoutParameters parameters {contentsMargins(), horizontal_spacing(),
+                                           vertical_spacing(), m_row_alignment};
+        QList<QSize> item_sizes;
+        QList<QLayoutItem*> laid_out_items;
+        const qsizetype laid_out_count = m_item_list.size() - m_hidden_items.size();
+        item_sizes.reserve(laid_out_count);
+        laid_out_items.reserve(laid_out_count);
 
-        if ((next_x - space_x > rect.right()) && (line_height > 0))
+        for (QLayoutItem* item: m_item_list)
         {
-            int offset_x = 0;
-
-            if (m_row_alignment == RowAlignment::CenterLeft)
+            if (!m_hidden_items.contains(item))
             {
-                if (is_first_row)
-                {
-                    offset_x = (max_width - line_width + space_x) / 2;
-                    first_row_left_x = start_x + offset_x;
-                    is_first_row = false;
-                }
-                else
-                {
-                    offset_x = first_row_left_x - start_x;
-                }
+                laid_out_items.append(item);
+                item_sizes.append(item->sizeHint());
             }
-            else if (m_row_alignment == RowAlignment::Center)
+        }
+
+        if (parameters == m_layout_parameters)
+        {
+            const int common_count =
+                static_cast<int>(std::min(item_sizes.size(), m_item_sizes.size()));
+            int first_changed = 0;
+
+            while (first_changed < common_count &&
+                   item_sizes.at(first_changed) == m_item_sizes.at(first_changed))
             {
-                offset_x = (max_width - line_width + space_x) / 2;
+                ++first_changed;
             }
-            // Left: offset_x remains 0
 
-            for (int j = 0; j < line_items.size(); ++j)
+            for (CachedLayout& cached: m_layout_cache)
             {
-                if (!test_only)
-                {
-                    QRect geom = line_items.at(j)->geometry();
-                    geom.moveLeft(geom.left() + offset_x);
-                    line_items.at(j)->setGeometry(geom);
-                }
+                cached.valid_items = std::min(cached.valid_items, first_changed);
             }
+        }
+        else
+        {
+            m_layout_cache.clear();
+            m_layout_parameters = parameters;
+        }
 
-            line_items.clear();
-            line_width = 0;
+        m_item_sizes = std::move(item_sizes);
+        m_laid_out_items = std::move(laid_out_items);
+        m_item_sizes_dirty = false;
+    }
+}
 
-            x = start_x;
-            y += line_height + space_y;
-            next_x = x + item_width + space_x;
-            line_height = 0;
-        }
+/**
+ * @brief Returns the cached layout for a width, computing or re-flowing it as needed.
+ *
+ * A cached width whose leading items are still valid is re-flowed from the row containing the
+ * first changed item; only unknown widths are laid out from scratch.
+ *
+ * @param width The width of the layout rectangle.
+ * @return The layout result for that width.
+ */
+auto FlowLayout::get_layout_for_width(int width) const -> const LayoutResult&
+{
+    sync_item_sizes();
+    const int item_count = static_cast<int>(m_item_sizes.size());
+    auto cached = m_layout_cache.find(width);
 
-        if (!test_only)
+    if (cached == m_layout_cache.end())
+    {
+        if (m_layout_cache.size() >= kMaxCachedWidths)
         {
-            item->setGeometry(QRect(QPoint(x, y), item->sizeHint()));
+            m_layout_cache.clear();
         }
 
-        line_items.append(item);
-        line_width += item_width + space_x;
-        x = next_x;
-        line_height = std::max(line_height, item_height);
+        CachedLayout entry;
+        update_geometry_from_row(entry.layout, 0, m_item_sizes, width, m_layout_parameters);
+        entry.valid_items = item_count;
+        cached = m_layout_cache.insert(width, entry);
+    }
+    else if (cached->valid_items < item_count || cached->layout.item_rects.size() != item_count)
+    {
+        update_geometry_from_row(cached->layout,
+                                 get_resume_row(cached->layout, cached->valid_items),
+                                 m_item_sizes, width, m_layout_parameters);
+        cached->valid_items = item_count;
     }
 
-    // Handle last line
-    if (!line_items.isEmpty())
+    return cached->layout;
+}
+
+/**
+ * @brief Returns the first row that may change when items from an index on change.
+ *
+ * That is the row containing the item; if the item starts its row, the row above may now have
+ * room for it as well.
+ *
+ * @param layout The cached layout result.
+ * @param first_changed_item The index of the first changed item.
+ * @return The row to re-flow from.
+ */
+auto FlowLayout::get_resume_row(const LayoutResult& layout, int first_changed_item) -> int
+{
+    const auto row_end = std::upper_bound(layout.row_starts.cbegin(), layout.row_starts.cend(),
+                                          first_changed_item);
+    int result = std::max(0, static_cast<int>(row_end - layout.row_starts.cbegin()) - 1);
+
+    if (result > 0 && layout.row_starts.at(result) == first_changed_item)
     {
+        --result;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Computes row breaks and item rectangles for items of the given sizes.
+ *
+ * Lays out all items with `update_geometry_from_row()`.
+ *
+ * @param item_sizes The size of each item, in item order.
+ * @param width The width of the layout rectangle.
+ * @param margins The contents margins.
+ * @param h_spacing The horizontal spacing between items (not negative).
+ * @param v_spacing The vertical spacing between rows (not negative).
+ * @param alignment The row alignment.
+ * @return The layout result, relative to the origin (0, 0).
+ *
+ * RowAlignment::Left: rows are left-aligned.
+ * RowAlignment::Center: rows are always centered.
+ * RowAlignment::CenterLeft: all rows are centered, but rows with fewer items are left-aligned with
+ * the widest row above.
+ */
+auto FlowLayout::compute_geometry(const QList<QSize>& item_sizes, int width,
+                                  const QMargins& margins, int h_spacing, int v_spacing,
+                                  RowAlignment alignment) -> LayoutResult
+{
+    LayoutResult result;
+    update_geometry_from_row(result, 0, item_sizes, width,
+                             LayoutParameters {margins, h_spacing, v_spacing, alignment});
+    return result;
+}
+
+/**
+ * @brief Re-flows a layout result from a row onward (row-breaking engine).
+ *
+ * Rows are filled left to right until the next item would cross the right edge. Once a row is
+ * complete, its items are shifted by the row's alignment offset in the result list, so no item
+ * is positioned twice.
+ *
+ * A row only depends on its own items, its top edge and (for CenterLeft) the left edge of the
+ * first row, all of which are kept in the result; so rows before first_row are reused as they
+ * are and the pass starts at the first item of first_row.
+ *
+ * @param result The result to update; rows before first_row are kept.
+ * @param first_row The first row to lay out again (0 lays out everything).
+ * @param item_sizes The size of each item, in item order.
+ * @param width The width of the layout rectangle.
+ * @param parameters The margins, spacing and alignment.
+ */
+auto FlowLayout::update_geometry_from_row(LayoutResult& result, int first_row,
+                                          const QList<QSize>& item_sizes, int width,
+                                          const LayoutParameters& parameters) -> void
+{
+    const int item_count = static_cast<int>(item_sizes.size());
+    const QMargins& margins = parameters.margins;
+    const RowAlignment alignment = parameters.alignment;
+    const int space_x = parameters.h_spacing;
+    const int space_y = parameters.v_spacing;
+
+    // The layout is computed for a rectangle at the origin; callers translate the result
+    const int right_edge = width - 1;
+    const int start_x = margins.left();
+    const int max_width = width - margins.left() - margins.right();
+    int line_start = 0;
+    int y = margins.top();
+
+    // Track the left edge of the first centered row
+    int first_row_left_x = -1;
+    bool is_first_row = true;
+
+    if (first_row > 0 && first_row < result.row_starts.size() &&
+        result.row_starts.at(first_row) < item_count)
+    {
+        line_start = result.row_starts.at(first_row);
+        y = result.item_rects.at(line_start).top();
+        first_row_left_x = result.item_rects.at(0).left();
+        is_first_row = false;
+        result.row_starts.resize(first_row);
+        result.item_rects.resize(line_start);
+    }
+    else
+    {
+        result.row_starts.clear();
+        result.item_rects.clear();
+    }
+
+    result.item_rects.reserve(item_count);
+
+    int x = start_x;
+    int line_height = 0;
+    int line_width = 0;
+
+    const auto align_line = [&](int line_end) {
         int offset_x = 0;
 
-        if (m_row_alignment == RowAlignment::CenterLeft)
+        if (alignment == RowAlignment::CenterLeft)
         {
             if (is_first_row)
             {
-                offset_x = (max_width - line_width + horizontal_spacing()) / 2;
+                offset_x = (max_width - line_width + space_x) / 2;
                 first_row_left_x = start_x + offset_x;
+                is_first_row = false;
             }
             else
             {
                 offset_x = first_row_left_x - start_x;
             }
         }
-        else if (m_row_alignment == RowAlignment::Center)
+        else if (alignment == RowAlignment::Center)
         {
-            offset_x = (max_width - line_width + horizontal_spacing()) / 2;
+            offset_x = (max_width - line_width + space_x) / 2;
         }
         // Left: offset_x remains 0
 
-        for (int j = 0; j < line_items.size(); ++j)
+        for (int j = line_start; j < line_end; ++j)
+        {
+            result.item_rects[j].translate(offset_x, 0);
+        }
+    };
+
+    if (line_start < item_count)
+    {
+        result.row_starts.append(line_start);
+    }
+
+    for (int i = line_start; i < item_count; ++i)
+    {
+        const QSize& item_size = item_sizes.at(i);
+        int next_x = x + item_size.width() + space_x;
+
+        if ((next_x - space_x > right_edge) && (line_height > 0))
+        {
+            align_line(i);
+            line_start = i;
+            line_width = 0;
+            result.row_starts.append(i);
+
+            x = start_x;
+            y += line_height + space_y;
+            next_x = x + item_size.width() + space_x;
+            line_height = 0;
+        }
+
+        result.item_rects.append(QRect(QPoint(x, y), item_size));
+        line_width += item_size.width() + space_x;
+        x = next_x;
+        line_height = std::max(line_height, item_size.height());
+    }
+
+    // Handle last line
+    if (line_start < item_count)
+    {
+        align_line(item_count);
+    }
+
+    result.height = y + line_height;
+}
+
+/**
+ * @brief Starts (or retargets) the reflow animation towards the layout of a rectangle.
+ *
+ * Every item starts at its current geometry, so a reflow during a running animation continues
+ * smoothly from the intermediate positions. Items that are already in place, hidden widgets and
+ * items without a valid geometry yet (just added) are placed directly.
+ *
+ * @param rect The rectangle to layout within.
+ */
+auto FlowLayout::start_animation(const QRect& rect) -> void
+{
+    // Copy (cheap, implicitly shared): applying geometries may invalidate the cache
+    const LayoutResult layout = get_layout_for_width(rect.width());
+    const QList<QLayoutItem*> items = m_laid_out_items;
+    const QPoint origin = rect.topLeft();
+
+    m_animated_items.clear();
+    m_animation_from.clear();
+    m_animation_to.clear();
+
+    for (int i = 0; i < items.size(); ++i)
+    {
+        QLayoutItem* item = items.at(i);
+        const QRect current = item->geometry();
+        const QRect target = layout.item_rects.at(i).translated(origin);
+        const QWidget* widget = item->widget();
+        const bool can_animate = current.isValid() && (widget == nullptr || widget->isVisible());
+
+        if (current != target && can_animate && m_animation_duration > 0)
+        {
+            m_animated_items.append(item);
+            m_animation_from.append(current);
+            m_animation_to.append(target);
+        }
+        else if (current != target)
+        {
+            item->setGeometry(target);
+        }
+    }
+
+    if (m_animated_items.isEmpty())
+    {
+        AnimationClock::instance().unsubscribe(this);
+    }
+    else
+    {
+        AnimationClock& clock = AnimationClock::instance();
+        m_animation_start = clock.get_time();
+        clock.subscribe(this, [this](qint64 now_msecs) { return advance_animation(now_msecs); });
+    }
+}
+
+/**
+ * @brief Applies one animation frame.
+ *
+ * The eased progress is computed from the elapsed time, then all items are moved in one pass
+ * over the start and end rectangle arrays. The last frame places the items exactly at their
+ * final rectangles.
+ *
+ * @param now_msecs The shared animation clock time in milliseconds.
+ * @return true while the animation is still running, false once it finished.
+ */
+auto FlowLayout::advance_animation(qint64 now_msecs) -> bool
+{
+    static const QEasingCurve easing(QEasingCurve::OutCubic);
+
+    const qreal linear = std::clamp(static_cast<qreal>(now_msecs - m_animation_start) /
+                                        std::max(1, m_animation_duration),
+                                    0.0, 1.0);
+    const bool result = linear < 1.0 && !m_animated_items.isEmpty();
+
+    if (result)
+    {
+        const qreal progress = easing.valueForProgress(linear);
+
+        for (int i = 0; i < m_animated_items.size(); ++i)
+        {
+            m_animated_items.at(i)->setGeometry(
+                interpolate_rect(m_animation_from.at(i), m_animation_to.at(i), progress));
+        }
+    }
+    else
+    {
+        stop_animation();
+    }
+
+    return result;
+}
+
+/**
+ * @brief Finishes a running animation by moving all items to their final rectangles.
+ */
+auto FlowLayout::stop_animation() -> void
+{
+    if (!m_animated_items.isEmpty())
+    {
+        for (int i = 0; i < m_animated_items.size(); ++i)
         {
-            if (!test_only)
+            m_animated_items.at(i)->setGeometry(m_animation_to.at(i));
+        }
+
+        m_animated_items.clear();
+        m_animation_from.clear();
+        m_animation_to.clear();
+        AnimationClock::instance().unsubscribe(this);
+    }
+}
+
+/**
+ * @brief Performs the layout of items.
+ * @param rect The rectangle to layout within.
+ * @param test_only If true, only calculates layout size, does not set geometry.
+ * @return The total height used.
+ *
+ * Uses the cached layout for the rectangle's width; each item's geometry is set at most once,
+ * and not at all if it is already in place (e.g. rows before an appended item).
+ */
+auto FlowLayout::do_layout(const QRect& rect, bool test_only) const -> int
+{
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("layout", "FlowLayout::do_layout");
+
+    // Copy (cheap, implicitly shared): applying geometries may invalidate the cache
+    const LayoutResult layout = get_layout_for_width(rect.width());
+
+    if (!test_only)
+    {
+        // Hidden items are not part of the layout result and keep their geometry
+        const QList<QLayoutItem*> items = m_laid_out_items;
+        const QPoint origin = rect.topLeft();
+
+        for (int i = 0; i < items.size(); ++i)
+        {
+            QLayoutItem* item = items.at(i);
+            const QRect target = layout.item_rects.at(i).translated(origin);
+
+            if (item->geometry() != target)
             {
-                QRect geom = line_items.at(j)->geometry();
-                geom.moveLeft(geom.left() + offset_x);
-                line_items.at(j)->setGeometry(geom);
+                item->setGeometry(target);
             }
         }
     }
 
-    int result = y + line_height - rect.y();
-    return result;
+    return layout.height;
 }
 
 /**
@@ -0,0 +1,252 @@
+#include "QtWidgetsCommonLib/Services/Preferences/BatchedMainWindowStatePersistence.h"
+
+#include <QDebug>
+
+#include "QtWidgetsCommonLib/Services/Preferences/IPreferencesTransaction.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @brief Constructs the decorator.
+ *
+ * Sets up a single-shot `QTimer` that coalesces changes into one flush and a repeating
+ * `QTimer` for periodic snapshots (disabled by default).
+ *
+ * @param target The persistence the values are written to; must outlive the decorator.
+ * @param parent The parent QObject, or nullptr.
+ */
+BatchedMainWindowStatePersistence::BatchedMainWindowStatePersistence(
+    IMainWindowStatePersistence* target, QObject* parent)
+    : QObject(parent), m_target(target)
+{
+    if (m_target == nullptr)
+    {
+        qWarning() << "[BatchedMainWindowStatePersistence] Target is null, values are not saved.";
+    }
+
+    m_flush_timer.setSingleShot(true);
+    m_flush_timer.setInterval(m_flush_delay);
+    QObject::connect(&m_flush_timer, &QTimer::timeout, this, [this]() { flush(); });
+
+    QObject::connect(&m_snapshot_timer, &QTimer::timeout, this, [this]() {
+        emit snapshotRequested();
+        flush();
+    });
+}
+
+/**
+ * @brief Returns the main window geometry (position and size).
+ * @return The geometry data.
+ */
+auto BatchedMainWindowStatePersistence::get_mainwindow_geometry() -> QByteArray
+{
+    ensure_loaded();
+    return m_pending.geometry;
+}
+
+/**
+ * @brief Sets the main window geometry; written on the next flush if it changed.
+ * @param geometry The geometry data.
+ */
+auto BatchedMainWindowStatePersistence::set_mainwindow_geometry(const QByteArray& geometry)
+    -> void
+{
+    ensure_loaded();
+    m_pending.geometry = geometry;
+    schedule_flush();
+}
+
+/**
+ * @brief Returns the main window state.
+ * @return The state data.
+ */
+auto BatchedMainWindowStatePersistence::get_mainwindow_state() -> QByteArray
+{
+    ensure_loaded();
+    return m_pending.state;
+}
+
+/**
+ * @brief Sets the main window state; written on the next flush if it changed.
+ * @param state The state data.
+ */
+auto BatchedMainWindowStatePersistence::set_mainwindow_state(const QByteArray& state) -> void
+{
+    ensure_loaded();
+    m_pending.state = state;
+    schedule_flush();
+}
+
+/**
+ * @brief Returns the main window window state.
+ * @return The window state as an integer.
+ */
+auto BatchedMainWindowStatePersistence::get_mainwindow_windowstate() -> int
+{
+    ensure_loaded();
+    return m_pending.window_state;
+}
+
+/**
+ * @brief Sets the main window window state; written on the next flush if it changed.
+ * @param state The window state as an integer.
+ */
+auto BatchedMainWindowStatePersistence::set_mainwindow_windowstate(int state) -> void
+{
+    ensure_loaded();
+    m_pending.window_state = state;
+    schedule_flush();
+}
+
+/**
+ * @brief Writes all changed values to the target.
+ *
+ * Only the values that differ from the target's are written, inside one transaction when the
+ * target implements `IPreferencesTransaction`.
+ *
+ * @return true if anything was written, false if nothing had changed.
+ */
+auto BatchedMainWindowStatePersistence::flush() -> bool
+{
+    m_flush_timer.stop();
+    const bool result = has_pending_writes() && m_target != nullptr;
+
+    if (result)
+    {
+        auto* transaction = dynamic_cast<IPreferencesTransaction*>(m_target);
+
+        if (transaction != nullptr)
+        {
+            transaction->begin_transaction();
+        }
+
+        if (m_pending.geometry != m_persisted.geometry)
+        {
+            m_target->set_mainwindow_geometry(m_pending.geometry);
+        }
+
+        if (m_pending.state != m_persisted.state)
+        {
+            m_target->set_mainwindow_state(m_pending.state);
+        }
+
+        if (m_pending.window_state != m_persisted.window_state)
+        {
+            m_target->set_mainwindow_windowstate(m_pending.window_state);
+        }
+
+        if (transaction != nullptr)
+        {
+            transaction->commit_transaction();
+        }
+
+        m_persisted = m_pending;
+        ++m_write_batch_count;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns whether values differ from what the target holds.
+ * @return true if a flush would write something.
+ */
+auto BatchedMainWindowStatePersistence::has_pending_writes() const -> bool
+{
+    return m_pending.geometry != m_persisted.geometry || m_pending.state != m_persisted.state ||
+           m_pending.window_state != m_persisted.window_state;
+}
+
+/**
+ * @brief Sets the delay between a change and the automatic flush.
+ * @param msec The delay in milliseconds; negative values disable the automatic flush.
+ */
+auto BatchedMainWindowStatePersistence::set_flush_delay(int msec) -> void
+{
+    m_flush_delay = msec;
+
+    if (m_flush_delay < 0)
+    {
+        m_flush_timer.stop();
+    }
+    else
+    {
+        m_flush_timer.setInterval(m_flush_delay);
+    }
+}
+
+/**
+ * @brief Returns the delay between a change and the automatic flush.
+ * @return The delay in milliseconds, or a negative value if disabled.
+ */
+auto BatchedMainWindowStatePersistence::get_flush_delay() const -> int
+{
+    return m_flush_delay;
+}
+
+/**
+ * @brief Sets the interval of periodic snapshots.
+ * @param msec The interval in milliseconds; 0 or less disables snapshots.
+ */
+auto BatchedMainWindowStatePersistence::set_snapshot_interval(int msec) -> void
+{
+    if (msec > 0)
+    {
+        m_snapshot_timer.start(msec);
+    }
+    else
+    {
+        m_snapshot_timer.stop();
+    }
+}
+
+/**
+ * @brief Returns the interval of periodic snapshots.
+ * @return The interval in milliseconds, or 0 if disabled.
+ */
+auto BatchedMainWindowStatePersistence::get_snapshot_interval() const -> int
+{
+    return m_snapshot_timer.isActive() ? m_snapshot_timer.interval() : 0;
+}
+
+/**
+ * @brief Returns the number of flushes that wrote to the target.
+ * @return The number of write batches.
+ */
+auto BatchedMainWindowStatePersistence::get_write_batch_count() const -> int
+{
+    return m_write_batch_count;
+}
+
+/**
+ * @brief Reads the target's values once, before the first get or set.
+ */
+auto BatchedMainWindowStatePersistence::ensure_loaded() -> void
+{
+    if (!m_loaded && m_target != nullptr)
+    {
+        m_persisted.geometry = m_target->get_mainwindow_geometry();
+        m_persisted.state = m_target->get_mainwindow_state();
+        m_persisted.window_state = m_target->get_mainwindow_windowstate();
+        m_pending = m_persisted;
+    }
+
+    m_loaded = true;
+}
+
+/**
+ * @brief Starts the flush timer if values changed and the automatic flush is enabled.
+ *
+ * A running timer is not restarted, so a steady stream of changes is still written once per
+ * delay.
+ */
+auto BatchedMainWindowStatePersistence::schedule_flush() -> void
+{
+    if (m_flush_delay >= 0 && has_pending_writes() && !m_flush_timer.isActive())
+    {
+        m_flush_timer.start();
+    }
+}
+
+}  // namespace QtWidgetsCommonLib
@@ -5,8 +5,121 @@
 
 #include "QtWidgetsCommonLib/Services/Translator.h"
 
+#include <QApplication>
 #include <QCoreApplication>
 #include <QDir>
+#include <QEvent>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QResource>
+#include <QTimer>
+#include <QWidget>
+#include <QtConcurrent>
+#include <algorithm>
+#include <utility>
+
+#include "QtWidgetsCommonLib/Utils/Trace.h"
+
+namespace
+{
+
+/**
+ * @brief Resource directory of compiled-in translations, preferred over loose files.
+ */
+const QString kResourceTranslationsPath = QStringLiteral(":/translations");
+
+/**
+ * @brief Returns whether a translations path points into the Qt resource system.
+ * @param path The translations path.
+ * @return True for resource paths (":/...").
+ */
+auto is_resource_path(const QString& path) -> bool
+{
+    return path.startsWith(QLatin1Char(':'));
+}
+
+/**
+ * @brief Finds a translation file the way QTranslator::load(locale, ...) does.
+ *
+ * Tries every UI language of the locale (e.g. "de_DE", then "de") in order.
+ *
+ * @param locale The locale.
+ * @param filename The base filename (e.g. "app").
+ * @param directory The translations directory.
+ * @return The path of the first existing file, or an empty string.
+ */
+auto find_translation_file(const QLocale& locale, const QString& filename,
+                           const QString& directory) -> QString
+{
+    QString result;
+    const QStringList languages = locale.uiLanguages();
+
+    for (qsizetype i = 0; i < languages.size() && result.isEmpty(); ++i)
+    {
+        QString name = languages.at(i);
+        name.replace(QLatin1Char('-'), QLatin1Char('_'));
+
+        while (result.isEmpty() && !name.isEmpty())
+        {
+            const QString candidate = directory + QLatin1Char('/') + filename +
+                                      QLatin1Char('_') + name + QStringLiteral(".qm");
+
+            if (QFile::exists(candidate))
+            {
+                result = candidate;
+            }
+            else
+            {
+                const qsizetype separator = name.lastIndexOf(QLatin1Char('_'));
+                name = (separator > 0) ? name.left(separator) : QString();
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Reads a file completely.
+ * @param path The file path; an empty path yields an empty result.
+ * @return The file contents, or an empty array if it cannot be read.
+ */
+auto read_file(const QString& path) -> QByteArray
+{
+    QByteArray result;
+    QFile file(path);
+
+    if (!path.isEmpty() && file.open(QIODevice::ReadOnly))
+    {
+        result = file.readAll();
+    }
+
+    return result;
+}
+
+/**
+ * @brief Loads a translator from file contents that outlive it.
+ *
+ * Dependencies of the file (e.g. the qtbase_*.qm files a qt_*.qm meta catalog refers to) are
+ * resolved relative to the directory of the file they were read from.
+ *
+ * @param translator The translator.
+ * @param data The .qm file contents.
+ * @param path The path the contents were read from.
+ * @return True if the translator was loaded.
+ */
+auto load_from_data(QTranslator& translator, const QByteArray& data, const QString& path) -> bool
+{
+    const bool result =
+        !data.isEmpty() && translator.load(reinterpret_cast<const uchar*>(data.constData()),
+                                           static_cast<int>(data.size()),
+                                           QFileInfo(path).absolutePath());
+    return result;
+}
+
+}  // namespace
 
 namespace QtWidgetsCommonLib
 {
@@ -18,23 +131,12 @@ namespace QtWidgetsCommonLib
  */
 Translator::Translator(QObject* parent)
     : QObject(parent),
-      m_qt_translator(),
-      m_app_translator(),
-      m_translations_path(QCoreApplication::applicationDirPath() + "/translations"),
+      m_translations_path(QFileInfo::exists(kResourceTranslationsPath)
+                              ? kResourceTranslationsPath
+                              : QCoreApplication::applicationDirPath() + "/translations"),
       m_current_locale()
 {
-    QDir translations_dir(m_translations_path);
-
-    if (!translations_dir.exists())
-    {
-        static bool logged_once = false;
-        if (!logged_once)
-        {
-            qWarning() << "Translations folder missing at" << m_translations_path
-                       << "- no translations will be available.";
-            logged_once = true;
-        }
-    }
+    watch_translations_path();
 }
 
 // NOLINTBEGIN(modernize-use-trailing-return-type)
@@ -58,39 +160,30 @@ bool Translator::load_translation(const QString& language_code)
 /**
  * @brief Loads the language translations for the specified locale.
  *
- * This method attempts to load the Qt provided translation file and the app-specific translation
- * file for the specified locale. If both files are loaded successfully, the translators are
- * installed and the languageChanged signal is emitted. If either of the files fails to load, the
- * method attempts to load the translations for the default language.
+ * This method makes the Qt provided translation file and the app-specific translation file for
+ * the specified locale available, reading them from disk only if the locale is not cached yet.
+ * If both are available, the previous translators are replaced by them and the languageChanged
+ * signal is emitted. Otherwise the previous translators stay installed and the method attempts
+ * to load the translations for the default language. Pending asynchronous loads are superseded.
  *
  * @param locale The locale to load translations for.
  * @return True if the translations were loaded successfully, false otherwise.
  */
 bool Translator::load_translation(const QLocale& locale)
 {
-    remove_none_empty_translators();
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("translation", "Translator::load_translation");
+
     qDebug() << "Attempting to load translations for the language" << locale << "from"
              << m_translations_path;
-    bool result = load(locale, QStringLiteral("qt"), m_qt_translator);
 
-    if (result)
-    {
-        result = load(locale, QStringLiteral("app"), m_app_translator);
+    // Supersedes pending asynchronous loads; their results are only cached
+    ++m_async_generation;
+    bool result = cache_translators(locale);
 
-        if (result)
-        {
-            qDebug() << (result ? "Successfully loaded the translators for locale"
-                                : "Failed to load the application translator for locale")
-                     << locale;
-            qApp->installTranslator(&m_qt_translator);
-            qApp->installTranslator(&m_app_translator);
-            m_current_locale = locale;
-            emit languageChanged();
-        }
-    }
-    else
+    if (result)
     {
-        qDebug() << "Failed to load the Qt translator for locale" << locale;
+        qDebug() << "Successfully loaded the translators for locale" << locale;
+        install_front_translators(locale);
     }
 
     // Attempt to load the default translation if it hasn't been tried yet.
@@ -114,6 +207,242 @@ bool Translator::load_default_translation()
     return load_translation(QLocale(QStringLiteral("en_EN")));
 }
 
+/**
+ * @brief Loads the translations for a language code without blocking the GUI thread.
+ *
+ * @param language_code The language code to load (e.g. "en", "de").
+ */
+void Translator::load_translation_async(const QString& language_code)
+{
+    load_translation_async(QLocale(language_code));
+}
+
+/**
+ * @brief Loads the translations for a locale without blocking the GUI thread.
+ *
+ * The worker thread only reads the files; parsing and installing happen on the GUI thread, where
+ * the translators are used. A result that arrives after a newer request is cached but not
+ * installed.
+ *
+ * @param locale The QLocale to load translations for.
+ */
+void Translator::load_translation_async(const QLocale& locale)
+{
+    const quint64 generation = ++m_async_generation;
+
+    // Cached, shared and compiled-in translations need no disk I/O; they are installed right away
+    if (is_translation_cached(locale) ||
+        get_registry().contains(std::make_pair(m_translations_path, locale)) ||
+        is_resource_path(m_translations_path))
+    {
+        const bool result = load_translation(locale);
+        emit translationLoadFinished(result);
+    }
+    else
+    {
+        AsyncLoad load;
+        load.watcher = new QFutureWatcher<std::shared_ptr<TranslationData>>(this);
+        load.locale = locale;
+        load.generation = generation;
+        load.path = m_translations_path;
+        m_async_loads.append(load);
+
+        connect(load.watcher, &QFutureWatcherBase::finished, this, [this, load]() {
+            m_async_loads.removeIf(
+                [&load](const AsyncLoad& pending) { return pending.watcher == load.watcher; });
+            finish_async_load(load);
+            load.watcher->deleteLater();
+        });
+        load.watcher->setFuture(QtConcurrent::run([locale, path = m_translations_path]() {
+            return read_translation_data(locale, path);
+        }));
+    }
+}
+
+/**
+ * @brief Returns whether an asynchronous load is still pending.
+ *
+ * @return True while load_translation_async() waits for a worker thread.
+ */
+bool Translator::is_loading_translation() const
+{
+    return !m_async_loads.isEmpty();
+}
+
+/**
+ * @brief Blocks until the pending asynchronous loads finished and installs their results now.
+ *
+ * Waits on the worker threads only; no events are processed meanwhile. A fallback to the default
+ * translation started by a failed load is waited for as well, so translationLoadFinished() has
+ * been emitted when this returns.
+ */
+void Translator::wait_for_translation_load()
+{
+    while (!m_async_loads.isEmpty())
+    {
+        const AsyncLoad load = m_async_loads.takeFirst();
+        load.watcher->waitForFinished();
+        finish_async_load(load);
+
+        // Also discards the finished notification the watcher may have queued already
+        delete load.watcher;
+    }
+}
+
+/**
+ * @brief Enables or disables staged delivery of retranslation events.
+ *
+ * Disabling delivers all held back events right away.
+ *
+ * @param enabled True to stage retranslation.
+ */
+void Translator::set_staged_retranslation(bool enabled)
+{
+    m_staged_retranslation = enabled;
+
+    while (!enabled && !m_pending_retranslation.isEmpty())
+    {
+        deliver_retranslation(m_pending_retranslation.takeFirst());
+    }
+}
+
+/**
+ * @brief Returns whether retranslation events are staged.
+ *
+ * @return True if staged retranslation is enabled.
+ */
+bool Translator::get_staged_retranslation() const
+{
+    return m_staged_retranslation;
+}
+
+/**
+ * @brief Returns how many windows still wait for their staged LanguageChange event.
+ *
+ * @return The number of pending windows.
+ */
+int Translator::get_pending_retranslation_count() const
+{
+    return static_cast<int>(m_pending_retranslation.size());
+}
+
+/**
+ * @brief Sets the directory or resource path the translations are loaded from.
+ *
+ * The translator cache is cleared, so every locale is loaded from the new path; the installed
+ * translators stay in use until the next load. The language catalog is rebuilt.
+ *
+ * @param path A directory, or a resource path such as ":/translations".
+ */
+void Translator::set_translations_path(const QString& path)
+{
+    if (path != m_translations_path)
+    {
+        m_translations_path = path;
+
+        // The installed translators stay alive through m_qt_translator and m_app_translator,
+        // the contents they read through m_installed_data
+        m_cache.clear();
+
+        delete m_catalog_watcher;
+        m_catalog_watcher = nullptr;
+        watch_translations_path();
+        refresh_language_catalog();
+    }
+}
+
+/**
+ * @brief Returns the directory or resource path the translations are loaded from.
+ *
+ * @return The translations path.
+ */
+QString Translator::get_translations_path() const
+{
+    return m_translations_path;
+}
+
+/**
+ * @brief Registers a packed resource archive (.rcc) and loads translations from it.
+ *
+ * QResource memory-maps the archive where the platform supports it; it stays registered for the
+ * lifetime of the process, since installed translators point into it.
+ *
+ * @param archive_path The path of the .rcc file.
+ * @param resource_path The resource directory of the translations inside the archive.
+ * @return True if the archive was registered, false otherwise (the path is then unchanged).
+ */
+bool Translator::register_translations_archive(const QString& archive_path,
+                                               const QString& resource_path)
+{
+    const bool result = QResource::registerResource(archive_path);
+
+    if (result)
+    {
+        set_translations_path(resource_path);
+    }
+    else
+    {
+        qWarning() << "[Translator] Failed to register translations archive" << archive_path;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Loads the translations for a locale into the cache without installing them.
+ *
+ * @param locale The QLocale to preload translations for.
+ * @return True if the translations are cached (loaded now or before), false otherwise.
+ */
+bool Translator::preload_translation(const QLocale& locale)
+{
+    const bool result = cache_translators(locale);
+    trim_cache();
+    return result;
+}
+
+/**
+ * @brief Preloads the default language translations used as fallback.
+ *
+ * @return True if the translations are cached (loaded now or before), false otherwise.
+ */
+bool Translator::preload_default_translation()
+{
+    return preload_translation(QLocale(QStringLiteral("en_EN")));
+}
+
+/**
+ * @brief Returns whether the translations for a locale are in the cache.
+ *
+ * @param locale The locale to check.
+ * @return True if a loaded translator pair for the locale is cached.
+ */
+bool Translator::is_translation_cached(const QLocale& locale) const
+{
+    return find_cached(locale) >= 0;
+}
+
+/**
+ * @brief Sets how many loaded translator pairs are kept (including the installed one).
+ *
+ * @param capacity The maximum number of cached locales; values < 1 are clamped to 1.
+ */
+void Translator::set_cache_capacity(int capacity)
+{
+    m_cache_capacity = std::max(1, capacity);
+    trim_cache();
+}
+
+/**
+ * @brief Returns the maximum number of cached translator pairs.
+ *
+ * @return The cache capacity.
+ */
+int Translator::get_cache_capacity() const
+{
+    return m_cache_capacity;
+}
+
 /**
  * @brief Returns the current language code.
  *
@@ -132,7 +461,171 @@ QString Translator::get_current_language_code() const
  */
 QStringList Translator::get_available_language_codes() const
 {
-    QStringList codes;
+    return get_catalog().codes;
+}
+
+/**
+ * @brief Returns a list of available language names found in the translations directory.
+ * @return A QStringList of language names (e.g. "English", "German").
+ */
+QStringList Translator::get_available_language_names() const
+{
+    return get_catalog().names;
+}
+
+/**
+ * @brief Returns a map of language codes to language names found in the translations directory.
+ * @return A QMap mapping language code to language name.
+ */
+QMap<QString, QString> Translator::get_language_code_name_map() const
+{
+    return get_catalog().code_name_map;
+}
+
+/**
+ * @brief Returns the native names of the available languages, in code order.
+ * @return A QStringList of native language names (e.g. "English", "Deutsch").
+ */
+QStringList Translator::get_available_native_language_names() const
+{
+    return get_catalog().native_names;
+}
+
+/**
+ * @brief Returns the English name of an available language.
+ * @param language_code The language code (e.g. "de").
+ * @return The language name (e.g. "German"), or an empty string if not available.
+ */
+QString Translator::get_language_name(const QString& language_code) const
+{
+    return get_catalog().code_name_map.value(language_code);
+}
+
+/**
+ * @brief Returns the native name of an available language.
+ * @param language_code The language code (e.g. "de").
+ * @return The native language name (e.g. "Deutsch"), or an empty string if not available.
+ */
+QString Translator::get_native_language_name(const QString& language_code) const
+{
+    return get_catalog().native_name_by_code.value(language_code);
+}
+
+/**
+ * @brief Returns the code of an available language from its English or native name.
+ * @param language_name The language name, compared case-insensitively.
+ * @return The language code, or an empty string if no available language has that name.
+ */
+QString Translator::get_language_code(const QString& language_name) const
+{
+    return get_catalog().code_by_name.value(language_name.toLower());
+}
+
+/**
+ * @brief Re-indexes the translations directory.
+ *
+ * Emits availableLanguagesChanged() if the list of language codes changed.
+ */
+void Translator::refresh_language_catalog()
+{
+    const QStringList previous_codes = m_catalog.codes;
+    const bool was_valid = m_catalog.valid;
+    m_catalog = build_catalog();
+
+    if (was_valid && previous_codes != m_catalog.codes)
+    {
+        emit availableLanguagesChanged();
+    }
+}
+
+/**
+ * @brief Holds back LanguageChange events of widgets during staged retranslation.
+ *
+ * Records the window of each held back widget so deliver_retranslation_step() can send the
+ * event later. Events sent by deliver_retranslation() pass through.
+ *
+ * @param watched The object receiving the event.
+ * @param event The event being filtered.
+ * @return true if the event was held back; false otherwise.
+ */
+bool Translator::eventFilter(QObject* watched, QEvent* event)
+{
+    bool result = false;
+
+    if (event->type() == QEvent::LanguageChange && watched->isWidgetType() &&
+        !m_delivering_retranslation && m_staged_retranslation)
+    {
+        QWidget* window = static_cast<QWidget*>(watched)->window();
+
+        if (!m_pending_retranslation.contains(window))
+        {
+            m_pending_retranslation.append(window);
+        }
+
+        result = true;
+    }
+    else
+    {
+        result = QObject::eventFilter(watched, event);
+    }
+
+    return result;
+}
+
+// NOLINTEND(modernize-use-trailing-return-type)
+
+/**
+ * @brief Watches a translations directory for changes; resource paths need no watcher.
+ *
+ * Logs once per process when the directory does not exist.
+ */
+auto Translator::watch_translations_path() -> void
+{
+    if (!is_resource_path(m_translations_path))
+    {
+        QDir translations_dir(m_translations_path);
+
+        if (!translations_dir.exists())
+        {
+            static bool logged_once = false;
+            if (!logged_once)
+            {
+                qWarning() << "Translations folder missing at" << m_translations_path
+                           << "- no translations will be available.";
+                logged_once = true;
+            }
+        }
+        else
+        {
+            // Re-index when .qm files are added, removed or renamed
+            m_catalog_watcher = new QFileSystemWatcher({m_translations_path}, this);
+            connect(m_catalog_watcher, &QFileSystemWatcher::directoryChanged, this,
+                    [this]() { refresh_language_catalog(); });
+        }
+    }
+}
+
+/**
+ * @brief Returns the language catalog, indexing the translations directory if needed.
+ * @return The current catalog.
+ */
+auto Translator::get_catalog() const -> const LanguageCatalog&
+{
+    if (!m_catalog.valid)
+    {
+        m_catalog = build_catalog();
+    }
+
+    return m_catalog;
+}
+
+/**
+ * @brief Builds a catalog from the app_*.qm files in the translations directory.
+ * @return The new catalog.
+ */
+auto Translator::build_catalog() const -> LanguageCatalog
+{
+    LanguageCatalog catalog;
     QDir dir(m_translations_path);
     QStringList files = dir.entryList(QStringList() << "app_*.qm", QDir::Files);
 
@@ -141,74 +634,412 @@ QStringList Translator::get_available_language_codes() const
         // Example: "app_de.qm" -> "de"
         QString code = file.mid(4, file.length() - 7);
 
-        if (!codes.contains(code))
+        if (!catalog.code_name_map.contains(code))
         {
-            codes.append(code);
+            const QLocale locale(code);
+            const QString name = QLocale::languageToString(locale.language());
+            const QString native_name = locale.nativeLanguageName();
+
+            catalog.codes.append(code);
+            catalog.names.append(name);
+            catalog.native_names.append(native_name);
+            catalog.code_name_map.insert(code, name);
+            catalog.native_name_by_code.insert(code, native_name);
+
+            // The first code wins when several codes share a name (e.g. "de" and "de_AT")
+            if (!catalog.code_by_name.contains(name.toLower()))
+            {
+                catalog.code_by_name.insert(name.toLower(), code);
+            }
+
+            if (!native_name.isEmpty() && !catalog.code_by_name.contains(native_name.toLower()))
+            {
+                catalog.code_by_name.insert(native_name.toLower(), code);
+            }
         }
     }
 
-    return codes;
+    catalog.valid = true;
+    return catalog;
 }
 
 /**
- * @brief Returns a list of available language names found in the translations directory.
- * @return A QStringList of language names (e.g. "English", "German").
+ * @brief Removes the installed translators if they are not empty.
  */
-QStringList Translator::get_available_language_names() const
+auto Translator::remove_none_empty_translators() -> void
 {
-    QStringList names;
-    QStringList codes = get_available_language_codes();
+    if (m_qt_translator != nullptr && !m_qt_translator->isEmpty())
+    {
+        qApp->removeTranslator(m_qt_translator.get());
+    }
 
-    for (const QString& code: codes)
+    if (m_app_translator != nullptr && !m_app_translator->isEmpty())
     {
-        QLocale locale(code);
-        QString name = QLocale::languageToString(locale.language());
-        names.append(name);
+        qApp->removeTranslator(m_app_translator.get());
     }
+}
 
-    return names;
+/**
+ * @brief Returns the cache index of a locale's translators.
+ *
+ * @param locale The locale to look up.
+ * @return The index in the cache, or -1 if the locale is not cached.
+ */
+auto Translator::find_cached(const QLocale& locale) const -> qsizetype
+{
+    qsizetype result = -1;
+
+    for (qsizetype i = 0; i < m_cache.size() && result < 0; ++i)
+    {
+        if (m_cache[i]->locale == locale)
+        {
+            result = i;
+        }
+    }
+
+    return result;
 }
 
 /**
- * @brief Returns a map of language codes to language names found in the translations directory.
- * @return A QMap mapping language code to language name.
+ * @brief Makes a locale's translators available in the cache as most recently used.
+ *
+ * @param locale The locale to load translations for.
+ * @return True if both translators are loaded, false otherwise.
  */
-QMap<QString, QString> Translator::get_language_code_name_map() const
+auto Translator::cache_translators(const QLocale& locale) -> bool
 {
-    QMap<QString, QString> map;
-    QStringList codes = get_available_language_codes();
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("translation", "Translator::cache_translators");
+
+    const qsizetype index = find_cached(locale);
+    bool result = index >= 0;
 
-    for (const QString& code: codes)
+    if (result)
     {
-        QLocale locale(code);
-        QString name = QLocale::languageToString(locale.language());
-        map.insert(code, name);
+        m_cache.move(index, 0);
+    }
+    else
+    {
+        const std::shared_ptr<CachedTranslators> entry = create_translators(locale);
+        result = entry != nullptr;
+
+        if (result)
+        {
+            m_cache.prepend(entry);
+        }
     }
 
-    return map;
+    return result;
 }
 
-// NOLINTEND(modernize-use-trailing-return-type)
+/**
+ * @brief Loads both translators of a locale from the translations path.
+ *
+ * Only the file contents are shared with other instances: QTranslator::removeTranslator() removes
+ * every installation of a translator, so each instance installs translators of its own.
+ * Compiled-in translations are read in place and need no sharing.
+ *
+ * @param locale The locale to load translations for.
+ * @return The loaded pair, or nullptr if either translator failed to load.
+ */
+auto Translator::create_translators(const QLocale& locale) -> std::shared_ptr<CachedTranslators>
+{
+    std::shared_ptr<CachedTranslators> result;
+
+    if (is_resource_path(m_translations_path))
+    {
+        auto entry = std::make_shared<CachedTranslators>();
+        entry->locale = locale;
+        entry->qt_translator = std::make_shared<QTranslator>();
+        entry->app_translator = std::make_shared<QTranslator>();
+
+        if (!load(locale, QStringLiteral("qt"), *entry->qt_translator))
+        {
+            qDebug() << "Failed to load the Qt translator for locale" << locale;
+        }
+        else if (!load(locale, QStringLiteral("app"), *entry->app_translator))
+        {
+            qDebug() << "Failed to load the application translator for locale" << locale;
+        }
+        else
+        {
+            result = entry;
+        }
+    }
+    else
+    {
+        // File contents another instance already read for the same path are reused
+        result = create_translators(
+            locale, get_registry().acquire(std::make_pair(m_translations_path, locale),
+                                           [this, &locale]() {
+                                               return read_translation_data(locale,
+                                                                            m_translations_path);
+                                           }));
+    }
+
+    return result;
+}
 
 /**
- * @brief Removes the installed translators if they are not empty.
+ * @brief Parses shared file contents into a translator pair of this instance.
+ *
+ * The translators read the contents in place; the pair keeps them alive.
+ *
+ * @param locale The locale of the contents.
+ * @param data The file contents; nullptr fails.
+ * @return The loaded pair, or nullptr if either translator failed to load.
  */
-auto Translator::remove_none_empty_translators() -> void
+auto Translator::create_translators(const QLocale& locale,
+                                    std::shared_ptr<const TranslationData> data)
+    -> std::shared_ptr<CachedTranslators>
+{
+    std::shared_ptr<CachedTranslators> result;
+    auto entry = std::make_shared<CachedTranslators>();
+    entry->locale = locale;
+    entry->data = std::move(data);
+    entry->qt_translator = std::make_shared<QTranslator>();
+    entry->app_translator = std::make_shared<QTranslator>();
+
+    if (entry->data == nullptr ||
+        !load_from_data(*entry->qt_translator, entry->data->qt_data, entry->data->qt_path))
+    {
+        qDebug() << "Failed to load the Qt translator for locale" << locale;
+    }
+    else if (!load_from_data(*entry->app_translator, entry->data->app_data,
+                             entry->data->app_path))
+    {
+        qDebug() << "Failed to load the application translator for locale" << locale;
+    }
+    else
+    {
+        result = entry;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Reads the Qt and application .qm files of a locale (runs on a worker thread).
+ * @param locale The locale.
+ * @param directory The translations directory.
+ * @return The file contents, or nullptr if the Qt file is missing; a missing application file
+ * leaves its contents empty.
+ */
+auto Translator::read_translation_data(const QLocale& locale, const QString& directory)
+    -> std::shared_ptr<TranslationData>
 {
-    if (!m_qt_translator.isEmpty())
+    std::shared_ptr<TranslationData> result;
+    auto data = std::make_shared<TranslationData>();
+    data->qt_path = find_translation_file(locale, QStringLiteral("qt"), directory);
+    data->qt_data = read_file(data->qt_path);
+
+    if (!data->qt_data.isEmpty())
     {
-        qApp->removeTranslator(&m_qt_translator);
+        data->app_path = find_translation_file(locale, QStringLiteral("app"), directory);
+        data->app_data = read_file(data->app_path);
+        result = data;
     }
 
-    if (!m_app_translator.isEmpty())
+    return result;
+}
+
+/**
+ * @brief Returns the process-wide .qm file contents, keyed by translations path and locale.
+ *
+ * Entries are released once no Translator instance caches translators parsed from them.
+ *
+ * @return The registry.
+ */
+auto Translator::get_registry() -> TranslationRegistry&
+{
+    static TranslationRegistry registry;
+    return registry;
+}
+
+/**
+ * @brief Returns how many locales are currently loaded, shared by all Translator instances.
+ *
+ * @return The number of locales whose .qm file contents are in use.
+ */
+auto Translator::get_shared_translation_count() -> qsizetype
+{
+    return get_registry().get_entry_count();
+}
+
+/**
+ * @brief Installs the result of an asynchronous load on the GUI thread.
+ *
+ * A result that arrives after a newer request is cached but not installed.
+ *
+ * @param load The finished request.
+ */
+auto Translator::finish_async_load(const AsyncLoad& load) -> void
+{
+    bool result = is_translation_cached(load.locale);
+
+    if (!result)
+    {
+        // Another instance may have read the locale meanwhile; its contents win
+        const std::shared_ptr<CachedTranslators> entry = create_translators(
+            load.locale, get_registry().insert(std::make_pair(load.path, load.locale),
+                                               load.watcher->result()));
+        result = entry != nullptr;
+
+        if (result)
+        {
+            m_cache.prepend(entry);
+        }
+    }
+
+    if (load.generation == m_async_generation)
     {
-        qApp->removeTranslator(&m_app_translator);
+        if (result)
+        {
+            m_cache.move(find_cached(load.locale), 0);
+            install_front_translators(load.locale);
+            emit translationLoadFinished(true);
+        }
+        else if (QLocale(QStringLiteral("en_EN")) != load.locale)
+        {
+            qDebug() << "Attempting to load the default translation asynchronously";
+            load_translation_async(QLocale(QStringLiteral("en_EN")));
+        }
+        else
+        {
+            emit translationLoadFinished(false);
+        }
+    }
+    else
+    {
+        trim_cache();
+    }
+}
+
+/**
+ * @brief Installs the most recently used cached translators and emits languageChanged.
+ *
+ * With staged retranslation, the application-wide event filter is installed first so that the
+ * LanguageChange events triggered by installTranslator() are held back and delivered in steps.
+ *
+ * @param locale The locale of the translators at the front of the cache.
+ */
+auto Translator::install_front_translators(const QLocale& locale) -> void
+{
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("translation", "Translator::install_front_translators");
+
+    if (m_staged_retranslation && !m_retranslation_filter_installed)
+    {
+        qApp->installEventFilter(this);
+        m_retranslation_filter_installed = true;
+    }
+
+    remove_none_empty_translators();
+
+    const CachedTranslators& entry = *m_cache.first();
+    m_qt_translator = entry.qt_translator;
+    m_app_translator = entry.app_translator;
+    m_installed_data = entry.data;
+    qApp->installTranslator(m_qt_translator.get());
+    qApp->installTranslator(m_app_translator.get());
+    m_current_locale = locale;
+    trim_cache();
+    emit languageChanged();
+
+    if (m_retranslation_filter_installed)
+    {
+        // Events sent during installTranslator() are pending now; posted ones arrive later
+        deliver_retranslation_step(false);
+    }
+}
+
+/**
+ * @brief Delivers held back LanguageChange events: all visible windows, else one hidden.
+ *
+ * Schedules the next step while the filter is installed. Only a scheduled step removes the
+ * filter, once nothing is pending, so events Qt posts during installTranslator() are still
+ * held back.
+ *
+ * @param allow_finish If true, the event filter is removed once nothing is pending.
+ */
+auto Translator::deliver_retranslation_step(bool allow_finish) -> void
+{
+    QList<QPointer<QWidget>> hidden;
+    bool delivered_visible = false;
+
+    while (!m_pending_retranslation.isEmpty())
+    {
+        const QPointer<QWidget> window = m_pending_retranslation.takeFirst();
+
+        if (!window.isNull() && window->isVisible())
+        {
+            deliver_retranslation(window);
+            delivered_visible = true;
+        }
+        else if (!window.isNull())
+        {
+            hidden.append(window);
+        }
+    }
+
+    m_pending_retranslation = hidden;
+
+    if (!delivered_visible && !m_pending_retranslation.isEmpty() && allow_finish)
+    {
+        deliver_retranslation(m_pending_retranslation.takeFirst());
+    }
+
+    if (allow_finish && m_pending_retranslation.isEmpty())
+    {
+        qApp->removeEventFilter(this);
+        m_retranslation_filter_installed = false;
+    }
+    else
+    {
+        QTimer::singleShot(0, this, [this]() { deliver_retranslation_step(true); });
+    }
+}
+
+/**
+ * @brief Sends one LanguageChange event to a window and its children.
+ * @param window The top-level window.
+ */
+auto Translator::deliver_retranslation(QWidget* window) -> void
+{
+    if (window != nullptr)
+    {
+        m_delivering_retranslation = true;
+        QEvent event(QEvent::LanguageChange);
+        QCoreApplication::sendEvent(window, &event);
+        m_delivering_retranslation = false;
+    }
+}
+
+/**
+ * @brief Releases least recently used translator pairs beyond the cache capacity.
+ *
+ * The installed translators are never released.
+ */
+auto Translator::trim_cache() -> void
+{
+    qsizetype index = m_cache.size() - 1;
+
+    while (m_cache.size() > m_cache_capacity && index >= 0)
+    {
+        if (m_cache[index]->qt_translator != m_qt_translator)
+        {
+            m_cache.removeAt(index);
+        }
+
+        --index;
     }
 }
 
 /**
  * @brief Loads the translations for the specified locale and filename into the given translator.
  *
+ * Only used for resource translation paths; catalogs on disk are read once into the shared
+ * registry by `read_translation_data()` instead. An uncompressed resource is loaded without a
+ * copy, a compressed one through its path.
+ *
  * @param locale The locale to load translations for.
  * @param filename The filename of the translation file.
  * @param translator The translator object to load the translations into.
@@ -217,7 +1048,25 @@ auto Translator::remove_none_empty_translators() -> void
 auto Translator::load(const QLocale& locale, const QString& filename,
                       QTranslator& translator) -> bool
 {
-    return translator.load(locale, filename, QStringLiteral("_"), m_translations_path);
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("translation", "Translator::load");
+
+    bool result = false;
+    const QString path = find_translation_file(locale, filename, m_translations_path);
+    const QResource resource(path);
+
+    if (!path.isEmpty() && resource.compressionAlgorithm() == QResource::NoCompression)
+    {
+        // Zero-copy: the translator reads the compiled-in or memory-mapped data directly;
+        // dependencies of a meta catalog are resolved next to it
+        result = translator.load(resource.data(), static_cast<int>(resource.size()),
+                                 QFileInfo(path).absolutePath());
+    }
+    else if (!path.isEmpty())
+    {
+        result = translator.load(path);
+    }
+
+    return result;
 }
 
 }  // namespace QtWidgetsCommonLib
@@ -0,0 +1,347 @@
+#include "QtWidgetsCommonLib/Utils/AbbreviatedNumberFormatter.h"
+
+#include <QDebug>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+
+#include "QtWidgetsCommonLib/Services/Translator.h"
+#include "QtWidgetsCommonLib/Utils/NumberFormatUtils.h"
+
+namespace QtWidgetsCommonLib
+{
+
+namespace
+{
+
+constexpr int kMaxDecimals = 6;
+
+/**
+ * @brief ASCII scratch buffer for the digits of any double.
+ */
+using DigitBuffer = std::array<char, NumberFormatUtils::kMaxAbbreviatedLength + kMaxDecimals>;
+
+/**
+ * @brief Copies the UTF-16 code units of a string.
+ * @param text The string to copy.
+ * @param out The destination.
+ * @return The position after the last written code unit.
+ */
+auto copy_units(const QString& text, char16_t* out) -> char16_t*
+{
+    const auto* units = reinterpret_cast<const char16_t*>(text.constData());
+
+    return std::copy(units, units + text.size(), out);
+}
+
+}  // namespace
+
+/**
+ * @brief Constructs a formatter.
+ * @param locale The locale providing decimal point, negative sign and digits.
+ * @param options The precision and suffix set.
+ * @param parent The parent QObject, or nullptr.
+ */
+AbbreviatedNumberFormatter::AbbreviatedNumberFormatter(const QLocale& locale,
+                                                       const AbbreviatedNumberOptions& options,
+                                                       QObject* parent)
+    : QObject(parent), m_locale(locale)
+{
+    rebuild_symbols();
+    set_options(options);
+}
+
+/**
+ * @brief Returns the options for K/M/B/T suffixes with base 1000.
+ * @return The metric options.
+ */
+auto AbbreviatedNumberFormatter::metric_options() -> AbbreviatedNumberOptions
+{
+    return AbbreviatedNumberOptions();
+}
+
+/**
+ * @brief Returns the options for binary byte units (B, KiB, MiB, ...) with base 1024.
+ * @return The byte options.
+ */
+auto AbbreviatedNumberFormatter::byte_options() -> AbbreviatedNumberOptions
+{
+    AbbreviatedNumberOptions options;
+    options.base = 1024.0;
+    options.suffixes = {QStringLiteral(" B"),   QStringLiteral(" KiB"), QStringLiteral(" MiB"),
+                        QStringLiteral(" GiB"), QStringLiteral(" TiB"), QStringLiteral(" PiB")};
+
+    return options;
+}
+
+/**
+ * @brief Formats a number.
+ *
+ * Allocates the result once with its final length.
+ *
+ * @param value The number to format.
+ * @return The abbreviated text.
+ */
+auto AbbreviatedNumberFormatter::format(double value) const -> QString
+{
+    DigitBuffer digits{};
+    int suffix_index = 0;
+    const qsizetype digit_count = to_digits(value, digits, suffix_index);
+    const std::span<const char> text(digits.data(), static_cast<std::size_t>(digit_count));
+    const bool negative = value < 0.0;
+
+    QString result(get_text_length(text, negative, suffix_index), Qt::Uninitialized);
+    write_text(text, negative, suffix_index, reinterpret_cast<char16_t*>(result.data()));
+
+    return result;
+}
+
+/**
+ * @brief Writes the abbreviation of a number into a caller-provided buffer.
+ * @param value The number to format.
+ * @param buffer The destination buffer.
+ * @return The number of code units written, or -1 if the buffer is too small.
+ */
+auto AbbreviatedNumberFormatter::format(double value, std::span<char16_t> buffer) const
+    -> qsizetype
+{
+    DigitBuffer digits{};
+    int suffix_index = 0;
+    const qsizetype digit_count = to_digits(value, digits, suffix_index);
+    const std::span<const char> text(digits.data(), static_cast<std::size_t>(digit_count));
+    const bool negative = value < 0.0;
+    qsizetype result = get_text_length(text, negative, suffix_index);
+
+    if (result <= static_cast<qsizetype>(buffer.size()))
+    {
+        write_text(text, negative, suffix_index, buffer.data());
+    }
+    else
+    {
+        result = -1;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Sets the locale and rebuilds the cached symbols.
+ * @param locale The new locale.
+ */
+auto AbbreviatedNumberFormatter::set_locale(const QLocale& locale) -> void
+{
+    if (locale != m_locale)
+    {
+        m_locale = locale;
+        rebuild_symbols();
+        emit formatChanged();
+    }
+}
+
+/**
+ * @brief Returns the locale.
+ * @return The current locale.
+ */
+auto AbbreviatedNumberFormatter::get_locale() const -> QLocale
+{
+    return m_locale;
+}
+
+/**
+ * @brief Sets the precision and suffix set and rebuilds the thresholds.
+ * @param options The new options.
+ */
+auto AbbreviatedNumberFormatter::set_options(const AbbreviatedNumberOptions& options) -> void
+{
+    m_options = options;
+    m_options.decimals = std::clamp(options.decimals, 0, kMaxDecimals);
+
+    if (!(options.base >= 2.0))
+    {
+        qWarning() << "[AbbreviatedNumberFormatter] Invalid base" << options.base
+                   << "- using 1000.";
+        m_options.base = 1000.0;
+    }
+
+    if (m_options.suffixes.isEmpty())
+    {
+        m_options.suffixes.append(QString());
+    }
+
+    m_thresholds.clear();
+    m_thresholds.reserve(m_options.suffixes.size());
+    double threshold = 1.0;
+
+    for (qsizetype i = 0; i < m_options.suffixes.size(); ++i)
+    {
+        m_thresholds.append(threshold);
+        threshold *= m_options.base;
+    }
+
+    emit formatChanged();
+}
+
+/**
+ * @brief Returns the precision and suffix set.
+ * @return The current options.
+ */
+auto AbbreviatedNumberFormatter::get_options() const -> AbbreviatedNumberOptions
+{
+    return m_options;
+}
+
+/**
+ * @brief Follows the language of a translator.
+ * @param translator The translator to follow, or nullptr.
+ */
+auto AbbreviatedNumberFormatter::follow_translator(Translator* translator) -> void
+{
+    disconnect(m_translator_connection);
+
+    if (translator != nullptr)
+    {
+        m_translator_connection =
+            connect(translator, &Translator::languageChanged, this, [this, translator]() {
+                set_locale(QLocale(translator->get_current_language_code()));
+            });
+        set_locale(QLocale(translator->get_current_language_code()));
+    }
+}
+
+/**
+ * @brief Recomputes the locale symbols from the current locale.
+ *
+ * Locales whose zero digit is outside the Basic Multilingual Plane keep ASCII digits.
+ */
+auto AbbreviatedNumberFormatter::rebuild_symbols() -> void
+{
+    const QString zero_digit = m_locale.zeroDigit();
+
+    m_negative_sign = m_locale.negativeSign();
+    m_decimal_point = m_locale.decimalPoint();
+    m_zero_digit = (zero_digit.size() == 1) ? zero_digit.front().unicode() : u'0';
+}
+
+/**
+ * @brief Writes the rounded absolute value in ASCII ('0'-'9', '.').
+ *
+ * Unscaled fractional values show up to `decimals` decimals without trailing zeros; scaled
+ * values below 10 show exactly `decimals` decimals, all others none.
+ *
+ * @param value The number to format.
+ * @param digits Receives the text.
+ * @param suffix_index Receives the index of the suffix to append.
+ * @return The length of the text.
+ */
+auto AbbreviatedNumberFormatter::to_digits(double value, std::span<char> digits,
+                                           int& suffix_index) const -> qsizetype
+{
+    const double abs_value = std::abs(value);
+    suffix_index = 0;
+
+    while (suffix_index + 1 < m_thresholds.size() && abs_value >= m_thresholds[suffix_index + 1])
+    {
+        ++suffix_index;
+    }
+
+    const double scaled = abs_value / m_thresholds[suffix_index];
+    int decimals = 0;
+
+    if (suffix_index == 0)
+    {
+        decimals = (scaled != std::trunc(scaled)) ? m_options.decimals : 0;
+    }
+    else
+    {
+        decimals = (scaled < 10.0) ? m_options.decimals : 0;
+    }
+
+    const std::to_chars_result converted = std::to_chars(
+        digits.data(), digits.data() + digits.size(), scaled, std::chars_format::fixed, decimals);
+    qsizetype result = (converted.ec == std::errc()) ? converted.ptr - digits.data() : 0;
+
+    // Rounding can leave trailing zeros (e.g. 999.96 -> "1000.0"); only unscaled values drop them
+    if (suffix_index == 0 && decimals > 0)
+    {
+        while (result > 0 && digits[result - 1] == '0')
+        {
+            --result;
+        }
+
+        if (result > 0 && digits[result - 1] == '.')
+        {
+            --result;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns the length of the localized text.
+ * @param digits The ASCII text from `to_digits()`.
+ * @param negative Whether the value is negative.
+ * @param suffix_index The suffix index from `to_digits()`.
+ * @return The number of UTF-16 code units.
+ */
+auto AbbreviatedNumberFormatter::get_text_length(std::span<const char> digits, bool negative,
+                                                 int suffix_index) const -> qsizetype
+{
+    qsizetype result =
+        static_cast<qsizetype>(digits.size()) + m_options.suffixes[suffix_index].size();
+
+    if (negative)
+    {
+        result += m_negative_sign.size();
+    }
+
+    for (const char c: digits)
+    {
+        if (c == '.')
+        {
+            result += m_decimal_point.size() - 1;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Writes the localized text.
+ * @param digits The ASCII text from `to_digits()`.
+ * @param negative Whether the value is negative.
+ * @param suffix_index The suffix index from `to_digits()`.
+ * @param out The destination, at least `get_text_length()` code units long.
+ */
+auto AbbreviatedNumberFormatter::write_text(std::span<const char> digits, bool negative,
+                                            int suffix_index, char16_t* out) const -> void
+{
+    char16_t* cursor = out;
+
+    if (negative)
+    {
+        cursor = copy_units(m_negative_sign, cursor);
+    }
+
+    for (const char c: digits)
+    {
+        if (c == '.')
+        {
+            cursor = copy_units(m_decimal_point, cursor);
+        }
+        else if (c >= '0' && c <= '9')
+        {
+            *cursor++ = static_cast<char16_t>(m_zero_digit + (c - '0'));
+        }
+        else
+        {
+            // "inf" and "nan" stay ASCII
+            *cursor++ = static_cast<char16_t>(c);
+        }
+    }
+
+    copy_units(m_options.suffixes[suffix_index], cursor);
+}
+
+}  // namespace QtWidgetsCommonLib
@@ -0,0 +1,640 @@
+#include "QtWidgetsCommonLib/Utils/CompiledStylesheet.h"
+
+#include <QRegularExpression>
+#include <QSet>
+#include <QStringView>
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+
+/**
+ * @brief Returns whether the character may appear in a variable name (`[A-Za-z0-9_-]`).
+ * @param c The character to test.
+ * @return true if the character is part of a variable name, false otherwise.
+ */
+[[nodiscard]] auto is_variable_name_char(QChar c) -> bool
+{
+    const char16_t u = c.unicode();
+    const bool result = (u >= u'a' && u <= u'z') || (u >= u'A' && u <= u'Z') ||
+                        (u >= u'0' && u <= u'9') || u == u'_' || u == u'-';
+    return result;
+}
+
+/**
+ * @brief Text split at its `@name` references.
+ *
+ * `literals` always holds one more element than `references`; the text is
+ * `literals[0] + value(references[0]) + literals[1] + ...`. `positions` holds the offset of
+ * each reference's '@' in the text.
+ */
+struct reference_template {
+        QStringList literals;
+        QStringList references;
+        QList<qsizetype> positions;
+};
+
+/**
+ * @brief Splits a text into literal segments and `@name` references in a single scan.
+ *
+ * A reference is `@` followed by the maximal run of name characters, so names only match
+ * exactly (e.g. `@Color` is never found inside `@ColorExtra`).
+ *
+ * @param text The text to split.
+ * @return The literal segments and the referenced names (without '@').
+ */
+[[nodiscard]] auto split_references(const QString& text) -> reference_template
+{
+    reference_template result;
+    const QChar* data = text.constData();
+    const qsizetype length = text.size();
+
+    qsizetype literal_start = 0;
+    qsizetype pos = 0;
+
+    while (pos < length)
+    {
+        qsizetype next_pos = pos + 1;
+
+        if (data[pos] == u'@')
+        {
+            qsizetype name_end = pos + 1;
+
+            while (name_end < length && is_variable_name_char(data[name_end]))
+            {
+                ++name_end;
+            }
+
+            if (name_end > pos + 1)
+            {
+                result.literals.append(text.mid(literal_start, pos - literal_start));
+                result.references.append(text.mid(pos + 1, name_end - pos - 1));
+                result.positions.append(pos);
+                literal_start = name_end;
+                next_pos = name_end;
+            }
+        }
+
+        pos = next_pos;
+    }
+
+    result.literals.append(text.mid(literal_start));
+    return result;
+}
+
+/**
+ * @brief Per-variable state of the iterative Tarjan traversal.
+ */
+struct tarjan_frame {
+        QString name;
+        qsizetype next_reference = 0;
+};
+
+}  // namespace
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @brief Parses the raw stylesheet into variable tables and a slot template.
+ *
+ * All @Variables blocks are matched in a single scan. The first unnamed block becomes the
+ * default table; the first block of each named theme is merged over the defaults. Blocks with an
+ * empty name are ignored. The text outside the blocks is compiled into the slot template.
+ *
+ * @param raw_stylesheet The raw QSS input including @Variables blocks.
+ */
+CompiledStylesheet::CompiledStylesheet(const QString& raw_stylesheet): m_source(raw_stylesheet)
+{
+    static const QRegularExpression block_regex(
+        R"(@Variables(?:\[Name="([^"]*)"\])?\s*\{([\s\S]*?)\})",
+        QRegularExpression::DotMatchesEverythingOption);
+    static const QRegularExpression default_marker_regex(R"(@Variables\s*\{)");
+
+    m_named_themes = parse_named_themes(m_source);
+    m_has_default_marker = default_marker_regex.match(m_source).hasMatch();
+    update_available_themes();
+
+    QHash<QString, QString> theme_blocks;
+    QString body;
+    body.reserve(m_source.size());
+    QList<std::pair<qsizetype, qsizetype>> body_to_source;
+
+    qsizetype body_start = 0;
+    QRegularExpressionMatchIterator it = block_regex.globalMatch(m_source);
+
+    while (it.hasNext())
+    {
+        const QRegularExpressionMatch match = it.next();
+        const bool is_named = match.capturedStart(1) >= 0;
+        const QString name = match.captured(1);
+
+        if (!is_named && !m_has_default_block)
+        {
+            parse_variables_block(match.captured(2), m_default_variables);
+            m_has_default_block = true;
+        }
+        else if (is_named && !name.isEmpty() && !theme_blocks.contains(name))
+        {
+            theme_blocks.insert(name, match.captured(2));
+        }
+
+        body_to_source.append({body.size(), body_start});
+        body.append(QStringView(m_source).mid(body_start, match.capturedStart() - body_start));
+        body_start = match.capturedEnd();
+    }
+
+    body_to_source.append({body.size(), body_start});
+    body.append(QStringView(m_source).mid(body_start));
+
+    for (auto block = theme_blocks.cbegin(); block != theme_blocks.cend(); ++block)
+    {
+        QMap<QString, QString> overrides;
+        parse_variables_block(block.value(), overrides);
+        m_theme_overrides.insert(block.key(), overrides);
+    }
+
+    update_theme_variables();
+    compile_template(body, body_to_source);
+}
+
+/**
+ * @brief Joins several compiled stylesheets into one, as if their sources were concatenated.
+ *
+ * Works on the compiled form only: variable tables are merged with the same first-block-wins
+ * rules as a single source, and the slot templates are appended with their slot names remapped,
+ * so no part is scanned again.
+ *
+ * Slot lines are shifted by the lines of the preceding parts. When an origin is given for every
+ * part, they are shifted to the part's first line in its file instead and tagged with the file.
+ *
+ * @param parts The compiled parts in source order.
+ * @param origins The origin of each part, or empty.
+ * @return The compiled stylesheet of the concatenated sources.
+ */
+auto CompiledStylesheet::concatenate(const QList<CompiledStylesheet>& parts,
+                                     const QList<SourceOrigin>& origins) -> CompiledStylesheet
+{
+    CompiledStylesheet result;
+    const bool has_origins = (origins.size() == parts.size());
+    int line_offset = 0;
+
+    for (qsizetype index = 0; index < parts.size(); ++index)
+    {
+        const CompiledStylesheet& part = parts.at(index);
+        const int slot_line_offset = has_origins ? origins.at(index).first_line - 1 : line_offset;
+        result.m_source += part.m_source;
+        result.m_named_themes += part.m_named_themes;
+        result.m_has_default_marker = result.m_has_default_marker || part.m_has_default_marker;
+
+        if (!result.m_has_default_block && part.m_has_default_block)
+        {
+            result.m_default_variables = part.m_default_variables;
+            result.m_has_default_block = true;
+        }
+
+        for (auto block = part.m_theme_overrides.cbegin(); block != part.m_theme_overrides.cend();
+             ++block)
+        {
+            if (!result.m_theme_overrides.contains(block.key()))
+            {
+                result.m_theme_overrides.insert(block.key(), block.value());
+            }
+        }
+
+        if (!part.m_segments.isEmpty())
+        {
+            // The last literal of the result and the first literal of the part are adjacent text
+            if (result.m_segments.isEmpty())
+            {
+                result.m_segments.append(QString());
+            }
+
+            result.m_segments.last() += part.m_segments.first();
+
+            for (qsizetype i = 0; i < part.m_slot_refs.size(); ++i)
+            {
+                const QString& name = part.m_slot_names.at(part.m_slot_refs.at(i));
+                result.m_slot_refs.append(result.add_slot_name(name));
+                result.m_slot_lines.append(part.m_slot_lines.at(i) + slot_line_offset);
+                result.m_slot_files.append(has_origins ? origins.at(index).file
+                                                       : part.m_slot_files.at(i));
+                result.m_segments.append(part.m_segments.at(i + 1));
+            }
+
+            result.m_literal_length += part.m_literal_length;
+        }
+
+        line_offset += static_cast<int>(part.m_source.count(QLatin1Char('\n')));
+    }
+
+    result.m_named_themes.removeDuplicates();
+    result.update_available_themes();
+    result.update_theme_variables();
+    return result;
+}
+
+/**
+ * @brief Returns whether no source has been compiled.
+ * @return true if the source text is empty, false otherwise.
+ */
+auto CompiledStylesheet::is_empty() const -> bool
+{
+    return m_source.isEmpty();
+}
+
+/**
+ * @brief Returns the raw source text this template was compiled from.
+ * @return The raw QSS input.
+ */
+auto CompiledStylesheet::get_source() const -> const QString&
+{
+    return m_source;
+}
+
+/**
+ * @brief Returns the theme names declared in the source ("Default" for an unnamed block).
+ * @return A QStringList of theme names.
+ */
+auto CompiledStylesheet::get_available_themes() const -> QStringList
+{
+    return m_available_themes;
+}
+
+/**
+ * @brief Returns the unresolved variables for a theme (default block overridden by the theme).
+ * @param theme_name The theme name, or empty for the default block.
+ * @return A QMap of variable name to raw (unresolved) value.
+ */
+auto CompiledStylesheet::get_theme_variables(const QString& theme_name) const
+    -> QMap<QString, QString>
+{
+    return m_theme_variables.value(theme_name, m_default_variables);
+}
+
+/**
+ * @brief Returns the distinct variable names referenced by the stylesheet body.
+ * @return A QStringList of variable names (without '@') in order of first use.
+ */
+auto CompiledStylesheet::get_slot_names() const -> const QStringList&
+{
+    return m_slot_names;
+}
+
+/**
+ * @brief Returns whether the stylesheet body references a variable.
+ * @param name The variable name (without '@').
+ * @return true if at least one slot uses the variable, false otherwise.
+ */
+auto CompiledStylesheet::references_variable(const QString& name) const -> bool
+{
+    return m_slot_name_indices.contains(name);
+}
+
+/**
+ * @brief Renders the stylesheet body by filling every slot with its variable value.
+ *
+ * Each distinct name is looked up once; the output is sized exactly before the segments and
+ * values are appended, so rendering is a single allocation plus copies. Unresolved slots are
+ * collected while the segments are joined, with the source file and line recorded at compile
+ * time.
+ *
+ * @param variables The variable values to insert.
+ * @param unresolved If not nullptr, receives every slot without a value, in source order.
+ * @return The final stylesheet text without @Variables blocks.
+ */
+auto CompiledStylesheet::render(const QMap<QString, QString>& variables,
+                                QList<UnresolvedVariable>* unresolved) const -> QString
+{
+    QStringList slot_values;
+    QList<bool> slot_missing;
+    slot_values.reserve(m_slot_names.size());
+    slot_missing.reserve(m_slot_names.size());
+
+    for (const QString& name: m_slot_names)
+    {
+        const auto found = variables.constFind(name);
+        const bool missing = (found == variables.cend());
+        slot_values.append(missing ? QStringLiteral("@") + name : found.value());
+        slot_missing.append(missing);
+    }
+
+    if (unresolved != nullptr)
+    {
+        unresolved->clear();
+    }
+
+    qsizetype total_length = m_literal_length;
+
+    for (const qsizetype ref: m_slot_refs)
+    {
+        total_length += slot_values.at(ref).size();
+    }
+
+    QString result;
+    result.reserve(total_length);
+
+    for (qsizetype i = 0; i < m_slot_refs.size(); ++i)
+    {
+        const qsizetype ref = m_slot_refs.at(i);
+        result.append(m_segments.at(i));
+        result.append(slot_values.at(ref));
+
+        if (unresolved != nullptr && slot_missing.at(ref))
+        {
+            unresolved->append({m_slot_names.at(ref), m_slot_lines.at(i), m_slot_files.at(i)});
+        }
+    }
+
+    if (!m_segments.isEmpty())
+    {
+        result.append(m_segments.last());
+    }
+
+    return result;
+}
+
+/**
+ * @brief Splits the stylesheet body into literal segments and variable slots.
+ *
+ * Scans the body once from left to right. Every `@name` token (name characters are
+ * `[A-Za-z0-9_-]`) becomes a slot referring to its distinct name, so a slot only ever matches a
+ * variable with exactly the same name (e.g. `@Color` never matches inside `@ColorExtra`). The
+ * text between tokens is stored as literal segments; there is always one more segment than slots.
+ *
+ * The source line of every slot is recorded for diagnostics. Slot offsets in the body are mapped
+ * back to the source through the piece offsets, and newlines are counted incrementally, so the
+ * source is scanned at most once.
+ *
+ * @param body The stylesheet text with all @Variables blocks removed.
+ * @param body_to_source Start offsets (body, source) of the body pieces, ascending.
+ */
+auto CompiledStylesheet::compile_template(
+    const QString& body, const QList<std::pair<qsizetype, qsizetype>>& body_to_source) -> void
+{
+    reference_template split = split_references(body);
+    m_slot_refs.reserve(split.references.size());
+    m_slot_lines.reserve(split.references.size());
+    m_slot_files.fill(QString(), split.references.size());
+
+    qsizetype piece = 0;
+    qsizetype counted_until = 0;
+    int line = 1;
+
+    for (qsizetype i = 0; i < split.references.size(); ++i)
+    {
+        const qsizetype position = split.positions.at(i);
+
+        while (piece + 1 < body_to_source.size() && body_to_source.at(piece + 1).first <= position)
+        {
+            ++piece;
+        }
+
+        const qsizetype source_position =
+            body_to_source.at(piece).second + (position - body_to_source.at(piece).first);
+        line += static_cast<int>(
+            QStringView(m_source).mid(counted_until, source_position - counted_until).count(u'\n'));
+        counted_until = source_position;
+
+        m_slot_refs.append(add_slot_name(split.references.at(i)));
+        m_slot_lines.append(line);
+    }
+
+    m_segments = std::move(split.literals);
+
+    for (const QString& segment: m_segments)
+    {
+        m_literal_length += segment.size();
+    }
+}
+
+/**
+ * @brief Returns the slot name index of a variable, registering the name on first use.
+ * @param name The variable name (without '@').
+ * @return The index into the distinct slot names.
+ */
+auto CompiledStylesheet::add_slot_name(const QString& name) -> qsizetype
+{
+    auto index = m_slot_name_indices.constFind(name);
+
+    if (index == m_slot_name_indices.cend())
+    {
+        index = m_slot_name_indices.insert(name, m_slot_names.size());
+        m_slot_names.append(name);
+    }
+
+    return index.value();
+}
+
+/**
+ * @brief Rebuilds the available theme list from the named themes and the default marker.
+ */
+auto CompiledStylesheet::update_available_themes() -> void
+{
+    m_available_themes = m_named_themes;
+
+    // Fallback: Add "Default" if there is an ungrouped @Variables block
+    if (m_has_default_marker)
+    {
+        m_available_themes << "Default";
+    }
+
+    m_available_themes.removeDuplicates();
+}
+
+/**
+ * @brief Rebuilds the per-theme variable tables (defaults overridden by each theme block).
+ */
+auto CompiledStylesheet::update_theme_variables() -> void
+{
+    m_theme_variables.clear();
+
+    for (auto block = m_theme_overrides.cbegin(); block != m_theme_overrides.cend(); ++block)
+    {
+        QMap<QString, QString> variables = m_default_variables;
+        variables.insert(block.value());
+        m_theme_variables.insert(block.key(), variables);
+    }
+}
+
+/**
+ * @brief Resolves references between variables (e.g. `@Accent: @ColorPrimary;`).
+ *
+ * Iterative Tarjan strongly-connected-components traversal over the reference graph, using an
+ * explicit call stack so deep chains cannot overflow the native stack. Components are completed
+ * in reverse topological order, i.e. every dependency of a variable is resolved before the
+ * variable itself, so each value is computed exactly once by joining its literal segments with
+ * the already resolved values of its references. Components with more than one variable, or a
+ * variable referencing itself, form a cycle: their members resolve to an empty string.
+ *
+ * @param variables The raw variable values, possibly referencing each other.
+ * @return The resolved values and diagnostics.
+ */
+auto CompiledStylesheet::resolve_variables(const QMap<QString, QString>& variables)
+    -> VariableResolution
+{
+    VariableResolution result;
+    QHash<QString, reference_template> templates;
+    templates.reserve(variables.size());
+
+    for (auto it = variables.cbegin(); it != variables.cend(); ++it)
+    {
+        templates.insert(it.key(), split_references(it.value()));
+    }
+
+    QHash<QString, int> indices;
+    QHash<QString, int> low_links;
+    QSet<QString> on_stack;
+    QSet<QString> undefined;
+    QStringList component_stack;
+    QList<tarjan_frame> call_stack;
+    int next_index = 0;
+
+    const auto visit = [&](const QString& name) {
+        indices.insert(name, next_index);
+        low_links.insert(name, next_index);
+        ++next_index;
+        component_stack.append(name);
+        on_stack.insert(name);
+        call_stack.append(tarjan_frame {name, 0});
+    };
+
+    for (auto root = variables.cbegin(); root != variables.cend(); ++root)
+    {
+        if (!indices.contains(root.key()))
+        {
+            visit(root.key());
+        }
+
+        while (!call_stack.isEmpty())
+        {
+            tarjan_frame& frame = call_stack.last();
+            const reference_template& current = *templates.constFind(frame.name);
+
+            if (frame.next_reference < current.references.size())
+            {
+                const QString reference = current.references.at(frame.next_reference);
+                ++frame.next_reference;
+
+                if (!templates.contains(reference))
+                {
+                    undefined.insert(reference);
+                }
+                else if (!indices.contains(reference))
+                {
+                    visit(reference);
+                }
+                else if (on_stack.contains(reference))
+                {
+                    low_links[frame.name] =
+                        qMin(low_links.value(frame.name), indices.value(reference));
+                }
+            }
+            else
+            {
+                const QString name = frame.name;
+                call_stack.removeLast();
+
+                if (low_links.value(name) == indices.value(name))
+                {
+                    QStringList component;
+                    QString member;
+
+                    do
+                    {
+                        member = component_stack.takeLast();
+                        on_stack.remove(member);
+                        component.append(member);
+                    } while (member != name);
+
+                    const bool is_cycle = component.size() > 1 || current.references.contains(name);
+
+                    if (is_cycle)
+                    {
+                        for (const QString& cyclic: component)
+                        {
+                            result.values.insert(cyclic, QString());
+                        }
+
+                        component.sort();
+                        result.cycles.append(component);
+                    }
+                    else
+                    {
+                        QString value = current.literals.first();
+
+                        for (qsizetype i = 0; i < current.references.size(); ++i)
+                        {
+                            value += result.values.value(current.references.at(i));
+                            value += current.literals.at(i + 1);
+                        }
+
+                        result.values.insert(name, value);
+                    }
+                }
+
+                if (!call_stack.isEmpty())
+                {
+                    const QString& parent = call_stack.last().name;
+                    low_links[parent] = qMin(low_links.value(parent), low_links.value(name));
+                }
+            }
+        }
+    }
+
+    std::sort(result.cycles.begin(), result.cycles.end(),
+              [](const QStringList& a, const QStringList& b) { return a.first() < b.first(); });
+
+    result.undefined_references = QStringList(undefined.cbegin(), undefined.cend());
+    result.undefined_references.sort();
+    return result;
+}
+
+/**
+ * @brief Parses variables from a variables block and fills the variables map.
+ * @param variables_block The content of the variables block.
+ * @param variables The map to fill with variable name/value pairs.
+ */
+void CompiledStylesheet::parse_variables_block(const QString& variables_block,
+                                               QMap<QString, QString>& variables)
+{
+    static const QRegularExpression var_regex(R"(@([A-Za-z0-9_\-]+)\s*:\s*([^;]+);)");
+    QRegularExpressionMatchIterator match_iterator = var_regex.globalMatch(variables_block);
+
+    while (match_iterator.hasNext())
+    {
+        QRegularExpressionMatch match = match_iterator.next();
+        QString name = match.captured(1);
+        QString value = match.captured(2).trimmed();
+        variables[name] = value;
+    }
+}
+
+/**
+ * @brief Parses the names of all named @Variables blocks from the raw stylesheet.
+ * @param stylesheet The raw QSS stylesheet.
+ * @return A QStringList of distinct theme names in order of first appearance.
+ */
+auto CompiledStylesheet::parse_named_themes(const QString& stylesheet) -> QStringList
+{
+    QStringList themes;
+    static const QRegularExpression theme_regex("@Variables\\[Name=\"([^\"]+)\"\\]");
+    QRegularExpressionMatchIterator it = theme_regex.globalMatch(stylesheet);
+
+    while (it.hasNext())
+    {
+        QRegularExpressionMatch match = it.next();
+        QString theme = match.captured(1);
+
+        if (!theme.isEmpty())
+        {
+            themes << theme;
+        }
+    }
+
+    themes.removeDuplicates();
+    return themes;
+}
+
+}  // namespace QtWidgetsCommonLib
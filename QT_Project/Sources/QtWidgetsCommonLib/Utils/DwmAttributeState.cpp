@@ -0,0 +1,96 @@
+#include "QtWidgetsCommonLib/Utils/DwmAttributeState.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @brief Returns whether any attribute changed.
+ * @return true if at least one attribute has to be applied.
+ */
+auto DwmAttributeState::Changes::any() const -> bool
+{
+    return frame || corner_preference || dark_mode || backdrop;
+}
+
+/**
+ * @brief Sets the desired attributes.
+ * @param attributes The values to apply with the next update.
+ */
+auto DwmAttributeState::set_desired(const Attributes& attributes) -> void
+{
+    m_desired = attributes;
+}
+
+/**
+ * @brief Returns the desired attributes.
+ * @return The values the next update applies.
+ */
+auto DwmAttributeState::get_desired() const -> Attributes
+{
+    return m_desired;
+}
+
+/**
+ * @brief Returns the last applied attributes.
+ * @return The snapshot, or std::nullopt if nothing was applied since the last invalidate.
+ */
+auto DwmAttributeState::get_applied() const -> std::optional<Attributes>
+{
+    return m_applied;
+}
+
+/**
+ * @brief Returns the attributes that have to be applied.
+ * @return Every attribute after `invalidate()`, otherwise only the changed ones.
+ */
+auto DwmAttributeState::get_pending_changes() const -> Changes
+{
+    Changes result;
+
+    if (m_applied.has_value())
+    {
+        result.frame = m_applied->extend_frame != m_desired.extend_frame;
+        result.corner_preference = m_applied->rounded_corners != m_desired.rounded_corners;
+        result.dark_mode = m_applied->dark_mode != m_desired.dark_mode;
+        result.backdrop = m_applied->mica != m_desired.mica;
+    }
+    else
+    {
+        result.frame = true;
+        result.corner_preference = true;
+        result.dark_mode = true;
+        result.backdrop = true;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Records the desired attributes as applied.
+ * @param changes The attributes that were applied.
+ */
+auto DwmAttributeState::mark_applied(const Changes& changes) -> void
+{
+    m_applied = m_desired;
+    m_applied_count += (changes.frame ? 1 : 0) + (changes.corner_preference ? 1 : 0) +
+                       (changes.dark_mode ? 1 : 0) + (changes.backdrop ? 1 : 0);
+}
+
+/**
+ * @brief Forgets the applied snapshot, so the next update applies every attribute.
+ */
+auto DwmAttributeState::invalidate() -> void
+{
+    m_applied.reset();
+}
+
+/**
+ * @brief Returns how many attributes were applied since construction.
+ * @return The number of applied attributes.
+ */
+auto DwmAttributeState::get_applied_count() const -> qint64
+{
+    return m_applied_count;
+}
+
+}  // namespace QtWidgetsCommonLib
@@ -0,0 +1,148 @@
+#include "QtWidgetsCommonLib/Utils/HitTestRegionMap.h"
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @brief Replaces all regions.
+ * @param window_size The size of the window.
+ * @param resize_border The thickness of the resize borders; 0 or less disables resizing.
+ * @param caption_rect The caption (title bar) area.
+ * @param interactive_rects Areas inside the caption that must stay client area.
+ */
+auto HitTestRegionMap::update(const QSize& window_size, int resize_border,
+                              const QRect& caption_rect, const QList<QRect>& interactive_rects)
+    -> void
+{
+    m_width = window_size.width();
+    m_height = window_size.height();
+    m_resize_border = resize_border;
+    m_caption_rect = caption_rect;
+    m_interactive_rects.clear();
+    m_interactive_rects.reserve(interactive_rects.size());
+
+    // Interactive areas outside the caption can never decide a hit test
+    for (const QRect& rect: interactive_rects)
+    {
+        const QRect clipped = rect.intersected(caption_rect);
+
+        if (!clipped.isEmpty())
+        {
+            m_interactive_rects.append(clipped);
+        }
+    }
+
+    m_valid = true;
+}
+
+/**
+ * @brief Marks the map as outdated; the owner rebuilds it before the next hit test.
+ */
+auto HitTestRegionMap::invalidate() -> void
+{
+    m_valid = false;
+}
+
+/**
+ * @brief Returns whether the map reflects the current window state.
+ * @return true after update() and until invalidate().
+ */
+auto HitTestRegionMap::is_valid() const -> bool
+{
+    return m_valid;
+}
+
+/**
+ * @brief Returns the region at a point.
+ *
+ * Resize borders win over everything; only points inside the caption that are not over an
+ * interactive rectangle are Caption.
+ *
+ * @param pos The point, relative to the window's top-left corner.
+ * @return The region under the point.
+ */
+auto HitTestRegionMap::hit_test(const QPoint& pos) const -> Region
+{
+    Region result = resize_region(pos);
+
+    if (result == Region::Client && m_caption_rect.contains(pos))
+    {
+        bool over_interactive = false;
+
+        for (qsizetype i = 0; i < m_interactive_rects.size() && !over_interactive; ++i)
+        {
+            over_interactive = m_interactive_rects[i].contains(pos);
+        }
+
+        if (!over_interactive)
+        {
+            result = Region::Caption;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns the number of interactive rectangles in the map.
+ * @return The interactive rectangle count.
+ */
+auto HitTestRegionMap::get_interactive_rect_count() const -> int
+{
+    return static_cast<int>(m_interactive_rects.size());
+}
+
+/**
+ * @brief Returns the resize region at a point, or Client when not on a border.
+ * @param pos The point, relative to the window's top-left corner.
+ * @return The resize region, or Region::Client.
+ */
+auto HitTestRegionMap::resize_region(const QPoint& pos) const -> Region
+{
+    Region result = Region::Client;
+
+    if (m_resize_border > 0)
+    {
+        const bool on_left = pos.x() < m_resize_border;
+        const bool on_right = pos.x() >= m_width - m_resize_border;
+        const bool on_top = pos.y() < m_resize_border;
+        const bool on_bottom = pos.y() >= m_height - m_resize_border;
+
+        if (on_left && on_top)
+        {
+            result = Region::TopLeft;
+        }
+        else if (on_right && on_top)
+        {
+            result = Region::TopRight;
+        }
+        else if (on_left && on_bottom)
+        {
+            result = Region::BottomLeft;
+        }
+        else if (on_right && on_bottom)
+        {
+            result = Region::BottomRight;
+        }
+        else if (on_top)
+        {
+            result = Region::Top;
+        }
+        else if (on_bottom)
+        {
+            result = Region::Bottom;
+        }
+        else if (on_left)
+        {
+            result = Region::Left;
+        }
+        else if (on_right)
+        {
+            result = Region::Right;
+        }
+    }
+
+    return result;
+}
+
+}  // namespace QtWidgetsCommonLib
@@ -0,0 +1,317 @@
+#include "QtWidgetsCommonLib/Utils/NativeIconCache.h"
+
+#include <QImage>
+#include <QSize>
+#include <algorithm>
+#include <utility>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+namespace
+{
+
+#ifdef Q_OS_WIN
+/**
+ * @brief Convert QPixmap to HICON.
+ *
+ * Creates a 32bpp ARGB HICON from a QPixmap by creating a DIB section,
+ * copying pixels (BGRA) and constructing an ICON via CreateIconIndirect.
+ *
+ * @param pixmap Source pixmap.
+ * @return HICON HICON handle (or nullptr on failure).
+ */
+auto create_hicon_from_pixmap(const QPixmap& pixmap) -> HICON
+{
+    HICON h_icon = nullptr;
+
+    if (!pixmap.isNull())
+    {
+        QImage image = pixmap.toImage().convertToFormat(QImage::Format_ARGB32);
+        const int width = image.width();
+        const int height = image.height();
+
+        // Prepare BITMAPV5HEADER for 32bpp RGBA
+        BITMAPV5HEADER bi{};
+        bi.bV5Size = sizeof(BITMAPV5HEADER);
+        bi.bV5Width = width;
+        bi.bV5Height = -height;  // top-down
+        bi.bV5Planes = 1;
+        bi.bV5BitCount = 32;
+        bi.bV5Compression = BI_BITFIELDS;
+        bi.bV5RedMask = 0x00FF0000;
+        bi.bV5GreenMask = 0x0000FF00;
+        bi.bV5BlueMask = 0x000000FF;
+        bi.bV5AlphaMask = 0xFF000000;
+
+        void* pv_bits = nullptr;
+        HBITMAP h_bitmap = nullptr;
+        HBITMAP h_mask = nullptr;
+
+        HDC screen_dc = GetDC(nullptr);
+
+        h_bitmap = CreateDIBSection(screen_dc, reinterpret_cast<BITMAPINFO*>(&bi), DIB_RGB_COLORS,
+                                    &pv_bits, nullptr, 0);
+
+        ReleaseDC(nullptr, screen_dc);
+
+        if (h_bitmap && pv_bits)
+        {
+            // copy pixels (BGRA)
+            const uint8_t* src_pixels = image.constBits();
+            const int src_stride = image.bytesPerLine();
+            const int dst_stride = width * 4;
+
+            for (int y = 0; y < height; ++y)
+            {
+                uint8_t* dest_row = reinterpret_cast<uint8_t*>(pv_bits) + y * dst_stride;
+                const uint8_t* src_row = src_pixels + y * src_stride;
+
+                for (int x = 0; x < width; ++x)
+                {
+                    const QRgb px = reinterpret_cast<const QRgb*>(src_row)[x];
+                    dest_row[x * 4 + 0] = qBlue(px);
+                    dest_row[x * 4 + 1] = qGreen(px);
+                    dest_row[x * 4 + 2] = qRed(px);
+                    dest_row[x * 4 + 3] = qAlpha(px);
+                }
+            }
+
+            // Create an empty monochrome mask bitmap
+            h_mask = CreateBitmap(width, height, 1, 1, nullptr);
+
+            if (h_mask)
+            {
+                ICONINFO ii{};
+                ii.fIcon = TRUE;
+                ii.hbmMask = h_mask;
+                ii.hbmColor = h_bitmap;
+
+                h_icon = CreateIconIndirect(&ii);
+            }
+
+            // system makes copies; safe to delete bitmaps now
+            if (h_bitmap)
+            {
+                DeleteObject(h_bitmap);
+            }
+
+            if (h_mask)
+            {
+                DeleteObject(h_mask);
+            }
+        }
+    }
+
+    return h_icon;
+}
+#endif  // Q_OS_WIN
+
+/**
+ * @brief Builds the key of a cache entry.
+ * @param icon The icon.
+ * @param size The icon size in physical pixels.
+ * @param dpi The DPI.
+ * @return The entry key.
+ */
+auto entry_key(const QIcon& icon, int size, int dpi) -> QString
+{
+    return QStringLiteral("%1@%2@%3").arg(icon.cacheKey()).arg(size).arg(dpi);
+}
+
+}  // namespace
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @brief Constructs a cache.
+ * @param create_function Creates the handles.
+ * @param destroy_function Destroys the handles.
+ */
+NativeIconCache::NativeIconCache(CreateFunction create_function,
+                                 DestroyFunction destroy_function)
+    : m_create_function(std::move(create_function)),
+      m_destroy_function(std::move(destroy_function))
+{
+}
+
+/**
+ * @brief Destroys all cached handles, including referenced ones.
+ */
+NativeIconCache::~NativeIconCache()
+{
+    for (const Entry& entry: std::as_const(m_entries))
+    {
+        if (m_destroy_function)
+        {
+            m_destroy_function(entry.handle);
+        }
+    }
+}
+
+/**
+ * @brief Returns the process-wide cache using the platform's native icon functions.
+ * @return The shared cache.
+ */
+auto NativeIconCache::shared() -> NativeIconCache&
+{
+#ifdef Q_OS_WIN
+    static NativeIconCache cache(
+        [](const QPixmap& pixmap) -> Handle { return create_hicon_from_pixmap(pixmap); },
+        [](Handle handle) { DestroyIcon(static_cast<HICON>(handle)); });
+#else
+    static NativeIconCache cache([](const QPixmap&) -> Handle { return nullptr; },
+                                 [](Handle) {});
+#endif
+
+    return cache;
+}
+
+/**
+ * @brief Returns the handle of an icon, creating it on a miss, and adds a reference.
+ * @param icon The icon.
+ * @param size The icon size in physical pixels (square).
+ * @param dpi The DPI the handle is created for.
+ * @return The handle, or nullptr if the icon is null or no handle could be created.
+ */
+auto NativeIconCache::acquire(const QIcon& icon, int size, int dpi) -> Handle
+{
+    Handle result = nullptr;
+
+    if (!icon.isNull() && size > 0)
+    {
+        const QString key = entry_key(icon, size, dpi);
+        auto it = m_entries.find(key);
+
+        if (it != m_entries.end())
+        {
+            if (it->references == 0)
+            {
+                m_unused.removeOne(key);
+            }
+
+            ++it->references;
+            result = it->handle;
+        }
+        else if (m_create_function)
+        {
+            // The size is already in physical pixels, so render at a device pixel ratio of 1
+            result = m_create_function(icon.pixmap(QSize(size, size), 1.0));
+
+            if (result != nullptr)
+            {
+                m_entries.insert(key, Entry{result, 1});
+                m_keys.insert(result, key);
+                ++m_created_count;
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Removes a reference added by `acquire()`.
+ * @param handle The handle to release.
+ */
+auto NativeIconCache::release(Handle handle) -> void
+{
+    const auto key_it = m_keys.constFind(handle);
+
+    if (handle != nullptr && key_it != m_keys.constEnd())
+    {
+        Entry& entry = m_entries[*key_it];
+
+        if (entry.references > 0)
+        {
+            --entry.references;
+
+            if (entry.references == 0)
+            {
+                m_unused.append(*key_it);
+                trim_unused();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sets how many unreferenced handles are kept for reuse.
+ * @param capacity The maximum number of unreferenced handles.
+ */
+auto NativeIconCache::set_unused_capacity(int capacity) -> void
+{
+    m_unused_capacity = std::max(capacity, 0);
+    trim_unused();
+}
+
+/**
+ * @brief Returns how many unreferenced handles are kept for reuse.
+ * @return The unused capacity.
+ */
+auto NativeIconCache::get_unused_capacity() const -> int
+{
+    return m_unused_capacity;
+}
+
+/**
+ * @brief Returns the number of cached handles, referenced or not.
+ * @return The entry count.
+ */
+auto NativeIconCache::get_entry_count() const -> qsizetype
+{
+    return m_entries.size();
+}
+
+/**
+ * @brief Returns the number of references to a handle.
+ * @param handle The handle.
+ * @return The reference count, or 0 if the handle is unknown or unreferenced.
+ */
+auto NativeIconCache::get_reference_count(Handle handle) const -> int
+{
+    const auto key_it = m_keys.constFind(handle);
+
+    return (key_it != m_keys.constEnd()) ? m_entries.value(*key_it).references : 0;
+}
+
+/**
+ * @brief Returns how many handles were created since construction.
+ * @return The number of created handles.
+ */
+auto NativeIconCache::get_created_count() const -> qint64
+{
+    return m_created_count;
+}
+
+/**
+ * @brief Destroys all unreferenced handles.
+ */
+auto NativeIconCache::clear_unused() -> void
+{
+    const int capacity = m_unused_capacity;
+    m_unused_capacity = 0;
+    trim_unused();
+    m_unused_capacity = capacity;
+}
+
+/**
+ * @brief Destroys the oldest unreferenced handles beyond the unused capacity.
+ */
+auto NativeIconCache::trim_unused() -> void
+{
+    while (m_unused.size() > m_unused_capacity)
+    {
+        const Entry entry = m_entries.take(m_unused.takeFirst());
+        m_keys.remove(entry.handle);
+
+        if (m_destroy_function)
+        {
+            m_destroy_function(entry.handle);
+        }
+    }
+}
+
+}  // namespace QtWidgetsCommonLib
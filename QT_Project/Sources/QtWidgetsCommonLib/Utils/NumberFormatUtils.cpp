@@ -1,5 +1,10 @@
 #include "QtWidgetsCommonLib/Utils/NumberFormatUtils.h"
 
+#include <QStringView>
+#include <array>
+#include <charconv>
+#include <cmath>
+
 namespace QtWidgetsCommonLib
 {
 
@@ -11,20 +16,47 @@ namespace QtWidgetsCommonLib
  */
 auto NumberFormatUtils::format_number_abbreviated(double value) -> QString
 {
-    constexpr const char* suffixes[] = {"", "K", "M", "B", "T"};
+    std::array<char16_t, kMaxAbbreviatedLength> buffer{};
+    const qsizetype length = format_number_abbreviated(value, buffer);
+
+    return QStringView(buffer.data(), length).toString();
+}
+
+/**
+ * @brief Formats an integer with abbreviated suffixes (e.g., 1.2K, 3M).
+ * @param value The integer to format.
+ * @return Abbreviated string representation.
+ */
+auto NumberFormatUtils::format_number_abbreviated(int value) -> QString
+{
+    return format_number_abbreviated(static_cast<double>(value));
+}
+
+/**
+ * @brief Writes the abbreviation of a number into a caller-provided buffer.
+ *
+ * The digits are produced by `std::to_chars` into a stack buffer, which rounds the same way as
+ * `QString::number(value, 'f', decimals)`, and are then widened into the destination.
+ *
+ * @param value The number to format.
+ * @param buffer The destination buffer.
+ * @return The number of code units written, or -1 if the buffer is too small.
+ */
+auto NumberFormatUtils::format_number_abbreviated(double value, std::span<char16_t> buffer)
+    -> qsizetype
+{
+    constexpr char suffixes[] = {'\0', 'K', 'M', 'B', 'T'};
     constexpr int num_suffixes = sizeof(suffixes) / sizeof(suffixes[0]);
 
     double abs_value = std::abs(value);
+    double printed_value = value;
     int suffix_index = 0;
     int decimals = 0;
-    QString number_str;
+    bool negative = false;
 
     if (abs_value < 1000.0)
     {
-        decimals = (abs_value < 10.0 && abs_value != static_cast<int>(abs_value))
-                       ? 1
-                       : (abs_value != static_cast<int>(abs_value) ? 1 : 0);
-        number_str = QString::number(value, 'f', decimals);
+        decimals = (abs_value != static_cast<int>(abs_value)) ? 1 : 0;
     }
     else
     {
@@ -35,33 +67,103 @@ auto NumberFormatUtils::format_number_abbreviated(double value) -> QString
         }
 
         decimals = (abs_value < 10.0 && suffix_index > 0) ? 1 : 0;
-        number_str = QString::number(abs_value, 'f', decimals);
+        printed_value = abs_value;
+        negative = value < 0.0;
+    }
 
-        if (value < 0.0)
-        {
-            number_str.prepend('-');
-        }
+    std::array<char, kMaxAbbreviatedLength> text{};
+    char* cursor = text.data();
 
-        number_str += suffixes[suffix_index];
+    if (negative)
+    {
+        *cursor++ = '-';
     }
 
+    // Leave room for the suffix
+    const std::to_chars_result converted =
+        std::to_chars(cursor, text.data() + text.size() - 1, printed_value,
+                      std::chars_format::fixed, decimals);
+    qsizetype length = converted.ptr - text.data();
+
     // Remove trailing .0 for whole numbers
-    if (number_str.endsWith(".0"))
+    if (suffix_index == 0 && length >= 2 && text[length - 2] == '.' && text[length - 1] == '0')
     {
-        number_str.chop(2);
+        length -= 2;
     }
 
-    return number_str;
+    if (suffix_index > 0)
+    {
+        text[length++] = suffixes[suffix_index];
+    }
+
+    qsizetype result = -1;
+
+    if (converted.ec == std::errc() && length <= static_cast<qsizetype>(buffer.size()))
+    {
+        for (qsizetype i = 0; i < length; ++i)
+        {
+            buffer[i] = static_cast<char16_t>(text[i]);
+        }
+
+        result = length;
+    }
+
+    return result;
 }
 
 /**
- * @brief Formats an integer with abbreviated suffixes (e.g., 1.2K, 3M).
+ * @brief Writes the abbreviation of an integer into a caller-provided buffer.
  * @param value The integer to format.
- * @return Abbreviated string representation.
+ * @param buffer The destination buffer.
+ * @return The number of code units written, or -1 if the buffer is too small.
  */
-auto NumberFormatUtils::format_number_abbreviated(int value) -> QString
+auto NumberFormatUtils::format_number_abbreviated(int value, std::span<char16_t> buffer)
+    -> qsizetype
 {
-    return format_number_abbreviated(static_cast<double>(value));
+    return format_number_abbreviated(static_cast<double>(value), buffer);
+}
+
+/**
+ * @brief Formats a span of numbers with abbreviated suffixes.
+ *
+ * One scratch buffer is reused for all values, so each result string is allocated exactly once.
+ *
+ * @param values The numbers to format.
+ * @return One abbreviated string per value, in order.
+ */
+auto NumberFormatUtils::format_numbers_abbreviated(std::span<const double> values) -> QStringList
+{
+    QStringList result;
+    result.reserve(static_cast<qsizetype>(values.size()));
+    std::array<char16_t, kMaxAbbreviatedLength> buffer{};
+
+    for (const double value: values)
+    {
+        const qsizetype length = format_number_abbreviated(value, buffer);
+        result.append(QStringView(buffer.data(), length).toString());
+    }
+
+    return result;
+}
+
+/**
+ * @brief Formats a span of integers with abbreviated suffixes.
+ * @param values The integers to format.
+ * @return One abbreviated string per value, in order.
+ */
+auto NumberFormatUtils::format_numbers_abbreviated(std::span<const int> values) -> QStringList
+{
+    QStringList result;
+    result.reserve(static_cast<qsizetype>(values.size()));
+    std::array<char16_t, kMaxAbbreviatedLength> buffer{};
+
+    for (const int value: values)
+    {
+        const qsizetype length = format_number_abbreviated(static_cast<double>(value), buffer);
+        result.append(QStringView(buffer.data(), length).toString());
+    }
+
+    return result;
 }
 
 }  // namespace QtWidgetsCommonLib
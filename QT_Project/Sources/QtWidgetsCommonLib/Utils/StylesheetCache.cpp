@@ -0,0 +1,305 @@
+#include "QtWidgetsCommonLib/Utils/StylesheetCache.h"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+
+namespace
+{
+
+constexpr quint32 kCacheMagic = 0x51535343;  // "QSSC"
+constexpr quint16 kCacheVersion = 4;
+constexpr auto kCacheSuffix = ".qsscache";
+
+}  // namespace
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @brief Constructs a cache rooted at the given directory.
+ * @param directory The cache directory, or empty for `QStandardPaths::CacheLocation` +
+ * "/stylesheets".
+ */
+StylesheetCache::StylesheetCache(const QString& directory): m_directory(directory)
+{
+    if (m_directory.isEmpty())
+    {
+        m_directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+                      QStringLiteral("/stylesheets");
+    }
+}
+
+/**
+ * @brief Returns the directory the cache files are stored in.
+ * @return The absolute cache directory path.
+ */
+auto StylesheetCache::get_directory() const -> QString
+{
+    return m_directory;
+}
+
+/**
+ * @brief Sets how many entries the cache directory keeps.
+ * @param count The maximum number of entries; values < 1 are clamped to 1.
+ */
+auto StylesheetCache::set_max_entry_count(int count) -> void
+{
+    m_max_entry_count = std::max(count, 1);
+}
+
+/**
+ * @brief Returns how many entries the cache directory keeps.
+ * @return The maximum number of entries.
+ */
+auto StylesheetCache::get_max_entry_count() const -> int
+{
+    return m_max_entry_count;
+}
+
+/**
+ * @brief Computes the digest of a source text, the part of the cache key shared by all themes.
+ *
+ * Hashes the UTF-16 data directly, avoiding an encoding conversion of the (potentially large)
+ * source. The origins are part of the digest because cached entries report unresolved variables
+ * by file and line: the same text composed from different files must not share them.
+ *
+ * @param source The raw QSS source text.
+ * @param origins The files the source was composed from, if any.
+ * @return A hex-encoded SHA-1 of the source and its origins.
+ */
+auto StylesheetCache::make_source_key(const QString& source,
+                                      const QList<SourceOrigin>& origins) -> QString
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArrayView(reinterpret_cast<const char*>(source.constData()),
+                                source.size() * qsizetype(sizeof(QChar))));
+
+    for (const SourceOrigin& origin: origins)
+    {
+        hash.addData(QByteArrayView("\0", 1));
+        hash.addData(
+            QStringLiteral("%1:%2").arg(origin.file, QString::number(origin.first_line)).toUtf8());
+    }
+
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+/**
+ * @brief Computes the cache key for a source digest and theme.
+ *
+ * Only hashes the short digest and the theme name, so callers that keep the digest of their
+ * source derive the keys of all its themes without hashing the source again.
+ *
+ * @param source_key The digest returned by `make_source_key()`.
+ * @param theme_name The theme name, or empty for the default block.
+ * @return A hex-encoded hash usable as file name.
+ */
+auto StylesheetCache::make_theme_key(const QString& source_key,
+                                     const QString& theme_name) -> QString
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(source_key.toLatin1());
+    hash.addData(QByteArrayView("\0", 1));
+    hash.addData(QByteArrayView(reinterpret_cast<const char*>(theme_name.constData()),
+                                theme_name.size() * qsizetype(sizeof(QChar))));
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+/**
+ * @brief Computes the cache key for a source text and theme.
+ * @param source The raw QSS source text.
+ * @param theme_name The theme name, or empty for the default block.
+ * @return A hex-encoded hash usable as file name.
+ */
+auto StylesheetCache::make_key(const QString& source, const QString& theme_name) -> QString
+{
+    return make_theme_key(make_source_key(source), theme_name);
+}
+
+/**
+ * @brief Reads a cache entry by memory-mapping its file.
+ *
+ * Entries with a wrong magic number, an unknown version or a truncated payload are rejected.
+ *
+ * @param key The key returned by `make_key()`.
+ * @param entry Receives the cached entry on success.
+ * @return true if a valid entry was found and read, false otherwise.
+ */
+auto StylesheetCache::load(const QString& key, StylesheetCacheEntry& entry) const -> bool
+{
+    bool success = false;
+    QFile file(get_entry_path(key));
+
+    if (file.open(QIODevice::ReadOnly) && file.size() > 0)
+    {
+        uchar* mapped = file.map(0, file.size());
+
+        if (mapped != nullptr)
+        {
+            const QByteArray data = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped),
+                                                            qsizetype(file.size()));
+            QDataStream stream(data);
+            stream.setVersion(QDataStream::Qt_6_0);
+
+            quint32 magic = 0;
+            quint16 version = 0;
+            stream >> magic >> version;
+
+            if (magic == kCacheMagic && version == kCacheVersion)
+            {
+                StylesheetCacheEntry read_entry;
+                QStringList unresolved_names;
+                QList<int> unresolved_lines;
+                QStringList unresolved_files;
+                stream >> read_entry.stylesheet >> read_entry.available_themes >>
+                    read_entry.variables >> read_entry.has_unresolved_variables >>
+                    read_entry.variable_cycles >> read_entry.undefined_references >>
+                    unresolved_names >> unresolved_lines >> unresolved_files;
+
+                if (stream.status() == QDataStream::Ok &&
+                    unresolved_names.size() == unresolved_lines.size() &&
+                    unresolved_names.size() == unresolved_files.size())
+                {
+                    for (qsizetype i = 0; i < unresolved_names.size(); ++i)
+                    {
+                        read_entry.unresolved_variables.append({unresolved_names.at(i),
+                                                                unresolved_lines.at(i),
+                                                                unresolved_files.at(i)});
+                    }
+
+                    entry = read_entry;
+                    success = true;
+                }
+            }
+
+            file.unmap(mapped);
+        }
+    }
+
+    return success;
+}
+
+/**
+ * @brief Writes a cache entry atomically, replacing an existing one with the same key.
+ *
+ * Entries beyond the maximum entry count are removed afterwards, oldest first.
+ *
+ * @param key The key returned by `make_key()`.
+ * @param entry The entry to store.
+ * @return true if the entry was written, false otherwise.
+ */
+auto StylesheetCache::store(const QString& key, const StylesheetCacheEntry& entry) const -> bool
+{
+    bool success = false;
+
+    if (QDir().mkpath(m_directory))
+    {
+        QSaveFile file(get_entry_path(key));
+
+        if (file.open(QIODevice::WriteOnly))
+        {
+            QStringList unresolved_names;
+            QList<int> unresolved_lines;
+            QStringList unresolved_files;
+
+            for (const UnresolvedVariable& unresolved: entry.unresolved_variables)
+            {
+                unresolved_names.append(unresolved.name);
+                unresolved_lines.append(unresolved.line);
+                unresolved_files.append(unresolved.file);
+            }
+
+            QDataStream stream(&file);
+            stream.setVersion(QDataStream::Qt_6_0);
+            stream << kCacheMagic << kCacheVersion << entry.stylesheet << entry.available_themes
+                   << entry.variables << entry.has_unresolved_variables << entry.variable_cycles
+                   << entry.undefined_references << unresolved_names << unresolved_lines
+                   << unresolved_files;
+            success = (stream.status() == QDataStream::Ok) && file.commit();
+        }
+    }
+
+    if (success)
+    {
+        remove_oldest_entries(key);
+    }
+    else
+    {
+        qWarning() << "[StylesheetCache] Failed to write cache entry to" << m_directory;
+    }
+
+    return success;
+}
+
+/**
+ * @brief Removes all cache files from the cache directory.
+ * @return true if all cache files were removed, false otherwise.
+ */
+auto StylesheetCache::clear() const -> bool
+{
+    bool success = true;
+    QDir dir(m_directory);
+    const QString pattern = QStringLiteral("*") + QLatin1String(kCacheSuffix);
+    const QStringList files = dir.entryList(QStringList {pattern}, QDir::Files);
+
+    for (const QString& file: files)
+    {
+        success = dir.remove(file) && success;
+    }
+
+    return success;
+}
+
+/**
+ * @brief Removes the entries beyond the maximum entry count with the oldest modification time.
+ *
+ * Entries of edited sources are never read again, so without a limit the directory would grow
+ * with every change to a stylesheet.
+ *
+ * @param kept_key The key of the entry just written; it is always kept.
+ */
+auto StylesheetCache::remove_oldest_entries(const QString& kept_key) const -> void
+{
+    QDir dir(m_directory);
+    const QString pattern = QStringLiteral("*") + QLatin1String(kCacheSuffix);
+    const QString kept_file = kept_key + QLatin1String(kCacheSuffix);
+    const QFileInfoList files = dir.entryInfoList(QStringList {pattern}, QDir::Files, QDir::Time);
+    int kept = 1;
+
+    // Newest first
+    for (const QFileInfo& file: files)
+    {
+        if (file.fileName() != kept_file)
+        {
+            if (kept < m_max_entry_count)
+            {
+                ++kept;
+            }
+            else
+            {
+                dir.remove(file.fileName());
+            }
+        }
+    }
+}
+
+/**
+ * @brief Returns the file path for a cache key.
+ * @param key The cache key.
+ * @return The absolute file path of the entry.
+ */
+auto StylesheetCache::get_entry_path(const QString& key) const -> QString
+{
+    return m_directory + QLatin1Char('/') + key + QLatin1String(kCacheSuffix);
+}
+
+}  // namespace QtWidgetsCommonLib
@@ -0,0 +1,350 @@
+#include "QtWidgetsCommonLib/Utils/StylesheetImportGraph.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @brief Loads a root file and all files it imports.
+ *
+ * The root is parsed first; only if it is readable the composition is rebuilt by expanding the
+ * imports depth-first. Files that are no longer reachable from the root are dropped from the
+ * cache.
+ *
+ * @param root_path The path to the root QSS file.
+ * @return true if the root file could be read, false otherwise (the graph keeps its previous
+ * state).
+ */
+auto StylesheetImportGraph::load(const QString& root_path) -> bool
+{
+    const QString root = normalize_path(root_path);
+    m_reparsed_files.clear();
+    m_error_string.clear();
+
+    const bool success = ensure_parsed(root);
+
+    if (success)
+    {
+        QStringList import_stack;
+        QSet<QString> included;
+
+        m_root_path = root;
+        m_source.clear();
+        m_file_order.clear();
+        m_composition.clear();
+        expand(root, import_stack, included);
+
+        // Drop files that are no longer part of the graph
+        auto it = m_files.begin();
+
+        while (it != m_files.end())
+        {
+            if (included.contains(it.key()))
+            {
+                ++it;
+            }
+            else
+            {
+                it = m_files.erase(it);
+            }
+        }
+    }
+
+    return success;
+}
+
+/**
+ * @brief Returns whether no root file has been loaded.
+ * @return true if the graph is empty, false otherwise.
+ */
+auto StylesheetImportGraph::is_empty() const -> bool
+{
+    return m_root_path.isEmpty();
+}
+
+/**
+ * @brief Returns the normalized path of the root file.
+ * @return The absolute root file path, or empty if nothing was loaded.
+ */
+auto StylesheetImportGraph::get_root_path() const -> QString
+{
+    return m_root_path;
+}
+
+/**
+ * @brief Returns the composed source of the last load.
+ * @return The expanded QSS text without import directives.
+ */
+auto StylesheetImportGraph::get_source() const -> const QString&
+{
+    return m_source;
+}
+
+/**
+ * @brief Compiles the composed source from the per-file compiled chunks.
+ *
+ * A file's chunks are compiled the first time they are needed after the file was (re-)parsed;
+ * the composition itself only merges the compiled chunks. Each chunk is merged with its file and
+ * first line, so unresolved variables are reported where they are written, not at their line in
+ * the composed source.
+ *
+ * @return The compiled stylesheet of the composed source.
+ */
+auto StylesheetImportGraph::compile() -> CompiledStylesheet
+{
+    QList<CompiledStylesheet> parts;
+    QList<SourceOrigin> origins;
+    parts.reserve(m_composition.size());
+    origins.reserve(m_composition.size());
+
+    for (const ChunkRef& ref: m_composition)
+    {
+        ParsedFile& parsed = m_files[ref.file];
+
+        if (parsed.compiled.isEmpty())
+        {
+            parsed.compiled.reserve(parsed.chunks.size());
+
+            for (const QString& chunk: parsed.chunks)
+            {
+                parsed.compiled.append(CompiledStylesheet(chunk));
+            }
+        }
+
+        parts.append(parsed.compiled.at(ref.chunk));
+        origins.append({ref.file, parsed.chunk_lines.at(ref.chunk)});
+    }
+
+    return CompiledStylesheet::concatenate(parts, origins);
+}
+
+/**
+ * @brief Returns where each chunk of the composed source comes from.
+ *
+ * Two loads with the same composed source but a different split into files (e.g. a rule moved
+ * into an imported file) have different origins.
+ *
+ * @return One origin (file, first line in the file) per chunk in composition order.
+ */
+auto StylesheetImportGraph::get_origins() const -> QList<SourceOrigin>
+{
+    QList<SourceOrigin> result;
+    result.reserve(m_composition.size());
+
+    for (const ChunkRef& ref: m_composition)
+    {
+        result.append({ref.file, m_files.value(ref.file).chunk_lines.value(ref.chunk, 1)});
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns all files of the graph.
+ * @return The normalized file paths in include order, root first.
+ */
+auto StylesheetImportGraph::get_files() const -> QStringList
+{
+    return m_file_order;
+}
+
+/**
+ * @brief Returns whether a file is part of the graph.
+ * @param file_path The file path to look up.
+ * @return true if the file was included by the last load, false otherwise.
+ */
+auto StylesheetImportGraph::contains(const QString& file_path) const -> bool
+{
+    return m_files.contains(normalize_path(file_path));
+}
+
+/**
+ * @brief Returns the files that were (re-)read by the last load.
+ * @return The normalized paths of all files parsed during the last `load()`.
+ */
+auto StylesheetImportGraph::get_reparsed_files() const -> QStringList
+{
+    return m_reparsed_files;
+}
+
+/**
+ * @brief Returns the error of the last failed file read.
+ * @return A human-readable error message, or empty if no read failed.
+ */
+auto StylesheetImportGraph::get_error_string() const -> QString
+{
+    return m_error_string;
+}
+
+/**
+ * @brief Drops the cached parse of a file so the next load reads it again.
+ *
+ * Used for file watcher notifications, which may arrive before the modification time changes
+ * visibly (coarse file system timestamps).
+ *
+ * @param file_path The file that changed.
+ */
+auto StylesheetImportGraph::invalidate(const QString& file_path) -> void
+{
+    m_files.remove(normalize_path(file_path));
+}
+
+/**
+ * @brief Removes all files and the composed source.
+ */
+auto StylesheetImportGraph::clear() -> void
+{
+    m_root_path.clear();
+    m_source.clear();
+    m_error_string.clear();
+    m_files.clear();
+    m_file_order.clear();
+    m_composition.clear();
+    m_reparsed_files.clear();
+}
+
+/**
+ * @brief Returns the canonical form of a path used as key inside the graph.
+ * @param file_path The file path to normalize.
+ * @return The cleaned absolute file path.
+ */
+auto StylesheetImportGraph::normalize_path(const QString& file_path) -> QString
+{
+    return QDir::cleanPath(QFileInfo(file_path).absoluteFilePath());
+}
+
+/**
+ * @brief Makes sure a file is parsed and its cached form is up to date.
+ *
+ * A cached file is reused while its size and modification time are unchanged. Otherwise the
+ * file is read and split at its `@import "...";` directives in a single scan; compilation of the
+ * chunks is deferred to `compile()`. Comments are matched by the same scan and skipped as a
+ * whole, so a commented-out directive is neither split at nor imported.
+ *
+ * @param file_path The normalized file path.
+ * @return true if the file is available, false if it could not be read.
+ */
+auto StylesheetImportGraph::ensure_parsed(const QString& file_path) -> bool
+{
+    // A comment (possibly unterminated) or an import directive, whichever starts first
+    static const QRegularExpression import_regex(
+        R"(/\*.*?(?:\*/|\z)|@import\s+["']([^"']+)["']\s*;)",
+        QRegularExpression::DotMatchesEverythingOption);
+
+    bool result = false;
+    const QFileInfo info(file_path);
+    const auto cached = m_files.constFind(file_path);
+
+    if (cached != m_files.cend() && cached->size == info.size() &&
+        cached->last_modified == info.lastModified())
+    {
+        result = true;
+    }
+    else
+    {
+        QFile file(file_path);
+
+        if (file.open(QFile::ReadOnly | QFile::Text))
+        {
+            const QString text = QString::fromUtf8(file.readAll());
+            const QDir base_dir = info.absoluteDir();
+
+            ParsedFile parsed;
+            parsed.last_modified = info.lastModified();
+            parsed.size = info.size();
+
+            qsizetype chunk_start = 0;
+            int chunk_line = 1;
+            QRegularExpressionMatchIterator it = import_regex.globalMatch(text);
+
+            while (it.hasNext())
+            {
+                const QRegularExpressionMatch match = it.next();
+
+                // Comments stay part of the chunk
+                if (match.hasCaptured(1))
+                {
+                    const qsizetype directive_start = match.capturedStart();
+                    const qsizetype chunk_end = match.capturedEnd();
+                    parsed.chunks.append(text.mid(chunk_start, directive_start - chunk_start));
+                    parsed.chunk_lines.append(chunk_line);
+                    parsed.imports.append(normalize_path(base_dir.filePath(match.captured(1))));
+
+                    // The next chunk starts behind the directive, on the line it ends on
+                    chunk_line += static_cast<int>(
+                        QStringView(text).mid(chunk_start, chunk_end - chunk_start).count(u'\n'));
+                    chunk_start = chunk_end;
+                }
+            }
+
+            parsed.chunks.append(text.mid(chunk_start));
+            parsed.chunk_lines.append(chunk_line);
+            m_files.insert(file_path, parsed);
+            m_reparsed_files.append(file_path);
+            result = true;
+        }
+        else
+        {
+            m_error_string = file.errorString();
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Appends a file and, recursively, its imports to the composition.
+ *
+ * Each chunk of the file is appended in order, followed by the expansion of the import that
+ * terminated it.
+ *
+ * @param file_path The normalized file path.
+ * @param import_stack The files currently being expanded (cycle detection).
+ * @param included The files already part of the composition.
+ */
+auto StylesheetImportGraph::expand(const QString& file_path, QStringList& import_stack,
+                                   QSet<QString>& included) -> void
+{
+    if (import_stack.contains(file_path))
+    {
+        qWarning() << "[StylesheetImportGraph] Skipping import cycle:" << import_stack
+                   << "->" << file_path;
+    }
+    else if (!included.contains(file_path))
+    {
+        if (ensure_parsed(file_path))
+        {
+            // Copy: expanding imports may insert into m_files and invalidate references
+            const ParsedFile parsed = m_files.value(file_path);
+
+            included.insert(file_path);
+            m_file_order.append(file_path);
+            import_stack.append(file_path);
+
+            for (qsizetype i = 0; i < parsed.chunks.size(); ++i)
+            {
+                m_source += parsed.chunks.at(i);
+                m_composition.append(ChunkRef {file_path, i});
+
+                if (i < parsed.imports.size())
+                {
+                    expand(parsed.imports.at(i), import_stack, included);
+                }
+            }
+
+            import_stack.removeLast();
+        }
+        else
+        {
+            qWarning() << "[StylesheetImportGraph] Skipping unreadable import" << file_path << ":"
+                       << m_error_string;
+        }
+    }
+}
+
+}  // namespace QtWidgetsCommonLib
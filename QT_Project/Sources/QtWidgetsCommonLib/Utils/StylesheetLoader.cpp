@@ -1,17 +1,78 @@
 #include "QtWidgetsCommonLib/Utils/StylesheetLoader.h"
 
 #include <QApplication>
+#include <QCache>
 #include <QDebug>
-#include <QFile>
-#include <QRegularExpression>
+#include <QFutureWatcher>
+#include <QLayout>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+#include <utility>
+
+#include "QtWidgetsCommonLib/Utils/Trace.h"
+
+namespace
+{
+
+/**
+ * @brief Total size of the cached theme preview images in KiB.
+ */
+constexpr int kPreviewCacheCostLimit = 32 * 1024;
+
+/**
+ * @brief Returns the process-wide cache of theme preview images (GUI thread only).
+ * @return The cache; the cost of an image is its size in KiB.
+ */
+auto theme_preview_cache() -> QCache<QString, QImage>&
+{
+    static QCache<QString, QImage> cache(kPreviewCacheCostLimit);
+    return cache;
+}
+
+/**
+ * @brief Builds the cache key of a theme preview.
+ * @param source_key The stylesheet cache key of the source and theme.
+ * @param preview The preview widget.
+ * @param device_pixel_ratio The device pixel ratio the preview is rendered at.
+ * @return The cache key.
+ */
+auto theme_preview_key(const QString& source_key, const QWidget& preview,
+                       qreal device_pixel_ratio) -> QString
+{
+    return QStringLiteral("%1|%2/%3|%4x%5@%6")
+        .arg(source_key, QString::fromLatin1(preview.metaObject()->className()),
+             preview.objectName())
+        .arg(preview.width())
+        .arg(preview.height())
+        .arg(device_pixel_ratio);
+}
+
+}  // namespace
 
 namespace QtWidgetsCommonLib
 {
 
+/**
+ * @brief Result of the worker-thread part of an asynchronous load.
+ */
+struct StylesheetLoader::PreparedStylesheet {
+        quint64 generation = 0;
+        bool success = false;
+        QString error;
+        QString source_path;
+        QString theme_name;
+        QString source;
+        QString source_key;
+        std::shared_ptr<const CompiledStylesheet> compiled;  ///< nullptr if not compiled
+        std::shared_ptr<const StylesheetCacheEntry> entry;
+        StylesheetImportGraph import_graph;
+};
+
 /**
  * @brief Constructs a StylesheetLoader.
  *
- * Sets up a `QFileSystemWatcher` and a single-shot debounce `QTimer` for safe, coalesced reloads.
+ * Sets up a `QFileSystemWatcher` and a single-shot debounce `QTimer` for safe, coalesced reloads,
+ * plus a zero-interval single-shot `QTimer` that coalesces batched variable updates.
  * @param parent The parent QObject, or nullptr.
  */
 StylesheetLoader::StylesheetLoader(QObject* parent): QObject(parent)
@@ -26,16 +87,32 @@ StylesheetLoader::StylesheetLoader(QObject* parent): QObject(parent)
         {
             qDebug() << "[StylesheetLoader] Auto-reloading stylesheet from"
                      << m_current_stylesheet_path;
-            reload_stylesheet();
+
+            if (m_async_reload_enabled)
+            {
+                load_stylesheet_async(m_current_stylesheet_path, m_current_theme_name);
+            }
+            else
+            {
+                reload_stylesheet();
+            }
         }
     });
+
+    m_apply_timer.setSingleShot(true);
+    m_apply_timer.setInterval(0);
+    QObject::connect(&m_apply_timer, &QTimer::timeout, this,
+                     [this]() { flush_pending_changes(); });
 }
 
 /**
  * @brief Common parsing/apply routine used by both file and in-memory loading.
  *
- * Parses available themes and variables, resolves recursively, removes @Variables blocks,
- * substitutes variables, applies the stylesheet, and updates internal state.
+ * Compiles the raw text into a `CompiledStylesheet` (skipped when the text is unchanged since the
+ * last load), activates the requested theme, applies the stylesheet, and updates internal state.
+ * A theme that another loader already resolved for the same source is reused as is. With the disk
+ * cache enabled, a changed source is then looked up by (content hash, theme); on a hit the
+ * resolved result is applied directly and compilation is deferred until it is needed.
  *
  * @param raw_stylesheet The raw QSS input.
  * @param theme_name The requested theme (empty means default block only).
@@ -49,73 +126,58 @@ auto StylesheetLoader::process_and_apply_stylesheet(const QString& raw_styleshee
                                                     const QString& source_path,
                                                     bool configure_watcher) -> bool
 {
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("stylesheet", "StylesheetLoader::process_and_apply_stylesheet");
+
     bool success = false;
 
     if (!raw_stylesheet.isEmpty())
     {
-        m_raw_stylesheet = raw_stylesheet;
+        // A synchronous load supersedes any asynchronous load still in flight
+        ++m_load_generation;
         m_current_stylesheet_path = source_path;
-        m_variables.clear();
-
-        // Parse and store available themes
-        m_available_themes = parse_available_themes(m_raw_stylesheet);
 
-        // 1. Extract and parse the default @Variables block (if present)
-        QString default_block = extract_variables_block(m_raw_stylesheet, QString());
+        // Only re-parse when the source text or the files it is composed from actually changed
+        const QList<SourceOrigin> origins = m_import_graph.get_origins();
 
-        if (!default_block.isEmpty())
+        if (raw_stylesheet != m_source || origins != m_source_origins)
         {
-            parse_variables_block(default_block, m_variables);
+            m_source = raw_stylesheet;
+            m_source_origins = origins;
+            m_source_key = StylesheetCache::make_source_key(m_source, m_source_origins);
+            m_compile_pending = true;
         }
 
-        // 2. Extract and parse the theme @Variables block (overrides defaults if present)
-        if (!theme_name.isEmpty())
+        std::shared_ptr<const StylesheetCacheEntry> entry =
+            get_theme_registry().find(std::make_pair(m_source_key, theme_name));
+        QString cache_key;
+
+        if (entry == nullptr && m_disk_cache_enabled && m_compile_pending)
         {
-            QString theme_block = extract_variables_block(m_raw_stylesheet, theme_name);
+            StylesheetCacheEntry cached;
+            cache_key = StylesheetCache::make_theme_key(m_source_key, theme_name);
 
-            if (!theme_block.isEmpty())
+            if (m_disk_cache.load(cache_key, cached))
             {
-                parse_variables_block(theme_block, m_variables);
+                qDebug() << "[StylesheetLoader] Using cached stylesheet for theme:" << theme_name;
+                entry = get_theme_registry().insert(
+                    std::make_pair(m_source_key, theme_name),
+                    std::make_shared<const StylesheetCacheEntry>(std::move(cached)));
             }
         }
 
-        // 3. Recursively resolve all variables (handles references to other variables)
-        QMap<QString, QString> resolved_variables;
-
-        for (auto it = m_variables.begin(); it != m_variables.end(); ++it)
-        {
-            QSet<QString> seen;
-            resolved_variables[it.key()] = resolve_variable(it.key(), m_variables, seen);
-        }
-
-        m_variables = resolved_variables;
-
-        // 4. Remove all @Variables blocks from the stylesheet (non-greedy, multiline)
-        QString stylesheet = remove_variables_blocks(m_raw_stylesheet);
-
-        // 5. Substitute variables and apply the stylesheet
-        QString final_stylesheet = substitute_variables(stylesheet);
-
-        if (final_stylesheet.contains(QRegularExpression(R"(@[A-Za-z0-9_\-]+)")))
+        if (entry == nullptr)
         {
-            qWarning()
-                << "[StylesheetLoader] Warning: Unresolved variable(s) remain in stylesheet!";
-        }
-
-        apply_stylesheet(final_stylesheet);
-        m_current_theme_name = theme_name;
+            ensure_compiled();
+            entry = resolve_theme(theme_name);
 
-        // Update watcher paths
-        QStringList watched = m_watcher.files();
-        if (!watched.isEmpty())
-        {
-            m_watcher.removePaths(watched);
+            if (!cache_key.isEmpty())
+            {
+                m_disk_cache.store(cache_key, *entry);
+            }
         }
 
-        if (configure_watcher && m_auto_reload_enabled && !m_current_stylesheet_path.isEmpty())
-        {
-            m_watcher.addPath(m_current_stylesheet_path);
-        }
+        install_entry(entry, theme_name);
+        update_watched_paths(configure_watcher);
 
         // Log source
         if (!m_current_stylesheet_path.isEmpty())
@@ -146,24 +208,29 @@ auto StylesheetLoader::process_and_apply_stylesheet(const QString& raw_styleshee
  *  - Applies variables from the default block first (if present).
  *  - Overrides with requested theme (if provided and present).
  *
+ * The file is loaded through the import graph: `@import "file.qss";` directives are expanded and
+ * only files that changed since the previous load are read and parsed again.
+ *
  * @param file_path The path to the QSS file.
  * @param theme_name The theme name to use, or empty for default.
  * @return true if loading and applying succeeded, false otherwise.
  */
 auto StylesheetLoader::load_stylesheet(const QString& file_path, const QString& theme_name) -> bool
 {
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("stylesheet", "StylesheetLoader::load_stylesheet");
+
     bool success = false;
-    QFile style_file(file_path);
 
-    if (style_file.open(QFile::ReadOnly | QFile::Text))
+    // Files of the import graph that did not change are not read again
+    if (m_import_graph.load(file_path))
     {
-        const QString raw = QString::fromUtf8(style_file.readAll());
-        success = process_and_apply_stylesheet(raw, theme_name, file_path, true);
+        success =
+            process_and_apply_stylesheet(m_import_graph.get_source(), theme_name, file_path, true);
     }
     else
     {
         qWarning() << "[StylesheetLoader] Failed to load stylesheet from" << file_path << ":"
-                   << style_file.errorString();
+                   << m_import_graph.get_error_string();
     }
 
     return success;
@@ -182,9 +249,77 @@ auto StylesheetLoader::load_stylesheet(const QString& file_path, const QString&
 auto StylesheetLoader::load_stylesheet_from_data(const QString& stylesheet,
                                                  const QString& theme_name) -> bool
 {
+    // In-memory data has no files to import from or to watch
+    if (!stylesheet.isEmpty())
+    {
+        m_import_graph.clear();
+    }
+
     return process_and_apply_stylesheet(stylesheet, theme_name, QString(), false);
 }
 
+/**
+ * @brief Loads a stylesheet file on a worker thread and applies it when ready.
+ *
+ * The worker only receives copies (path, theme, cache settings), never loader state. The
+ * `QFutureWatcher` delivers the result back on the GUI thread, where `finish_async_load()` drops
+ * it if a newer load has started meanwhile.
+ *
+ * @param file_path The path to the QSS file.
+ * @param theme_name The theme name to use, or empty for default.
+ */
+auto StylesheetLoader::load_stylesheet_async(const QString& file_path,
+                                             const QString& theme_name) -> void
+{
+    const quint64 generation = ++m_load_generation;
+    const bool use_cache = m_disk_cache_enabled;
+    const StylesheetCache cache = m_disk_cache;
+    const StylesheetImportGraph import_graph = m_import_graph;
+
+    auto* watcher = new QFutureWatcher<PreparedStylesheet>(this);
+    QObject::connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher]() {
+        m_async_watchers.removeOne(watcher);
+        finish_async_load(watcher->result());
+        watcher->deleteLater();
+    });
+
+    m_async_watchers.append(watcher);
+    watcher->setFuture(
+        QtConcurrent::run([generation, file_path, theme_name, use_cache, cache, import_graph]() {
+            return prepare_stylesheet(generation, file_path, theme_name, use_cache, cache,
+                                      import_graph);
+        }));
+}
+
+/**
+ * @brief Returns whether asynchronous loads are still running.
+ * @return true if at least one async load has not delivered its result yet.
+ */
+auto StylesheetLoader::is_loading() const -> bool
+{
+    return !m_async_watchers.isEmpty();
+}
+
+/**
+ * @brief Blocks until the asynchronous loads in flight finished and installs their results now.
+ *
+ * Waits on the worker threads only; no events are processed meanwhile. Each result is handled
+ * as if it had been delivered by the event loop, so superseded loads are still dropped and
+ * `stylesheetReady()` is emitted from within this call.
+ */
+auto StylesheetLoader::wait_for_async_loads() -> void
+{
+    while (!m_async_watchers.isEmpty())
+    {
+        QFutureWatcher<PreparedStylesheet>* watcher = m_async_watchers.takeFirst();
+        watcher->waitForFinished();
+        finish_async_load(watcher->result());
+
+        // Also discards the finished notification the watcher may have queued already
+        delete watcher;
+    }
+}
+
 /**
  * @brief Reloads the last successfully loaded stylesheet path with the current theme.
  * @return true if reloading and applying succeeded, false otherwise.
@@ -207,6 +342,10 @@ auto StylesheetLoader::reload_stylesheet() -> bool
 
 /**
  * @brief Changes the current theme and reapplies the stylesheet.
+ *
+ * Uses the already compiled template: only the theme's variable table is resolved and the slots
+ * are refilled, the source is not parsed again. Source path and file watcher stay untouched.
+ *
  * @param theme_name The theme to set. Empty uses the default @Variables block.
  * @return true if the theme exists (or empty default) and was applied, false otherwise.
  */
@@ -217,9 +356,11 @@ auto StylesheetLoader::set_theme(const QString& theme_name) -> bool
     // Accept empty (default) theme, otherwise check availability
     if (theme_name.isEmpty() || m_available_themes.contains(theme_name))
     {
-        if (!m_raw_stylesheet.isEmpty())
+        if (!m_source.isEmpty())
         {
-            success = load_stylesheet_from_data(m_raw_stylesheet, theme_name);
+            activate_theme(theme_name);
+            qDebug() << "[StylesheetLoader] Switched theme to:" << theme_name;
+            success = true;
         }
         else if (!m_current_stylesheet_path.isEmpty())
         {
@@ -241,12 +382,16 @@ auto StylesheetLoader::set_theme(const QString& theme_name) -> bool
 
 /**
  * @brief Returns the current stylesheet as a QString (with variables substituted).
+ *
+ * Returns the cached text. After batched changes it is rendered on the first call and then
+ * reused, so frequent calls (e.g. from diagnostics tooling) do not render again.
+ *
  * @return The current stylesheet with variables replaced.
  */
 auto StylesheetLoader::get_current_stylesheet() const -> QString
 {
-    QString stylesheet = remove_variables_blocks(m_raw_stylesheet);
-    return substitute_variables(stylesheet);
+    ensure_rendered();
+    return m_current_stylesheet;
 }
 
 /**
@@ -286,6 +431,34 @@ auto StylesheetLoader::has_variable(const QString& name) const -> bool
     return m_variables.contains(name);
 }
 
+/**
+ * @brief Returns the variable reference cycles detected for the current theme.
+ * @return One sorted list of variable names per cycle; empty if there are no cycles.
+ */
+auto StylesheetLoader::get_variable_cycles() const -> QList<QStringList>
+{
+    return m_variable_cycles;
+}
+
+/**
+ * @brief Returns the undefined variables referenced by variable values of the current theme.
+ * @return Sorted, unique variable names (without '@').
+ */
+auto StylesheetLoader::get_undefined_variable_references() const -> QStringList
+{
+    return m_undefined_variable_references;
+}
+
+/**
+ * @brief Returns the variable references in the stylesheet body that have no value.
+ * @return The unresolved references in source order, with their file and 1-based line.
+ */
+auto StylesheetLoader::get_unresolved_variables() const -> QList<UnresolvedVariable>
+{
+    ensure_rendered();
+    return m_unresolved_variables;
+}
+
 /**
  * @brief Removes a variable and reapplies the stylesheet.
  * @param name The variable name (without '@').
@@ -298,8 +471,12 @@ auto StylesheetLoader::remove_variable(const QString& name) -> bool
     if (m_variables.remove(name) > 0)
     {
         removed = true;
-        QString final_stylesheet = get_current_stylesheet();
-        apply_stylesheet(final_stylesheet);
+        ensure_compiled();
+
+        if (m_compiled->references_variable(name))
+        {
+            refresh_stylesheet();
+        }
     }
 
     return removed;
@@ -313,214 +490,648 @@ auto StylesheetLoader::remove_variable(const QString& name) -> bool
 auto StylesheetLoader::set_variable(const QString& name, const QString& value) -> void
 {
     m_variables[name] = value;
-    QString final_stylesheet = get_current_stylesheet();
-    apply_stylesheet(final_stylesheet);
+    ensure_compiled();
+
+    // Unreferenced variables cannot change the rendered output
+    if (m_compiled->references_variable(name))
+    {
+        refresh_stylesheet();
+    }
 }
 
 /**
- * @brief Enables automatic reloading when the loaded stylesheet file changes.
+ * @brief Makes auto-reload parse the changed file on a worker thread.
+ * @param enabled True to reload via `load_stylesheet_async()`, false to reload synchronously.
+ */
+auto StylesheetLoader::enable_async_reload(bool enabled) -> void
+{
+    m_async_reload_enabled = enabled;
+}
+
+/**
+ * @brief Enables or disables the on-disk cache of resolved stylesheets.
  * @param enabled True to enable, false to disable.
- * @return true if the watcher was configured, false otherwise (e.g., no file loaded).
+ * @param directory The cache directory, or empty for the default cache location.
  */
-auto StylesheetLoader::enable_auto_reload(bool enabled) -> bool
+auto StylesheetLoader::enable_disk_cache(bool enabled, const QString& directory) -> void
 {
-    bool configured = false;
-    m_auto_reload_enabled = enabled;
+    m_disk_cache_enabled = enabled;
+    m_disk_cache = StylesheetCache(directory);
+}
 
-    QStringList watched = m_watcher.files();
-    if (!watched.isEmpty())
+/**
+ * @brief Returns whether the on-disk cache is enabled.
+ * @return true if loads consult and fill the disk cache, false otherwise.
+ */
+auto StylesheetLoader::is_disk_cache_enabled() const -> bool
+{
+    return m_disk_cache_enabled;
+}
+
+/**
+ * @brief Sets the widget whose subtree receives the stylesheet instead of the application.
+ * @param target The widget to style, or nullptr to apply application-wide again.
+ */
+auto StylesheetLoader::set_apply_target(QWidget* target) -> void
+{
+    m_apply_target = target;
+    m_has_apply_target = (target != nullptr);
+
+    if (m_apply_pending)
     {
-        m_watcher.removePaths(watched);
+        refresh_stylesheet();
     }
-
-    if (m_auto_reload_enabled && !m_current_stylesheet_path.isEmpty())
+    else if (!m_source.isEmpty())
     {
-        configured = m_watcher.addPath(m_current_stylesheet_path);
+        apply_current_stylesheet();
     }
+}
 
-    return configured;
+/**
+ * @brief Returns the widget the stylesheet is applied to.
+ * @return The target widget, or nullptr when applying application-wide.
+ */
+auto StylesheetLoader::get_apply_target() const -> QWidget*
+{
+    return m_apply_target.data();
 }
 
 /**
- * @brief Replaces all variable placeholders in the stylesheet with their values.
- * @param stylesheet The stylesheet string to process.
- * @return The stylesheet with variables substituted.
+ * @brief Renders a widget offscreen under several themes of the loaded stylesheet.
+ *
+ * Cached images are returned right away. The stylesheets of the remaining themes are resolved
+ * and rendered to text in parallel, since that only reads the shared compiled stylesheet.
+ * Widgets can only be painted on the GUI thread, so each theme is then applied to the preview
+ * and painted with `QWidget::render()`. That works for hidden widgets and never touches
+ * `qApp`.
+ *
+ * @param preview The widget to render.
+ * @param theme_names The themes to render, or empty for all available themes.
+ * @return One image per available theme in `theme_names`; unknown themes are skipped.
  */
-auto StylesheetLoader::substitute_variables(const QString& stylesheet) const -> QString
+auto StylesheetLoader::render_theme_previews(QWidget* preview, const QStringList& theme_names)
+    -> QHash<QString, QImage>
 {
-    QString result = stylesheet;
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("stylesheet", "StylesheetLoader::render_theme_previews");
 
-    // Sort variable names by length descending to avoid partial replacements
-    QStringList keys = m_variables.keys();
-    std::sort(keys.begin(), keys.end(),
-              [](const QString& a, const QString& b) { return a.length() > b.length(); });
+    QHash<QString, QImage> result;
 
-    for (const QString& key: keys)
+    if (preview != nullptr && !m_source.isEmpty() && !preview->size().isEmpty())
     {
-        // Replace only exact variable names (not as part of longer names)
-        // Use negative lookahead: not followed by [A-Za-z0-9_]
-        QRegularExpression regex("@" + QRegularExpression::escape(key) + R"((?![A-Za-z0-9_\-]))");
-        result.replace(regex, m_variables.value(key));
+        ensure_compiled();
+
+        const QStringList& requested = theme_names.isEmpty() ? m_available_themes : theme_names;
+        const qreal device_pixel_ratio = preview->devicePixelRatioF();
+        QCache<QString, QImage>& cache = theme_preview_cache();
+        QStringList missing_themes;
+        QStringList missing_keys;
+
+        for (const QString& theme_name: requested)
+        {
+            if (m_available_themes.contains(theme_name) && !result.contains(theme_name))
+            {
+                const QString key =
+                    theme_preview_key(StylesheetCache::make_theme_key(m_source_key, theme_name),
+                                      *preview, device_pixel_ratio);
+                const QImage* cached = cache.object(key);
+
+                if (cached != nullptr)
+                {
+                    result.insert(theme_name, *cached);
+                }
+                else if (!missing_themes.contains(theme_name))
+                {
+                    missing_themes.append(theme_name);
+                    missing_keys.append(key);
+                }
+            }
+        }
+
+        if (!missing_themes.isEmpty())
+        {
+            const std::shared_ptr<const CompiledStylesheet> compiled = m_compiled;
+            const QStringList stylesheets = QtConcurrent::blockingMapped<QStringList>(
+                missing_themes, [compiled](const QString& theme_name) {
+                    return build_entry(*compiled, theme_name).stylesheet;
+                });
+
+            const QString previous_stylesheet = preview->styleSheet();
+            const QSize pixel_size = preview->size() * device_pixel_ratio;
+
+            for (qsizetype i = 0; i < missing_themes.size(); ++i)
+            {
+                preview->setStyleSheet(stylesheets.at(i));
+
+                if (preview->layout() != nullptr)
+                {
+                    preview->layout()->activate();
+                }
+
+                QImage image(pixel_size, QImage::Format_ARGB32_Premultiplied);
+                image.setDevicePixelRatio(device_pixel_ratio);
+                image.fill(Qt::transparent);
+                preview->render(&image);
+
+                cache.insert(missing_keys.at(i), new QImage(image),
+                             static_cast<qsizetype>(image.sizeInBytes() / 1024));
+                result.insert(missing_themes.at(i), image);
+            }
+
+            preview->setStyleSheet(previous_stylesheet);
+        }
     }
 
     return result;
 }
 
 /**
- * @brief Applies the given stylesheet to the QApplication.
- * @param stylesheet The stylesheet string to apply.
+ * @brief Renders a widget offscreen under one theme; see `render_theme_previews()`.
+ * @param preview The widget to render.
+ * @param theme_name The theme to render.
+ * @return The image, or a null image if the theme is not available.
  */
-auto StylesheetLoader::apply_stylesheet(const QString& stylesheet) -> void
+auto StylesheetLoader::render_theme_preview(QWidget* preview, const QString& theme_name) -> QImage
 {
-    qApp->setStyleSheet(stylesheet);
+    return render_theme_previews(preview, QStringList(theme_name)).value(theme_name);
 }
 
 /**
- * @brief Extracts the @Variables block for a given theme name, or the default block if not found.
- * @param stylesheet The full QSS stylesheet.
- * @param theme_name The theme name to look for.
- * @return The content of the variables block, or an empty string if not found.
+ * @brief Drops all cached theme preview images.
  */
-auto StylesheetLoader::extract_variables_block(const QString& stylesheet,
-                                               const QString& theme_name) -> QString
+auto StylesheetLoader::clear_theme_preview_cache() -> void
 {
-    QString result;
-    QRegularExpression block_regex;
+    theme_preview_cache().clear();
+}
 
-    if (!theme_name.isEmpty())
+/**
+ * @brief Returns how many compiled stylesheets are currently shared by all loaders.
+ * @return The number of compiled stylesheets in use.
+ */
+auto StylesheetLoader::get_shared_stylesheet_count() -> qsizetype
+{
+    return get_compiled_registry().get_entry_count();
+}
+
+/**
+ * @brief Returns the process-wide compiled stylesheets, keyed by source digest.
+ *
+ * The digest (`StylesheetCache::make_source_key()`) is computed once per loaded source, so
+ * lookups hash a short key instead of the whole source text.
+ *
+ * @return The registry.
+ */
+auto StylesheetLoader::get_compiled_registry() -> CompiledRegistry&
+{
+    static CompiledRegistry registry;
+    return registry;
+}
+
+/**
+ * @brief Returns the process-wide resolved themes, keyed by source digest and theme name.
+ * @return The registry.
+ */
+auto StylesheetLoader::get_theme_registry() -> ThemeRegistry&
+{
+    static ThemeRegistry registry;
+    return registry;
+}
+
+/**
+ * @brief Sets or overrides several variables and schedules a single deferred reapply.
+ *
+ * Starts the zero-interval apply timer only if it is not already running, so any number of calls
+ * before the event loop runs again result in exactly one rebuild and one `setStyleSheet`. Nothing
+ * is scheduled when none of the variables is referenced by the stylesheet.
+ *
+ * @param variables The variable names (without '@') and values to set.
+ */
+auto StylesheetLoader::set_variables(const QMap<QString, QString>& variables) -> void
+{
+    bool affects_output = false;
+    ensure_compiled();
+
+    for (auto it = variables.cbegin(); it != variables.cend(); ++it)
+    {
+        m_variables.insert(it.key(), it.value());
+        affects_output = affects_output || m_compiled->references_variable(it.key());
+    }
+
+    if (affects_output)
     {
-        block_regex = QRegularExpression(QString(R"(@Variables\[Name="%1"\]\s*\{([\s\S]*?)\})")
-                                             .arg(QRegularExpression::escape(theme_name)),
-                                         QRegularExpression::DotMatchesEverythingOption);
-        QRegularExpressionMatch match = block_regex.match(stylesheet);
+        m_apply_pending = true;
+        m_render_pending = true;
 
-        if (match.hasMatch())
+        if (!m_apply_timer.isActive())
         {
-            result = match.captured(1);
+            m_apply_timer.start();
         }
     }
+}
+
+/**
+ * @brief Applies pending changes from `set_variables()` immediately.
+ * @return true if pending changes were applied, false if nothing was pending.
+ */
+auto StylesheetLoader::flush_pending_changes() -> bool
+{
+    const bool was_pending = m_apply_pending;
 
-    if (result.isEmpty())
+    if (was_pending)
     {
-        block_regex = QRegularExpression(R"(@Variables\s*\{([\s\S]*?)\})",
-                                         QRegularExpression::DotMatchesEverythingOption);
-        QRegularExpressionMatch match = block_regex.match(stylesheet);
+        // Reuses the text if get_current_stylesheet() already rendered it
+        ensure_rendered();
+        apply_current_stylesheet();
+    }
+
+    return was_pending;
+}
+
+/**
+ * @brief Returns whether changes from `set_variables()` are waiting to be applied.
+ * @return true if a deferred apply is scheduled, false otherwise.
+ */
+auto StylesheetLoader::has_pending_changes() const -> bool
+{
+    return m_apply_pending;
+}
+
+/**
+ * @brief Enables automatic reloading when the loaded stylesheet file changes.
+ * @param enabled True to enable, false to disable.
+ * @return true if the watcher was configured, false otherwise (e.g., no file loaded).
+ */
+auto StylesheetLoader::enable_auto_reload(bool enabled) -> bool
+{
+    m_auto_reload_enabled = enabled;
+    return update_watched_paths(true);
+}
 
-        if (match.hasMatch())
+/**
+ * @brief Activates the variables of a theme and reapplies the stylesheet.
+ *
+ * Takes the theme's variable table from the compiled template, resolves references between
+ * variables (each variable once, in dependency order) and installs the rendered result together
+ * with its cycle and undefined-reference diagnostics.
+ *
+ * @param theme_name The theme to activate, or empty for the default block.
+ */
+auto StylesheetLoader::activate_theme(const QString& theme_name) -> void
+{
+    ensure_compiled();
+    install_entry(resolve_theme(theme_name), theme_name);
+}
+
+/**
+ * @brief Returns the shared resolved state of a theme of the current source.
+ *
+ * Loaders of other windows with the same source and theme receive the same state, so the theme
+ * is resolved and rendered once and its text and variables are implicitly shared.
+ *
+ * @param theme_name The theme to resolve, or empty for the default block.
+ * @return The resolved state.
+ */
+auto StylesheetLoader::resolve_theme(const QString& theme_name)
+    -> std::shared_ptr<const StylesheetCacheEntry>
+{
+    const std::shared_ptr<const CompiledStylesheet> compiled = m_compiled;
+
+    return get_theme_registry().acquire(std::make_pair(m_source_key, theme_name),
+                                        [&compiled, &theme_name]() {
+                                            return std::make_shared<const StylesheetCacheEntry>(
+                                                build_entry(*compiled, theme_name));
+                                        });
+}
+
+/**
+ * @brief Resolves a theme of a compiled stylesheet and renders the final text.
+ *
+ * Pure function of its inputs, so it is safe to call from worker threads.
+ *
+ * @param compiled The compiled stylesheet.
+ * @param theme_name The theme to resolve, or empty for the default block.
+ * @return The resolved state (stylesheet, themes, variables and diagnostics).
+ */
+auto StylesheetLoader::build_entry(const CompiledStylesheet& compiled,
+                                   const QString& theme_name) -> StylesheetCacheEntry
+{
+    VariableResolution resolution =
+        CompiledStylesheet::resolve_variables(compiled.get_theme_variables(theme_name));
+
+    StylesheetCacheEntry entry;
+    entry.stylesheet = compiled.render(resolution.values, &entry.unresolved_variables);
+    entry.available_themes = compiled.get_available_themes();
+    entry.variables = std::move(resolution.values);
+    entry.has_unresolved_variables = !entry.unresolved_variables.isEmpty();
+    entry.variable_cycles = std::move(resolution.cycles);
+    entry.undefined_references = std::move(resolution.undefined_references);
+    return entry;
+}
+
+/**
+ * @brief Takes over a resolved state as the current one, logs its diagnostics and applies it.
+ *
+ * The loader keeps a reference to the shared state; its own copies of the text and variables are
+ * implicitly shared with it until they are modified.
+ *
+ * @param entry The resolved state (shared with other loaders).
+ * @param theme_name The theme the state was resolved for.
+ */
+auto StylesheetLoader::install_entry(const std::shared_ptr<const StylesheetCacheEntry>& entry,
+                                     const QString& theme_name) -> void
+{
+    const StylesheetCacheEntry& resolved = *entry;
+
+    for (const QStringList& cycle: resolved.variable_cycles)
+    {
+        qWarning() << "[StylesheetLoader] Variable reference cycle detected:" << cycle;
+    }
+
+    if (!resolved.undefined_references.isEmpty())
+    {
+        qWarning() << "[StylesheetLoader] Undefined variable reference(s):"
+                   << resolved.undefined_references;
+    }
+
+    if (!resolved.unresolved_variables.isEmpty())
+    {
+        QStringList locations;
+
+        for (const UnresolvedVariable& unresolved: resolved.unresolved_variables)
         {
-            result = match.captured(1);
+            const QString location =
+                unresolved.file.isEmpty()
+                    ? QStringLiteral("line %1").arg(unresolved.line)
+                    : QStringLiteral("%1:%2").arg(unresolved.file).arg(unresolved.line);
+            locations.append(QStringLiteral("@%1 (%2)").arg(unresolved.name, location));
         }
+
+        qWarning() << "[StylesheetLoader] Warning: Unresolved variable(s) remain in stylesheet:"
+                   << locations;
     }
 
-    return result;
+    m_available_themes = resolved.available_themes;
+    m_variables = resolved.variables;
+    m_variable_cycles = resolved.variable_cycles;
+    m_undefined_variable_references = resolved.undefined_references;
+    m_current_theme_name = theme_name;
+    m_current_stylesheet = resolved.stylesheet;
+    m_unresolved_variables = resolved.unresolved_variables;
+    m_render_pending = false;
+    m_theme_entry = entry;
+    apply_current_stylesheet();
 }
 
 /**
- * @brief Parses variables from a variables block and fills the variables map.
- * @param variables_block The content of the variables block.
- * @param variables The map to fill with variable name/value pairs.
+ * @brief Re-targets the file watcher at all files of the current import graph.
+ * @param configure_watcher If false, all watched paths are cleared (in-memory loads).
+ * @return true if at least one file is watched, false otherwise.
  */
-void StylesheetLoader::parse_variables_block(const QString& variables_block,
-                                             QMap<QString, QString>& variables)
+auto StylesheetLoader::update_watched_paths(bool configure_watcher) -> bool
 {
-    QRegularExpression var_regex(R"(@([A-Za-z0-9_\-]+)\s*:\s*([^;]+);)");
-    QRegularExpressionMatchIterator match_iterator = var_regex.globalMatch(variables_block);
+    bool configured = false;
+    QStringList watched = m_watcher.files();
+    if (!watched.isEmpty())
+    {
+        m_watcher.removePaths(watched);
+    }
 
-    while (match_iterator.hasNext())
+    if (configure_watcher && m_auto_reload_enabled && !m_import_graph.is_empty())
     {
-        QRegularExpressionMatch match = match_iterator.next();
-        QString name = match.captured(1);
-        QString value = match.captured(2).trimmed();
-        variables[name] = value;
+        const QStringList files = m_import_graph.get_files();
+        const QStringList failed = m_watcher.addPaths(files);
+        configured = failed.size() < files.size();
     }
+
+    return configured;
 }
 
 /**
- * @brief Parses all available theme names from the raw stylesheet.
- * @param stylesheet The raw QSS stylesheet.
- * @return A QStringList of theme names.
+ * @brief Reads, compiles and resolves a stylesheet file; runs on a worker thread.
+ *
+ * Mirrors the synchronous load path: a theme resolved by another loader or a disk cache hit skips
+ * compilation, a miss compiles the source (unless another loader already did) and writes the
+ * result back.
+ *
+ * @param generation The load generation the result belongs to.
+ * @param file_path The path to the QSS file.
+ * @param theme_name The theme to resolve.
+ * @param use_cache Whether to consult and fill the disk cache.
+ * @param cache The disk cache to use.
+ * @param import_graph A copy of the current import graph; only changed files are re-read.
+ * @return The prepared result, ready to be installed on the GUI thread.
  */
-auto StylesheetLoader::parse_available_themes(const QString& stylesheet) -> QStringList
+auto StylesheetLoader::prepare_stylesheet(quint64 generation, const QString& file_path,
+                                          const QString& theme_name, bool use_cache,
+                                          const StylesheetCache& cache,
+                                          StylesheetImportGraph import_graph) -> PreparedStylesheet
 {
-    QStringList themes;
-    QRegularExpression theme_regex("@Variables\\[Name=\"([^\"]+)\"\\]");
-    QRegularExpressionMatchIterator it = theme_regex.globalMatch(stylesheet);
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("stylesheet", "StylesheetLoader::prepare_stylesheet");
+
+    PreparedStylesheet result;
+    result.generation = generation;
+    result.source_path = file_path;
+    result.theme_name = theme_name;
 
-    while (it.hasNext())
+    if (import_graph.load(file_path))
     {
-        QRegularExpressionMatch match = it.next();
-        QString theme = match.captured(1);
+        result.source = import_graph.get_source();
 
-        if (!theme.isEmpty())
+        if (!result.source.isEmpty())
         {
-            themes << theme;
+            result.source_key =
+                StylesheetCache::make_source_key(result.source, import_graph.get_origins());
+            const std::pair<QString, QString> theme_key =
+                std::make_pair(result.source_key, theme_name);
+            QString cache_key;
+            result.entry = get_theme_registry().find(theme_key);
+
+            if (result.entry == nullptr && use_cache)
+            {
+                StylesheetCacheEntry cached;
+                cache_key = StylesheetCache::make_theme_key(result.source_key, theme_name);
+
+                if (cache.load(cache_key, cached))
+                {
+                    result.entry = get_theme_registry().insert(
+                        theme_key, std::make_shared<const StylesheetCacheEntry>(std::move(cached)));
+                }
+            }
+
+            if (result.entry == nullptr)
+            {
+                result.compiled =
+                    get_compiled_registry().acquire(result.source_key, [&import_graph]() {
+                        return std::make_shared<const CompiledStylesheet>(import_graph.compile());
+                    });
+                const std::shared_ptr<const CompiledStylesheet> compiled = result.compiled;
+                result.entry = get_theme_registry().acquire(theme_key, [&compiled, &theme_name]() {
+                    return std::make_shared<const StylesheetCacheEntry>(
+                        build_entry(*compiled, theme_name));
+                });
+
+                if (!cache_key.isEmpty())
+                {
+                    cache.store(cache_key, *result.entry);
+                }
+            }
+
+            result.success = true;
         }
+        else
+        {
+            result.error = QStringLiteral("Provided stylesheet data is empty.");
+        }
+
+        result.import_graph = import_graph;
+    }
+    else
+    {
+        result.error = import_graph.get_error_string();
     }
 
-    // Fallback: Add "Default" if there is an ungrouped @Variables block
-    QRegularExpression default_block(R"(@Variables\s*\{)");
+    return result;
+}
 
-    if (default_block.match(stylesheet).hasMatch())
+/**
+ * @brief Installs the result of an asynchronous load on the GUI thread.
+ * @param prepared The prepared result from the worker thread.
+ */
+auto StylesheetLoader::finish_async_load(const PreparedStylesheet& prepared) -> void
+{
+
+    if (prepared.generation != m_load_generation)
+    {
+        qDebug() << "[StylesheetLoader] Dropping stale asynchronous load of"
+                 << prepared.source_path;
+    }
+    else if (!prepared.success)
     {
-        themes << "Default";
+        qWarning() << "[StylesheetLoader] Failed to load stylesheet from" << prepared.source_path
+                   << ":" << prepared.error;
+        emit stylesheetReady(false);
     }
+    else
+    {
+        m_current_stylesheet_path = prepared.source_path;
+        m_import_graph = prepared.import_graph;
+
+        if (prepared.source_key != m_source_key)
+        {
+            m_source = prepared.source;
+            m_source_origins = m_import_graph.get_origins();
+            m_source_key = prepared.source_key;
+            m_compile_pending = true;
+        }
+
+        if (prepared.compiled != nullptr)
+        {
+            m_compiled = prepared.compiled;
+            m_compile_pending = false;
+        }
 
-    themes.removeDuplicates();
-    return themes;
+        install_entry(prepared.entry, prepared.theme_name);
+        update_watched_paths(true);
+        qDebug() << "[StylesheetLoader] Loaded stylesheet asynchronously from"
+                 << m_current_stylesheet_path << "with theme:" << prepared.theme_name;
+        emit stylesheetReady(true);
+    }
 }
 
 /**
- * @brief Removes all @Variables blocks from the given stylesheet string.
- * @param stylesheet The stylesheet string to process.
- * @return The stylesheet with all @Variables blocks removed.
+ * @brief Renders the compiled template with the current variables and applies the result.
  */
-auto StylesheetLoader::remove_variables_blocks(const QString& stylesheet) -> QString
+auto StylesheetLoader::refresh_stylesheet() -> void
 {
-    QString result = stylesheet;
-    QRegularExpression remove_blocks(R"(@Variables(\[Name="[^"]*"\])?\s*\{[\s\S]*?\})",
-                                     QRegularExpression::DotMatchesEverythingOption);
-    result.replace(remove_blocks, "");
-    return result;
+    ensure_compiled();
+    m_render_pending = true;
+    ensure_rendered();
+    apply_current_stylesheet();
 }
 
 /**
- * @brief Recursively resolves a variable to its final value, following references to other
- * variables. Prevents cycles via a seen-set.
- * @param name The variable name to resolve (without '@').
- * @param variables The map of all available variables.
- * @param seen A set of variable names already visited in this resolution chain.
- * @return The fully resolved value of the variable, or an empty string if not found or cyclic.
+ * @brief Applies `m_current_stylesheet` and cancels any pending deferred apply.
  */
-auto StylesheetLoader::resolve_variable(const QString& name,
-                                        const QMap<QString, QString>& variables,
-                                        QSet<QString>& seen) -> QString
+auto StylesheetLoader::apply_current_stylesheet() -> void
 {
-    QString result;
+    m_apply_timer.stop();
+    m_apply_pending = false;
+    apply_stylesheet(m_current_stylesheet);
+}
 
-    if (!seen.contains(name))
+/**
+ * @brief Renders the current stylesheet and its unresolved references if inputs changed.
+ *
+ * Rendering fills the text and the unresolved references in one pass; both stay cached until
+ * the variables change again.
+ */
+auto StylesheetLoader::ensure_rendered() const -> void
+{
+    if (m_render_pending)
     {
-        seen.insert(name);
-        auto it = variables.find(name);
+        m_current_stylesheet = m_compiled->render(m_variables, &m_unresolved_variables);
+        m_render_pending = false;
+    }
+}
 
-        if (it != variables.end())
-        {
-            QString value = it.value();
-            static QRegularExpression var_regex(R"(@([A-Za-z0-9\-_]+))");
-            QRegularExpressionMatch match = var_regex.match(value);
+/**
+ * @brief Compiles the current source if it changed since the last compilation.
+ *
+ * Compilation is deferred after a disk cache hit, so it only happens once the template is
+ * actually needed (theme switch, variable change). A source that another loader already compiled
+ * is shared instead of compiled again.
+ */
+auto StylesheetLoader::ensure_compiled() -> void
+{
+    if (m_compile_pending)
+    {
+        m_compiled = get_compiled_registry().acquire(m_source_key, [this]() {
+            std::shared_ptr<const CompiledStylesheet> result;
 
-            while (match.hasMatch())
+            // File-based sources are composed from the per-file compiled chunks of the import graph
+            if (m_import_graph.is_empty())
             {
-                QString inner_var = match.captured(1);
-                QString resolved = resolve_variable(inner_var, variables, seen);
-                value.replace("@" + inner_var, resolved);
-                match = var_regex.match(value);
+                result = std::make_shared<const CompiledStylesheet>(m_source);
+            }
+            else
+            {
+                result = std::make_shared<const CompiledStylesheet>(m_import_graph.compile());
             }
 
-            result = value;
-        }
+            return result;
+        });
+
+        m_compile_pending = false;
     }
+}
 
-    return result;
+/**
+ * @brief Applies the given stylesheet to the apply target (or the QApplication).
+ *
+ * Comparing against the stylesheet already set is a cheap string comparison, whereas
+ * `setStyleSheet()` re-polishes every affected widget, so identical sheets are skipped. If the
+ * configured target widget has been destroyed, nothing is applied.
+ *
+ * @param stylesheet The stylesheet string to apply.
+ */
+auto StylesheetLoader::apply_stylesheet(const QString& stylesheet) -> void
+{
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("stylesheet", "StylesheetLoader::apply_stylesheet");
+
+    if (m_has_apply_target)
+    {
+        if (m_apply_target.isNull())
+        {
+            qDebug() << "[StylesheetLoader] Apply target was destroyed; stylesheet not applied.";
+        }
+        else if (m_apply_target->styleSheet() != stylesheet)
+        {
+            m_apply_target->setStyleSheet(stylesheet);
+        }
+    }
+    else if (qApp->styleSheet() != stylesheet)
+    {
+        qApp->setStyleSheet(stylesheet);
+    }
 }
 
 /**
@@ -533,8 +1144,10 @@ auto StylesheetLoader::resolve_variable(const QString& name,
  */
 void StylesheetLoader::on_stylesheet_file_changed(const QString& changed_path)
 {
-    if (m_auto_reload_enabled && changed_path == m_current_stylesheet_path)
+    if (m_auto_reload_enabled && m_import_graph.contains(changed_path))
     {
+        // Only the changed file is re-read on reload, all others come from the graph cache
+        m_import_graph.invalidate(changed_path);
         m_reload_timer.start();
     }
 }
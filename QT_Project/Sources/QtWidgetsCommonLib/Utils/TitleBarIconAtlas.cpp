@@ -0,0 +1,208 @@
+#include "QtWidgetsCommonLib/Utils/TitleBarIconAtlas.h"
+
+#include <QHash>
+#include <QList>
+#include <QPainter>
+#include <QSvgRenderer>
+#include <array>
+#include <memory>
+
+#include "QtWidgetsCommonLib/Utils/UiUtils.h"
+
+namespace
+{
+
+using QtWidgetsCommonLib::TitleBarIconAtlas;
+
+/**
+ * @brief Number of glyphs in an atlas.
+ */
+constexpr int kGlyphCount = 4;
+
+/**
+ * @brief Maximum number of color and size combinations kept at the same time.
+ */
+constexpr int kMaxAtlasEntries = 16;
+
+/**
+ * @struct AtlasEntry
+ * @brief Atlases of one color and size and the glyph icons cut from them.
+ */
+struct AtlasEntry {
+        QHash<qreal, QPixmap> atlases;
+        std::array<QIcon, kGlyphCount> icons;
+};
+
+/**
+ * @brief Returns the process-wide atlas entries, keyed by color and size.
+ * @return The atlas entries.
+ */
+auto atlas_entries() -> QHash<QString, AtlasEntry>&
+{
+    static QHash<QString, AtlasEntry> entries;
+    return entries;
+}
+
+/**
+ * @brief Builds the key of an atlas entry.
+ * @param color The glyph color.
+ * @param icon_px The logical icon size in pixels.
+ * @return The entry key.
+ */
+auto entry_key(const QColor& color, int icon_px) -> QString
+{
+    return QStringLiteral("%1@%2").arg(color.name(QColor::HexArgb)).arg(icon_px);
+}
+
+/**
+ * @brief Returns the parsed SVGs of all glyphs, in atlas order (parsed once).
+ * @return One renderer per glyph.
+ */
+auto glyph_renderers() -> const std::array<std::unique_ptr<QSvgRenderer>, kGlyphCount>&
+{
+    static const std::array<std::unique_ptr<QSvgRenderer>, kGlyphCount> renderers = {
+        std::make_unique<QSvgRenderer>(QStringLiteral(":/Resources/Icons/titlebar-minimize.svg")),
+        std::make_unique<QSvgRenderer>(QStringLiteral(":/Resources/Icons/titlebar-maximize.svg")),
+        std::make_unique<QSvgRenderer>(QStringLiteral(":/Resources/Icons/titlebar-restore.svg")),
+        std::make_unique<QSvgRenderer>(QStringLiteral(":/Resources/Icons/titlebar-close.svg"))};
+    return renderers;
+}
+
+/**
+ * @brief Renders all glyphs into one atlas pixmap.
+ *
+ * The glyphs are drawn side by side, then the whole atlas is colored with one source-in fill.
+ *
+ * @param color The glyph color.
+ * @param icon_px The logical icon size in pixels.
+ * @param device_pixel_ratio The device pixel ratio to render for.
+ * @return The atlas pixmap.
+ */
+auto render_atlas(const QColor& color, int icon_px, qreal device_pixel_ratio) -> QPixmap
+{
+    const QSize logical_size(icon_px * kGlyphCount, icon_px);
+    QPixmap result(logical_size * device_pixel_ratio);
+    result.setDevicePixelRatio(device_pixel_ratio);
+    result.fill(Qt::transparent);
+
+    QPainter painter(&result);
+    const auto& renderers = glyph_renderers();
+
+    for (int i = 0; i < kGlyphCount; ++i)
+    {
+        renderers.at(i)->render(&painter, TitleBarIconAtlas::get_glyph_rect(
+                                              static_cast<TitleBarIconAtlas::Glyph>(i), icon_px));
+    }
+
+    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+    painter.fillRect(QRect(QPoint(0, 0), logical_size), color);
+    painter.end();
+    return result;
+}
+
+/**
+ * @brief Returns the atlas entry of a color and size, building it on first use.
+ * @param color The glyph color.
+ * @param icon_px The logical icon size in pixels.
+ * @return The atlas entry.
+ */
+auto get_entry(const QColor& color, int icon_px) -> const AtlasEntry&
+{
+    QHash<QString, AtlasEntry>& entries = atlas_entries();
+    const QString key = entry_key(color, icon_px);
+    auto it = entries.constFind(key);
+
+    if (it == entries.cend())
+    {
+        if (entries.size() >= kMaxAtlasEntries)
+        {
+            entries.clear();
+        }
+
+        AtlasEntry entry;
+
+        for (const qreal ratio: QtWidgetsCommonLib::UiUtils::get_screen_device_pixel_ratios())
+        {
+            const QPixmap atlas = render_atlas(color, icon_px, ratio);
+            entry.atlases.insert(ratio, atlas);
+
+            for (int i = 0; i < kGlyphCount; ++i)
+            {
+                const QRect logical_rect = TitleBarIconAtlas::get_glyph_rect(
+                    static_cast<TitleBarIconAtlas::Glyph>(i), icon_px);
+                const QRect device_rect(logical_rect.topLeft() * ratio,
+                                        logical_rect.size() * ratio);
+                QPixmap glyph = atlas.copy(device_rect);
+                glyph.setDevicePixelRatio(ratio);
+                entry.icons.at(i).addPixmap(glyph);
+            }
+        }
+
+        it = entries.insert(key, entry);
+    }
+
+    return it.value();
+}
+
+}  // namespace
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @brief Returns the shared icon of a glyph, building the atlas on first use.
+ *
+ * Repeated calls return copies of the same implicitly shared icon (equal `QIcon::cacheKey()`).
+ *
+ * @param glyph The glyph.
+ * @param color The glyph color.
+ * @param icon_px The logical icon size in pixels (square).
+ * @return The icon, with one pixmap per screen device pixel ratio.
+ */
+auto TitleBarIconAtlas::get_icon(Glyph glyph, const QColor& color, int icon_px) -> QIcon
+{
+    return get_entry(color, icon_px).icons.at(static_cast<int>(glyph));
+}
+
+/**
+ * @brief Returns the atlas pixmap for a color, size and device pixel ratio.
+ * @param color The glyph color.
+ * @param icon_px The logical icon size in pixels (square).
+ * @param device_pixel_ratio One of the screen device pixel ratios.
+ * @return The atlas, or a null pixmap if no atlas exists for that ratio.
+ */
+auto TitleBarIconAtlas::get_atlas(const QColor& color, int icon_px, qreal device_pixel_ratio)
+    -> QPixmap
+{
+    return get_entry(color, icon_px).atlases.value(device_pixel_ratio);
+}
+
+/**
+ * @brief Returns the logical rectangle of a glyph inside an atlas.
+ * @param glyph The glyph.
+ * @param icon_px The logical icon size in pixels (square).
+ * @return The source rectangle of the glyph.
+ */
+auto TitleBarIconAtlas::get_glyph_rect(Glyph glyph, int icon_px) -> QRect
+{
+    return QRect(static_cast<int>(glyph) * icon_px, 0, icon_px, icon_px);
+}
+
+/**
+ * @brief Returns the number of color and size combinations currently cached.
+ * @return The number of atlas entries.
+ */
+auto TitleBarIconAtlas::get_entry_count() -> int
+{
+    return static_cast<int>(atlas_entries().size());
+}
+
+/**
+ * @brief Removes all atlases and glyph icons.
+ */
+auto TitleBarIconAtlas::clear() -> void
+{
+    atlas_entries().clear();
+}
+
+}  // namespace QtWidgetsCommonLib
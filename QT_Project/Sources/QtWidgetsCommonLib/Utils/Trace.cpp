@@ -0,0 +1,333 @@
+#include "QtWidgetsCommonLib/Utils/Trace.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QSaveFile>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+namespace QtWidgetsCommonLib
+{
+
+namespace
+{
+
+/**
+ * @struct TraceEvent
+ * @brief One recorded scope.
+ */
+struct TraceEvent {
+        const char* category = nullptr;
+        const char* name = nullptr;
+        qint64 start_ns = 0;
+        qint64 duration_ns = 0;
+        quintptr thread_id = 0;
+};
+
+/**
+ * @struct TraceState
+ * @brief Process-wide tracer state.
+ *
+ * Counters are keyed by the literal pointers, which is a pointer comparison per record;
+ * `get_counters()` merges entries whose literals were not pooled by the linker.
+ */
+struct TraceState {
+        std::atomic<bool> enabled{true};
+        std::atomic<bool> event_recording{false};
+        QMutex mutex;
+        QHash<QPair<const char*, const char*>, TraceCounter> counters;
+        std::vector<TraceEvent> events;
+        qsizetype event_capacity = 100000;
+        std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+/**
+ * @brief Returns the process-wide tracer state.
+ * @return The state, created on first use.
+ */
+auto trace_state() -> TraceState&
+{
+    static TraceState state;
+    return state;
+}
+
+}  // namespace
+
+/**
+ * @brief Returns whether the trace macros are compiled into this build.
+ * @return true if `QTWIDGETSCOMMONLIB_ENABLE_TRACING` is defined.
+ */
+auto Tracer::is_compiled_in() -> bool
+{
+#if defined(QTWIDGETSCOMMONLIB_ENABLE_TRACING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Enables or disables recording at runtime.
+ * @param enabled false makes every scope a single atomic load.
+ */
+auto Tracer::set_enabled(bool enabled) -> void
+{
+    trace_state().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns whether recording is enabled at runtime.
+ * @return true if scopes are recorded.
+ */
+auto Tracer::is_enabled() -> bool
+{
+    return trace_state().enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Enables or disables keeping individual events for the trace export.
+ * @param enabled true to keep events, up to the event capacity.
+ */
+auto Tracer::set_event_recording(bool enabled) -> void
+{
+    trace_state().event_recording.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Returns whether individual events are kept.
+ * @return true if events are recorded.
+ */
+auto Tracer::is_event_recording() -> bool
+{
+    return trace_state().event_recording.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the maximum number of kept events; later events are only counted.
+ * @param capacity The maximum number of events.
+ */
+auto Tracer::set_event_capacity(qsizetype capacity) -> void
+{
+    TraceState& state = trace_state();
+    const QMutexLocker locker(&state.mutex);
+    state.event_capacity = std::max<qsizetype>(capacity, 0);
+}
+
+/**
+ * @brief Returns the nanoseconds since the tracer's epoch (first use in the process).
+ * @return The monotonic timestamp in nanoseconds.
+ */
+auto Tracer::now_ns() -> qint64
+{
+    const auto elapsed = std::chrono::steady_clock::now() - trace_state().epoch;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+/**
+ * @brief Records one measured scope.
+ * @param category The category literal.
+ * @param name The name literal.
+ * @param start_ns The start timestamp from `now_ns()`.
+ * @param duration_ns The duration in nanoseconds.
+ */
+auto Tracer::record(const char* category, const char* name, qint64 start_ns,
+                    qint64 duration_ns) -> void
+{
+    TraceState& state = trace_state();
+
+    if (state.enabled.load(std::memory_order_relaxed))
+    {
+        const QMutexLocker locker(&state.mutex);
+        TraceCounter& counter = state.counters[qMakePair(category, name)];
+
+        if (counter.count == 0)
+        {
+            counter.category = QString::fromUtf8(category);
+            counter.name = QString::fromUtf8(name);
+            counter.min_ns = duration_ns;
+            counter.max_ns = duration_ns;
+        }
+
+        ++counter.count;
+        counter.total_ns += duration_ns;
+        counter.min_ns = std::min(counter.min_ns, duration_ns);
+        counter.max_ns = std::max(counter.max_ns, duration_ns);
+
+        if (state.event_recording.load(std::memory_order_relaxed) &&
+            static_cast<qsizetype>(state.events.size()) < state.event_capacity)
+        {
+            state.events.push_back(
+                {category, name, start_ns, duration_ns,
+                 reinterpret_cast<quintptr>(QThread::currentThreadId())});
+        }
+    }
+}
+
+/**
+ * @brief Returns the aggregated counters, sorted by category and name.
+ * @return One counter per traced scope.
+ */
+auto Tracer::get_counters() -> QList<TraceCounter>
+{
+    TraceState& state = trace_state();
+    QList<TraceCounter> result;
+
+    {
+        const QMutexLocker locker(&state.mutex);
+        result.reserve(state.counters.size());
+
+        for (const TraceCounter& counter: std::as_const(state.counters))
+        {
+            result.append(counter);
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const TraceCounter& a, const TraceCounter& b) {
+        return a.category != b.category ? a.category < b.category : a.name < b.name;
+    });
+
+    // Identical literals from different translation units may have different addresses
+    QList<TraceCounter> merged;
+    merged.reserve(result.size());
+
+    for (const TraceCounter& counter: std::as_const(result))
+    {
+        if (!merged.isEmpty() && merged.last().category == counter.category &&
+            merged.last().name == counter.name)
+        {
+            TraceCounter& last = merged.last();
+            last.count += counter.count;
+            last.total_ns += counter.total_ns;
+            last.min_ns = std::min(last.min_ns, counter.min_ns);
+            last.max_ns = std::max(last.max_ns, counter.max_ns);
+        }
+        else
+        {
+            merged.append(counter);
+        }
+    }
+
+    return merged;
+}
+
+/**
+ * @brief Returns the number of kept events.
+ * @return The event count.
+ */
+auto Tracer::get_event_count() -> qsizetype
+{
+    TraceState& state = trace_state();
+    const QMutexLocker locker(&state.mutex);
+    return static_cast<qsizetype>(state.events.size());
+}
+
+/**
+ * @brief Exports the kept events as Chrome trace-event JSON ("X" complete events).
+ *
+ * Timestamps and durations are in microseconds, as the format requires; the process id is the
+ * application's and each thread gets its own track.
+ *
+ * @return The JSON document.
+ */
+auto Tracer::to_chrome_trace_json() -> QByteArray
+{
+    TraceState& state = trace_state();
+    std::vector<TraceEvent> events;
+
+    {
+        const QMutexLocker locker(&state.mutex);
+        events = state.events;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray trace_events;
+
+    for (const TraceEvent& event: events)
+    {
+        QJsonObject object;
+        object.insert(QStringLiteral("name"), QString::fromUtf8(event.name));
+        object.insert(QStringLiteral("cat"), QString::fromUtf8(event.category));
+        object.insert(QStringLiteral("ph"), QStringLiteral("X"));
+        object.insert(QStringLiteral("ts"), static_cast<double>(event.start_ns) / 1000.0);
+        object.insert(QStringLiteral("dur"), static_cast<double>(event.duration_ns) / 1000.0);
+        object.insert(QStringLiteral("pid"), pid);
+        object.insert(QStringLiteral("tid"), static_cast<qint64>(event.thread_id));
+        trace_events.append(object);
+    }
+
+    QJsonObject root;
+    root.insert(QStringLiteral("traceEvents"), trace_events);
+    root.insert(QStringLiteral("displayTimeUnit"), QStringLiteral("ms"));
+
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+/**
+ * @brief Writes the Chrome trace-event JSON to a file.
+ * @param file_path The destination file.
+ * @return true if the file was written, false otherwise.
+ */
+auto Tracer::write_chrome_trace(const QString& file_path) -> bool
+{
+    QSaveFile file(file_path);
+    bool result = file.open(QIODevice::WriteOnly);
+
+    if (result)
+    {
+        file.write(to_chrome_trace_json());
+        result = file.commit();
+    }
+
+    if (!result)
+    {
+        qWarning() << "[Tracer] Failed to write trace to" << file_path << ":"
+                   << file.errorString();
+    }
+
+    return result;
+}
+
+/**
+ * @brief Clears all counters and events.
+ */
+auto Tracer::reset() -> void
+{
+    TraceState& state = trace_state();
+    const QMutexLocker locker(&state.mutex);
+    state.counters.clear();
+    state.events.clear();
+}
+
+/**
+ * @brief Starts the measurement if recording is enabled.
+ * @param category The category literal.
+ * @param name The name literal.
+ */
+TraceScope::TraceScope(const char* category, const char* name)
+    : m_category(category), m_name(name), m_start_ns(Tracer::is_enabled() ? Tracer::now_ns() : -1)
+{
+}
+
+/**
+ * @brief Records the measured duration.
+ */
+TraceScope::~TraceScope()
+{
+    if (m_start_ns >= 0)
+    {
+        Tracer::record(m_category, m_name, m_start_ns, Tracer::now_ns() - m_start_ns);
+    }
+}
+
+}  // namespace QtWidgetsCommonLib
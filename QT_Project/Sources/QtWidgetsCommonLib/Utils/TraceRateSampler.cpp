@@ -0,0 +1,156 @@
+#include "QtWidgetsCommonLib/Utils/TraceRateSampler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace QtWidgetsCommonLib
+{
+
+namespace
+{
+
+constexpr double kNanosecondsPerMillisecond = 1000000.0;
+
+/**
+ * @brief Returns the key of a counter in the previous snapshot.
+ * @param category The trace category.
+ * @param name The trace name.
+ * @return "category/name".
+ */
+auto counter_key(const QString& category, const QString& name) -> QString
+{
+    return category + QLatin1Char('/') + name;
+}
+
+}  // namespace
+
+/**
+ * @brief Takes a snapshot and computes the rates since the previous one.
+ *
+ * The first sample (and the first after `reset()`) only records the baseline. Counters that went
+ * backwards (after `Tracer::reset()`) are measured from zero.
+ *
+ * @param counters The cumulative counters, e.g. from `Tracer::get_counters()`.
+ * @param now_ns The snapshot time in nanoseconds, e.g. from `Tracer::now_ns()`.
+ */
+auto TraceRateSampler::sample(const QList<TraceCounter>& counters, qint64 now_ns) -> void
+{
+    QHash<QString, TraceCounter> current;
+    current.reserve(counters.size());
+    m_rates.clear();
+    m_interval_ms = 0.0;
+
+    if (m_previous_ns >= 0 && now_ns > m_previous_ns)
+    {
+        m_interval_ms = static_cast<double>(now_ns - m_previous_ns) / kNanosecondsPerMillisecond;
+    }
+
+    for (const TraceCounter& counter: counters)
+    {
+        const QString key = counter_key(counter.category, counter.name);
+        const TraceCounter previous = m_previous.value(key);
+        const bool restarted = counter.count < previous.count;
+        const qint64 count = counter.count - (restarted ? 0 : previous.count);
+        const qint64 total_ns = counter.total_ns - (restarted ? 0 : previous.total_ns);
+
+        if (m_interval_ms > 0.0 && count > 0)
+        {
+            const double seconds = m_interval_ms / 1000.0;
+            const double total_ms = static_cast<double>(total_ns) / kNanosecondsPerMillisecond;
+            m_rates.append({counter.category, counter.name, static_cast<double>(count) / seconds,
+                            total_ms / static_cast<double>(count), total_ms / seconds});
+        }
+
+        current.insert(key, counter);
+    }
+
+    std::sort(m_rates.begin(), m_rates.end(), [](const TraceRate& a, const TraceRate& b) {
+        return a.category != b.category ? a.category < b.category : a.name < b.name;
+    });
+
+    m_previous = std::move(current);
+    m_previous_ns = now_ns;
+}
+
+/**
+ * @brief Returns the rates of the last interval, sorted by category and name.
+ * @return One rate per scope that ran in the interval.
+ */
+auto TraceRateSampler::get_rates() const -> QList<TraceRate>
+{
+    return m_rates;
+}
+
+/**
+ * @brief Returns the rate of one scope in the last interval.
+ * @param category The trace category.
+ * @param name The trace name.
+ * @return The rate, or a zero rate if the scope did not run.
+ */
+auto TraceRateSampler::get_rate(const QString& category, const QString& name) const -> TraceRate
+{
+    TraceRate result {category, name};
+
+    for (const TraceRate& rate: m_rates)
+    {
+        if (rate.category == category && rate.name == name)
+        {
+            result = rate;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns the length of the last interval.
+ * @return The interval in milliseconds, or 0 before the second sample.
+ */
+auto TraceRateSampler::get_interval_ms() const -> double
+{
+    return m_interval_ms;
+}
+
+/**
+ * @brief Formats the rates as text lines, grouped by category.
+ *
+ * Each scope line shows the rate, the average duration and the time share, e.g.
+ * `  AppWindow::nativeEvent  412/s  0.02 ms  8.1 ms/s`.
+ *
+ * @return A header line per category followed by one line per scope.
+ */
+auto TraceRateSampler::to_lines() const -> QStringList
+{
+    QStringList result;
+    QString category;
+
+    for (const TraceRate& rate: m_rates)
+    {
+        if (result.isEmpty() || rate.category != category)
+        {
+            category = rate.category;
+            result.append(category);
+        }
+
+        result.append(QStringLiteral("  %1  %2/s  %3 ms  %4 ms/s")
+                          .arg(rate.name)
+                          .arg(rate.count_per_second, 0, 'f', 0)
+                          .arg(rate.average_ms, 0, 'f', 2)
+                          .arg(rate.busy_ms_per_second, 0, 'f', 1));
+    }
+
+    return result;
+}
+
+/**
+ * @brief Forgets the baseline and the rates.
+ */
+auto TraceRateSampler::reset() -> void
+{
+    m_previous.clear();
+    m_previous_ns = -1;
+    m_interval_ms = 0.0;
+    m_rates.clear();
+}
+
+}  // namespace QtWidgetsCommonLib
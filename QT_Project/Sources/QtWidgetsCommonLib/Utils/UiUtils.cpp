@@ -5,8 +5,177 @@
 
 #include "QtWidgetsCommonLib/Utils/UiUtils.h"
 
+#include <QDebug>
+#include <QFutureWatcher>
+#include <QGuiApplication>
+#include <QHash>
+#include <QImage>
 #include <QPainter>
+#include <QPixmapCache>
+#include <QScreen>
+#include <QStringList>
 #include <QSvgRenderer>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "QtWidgetsCommonLib/Utils/Trace.h"
+
+namespace
+{
+
+/**
+ * @brief Maximum number of parsed SVGs kept at the same time; the least recently used goes first.
+ */
+constexpr int kMaxCachedRenderers = 64;
+
+/**
+ * @struct IconCacheState
+ * @brief Process-wide state of the icon caches.
+ */
+struct IconCacheState {
+        QHash<QString, std::shared_ptr<QSvgRenderer>> renderers;
+        /** @brief Paths of the cached renderers, least recently used first. */
+        QStringList renderer_order;
+        /** @brief Part of every pixmap key; bumping it invalidates all cached pixmaps at once. */
+        quint64 pixmap_generation = 0;
+        QtWidgetsCommonLib::UiUtils::IconCacheStats stats;
+};
+
+/**
+ * @brief Returns the process-wide icon cache state.
+ * @return The cache state.
+ */
+auto icon_cache_state() -> IconCacheState&
+{
+    static IconCacheState state;
+    return state;
+}
+
+/**
+ * @brief Builds the QPixmapCache key of a colored icon in the current cache generation.
+ * @param svg_path The path to the SVG resource.
+ * @param color The overlay color.
+ * @param size The logical icon size.
+ * @param device_pixel_ratio The device pixel ratio.
+ * @return The cache key.
+ */
+auto pixmap_cache_key(const QString& svg_path, const QColor& color, const QSize& size,
+                      qreal device_pixel_ratio) -> QString
+{
+    return QStringLiteral("QtWidgetsCommonLib/svg/%1/%2|%3|%4x%5@%6")
+        .arg(icon_cache_state().pixmap_generation)
+        .arg(svg_path, color.name(QColor::HexArgb))
+        .arg(size.width())
+        .arg(size.height())
+        .arg(device_pixel_ratio);
+}
+
+/**
+ * @brief Paints a colored SVG onto a paint device.
+ *
+ * The device's device pixel ratio must already be set; painting happens in logical coordinates.
+ *
+ * @param device The transparent pixmap or image to paint on.
+ * @param renderer The parsed SVG.
+ * @param color The overlay color.
+ * @param size The logical icon size.
+ */
+auto paint_colored_svg(QPaintDevice& device, QSvgRenderer& renderer, const QColor& color,
+                       const QSize& size) -> void
+{
+    const QRect logical_rect(QPoint(0, 0), size);
+    QPainter painter(&device);
+    renderer.render(&painter, logical_rect);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+    painter.fillRect(logical_rect, color);
+    painter.end();
+}
+
+/**
+ * @brief Renders the images of an icon batch (worker thread safe).
+ *
+ * Uses renderers local to the call, so each SVG path of the batch is parsed once and no state
+ * is shared with the GUI thread.
+ *
+ * @param requests The icons to render.
+ * @param ratios The device pixel ratios to render each icon for.
+ * @return Per request, one image per ratio.
+ */
+auto render_icon_images(const QList<QtWidgetsCommonLib::UiUtils::IconRequest>& requests,
+                        const QList<qreal>& ratios) -> QList<QList<QImage>>
+{
+    QHash<QString, std::shared_ptr<QSvgRenderer>> renderers;
+    QList<QList<QImage>> result;
+    result.reserve(requests.size());
+
+    for (const QtWidgetsCommonLib::UiUtils::IconRequest& request: requests)
+    {
+        std::shared_ptr<QSvgRenderer>& renderer = renderers[request.svg_path];
+
+        if (!renderer)
+        {
+            renderer = std::make_shared<QSvgRenderer>(request.svg_path);
+        }
+
+        QList<QImage> images;
+        images.reserve(ratios.size());
+
+        for (const qreal ratio: ratios)
+        {
+            QImage image(request.size * ratio, QImage::Format_ARGB32_Premultiplied);
+            image.setDevicePixelRatio(ratio);
+            image.fill(Qt::transparent);
+            paint_colored_svg(image, *renderer, request.color, request.size);
+            images.append(image);
+        }
+
+        result.append(images);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns the parsed SVG of a path, parsing it on first use.
+ *
+ * Once `kMaxCachedRenderers` SVGs are cached, parsing another one evicts the least recently used,
+ * so an application cycling through more icons than that only re-parses the ones it has not used
+ * for longest. The recency list is as short as the cache, so updating it is cheap.
+ *
+ * @param svg_path The path to the SVG resource.
+ * @return The shared renderer (invalid if the file could not be parsed).
+ */
+auto renderer_for(const QString& svg_path) -> std::shared_ptr<QSvgRenderer>
+{
+    IconCacheState& state = icon_cache_state();
+    std::shared_ptr<QSvgRenderer> result = state.renderers.value(svg_path);
+
+    if (result)
+    {
+        ++state.stats.renderer_hits;
+        state.renderer_order.removeOne(svg_path);
+        state.renderer_order.append(svg_path);
+    }
+    else
+    {
+        ++state.stats.renderer_misses;
+
+        if (state.renderers.size() >= kMaxCachedRenderers)
+        {
+            state.renderers.remove(state.renderer_order.takeFirst());
+        }
+
+        result = std::make_shared<QSvgRenderer>(svg_path);
+        state.renderers.insert(svg_path, result);
+        state.renderer_order.append(svg_path);
+    }
+
+    return result;
+}
+
+}  // namespace
 
 namespace QtWidgetsCommonLib
 {
@@ -17,22 +186,191 @@ namespace QtWidgetsCommonLib
  * This method loads the SVG at the given path, renders it to a pixmap of the specified size,
  * and applies the given color using source-in composition.
  *
+ * A cached pixmap for the same path, color, size and device pixel ratio is returned without
+ * rendering; otherwise the parsed SVG is taken from the renderer cache.
+ *
  * @param svg_path The path to the SVG resource.
  * @param color The color to apply to the SVG.
  * @param size The desired size of the resulting pixmap.
+ * @param device_pixel_ratio The device pixel ratio to render for.
  * @return A QPixmap containing the colored SVG.
  */
-auto UiUtils::colored_svg_icon(const QString& svg_path, const QColor& color, QSize size) -> QPixmap
+auto UiUtils::colored_svg_icon(const QString& svg_path, const QColor& color, QSize size,
+                               qreal device_pixel_ratio) -> QPixmap
 {
-    QSvgRenderer renderer(svg_path);
-    QPixmap pixmap(size);
-    pixmap.fill(Qt::transparent);
-    QPainter painter(&pixmap);
-    renderer.render(&painter);
-    painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
-    painter.fillRect(pixmap.rect(), color);
-    painter.end();
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("icons", "UiUtils::colored_svg_icon");
+
+    IconCacheState& state = icon_cache_state();
+    const QString key = pixmap_cache_key(svg_path, color, size, device_pixel_ratio);
+    QPixmap pixmap;
+
+    if (QPixmapCache::find(key, &pixmap))
+    {
+        ++state.stats.pixmap_hits;
+    }
+    else
+    {
+        ++state.stats.pixmap_misses;
+        const std::shared_ptr<QSvgRenderer> renderer = renderer_for(svg_path);
+
+        pixmap = QPixmap(size * device_pixel_ratio);
+        pixmap.setDevicePixelRatio(device_pixel_ratio);
+        pixmap.fill(Qt::transparent);
+        paint_colored_svg(pixmap, *renderer, color, size);
+
+        QPixmapCache::insert(key, pixmap);
+    }
+
     return pixmap;
 }
 
+/**
+ * @brief Returns the distinct device pixel ratios of all connected screens.
+ * @return The ratios in ascending order; at least 1.0 if there is no screen.
+ */
+auto UiUtils::get_screen_device_pixel_ratios() -> QList<qreal>
+{
+    QList<qreal> result;
+
+    for (const QScreen* screen: QGuiApplication::screens())
+    {
+        const qreal ratio = screen->devicePixelRatio();
+
+        if (!result.contains(ratio))
+        {
+            result.append(ratio);
+        }
+    }
+
+    if (result.isEmpty())
+    {
+        result.append(1.0);
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/**
+ * @brief Renders a batch of colored icons for all screen device pixel ratios.
+ *
+ * Pixmaps come from (and go into) the icon cache.
+ *
+ * @param requests The icons to render.
+ * @return One icon per request, in request order.
+ */
+auto UiUtils::colored_svg_icons(const QList<IconRequest>& requests) -> QList<QIcon>
+{
+    const QList<qreal> ratios = get_screen_device_pixel_ratios();
+    QList<QIcon> result;
+    result.reserve(requests.size());
+
+    for (const IconRequest& request: requests)
+    {
+        QIcon icon;
+
+        for (const qreal ratio: ratios)
+        {
+            icon.addPixmap(colored_svg_icon(request.svg_path, request.color, request.size, ratio));
+        }
+
+        result.append(icon);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Renders a batch of colored icons on a worker thread.
+ *
+ * The screen ratios are read on the calling thread. Results are inserted into the icon cache
+ * when they arrive, so later `colored_svg_icon()` calls for the same icons are cache hits.
+ * Without a context nothing is rendered: the callback could never be delivered.
+ *
+ * @param requests The icons to render.
+ * @param context The object whose thread and lifetime the callback is bound to.
+ * @param callback Receives one icon per request, in request order.
+ */
+auto UiUtils::colored_svg_icons_async(const QList<IconRequest>& requests, QObject* context,
+                                      IconsReadyCallback callback) -> void
+{
+    if (context == nullptr)
+    {
+        qWarning() << "[UiUtils] colored_svg_icons_async() needs a context object; ignoring"
+                   << requests.size() << "icon request(s)";
+    }
+    else
+    {
+        const QList<qreal> ratios = get_screen_device_pixel_ratios();
+
+        auto* watcher = new QFutureWatcher<QList<QList<QImage>>>(context);
+
+        const auto finish = [watcher, requests, ratios, callback = std::move(callback)]() {
+            const QList<QList<QImage>> images = watcher->result();
+            QList<QIcon> icons;
+            icons.reserve(requests.size());
+
+            for (qsizetype i = 0; i < requests.size(); ++i)
+            {
+                const IconRequest& request = requests.at(i);
+                QIcon icon;
+
+                for (qsizetype j = 0; j < ratios.size(); ++j)
+                {
+                    const QPixmap pixmap = QPixmap::fromImage(images.at(i).at(j));
+                    const QString key = pixmap_cache_key(request.svg_path, request.color,
+                                                         request.size, ratios.at(j));
+                    QPixmapCache::insert(key, pixmap);
+                    icon.addPixmap(pixmap);
+                }
+
+                icons.append(icon);
+            }
+
+            if (callback)
+            {
+                callback(icons);
+            }
+
+            watcher->deleteLater();
+        };
+
+        QObject::connect(watcher, &QFutureWatcherBase::finished, context, finish);
+        watcher->setFuture(QtConcurrent::run(
+            [requests, ratios]() { return render_icon_images(requests, ratios); }));
+    }
+}
+
+/**
+ * @brief Returns the hit and miss counters of the icon caches.
+ * @return The counters since the last reset.
+ */
+auto UiUtils::get_icon_cache_stats() -> IconCacheStats
+{
+    return icon_cache_state().stats;
+}
+
+/**
+ * @brief Resets the hit and miss counters of the icon caches.
+ */
+auto UiUtils::reset_icon_cache_stats() -> void
+{
+    icon_cache_state().stats = IconCacheStats();
+}
+
+/**
+ * @brief Removes all cached icons and parsed SVGs (e.g. after SVG files changed).
+ *
+ * No pixmap keys are tracked: the cache generation in every key is bumped instead, so the old
+ * pixmaps are never found again and `QPixmapCache` evicts them as least recently used. Other
+ * entries of the shared `QPixmapCache` are left alone.
+ */
+auto UiUtils::clear_icon_cache() -> void
+{
+    IconCacheState& state = icon_cache_state();
+    ++state.pixmap_generation;
+    state.renderers.clear();
+    state.renderer_order.clear();
+}
+
 }  // namespace QtWidgetsCommonLib
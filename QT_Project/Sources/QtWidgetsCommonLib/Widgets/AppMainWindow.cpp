@@ -1,5 +1,8 @@
 #include "QtWidgetsCommonLib/Widgets/AppMainWindow.h"
 
+#include <QEvent>
+
+#include "QtWidgetsCommonLib/Services/Preferences/BatchedMainWindowStatePersistence.h"
 #include "QtWidgetsCommonLib/Services/Preferences/IUiPreferences.h"
 #include "QtWidgetsCommonLib/Services/Translator.h"
 #include "QtWidgetsCommonLib/Utils/StylesheetLoader.h"
@@ -7,6 +10,13 @@
 namespace QtWidgetsCommonLib
 {
 
+namespace
+{
+
+constexpr int kWindowStateSnapshotIntervalMs = 30000;
+
+}  // namespace
+
 /**
  * @brief Constructs a AppMainWindow object.
  *
@@ -21,10 +31,26 @@ AppMainWindow::AppMainWindow(IUiPreferences* ui_preferences, QWidget* parent)
     : QMainWindow(parent),
       m_ui_preferences(ui_preferences),
       m_stylesheet_loader(new StylesheetLoader(this)),
+      m_stylesheet_path(QStringLiteral(":/Resources/style.qss")),
       m_translator(new Translator(this))
 {
     qDebug() << "AppMainWindow constructor started";
 
+    if (m_ui_preferences != nullptr)
+    {
+        m_window_state_persistence = new BatchedMainWindowStatePersistence(m_ui_preferences, this);
+        m_window_state_persistence->set_snapshot_interval(kWindowStateSnapshotIntervalMs);
+
+        // Snapshots before the restore would overwrite the saved state with the initial geometry
+        connect(m_window_state_persistence, &BatchedMainWindowStatePersistence::snapshotRequested,
+                this, [this]() {
+                    if (m_window_restored)
+                    {
+                        save_window_settings();
+                    }
+                });
+    }
+
     // Note: Old SIGNAL/SLOT syntax is required here because the signal is declared as a pure
     // virtual function in the interface and not as a real Qt signal. The new function pointer
     // syntax only works with signals declared in QObject-based classes using Q_OBJECT.
@@ -35,6 +61,29 @@ AppMainWindow::AppMainWindow(IUiPreferences* ui_preferences, QWidget* parent)
     connect(dynamic_cast<QObject*>(m_ui_preferences), SIGNAL(languageCodeChanged(QString)), this,
             SLOT(onLanguageCodeChanged(QString)));
 
+    // Startup pipeline: stylesheet and translation load concurrently while the UI is being built
+    if (m_ui_preferences != nullptr)
+    {
+        connect(m_stylesheet_loader, &StylesheetLoader::stylesheetReady, this,
+                [this](bool success) {
+                    if (!m_theme_applied)
+                    {
+                        m_theme_applied = true;
+                        qInfo() << "[AppMainWindow] Startup stylesheet applied:" << success;
+                    }
+                });
+        connect(m_translator, &Translator::translationLoadFinished, this, [this](bool success) {
+            if (!m_language_applied)
+            {
+                m_language_applied = true;
+                qInfo() << "[AppMainWindow] Startup translation applied:" << success;
+            }
+        });
+
+        start_stylesheet_load();
+        m_translator->load_translation_async(m_ui_preferences->get_language_code());
+    }
+
     qDebug() << "AppMainWindow constructor finished";
 }
 
@@ -75,14 +124,90 @@ auto AppMainWindow::get_translator() const -> Translator*
 }
 
 /**
- * @brief Saves the main window geometry, state, and window state to preferences.
+ * @brief Gets the batching window state persistence.
  *
- * This method saves the current geometry, state, and window state of the main window to the
- * preferences object if it is not null.
+ * @return Pointer to the persistence, or nullptr without preferences.
  */
-auto AppMainWindow::save_window_settings() -> void
+auto AppMainWindow::get_window_state_persistence() const -> BatchedMainWindowStatePersistence*
 {
+    return m_window_state_persistence;
+}
+
+/**
+ * @brief Sets the stylesheet file loaded with the preferences' theme.
+ *
+ * Before the window is first polished, this restarts the startup load with the new file;
+ * superseded loads are dropped by the stylesheet loader. Afterwards the file is loaded right away.
+ *
+ * @param file_path The path of the QSS file.
+ */
+auto AppMainWindow::set_stylesheet_path(const QString& file_path) -> void
+{
+    m_stylesheet_path = file_path;
+
     if (m_ui_preferences != nullptr)
+    {
+        if (!m_startup_finished)
+        {
+            m_theme_applied = false;
+            start_stylesheet_load();
+        }
+        else
+        {
+            m_stylesheet_loader->load_stylesheet(m_stylesheet_path, m_ui_preferences->get_theme());
+        }
+    }
+}
+
+/**
+ * @brief Returns the stylesheet file loaded with the preferences' theme.
+ * @return The path of the QSS file.
+ */
+auto AppMainWindow::get_stylesheet_path() const -> QString
+{
+    return m_stylesheet_path;
+}
+
+/**
+ * @brief Enables or disables the on-disk cache of resolved stylesheets.
+ *
+ * Resolved stylesheets are cached per (source hash, theme) to skip parsing on the next start.
+ * Before the window is first polished, this restarts the startup load so it already uses the
+ * cache.
+ *
+ * @param enabled True to enable, false to disable.
+ * @param directory The cache directory, or empty for `QStandardPaths::CacheLocation`.
+ */
+auto AppMainWindow::set_stylesheet_disk_cache_enabled(bool enabled,
+                                                      const QString& directory) -> void
+{
+    m_stylesheet_loader->enable_disk_cache(enabled, directory);
+
+    if (m_ui_preferences != nullptr && !m_startup_finished)
+    {
+        m_theme_applied = false;
+        start_stylesheet_load();
+    }
+}
+
+/**
+ * @brief Returns whether the on-disk cache of resolved stylesheets is enabled.
+ * @return true if stylesheet loads consult and fill the disk cache, false otherwise.
+ */
+auto AppMainWindow::is_stylesheet_disk_cache_enabled() const -> bool
+{
+    return m_stylesheet_loader->is_disk_cache_enabled();
+}
+
+/**
+ * @brief Stores the main window geometry, state, and window state for the next flush.
+ *
+ * The values go to the batching persistence, which writes them to the preferences object
+ * together and only if they changed.
+ */
+auto AppMainWindow::save_window_settings() -> void
+{
+    if (m_window_state_persistence != nullptr)
     {
         QWidget* tlw = topLevelWidget();
         QByteArray geometry;
@@ -99,9 +224,9 @@ auto AppMainWindow::save_window_settings() -> void
             wnd_state = static_cast<int>(windowState());
         }
 
-        m_ui_preferences->set_mainwindow_geometry(geometry);
-        m_ui_preferences->set_mainwindow_state(saveState());
-        m_ui_preferences->set_mainwindow_windowstate(wnd_state);
+        m_window_state_persistence->set_mainwindow_geometry(geometry);
+        m_window_state_persistence->set_mainwindow_state(saveState());
+        m_window_state_persistence->set_mainwindow_windowstate(wnd_state);
     }
     else
     {
@@ -118,11 +243,11 @@ auto AppMainWindow::save_window_settings() -> void
  */
 auto AppMainWindow::restore_window_settings() -> void
 {
-    if (m_ui_preferences != nullptr)
+    if (m_window_state_persistence != nullptr)
     {
-        const QByteArray geometry = m_ui_preferences->get_mainwindow_geometry();
-        const QByteArray state = m_ui_preferences->get_mainwindow_state();
-        int window_state = m_ui_preferences->get_mainwindow_windowstate();
+        const QByteArray geometry = m_window_state_persistence->get_mainwindow_geometry();
+        const QByteArray state = m_window_state_persistence->get_mainwindow_state();
+        int window_state = m_window_state_persistence->get_mainwindow_windowstate();
 
         QWidget* tlw = topLevelWidget();
 
@@ -161,11 +286,30 @@ auto AppMainWindow::restore_window_settings() -> void
     }
 }
 
+/**
+ * @brief Finishes the startup loads when the window is polished, before its first paint.
+ *
+ * The `Polish` event arrives before the window and its children are polished for the first time,
+ * so applying the stylesheet here avoids a second polish and repaint.
+ *
+ * @param event The event.
+ * @return true if the event was recognized; false otherwise.
+ */
+bool AppMainWindow::event(QEvent* event)
+{
+    if (event->type() == QEvent::Polish && !m_startup_finished)
+    {
+        finish_startup();
+    }
+
+    return QMainWindow::event(event);
+}
+
 /**
  * @brief Handles the show event of the main window.
  *
- * This method is called when the main window is shown. It checks if the theme has been applied
- * and loads the stylesheet based on the user's preferences.
+ * This method is called when the main window is shown. It restores the saved window geometry and
+ * state once; theme and language are already applied by the startup pipeline.
  *
  * @param event The show event.
  */
@@ -179,25 +323,9 @@ void AppMainWindow::showEvent(QShowEvent* event)
         m_window_restored = true;
     }
 
-    if (m_ui_preferences != nullptr)
+    if (!m_startup_finished)
     {
-        if (!m_theme_applied)
-        {
-            const QString theme = m_ui_preferences->get_theme();
-            m_stylesheet_loader->load_stylesheet(
-                "D:/Projects/VS_Projects/Qt-LogViewer/QT_Project/Resources/style.qss", theme);
-            m_theme_applied = true;
-            qInfo() << "[AppMainWindow] Loaded theme from preferences (showEvent):" << theme;
-        }
-
-        if (!m_language_applied)
-        {
-            const QString language_code = m_ui_preferences->get_language_code();
-            m_translator->load_translation(language_code);
-            m_language_applied = true;
-            qInfo() << "[AppMainWindow] Loaded language from preferences (showEvent):"
-                    << language_code;
-        }
+        finish_startup();
     }
 }
 
@@ -205,16 +333,52 @@ void AppMainWindow::showEvent(QShowEvent* event)
  * @brief Handles the close event of the main window.
  *
  * This method is called when the main window is closed. It saves the current window geometry,
- * state, and window state to preferences.
+ * state, and window state to preferences in one batch; nothing is written if they are unchanged
+ * since the last snapshot.
  *
  * @param event The close event.
  */
 void AppMainWindow::closeEvent(QCloseEvent* event)
 {
     save_window_settings();
+
+    if (m_window_state_persistence != nullptr)
+    {
+        m_window_state_persistence->flush();
+    }
+
     QMainWindow::closeEvent(event);
 }
 
+/**
+ * @brief Starts loading the stylesheet with the preferences' theme on a worker thread.
+ */
+auto AppMainWindow::start_stylesheet_load() -> void
+{
+    const QString theme = m_ui_preferences->get_theme();
+    m_stylesheet_loader->load_stylesheet_async(m_stylesheet_path, theme);
+    qInfo() << "[AppMainWindow] Loading theme from preferences:" << theme << "from"
+            << m_stylesheet_path;
+}
+
+/**
+ * @brief Applies the startup stylesheet and translation loads before the first polish.
+ *
+ * Blocks on the worker threads only, without a local event loop, so no timers, sockets or
+ * deferred deletes of the application run in between. The loads only read and parse files, so
+ * the wait is short; results that are already there are applied without waiting.
+ */
+auto AppMainWindow::finish_startup() -> void
+{
+    m_startup_finished = true;
+
+    if (m_ui_preferences != nullptr)
+    {
+        m_stylesheet_loader->wait_for_async_loads();
+        m_translator->wait_for_translation_load();
+    }
+}
+
 /**
  * @brief Slot: Handles language code changes.
  *
@@ -225,8 +389,7 @@ void AppMainWindow::closeEvent(QCloseEvent* event)
  */
 void AppMainWindow::onLanguageCodeChanged(const QString& language_code)
 {
-    QMap<QString, QString> code_name_map = m_translator->get_language_code_name_map();
-    QString language_name = code_name_map.value(language_code);
+    QString language_name = m_translator->get_language_name(language_code);
 
     if (!language_name.isEmpty())
     {
@@ -243,6 +406,7 @@ void AppMainWindow::onLanguageCodeChanged(const QString& language_code)
         qWarning() << "[AppMainWindow] Language name for language code not found:" << language_code;
     }
 
+    m_language_applied = true;
     m_translator->load_translation(language_code);
 }
 
@@ -256,17 +420,7 @@ void AppMainWindow::onLanguageCodeChanged(const QString& language_code)
  */
 void AppMainWindow::onLanguageNameChanged(const QString& language_name)
 {
-    QMap<QString, QString> code_name_map = m_translator->get_language_code_name_map();
-    QString found_code;
-
-    for (auto it = code_name_map.begin(); it != code_name_map.end(); ++it)
-    {
-        if (it.value().compare(language_name, Qt::CaseInsensitive) == 0)
-        {
-            found_code = it.key();
-            break;
-        }
-    }
+    QString found_code = m_translator->get_language_code(language_name);
 
     if (!found_code.isEmpty())
     {
@@ -278,6 +432,7 @@ void AppMainWindow::onLanguageNameChanged(const QString& language_name)
             obj->blockSignals(false);
         }
 
+        m_language_applied = true;
         m_translator->load_translation(found_code);
     }
     else
@@ -296,7 +451,8 @@ void AppMainWindow::onLanguageNameChanged(const QString& language_name)
  */
 void AppMainWindow::onThemeChanged(const QString& theme_name)
 {
-    m_stylesheet_loader->load_stylesheet(":/Resources/style.qss", theme_name);
+    m_theme_applied = true;
+    m_stylesheet_loader->load_stylesheet(m_stylesheet_path, theme_name);
 }
 
 }  // namespace QtWidgetsCommonLib
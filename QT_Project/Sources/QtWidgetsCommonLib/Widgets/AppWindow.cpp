@@ -1,14 +1,25 @@
 #include "QtWidgetsCommonLib/Widgets/AppWindow.h"
 
+#include <QAction>
 #include <QApplication>
 #include <QCursor>
+#include <QEvent>
 #include <QMenu>
 #include <QMenuBar>
 #include <QPushButton>
+#include <QRectF>
 #include <QScreen>
+#include <QShortcut>
+#include <QTimer>
 #include <QVBoxLayout>
 #include <QWindow>
+#include <algorithm>
+#include <iterator>
+#include <utility>
 
+#include "QtWidgetsCommonLib/Utils/NativeIconCache.h"
+#include "QtWidgetsCommonLib/Utils/Trace.h"
+#include "QtWidgetsCommonLib/Widgets/PerformanceOverlay.h"
 #include "QtWidgetsCommonLib/Widgets/WindowTitleBar.h"
 
 #ifdef Q_OS_WIN
@@ -127,100 +138,134 @@ enum class dwm_system_backdrop_type : DWORD
 }
 
 /**
- * @brief Convert QPixmap to HICON (fallback if QtWinExtras not available).
+ * @struct class_icon_handles
+ * @brief Icon handles set on the window class, shared by all top-level Qt windows.
  *
- * Creates a 32bpp ARGB HICON from a QPixmap by creating a DIB section,
- * copying pixels (BGRA) and constructing an ICON via CreateIconIndirect.
- *
- * This function follows the project rule: single return at the end, and all control
- * structures use braces.
+ * They hold their own references into the native icon cache, so closing the window that set
+ * them does not destroy icons the class still uses.
+ */
+struct class_icon_handles {
+        HICON small_icon = nullptr;
+        HICON big_icon = nullptr;
+};
+
+/**
+ * @brief Get the icon handles currently set on the window class.
  *
- * @param pixmap Source pixmap.
- * @return HICON HICON handle (or nullptr on failure).
+ * @return class_icon_handles& Reference to the static handles.
  */
-[[nodiscard]] static HICON create_hicon_from_pixmap(const QPixmap& pixmap)
+[[nodiscard]] static auto get_class_icon_handles() -> class_icon_handles&
 {
-    HICON h_icon = nullptr;
-
-    if (!pixmap.isNull())
-    {
-        QImage image = pixmap.toImage().convertToFormat(QImage::Format_ARGB32);
-        const int width = image.width();
-        const int height = image.height();
-
-        // Prepare BITMAPV5HEADER for 32bpp RGBA
-        BITMAPV5HEADER bi{};
-        bi.bV5Size = sizeof(BITMAPV5HEADER);
-        bi.bV5Width = width;
-        bi.bV5Height = -height;  // top-down
-        bi.bV5Planes = 1;
-        bi.bV5BitCount = 32;
-        bi.bV5Compression = BI_BITFIELDS;
-        bi.bV5RedMask = 0x00FF0000;
-        bi.bV5GreenMask = 0x0000FF00;
-        bi.bV5BlueMask = 0x000000FF;
-        bi.bV5AlphaMask = 0xFF000000;
-
-        void* pv_bits = nullptr;
-        HBITMAP h_bitmap = nullptr;
-        HBITMAP h_mask = nullptr;
-
-        HDC screen_dc = GetDC(nullptr);
-
-        h_bitmap = CreateDIBSection(screen_dc, reinterpret_cast<BITMAPINFO*>(&bi), DIB_RGB_COLORS,
-                                    &pv_bits, nullptr, 0);
-
-        ReleaseDC(nullptr, screen_dc);
-
-        if (h_bitmap && pv_bits)
-        {
-            // copy pixels (BGRA)
-            const uint8_t* src_pixels = image.constBits();
-            const int src_stride = image.bytesPerLine();
-            const int dst_stride = width * 4;
-
-            for (int y = 0; y < height; ++y)
-            {
-                uint8_t* dest_row = reinterpret_cast<uint8_t*>(pv_bits) + y * dst_stride;
-                const uint8_t* src_row = src_pixels + y * src_stride;
-
-                for (int x = 0; x < width; ++x)
-                {
-                    const QRgb px = reinterpret_cast<const QRgb*>(src_row)[x];
-                    dest_row[x * 4 + 0] = qBlue(px);
-                    dest_row[x * 4 + 1] = qGreen(px);
-                    dest_row[x * 4 + 2] = qRed(px);
-                    dest_row[x * 4 + 3] = qAlpha(px);
-                }
-            }
-
-            // Create an empty monochrome mask bitmap
-            h_mask = CreateBitmap(width, height, 1, 1, nullptr);
+    static class_icon_handles handles;
+    return handles;
+}
 
-            if (h_mask)
-            {
-                ICONINFO ii{};
-                ii.fIcon = TRUE;
-                ii.hbmMask = h_mask;
-                ii.hbmColor = h_bitmap;
+#if defined(QTWIDGETSCOMMONLIB_ENABLE_TRACING)
+/**
+ * @brief Returns the trace name of a native message.
+ *
+ * The names are literals, as the tracer requires; messages without their own name are counted
+ * together.
+ *
+ * @param message The message id.
+ * @return The message name, e.g. "WM_NCHITTEST", or "other".
+ */
+[[nodiscard]] static auto native_message_name(UINT message) -> const char*
+{
+    static constexpr std::pair<UINT, const char*> kNames[] = {
+        {WM_NCHITTEST, "WM_NCHITTEST"},
+        {WM_NCCALCSIZE, "WM_NCCALCSIZE"},
+        {WM_NCACTIVATE, "WM_NCACTIVATE"},
+        {WM_NCMOUSEMOVE, "WM_NCMOUSEMOVE"},
+        {WM_SETCURSOR, "WM_SETCURSOR"},
+        {WM_MOUSEMOVE, "WM_MOUSEMOVE"},
+        {WM_PAINT, "WM_PAINT"},
+        {WM_ERASEBKGND, "WM_ERASEBKGND"},
+        {WM_SIZE, "WM_SIZE"},
+        {WM_MOVE, "WM_MOVE"},
+        {WM_WINDOWPOSCHANGING, "WM_WINDOWPOSCHANGING"},
+        {WM_WINDOWPOSCHANGED, "WM_WINDOWPOSCHANGED"},
+        {WM_GETMINMAXINFO, "WM_GETMINMAXINFO"},
+        {WM_ENTERSIZEMOVE, "WM_ENTERSIZEMOVE"},
+        {WM_EXITSIZEMOVE, "WM_EXITSIZEMOVE"},
+        {WM_DPICHANGED, "WM_DPICHANGED"},
+        {WM_SETTINGCHANGE, "WM_SETTINGCHANGE"},
+        {WM_DWMCOMPOSITIONCHANGED, "WM_DWMCOMPOSITIONCHANGED"},
+        {WM_TIMER, "WM_TIMER"},
+    };
+
+    const auto it = std::find_if(std::cbegin(kNames), std::cend(kNames),
+                                 [message](const auto& entry) { return entry.first == message; });
+    return it != std::cend(kNames) ? it->second : "other";
+}
+#endif
 
-                h_icon = CreateIconIndirect(&ii);
-            }
+/**
+ * @brief Returns whether an event on a watched title bar widget can move a hit-test region.
+ *
+ * @param type The event type.
+ * @return bool True for geometry, visibility, child and action changes.
+ */
+[[nodiscard]] static auto affects_hit_test_regions(QEvent::Type type) -> bool
+{
+    const bool result = type == QEvent::Move || type == QEvent::Resize || type == QEvent::Show ||
+                        type == QEvent::Hide || type == QEvent::LayoutRequest ||
+                        type == QEvent::ChildAdded || type == QEvent::ChildRemoved ||
+                        type == QEvent::ActionAdded || type == QEvent::ActionChanged ||
+                        type == QEvent::ActionRemoved;
+    return result;
+}
 
-            // system makes copies; safe to delete bitmaps now
-            if (h_bitmap)
-            {
-                DeleteObject(h_bitmap);
-            }
+/**
+ * @brief Convert a hit-test region to the matching WM_NCHITTEST result.
+ *
+ * @param region The region from the hit-test region map.
+ * @return LRESULT Hit-test code (HT*).
+ */
+[[nodiscard]] static auto to_hit_test_code(QtWidgetsCommonLib::HitTestRegionMap::Region region)
+    -> LRESULT
+{
+    using Region = QtWidgetsCommonLib::HitTestRegionMap::Region;
+    LRESULT result = HTCLIENT;
 
-            if (h_mask)
-            {
-                DeleteObject(h_mask);
-            }
-        }
+    if (region == Region::Caption)
+    {
+        result = HTCAPTION;
+    }
+    else if (region == Region::TopLeft)
+    {
+        result = HTTOPLEFT;
+    }
+    else if (region == Region::TopRight)
+    {
+        result = HTTOPRIGHT;
+    }
+    else if (region == Region::BottomLeft)
+    {
+        result = HTBOTTOMLEFT;
+    }
+    else if (region == Region::BottomRight)
+    {
+        result = HTBOTTOMRIGHT;
+    }
+    else if (region == Region::Top)
+    {
+        result = HTTOP;
+    }
+    else if (region == Region::Bottom)
+    {
+        result = HTBOTTOM;
+    }
+    else if (region == Region::Left)
+    {
+        result = HTLEFT;
+    }
+    else if (region == Region::Right)
+    {
+        result = HTRIGHT;
     }
 
-    return h_icon;
+    return result;
 }
 }  // namespace
 
@@ -270,10 +315,30 @@ AppWindow::AppWindow(QWidget* parent, QWidget* content_widget, WindowTitleBar* t
 
 #ifdef Q_OS_WIN
     createWinId();
+    refresh_non_client_metrics();
 
+    if (windowHandle() != nullptr)
+    {
+        connect(windowHandle(), &QWindow::screenChanged, this,
+                [this](QScreen*) { refresh_non_client_metrics(); });
+    }
+
+    m_live_resize_timer = new QTimer(this);
+    m_live_resize_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_live_resize_timer, &QTimer::timeout, this, &AppWindow::apply_live_resize_frame);
+
+    m_dwm_update_timer = new QTimer(this);
+    m_dwm_update_timer->setSingleShot(true);
+    m_dwm_update_timer->setInterval(0);
+    connect(m_dwm_update_timer, &QTimer::timeout, this, &AppWindow::apply_dwm_attributes);
+
+    // Also extends the DWM frame and applies the initial user prefs (mica/corners)
     enable_native_window_styles();
-    extend_frame_into_client_area();  // remove white borders from DWM
-    enable_win11_features();          // apply initial user prefs (mica/corners)
+
+    if (!m_title_bar.isNull())
+    {
+        m_title_bar->installEventFilter(this);
+    }
 #endif
 
     // Connect title bar signals (cross-platform)
@@ -289,22 +354,16 @@ AppWindow::AppWindow(QWidget* parent, QWidget* content_widget, WindowTitleBar* t
 /**
  * @brief Destructor.
  *
- * Cleans up any native resources allocated by the AppWindow (HICONs).
+ * Releases the native icon handles of the AppWindow.
  */
 AppWindow::~AppWindow()
 {
 #ifdef Q_OS_WIN
-    if (m_hicon_small)
-    {
-        DestroyIcon(m_hicon_small);
-        m_hicon_small = nullptr;
-    }
-
-    if (m_hicon_big)
-    {
-        DestroyIcon(m_hicon_big);
-        m_hicon_big = nullptr;
-    }
+    NativeIconCache& icon_cache = NativeIconCache::shared();
+    icon_cache.release(m_hicon_small);
+    icon_cache.release(m_hicon_big);
+    m_hicon_small = nullptr;
+    m_hicon_big = nullptr;
 
     // nothing special here; Qt will destroy native window
     Q_UNUSED(nativeWindowHandle());
@@ -338,6 +397,12 @@ auto AppWindow::set_central_widget(QWidget* widget) -> void
             layout()->addWidget(m_content_widget);
             m_content_widget->setParent(this);
         }
+
+        // The new content is stacked above older children; keep the overlay on top
+        if (!m_performance_overlay.isNull())
+        {
+            m_performance_overlay->raise();
+        }
     }
 }
 
@@ -346,7 +411,8 @@ auto AppWindow::set_central_widget(QWidget* widget) -> void
  * @brief Set the application / window icon.
  *
  * On Windows this will set both the Qt window icon and the native HWND icons
- * (small and big) so the taskbar shows the correct icon immediately.
+ * (small and big) so the taskbar shows the correct icon immediately. The native handles are
+ * shared through `NativeIconCache`, so icons already used by any window cost no new HICON.
  *
  * @param icon QIcon to use for the window.
  */
@@ -365,66 +431,89 @@ void AppWindow::set_app_icon(const QIcon& icon)
         }
     }
 
+    m_app_icon = icon;
+
     // Ensure native window exists
     createWinId();
+    update_native_icons();
+}
+
+/**
+ * @brief Set the native small and big icons from `m_app_icon` for the window DPI.
+ *
+ * Sizes follow SM_CXSMICON and SM_CXICON for the DPI. The new handles are acquired from the
+ * shared cache (created only on a miss) and set before the previous ones are released, so the
+ * window never refers to a destroyed icon. A size without a handle (null icon, failed conversion)
+ * keeps the icon the window already has.
+ */
+auto AppWindow::update_native_icons() -> void
+{
     HWND hwnd = nativeWindowHandle();
 
     if (IsWindow(hwnd))
     {
-        // create HICONs for small and big sizes
-        const QPixmap small_pm = icon.pixmap(16, 16);
-        const QPixmap big_pm = icon.pixmap(32, 32);
+        NativeIconCache& icon_cache = NativeIconCache::shared();
+        const UINT dpi = get_window_dpi(hwnd);
+        const int small_size = static_cast<int>(GetSystemMetricsForDpi(SM_CXSMICON, dpi));
+        const int big_size = static_cast<int>(GetSystemMetricsForDpi(SM_CXICON, dpi));
+        const int dpi_key = static_cast<int>(dpi);
+
+        HICON small_icon =
+            static_cast<HICON>(icon_cache.acquire(m_app_icon, small_size, dpi_key));
+        HICON big_icon = static_cast<HICON>(icon_cache.acquire(m_app_icon, big_size, dpi_key));
 
-        // destroy previous icons if present
-        if (m_hicon_small)
+        if (small_icon && small_icon != m_hicon_small)
         {
-            DestroyIcon(m_hicon_small);
-            m_hicon_small = nullptr;
+            SendMessageW(hwnd, WM_SETICON, ICON_SMALL, reinterpret_cast<LPARAM>(small_icon));
         }
 
-        if (m_hicon_big)
+        if (big_icon && big_icon != m_hicon_big)
         {
-            DestroyIcon(m_hicon_big);
-            m_hicon_big = nullptr;
+            SendMessageW(hwnd, WM_SETICON, ICON_BIG, reinterpret_cast<LPARAM>(big_icon));
         }
 
-        // Try QtWinExtras first (if available). Otherwise fallback to our converter.
-#if defined(QT_WINEXTRAS_LIB)
-        m_hicon_small = QtWin::toHICON(small_pm);
-        m_hicon_big = QtWin::toHICON(big_pm);
-        if (!m_hicon_small)
+        // also set the class icons so the taskbar picks it up immediately
+        class_icon_handles& class_icons = get_class_icon_handles();
+
+        if (big_icon && big_icon != class_icons.big_icon)
         {
-            m_hicon_small = create_hicon_from_pixmap(small_pm);
+            SetClassLongPtrW(hwnd, GCLP_HICON, reinterpret_cast<LONG_PTR>(big_icon));
+            static_cast<void>(icon_cache.acquire(m_app_icon, big_size, dpi_key));
+            icon_cache.release(class_icons.big_icon);
+            class_icons.big_icon = big_icon;
         }
-        if (!m_hicon_big)
+
+        if (small_icon && small_icon != class_icons.small_icon)
         {
-            m_hicon_big = create_hicon_from_pixmap(big_pm);
+            SetClassLongPtrW(hwnd, GCLP_HICONSM, reinterpret_cast<LONG_PTR>(small_icon));
+            static_cast<void>(icon_cache.acquire(m_app_icon, small_size, dpi_key));
+            icon_cache.release(class_icons.small_icon);
+            class_icons.small_icon = small_icon;
         }
-#else
-        m_hicon_small = create_hicon_from_pixmap(small_pm);
-        m_hicon_big = create_hicon_from_pixmap(big_pm);
-#endif
 
-        if (m_hicon_small)
+        // Release the previous handles only where they were replaced; otherwise drop the
+        // reference acquired above (a no-op for a null handle)
+        if (small_icon && small_icon != m_hicon_small)
         {
-            SendMessageW(hwnd, WM_SETICON, ICON_SMALL, reinterpret_cast<LPARAM>(m_hicon_small));
+            icon_cache.release(m_hicon_small);
+            m_hicon_small = small_icon;
         }
-
-        if (m_hicon_big)
+        else
         {
-            SendMessageW(hwnd, WM_SETICON, ICON_BIG, reinterpret_cast<LPARAM>(m_hicon_big));
+            icon_cache.release(small_icon);
         }
 
-        // also set the class icons so the taskbar picks it up immediately
-        if (m_hicon_big)
+        if (big_icon && big_icon != m_hicon_big)
         {
-            SetClassLongPtrW(hwnd, GCLP_HICON, reinterpret_cast<LONG_PTR>(m_hicon_big));
+            icon_cache.release(m_hicon_big);
+            m_hicon_big = big_icon;
         }
-
-        if (m_hicon_small)
+        else
         {
-            SetClassLongPtrW(hwnd, GCLP_HICONSM, reinterpret_cast<LONG_PTR>(m_hicon_small));
+            icon_cache.release(big_icon);
         }
+
+        m_icon_dpi = dpi;
     }
 }
 #else
@@ -466,8 +555,11 @@ auto AppWindow::set_app_title(const QString& title) -> void
 auto AppWindow::set_use_mica(bool enabled) -> void
 {
 #ifdef Q_OS_WIN
-    m_use_mica = enabled;
-    enable_win11_features();
+    if (m_use_mica != enabled)
+    {
+        m_use_mica = enabled;
+        schedule_dwm_update();
+    }
 #else
     Q_UNUSED(enabled);
 #endif
@@ -498,8 +590,11 @@ auto AppWindow::set_use_mica(bool enabled) -> void
 auto AppWindow::set_use_rounded_corners(bool enabled) -> void
 {
 #ifdef Q_OS_WIN
-    m_use_rounded_corners = enabled;
-    enable_win11_features();
+    if (m_use_rounded_corners != enabled)
+    {
+        m_use_rounded_corners = enabled;
+        schedule_dwm_update();
+    }
 #else
     Q_UNUSED(enabled);
 #endif
@@ -519,6 +614,129 @@ auto AppWindow::set_use_rounded_corners(bool enabled) -> void
 #endif
 }
 
+/**
+ * @brief Enable/disable throttled content relayout while the user resizes the window.
+ *
+ * Disabling during a live resize returns the central widget to the layout immediately.
+ *
+ * @param enabled True to throttle content relayout during live resize.
+ */
+auto AppWindow::set_live_resize_throttling(bool enabled) -> void
+{
+#ifdef Q_OS_WIN
+    m_live_resize_throttling = enabled;
+
+    if (!enabled && m_in_live_resize)
+    {
+        end_live_resize();
+    }
+#else
+    Q_UNUSED(enabled);
+#endif
+}
+
+/**
+ * @brief Query whether live resize throttling is enabled.
+ *
+ * @return bool True if throttling is enabled, false otherwise.
+ */
+auto AppWindow::get_live_resize_throttling() const noexcept -> bool
+{
+    bool result = m_live_resize_throttling;
+    return result;
+}
+
+/**
+ * @brief Returns the rendered and dropped content frames of throttled live resizes.
+ *
+ * @return LiveResizeStats Counters accumulated since construction or the last reset.
+ */
+auto AppWindow::get_live_resize_stats() const noexcept -> LiveResizeStats
+{
+    LiveResizeStats result = m_live_resize_stats;
+    return result;
+}
+
+/**
+ * @brief Reset the live resize frame counters to zero.
+ */
+auto AppWindow::reset_live_resize_stats() -> void
+{
+    m_live_resize_stats = LiveResizeStats{};
+}
+
+/**
+ * @brief Show or hide the performance overlay in the bottom-right corner.
+ *
+ * The overlay is created on enable and deleted on disable, so a disabled overlay costs nothing.
+ *
+ * @param enabled True to show the overlay, false to delete it.
+ */
+auto AppWindow::set_performance_overlay_enabled(bool enabled) -> void
+{
+    if (enabled && m_performance_overlay.isNull())
+    {
+        m_performance_overlay = new PerformanceOverlay(this);
+        m_performance_overlay->show();
+    }
+    else if (!enabled && !m_performance_overlay.isNull())
+    {
+        delete m_performance_overlay;
+    }
+}
+
+/**
+ * @brief Query whether the performance overlay is shown.
+ *
+ * @return bool True if the overlay is enabled, false otherwise.
+ */
+auto AppWindow::get_performance_overlay_enabled() const noexcept -> bool
+{
+    bool result = !m_performance_overlay.isNull();
+    return result;
+}
+
+/**
+ * @brief Set a window shortcut that toggles the performance overlay.
+ *
+ * @param shortcut The key sequence, or an empty sequence to remove the shortcut.
+ */
+auto AppWindow::set_performance_overlay_shortcut(const QKeySequence& shortcut) -> void
+{
+    if (shortcut.isEmpty())
+    {
+        delete m_performance_overlay_shortcut;
+        m_performance_overlay_shortcut = nullptr;
+    }
+    else if (m_performance_overlay_shortcut == nullptr)
+    {
+        m_performance_overlay_shortcut = new QShortcut(shortcut, this);
+        connect(m_performance_overlay_shortcut, &QShortcut::activated, this,
+                [this]() { set_performance_overlay_enabled(!get_performance_overlay_enabled()); });
+    }
+    else
+    {
+        m_performance_overlay_shortcut->setKey(shortcut);
+    }
+}
+
+/**
+ * @brief Returns the shortcut that toggles the performance overlay.
+ *
+ * @return QKeySequence The key sequence, empty if none is set.
+ */
+auto AppWindow::get_performance_overlay_shortcut() const -> QKeySequence
+{
+    QKeySequence result;
+
+    if (m_performance_overlay_shortcut != nullptr)
+    {
+        result = m_performance_overlay_shortcut->key();
+    }
+
+    return result;
+}
+
 /**
  * @brief Returns the WindowTitleBar instance.
  *
@@ -555,37 +773,49 @@ auto AppWindow::set_adopt_menubar(bool enabled, WindowTitleBar::RowPosition row)
 /**
  * @brief Returns the system resize border thickness in pixels (DPI-aware).
  *
- * Uses SM_CXSIZEFRAME + SM_CXPADDEDBORDER scaled for the window's DPI.
+ * SM_CXSIZEFRAME + SM_CXPADDEDBORDER scaled for the window's DPI, taken from the cached
+ * non-client metrics.
  *
  * @return int Total border width in pixels for the current DPI.
  */
 auto AppWindow::system_resize_border_width() const noexcept -> int
 {
-    HWND hwnd = nativeWindowHandle();
-    const UINT dpi = get_window_dpi(hwnd);
-
-    const int cx_size_frame = static_cast<int>(GetSystemMetricsForDpi(SM_CXSIZEFRAME, dpi));
-    const int cx_padded_border = static_cast<int>(GetSystemMetricsForDpi(SM_CXPADDEDBORDER, dpi));
-    const int result = cx_size_frame + cx_padded_border;
-
+    const int result = m_non_client_metrics.resize_border_width;
     return result;
 }
 
 /**
  * @brief Returns the system caption (titlebar) height in pixels (DPI-aware).
  *
- * Uses SM_CYCAPTION scaled for the window's DPI.
+ * SM_CYCAPTION scaled for the window's DPI, taken from the cached non-client metrics.
  *
  * @return int Caption height in pixels for the current DPI.
  */
 auto AppWindow::system_caption_height() const noexcept -> int
 {
-    HWND hwnd = nativeWindowHandle();
-    const UINT dpi = get_window_dpi(hwnd);
+    const int result = m_non_client_metrics.caption_height;
+    return result;
+}
 
-    const int result = static_cast<int>(GetSystemMetricsForDpi(SM_CYCAPTION, dpi));
+/**
+ * @brief Re-read the window DPI and the DPI-scaled system metrics.
+ *
+ * Called once the native window exists and again on WM_DPICHANGED, WM_SETTINGCHANGE and when
+ * the window moves to another screen. Also marks the hit-test regions as outdated.
+ */
+auto AppWindow::refresh_non_client_metrics() -> void
+{
+    const UINT dpi = get_window_dpi(nativeWindowHandle());
 
-    return result;
+    const int cx_size_frame = static_cast<int>(GetSystemMetricsForDpi(SM_CXSIZEFRAME, dpi));
+    const int cx_padded_border = static_cast<int>(GetSystemMetricsForDpi(SM_CXPADDEDBORDER, dpi));
+
+    m_non_client_metrics.dpi = dpi;
+    m_non_client_metrics.resize_border_width = cx_size_frame + cx_padded_border;
+    m_non_client_metrics.caption_height =
+        static_cast<int>(GetSystemMetricsForDpi(SM_CYCAPTION, dpi));
+
+    m_hit_test_regions.invalidate();
 }
 
 /**
@@ -617,8 +847,9 @@ auto AppWindow::enable_native_window_styles() -> void
         SetWindowPos(hwnd, nullptr, 0, 0, 0, 0,
                      SWP_FRAMECHANGED | SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE);
 
-        extend_frame_into_client_area();
-        enable_win11_features();
+        // The frame change may reset the DWM frame, so apply every attribute again
+        m_dwm_state.invalidate();
+        apply_dwm_attributes();
     }
 }
 
@@ -672,8 +903,10 @@ auto AppWindow::extend_frame_into_client_area() -> void
  * Applies rounded corners and optional Mica backdrop, gated by runtime availability and
  * the user preferences set via set_use_mica() and set_use_rounded_corners().
  * Also attempts to enable immersive dark mode for borders/caption where supported.
+ *
+ * @param changes The attributes to apply; all others are left untouched.
  */
-auto AppWindow::enable_win11_features() -> void
+auto AppWindow::enable_win11_features(const DwmAttributeState::Changes& changes) -> void
 {
     HWND hwnd = nativeWindowHandle();
 
@@ -682,7 +915,7 @@ auto AppWindow::enable_win11_features() -> void
         const auto& f = get_dwm_functions();
 
         // Corner preference (Windows 11)
-        if (f.dwm_set_window_attribute)
+        if (changes.corner_preference && f.dwm_set_window_attribute)
         {
             const dwm_window_corner_pref pref = m_use_rounded_corners
                                                     ? dwm_window_corner_pref::round
@@ -694,7 +927,7 @@ auto AppWindow::enable_win11_features() -> void
         }
 
         // Try immersive dark mode (Win10+ attribute, not always available)
-        if (f.dwm_set_window_attribute)
+        if (changes.dark_mode && f.dwm_set_window_attribute)
         {
             BOOL enable_dark = TRUE;
 
@@ -709,7 +942,7 @@ auto AppWindow::enable_win11_features() -> void
         }
 
         // Mica/system backdrop (Windows 11)
-        if (f.dwm_set_window_attribute)
+        if (changes.backdrop && f.dwm_set_window_attribute)
         {
             if (m_use_mica)
             {
@@ -745,210 +978,288 @@ auto AppWindow::enable_win11_features() -> void
 }
 
 /**
- * @brief Map a global (screen) point to local titlebar coordinates.
+ * @brief Apply the DWM attributes that differ from the last applied snapshot.
+ *
+ * The desired values follow the user preferences; only changed attributes cross into DWM.
+ */
+auto AppWindow::apply_dwm_attributes() -> void
+{
+    if (m_dwm_update_timer != nullptr)
+    {
+        m_dwm_update_timer->stop();
+    }
+
+    DwmAttributeState::Attributes desired = m_dwm_state.get_desired();
+    desired.rounded_corners = m_use_rounded_corners;
+    desired.mica = m_use_mica;
+    m_dwm_state.set_desired(desired);
+
+    if (IsWindow(nativeWindowHandle()))
+    {
+        const DwmAttributeState::Changes changes = m_dwm_state.get_pending_changes();
+
+        if (changes.frame)
+        {
+            extend_frame_into_client_area();
+        }
+
+        if (changes.corner_preference || changes.dark_mode || changes.backdrop)
+        {
+            enable_win11_features(changes);
+        }
+
+        m_dwm_state.mark_applied(changes);
+    }
+}
+
+/**
+ * @brief Apply the DWM attributes at the end of the current event loop turn.
+ */
+auto AppWindow::schedule_dwm_update() -> void
+{
+    if (m_dwm_update_timer != nullptr)
+    {
+        m_dwm_update_timer->start();
+    }
+    else
+    {
+        apply_dwm_attributes();
+    }
+}
+
+/**
+ * @brief Detach the central widget from the layout and start the frame timer.
  *
- * Returns a large negative point when title bar is not available to avoid accidental matches.
+ * The timer interval follows the refresh rate of the window's screen (60 Hz if unknown). The
+ * title bar stays in the layout and keeps following every size step.
+ */
+auto AppWindow::begin_live_resize() -> void
+{
+    m_in_live_resize = true;
+    m_pending_resize_steps = 0;
+    m_live_resize_minimum_size = minimumSize();
+
+    if (m_content_widget != nullptr)
+    {
+        layout()->removeWidget(m_content_widget);
+    }
+
+    const qreal refresh_rate = (screen() != nullptr) ? screen()->refreshRate() : 0.0;
+    const qreal frame_rate = (refresh_rate > 0.0) ? refresh_rate : 60.0;
+    m_live_resize_timer->start(qMax(1, qRound(1000.0 / frame_rate)));
+}
+
+/**
+ * @brief Apply the pending size steps to the central widget as one frame.
  *
- * @param global_x Global X coordinate in screen space.
- * @param global_y Global Y coordinate in screen space.
- * @return QPoint Local coordinates relative to the title bar (or a sentinel negative point).
+ * The central widget fills the area below the title bar, as the window layout would place it.
+ * All but one of the coalesced size steps count as dropped frames.
  */
-auto AppWindow::map_global_to_titlebar_local(int global_x, int global_y) const -> QPoint
+auto AppWindow::apply_live_resize_frame() -> void
 {
-    QPoint global(global_x, global_y);
-    QPoint local = m_title_bar ? m_title_bar->mapFromGlobal(global) : QPoint(-10000, -10000);
-    return local;
+    if (m_pending_resize_steps > 0)
+    {
+        if (m_content_widget != nullptr)
+        {
+            const int top = m_title_bar ? m_title_bar->geometry().bottom() + 1 : 0;
+            m_content_widget->setGeometry(0, top, width(), qMax(0, height() - top));
+        }
+
+        ++m_live_resize_stats.frames_rendered;
+        m_live_resize_stats.frames_dropped += m_pending_resize_steps - 1;
+        m_pending_resize_steps = 0;
+    }
 }
 
 /**
- * @brief Handle WM_NCCALCSIZE - remove the standard non-client frame.
+ * @brief Stop the frame timer and return the central widget to the layout.
  *
- * Returning 0 indicates we've handled the sizing and the whole window is client area.
+ * Pending size steps are applied first; re-adding the widget then lays it out at the final size.
+ */
+auto AppWindow::end_live_resize() -> void
+{
+    m_live_resize_timer->stop();
+    apply_live_resize_frame();
+
+    // set_central_widget() may have added a new widget to the layout in the meantime
+    if (m_content_widget != nullptr && layout()->indexOf(m_content_widget) < 0)
+    {
+        layout()->addWidget(m_content_widget);
+    }
+
+    m_in_live_resize = false;
+}
+
+/**
+ * @brief Map a rectangle of a descendant widget to native window pixels.
  *
- * @param msg Native MSG pointer.
- * @return LRESULT Result value for WM_NCCALCSIZE handling (0 = handled).
+ * @param widget The widget the rectangle is relative to (this window or a descendant).
+ * @param rect The rectangle in the widget's logical coordinates.
+ * @return QRect The rectangle relative to the window's top-left corner, in native pixels.
  */
-auto AppWindow::handle_nc_calc_size(MSG* msg) -> LRESULT
+auto AppWindow::to_native_window_rect(const QWidget* widget, const QRect& rect) const -> QRect
 {
-    (void)msg;
-    LRESULT result = 0;
+    const qreal dpr = devicePixelRatioF();
+    const QPointF top_left = QPointF(widget->mapTo(this, rect.topLeft())) * dpr;
+    const QSizeF size = QSizeF(rect.size()) * dpr;
+    const QRect result = QRectF(top_left, size).toAlignedRect();
     return result;
 }
 
 /**
- * @brief Perform custom hit-testing for frameless window.
+ * @brief Rebuild the cached hit-test regions from the current window and widget geometry.
  *
- * Returns HT* values for caption dragging, client controls and resize edges.
+ * Collects the resize border (none while maximized), the title bar rectangle and the
+ * interactive rectangles inside it (window buttons, menubar actions, custom widget) in native
+ * pixels relative to the window, and starts watching these widgets for changes.
  *
- * Notes:
- *  - To allow resizing near the edges while using a custom title bar, points that fall
- *    inside the system resize border are not treated as caption.
- *  - When the window is maximized, resize zones are ignored so that clicks at the very
- *    outermost pixels of the titlebar behave like a restore+drag (native behavior).
- *
- * @param msg Native MSG pointer containing screen coordinates in lParam.
- * @return LRESULT Hit-test code (HT*), e.g. HTCAPTION, HTCLIENT, HTLEFT, etc.
+ * Only actions are interactive on a top-row menubar; its whitespace stays draggable. A menubar
+ * on the second row is interactive as a whole.
  */
-auto AppWindow::handle_nc_hit_test(MSG* msg) -> LRESULT
+auto AppWindow::rebuild_hit_test_regions() -> void
 {
-    const int x = GET_X_LPARAM(msg->lParam);
-    const int y = GET_Y_LPARAM(msg->lParam);
+    HWND hwnd = nativeWindowHandle();
 
     RECT wr{};
-    GetWindowRect(nativeWindowHandle(), &wr);
-
-    const int left = wr.left;
-    const int top = wr.top;
-    const int right = wr.right;
-    const int bottom = wr.bottom;
+    GetWindowRect(hwnd, &wr);
+    m_window_origin = QPoint(wr.left, wr.top);
 
-    const int cx = x - left;
-    const int cy = y - top;
-    const int w = right - left;
-    const int h = bottom - top;
+    const QSize window_size(wr.right - wr.left, wr.bottom - wr.top);
 
-    // Border thickness (DPI aware)
-    const int border = system_resize_border_width();
-    const int caption = m_title_bar ? m_title_bar->height() : system_caption_height();
+    // When maximized, the outermost pixels belong to the caption (restore + drag), not resizing
+    const int border = ::IsZoomed(hwnd) ? 0 : system_resize_border_width();
 
-    // Compute edge booleans early so titlebar logic can respect resize zones.
-    bool on_left = cx < border;
-    bool on_right = cx >= w - border;
-    bool on_top = cy < border;
-    bool on_bottom = cy >= h - border;
+    QRect caption_rect(0, 0, window_size.width(), system_caption_height());
+    QList<QRect> interactive_rects;
 
-    // If the window is maximized, ignore the resize zones so clicks at the outermost
-    // pixels of the titlebar behave like titlebar drags (restore + move) instead of resize.
-    if (::IsZoomed(nativeWindowHandle()))
-    {
-        on_left = on_right = on_top = on_bottom = false;
-    }
-
-    LRESULT hit = HTCLIENT;
-    bool over_button = false;
-
-    // First check titlebar buttons: if the global point is over a button, treat as client
     if (m_title_bar)
     {
-        QPoint local = map_global_to_titlebar_local(x, y);
+        caption_rect = to_native_window_rect(m_title_bar, m_title_bar->rect());
 
-        if (m_title_bar->get_minimize_button() &&
-            m_title_bar->get_minimize_button()->geometry().contains(local))
-        {
-            over_button = true;
-            hit = HTCLIENT;
-        }
-        else if (m_title_bar->get_maximize_button() &&
-                 m_title_bar->get_maximize_button()->geometry().contains(local))
-        {
-            over_button = true;
-            hit = HTCLIENT;
-        }
-        else if (m_title_bar->get_close_button() &&
-                 m_title_bar->get_close_button()->geometry().contains(local))
+        const QList<QWidget*> buttons = {m_title_bar->get_minimize_button(),
+                                         m_title_bar->get_maximize_button(),
+                                         m_title_bar->get_close_button()};
+
+        for (QWidget* button: buttons)
         {
-            over_button = true;
-            hit = HTCLIENT;
+            if (button != nullptr && button->isVisible())
+            {
+                interactive_rects.append(to_native_window_rect(button, button->rect()));
+            }
+
+            if (button != nullptr)
+            {
+                button->installEventFilter(this);
+            }
         }
-        else
+
+        QMenuBar* tb_menubar = m_title_bar->get_menubar();
+
+        if (tb_menubar != nullptr)
         {
-            // Treat menubar and custom widget as interactive client area
-            QMenuBar* tb_menubar = m_title_bar->get_menubar();
-            QWidget* tb_custom = m_title_bar->get_custom_widget();
+            tb_menubar->installEventFilter(this);
+
+            const int mid_y = m_title_bar->height() / 2;
+            const bool menubar_on_top_row = tb_menubar->geometry().center().y() < mid_y;
 
-            if (tb_menubar != nullptr && tb_menubar->isVisible() &&
-                tb_menubar->geometry().contains(local))
+            if (tb_menubar->isVisible() && menubar_on_top_row)
             {
-                // Only treat as client when actually over a menu action; whitespace on the
-                // top-row menubar should remain draggable (HTCAPTION).
-                QPoint menubar_local = tb_menubar->mapFrom(m_title_bar, local);
-                QAction* under_action = tb_menubar->actionAt(menubar_local);
-                const int mid_y = m_title_bar->height() / 2;
-                const bool menubar_on_top_row = tb_menubar->geometry().center().y() < mid_y;
-
-                if (under_action != nullptr || !menubar_on_top_row)
+                const QList<QAction*> actions = tb_menubar->actions();
+
+                for (QAction* action: actions)
                 {
-                    over_button = true;
-                    hit = HTCLIENT;
+                    const QRect action_rect = tb_menubar->actionGeometry(action);
+
+                    if (action->isVisible() && !action_rect.isEmpty())
+                    {
+                        interactive_rects.append(to_native_window_rect(tb_menubar, action_rect));
+                    }
                 }
-                // else: whitespace on top row menubar -> keep as caption-eligible
             }
-            else if (tb_custom != nullptr && tb_custom->isVisible() &&
-                     tb_custom->geometry().contains(local))
+            else if (tb_menubar->isVisible())
             {
-                over_button = true;
-                hit = HTCLIENT;
+                interactive_rects.append(to_native_window_rect(tb_menubar, tb_menubar->rect()));
             }
         }
-    }
 
-    // If inside the titlebar area (but not buttons) -> allow dragging
-    // Only set HTCAPTION when not over a button.
-    if (m_title_bar && !over_button)
-    {
-        QPoint local = map_global_to_titlebar_local(x, y);
+        QWidget* tb_custom = m_title_bar->get_custom_widget();
 
-        if (m_title_bar->rect().contains(local))
+        if (tb_custom != nullptr)
         {
-            // If the point lies inside the system resize border, allow the resize handling
-            // below to run by not returning HTCAPTION here.
-            if (!(on_top || on_left || on_right || on_bottom))
+            tb_custom->installEventFilter(this);
+
+            if (tb_custom->isVisible())
             {
-                hit = HTCAPTION;
+                interactive_rects.append(to_native_window_rect(tb_custom, tb_custom->rect()));
             }
-            // else: fall through so edge/corner checks below can set resize values
         }
     }
-    else if (!m_title_bar && !over_button)
+
+    m_hit_test_regions.update(window_size, border, caption_rect, interactive_rects);
+}
+
+/**
+ * @brief Marks the hit-test regions as outdated when title bar widgets move or change.
+ *
+ * @param watched The watched widget.
+ * @param event The event being filtered.
+ * @return bool The result of QWidget::eventFilter(); events are never consumed.
+ */
+auto AppWindow::eventFilter(QObject* watched, QEvent* event) -> bool
+{
+    if (affects_hit_test_regions(event->type()))
     {
-        // Fallback: allow top area as caption when no custom titlebar is present
-        if (cy >= 0 && cy < caption)
-        {
-            hit = HTCAPTION;
-        }
+        m_hit_test_regions.invalidate();
     }
 
-    // Now handle resize zones (corners + edges) if caption wasn't set
-    if (hit != HTCAPTION)
+    bool result = QWidget::eventFilter(watched, event);
+    return result;
+}
+
+/**
+ * @brief Handle WM_NCCALCSIZE - remove the standard non-client frame.
+ *
+ * Returning 0 indicates we've handled the sizing and the whole window is client area.
+ *
+ * @param msg Native MSG pointer.
+ * @return LRESULT Result value for WM_NCCALCSIZE handling (0 = handled).
+ */
+auto AppWindow::handle_nc_calc_size(MSG* msg) -> LRESULT
+{
+    (void)msg;
+    LRESULT result = 0;
+    return result;
+}
+
+/**
+ * @brief Perform custom hit-testing for frameless window.
+ *
+ * Returns HT* values for caption dragging, client controls and resize edges. The point is
+ * looked up in the cached hit-test regions (a few integer comparisons), which are rebuilt first
+ * when a resize, layout or DPI change marked them outdated.
+ *
+ * Notes:
+ *  - To allow resizing near the edges while using a custom title bar, points that fall
+ *    inside the system resize border are not treated as caption.
+ *  - When the window is maximized, resize zones are ignored so that clicks at the very
+ *    outermost pixels of the titlebar behave like a restore+drag (native behavior).
+ *
+ * @param msg Native MSG pointer containing screen coordinates in lParam.
+ * @return LRESULT Hit-test code (HT*), e.g. HTCAPTION, HTCLIENT, HTLEFT, etc.
+ */
+auto AppWindow::handle_nc_hit_test(MSG* msg) -> LRESULT
+{
+    const int x = GET_X_LPARAM(msg->lParam);
+    const int y = GET_Y_LPARAM(msg->lParam);
+
+    if (!m_hit_test_regions.is_valid())
     {
-        if (on_left && on_top)
-        {
-            hit = HTTOPLEFT;
-        }
-        else if (on_right && on_top)
-        {
-            hit = HTTOPRIGHT;
-        }
-        else if (on_left && on_bottom)
-        {
-            hit = HTBOTTOMLEFT;
-        }
-        else if (on_right && on_bottom)
-        {
-            hit = HTBOTTOMRIGHT;
-        }
-        else if (on_top)
-        {
-            hit = HTTOP;
-        }
-        else if (on_bottom)
-        {
-            hit = HTBOTTOM;
-        }
-        else if (on_left)
-        {
-            hit = HTLEFT;
-        }
-        else if (on_right)
-        {
-            hit = HTRIGHT;
-        }
-        else
-        {
-            hit = HTCLIENT;
-        }
+        rebuild_hit_test_regions();
     }
 
+    const QPoint window_pos = QPoint(x, y) - m_window_origin;
+    const LRESULT hit = to_hit_test_code(m_hit_test_regions.hit_test(window_pos));
+
     return hit;
 }
 
@@ -983,10 +1294,11 @@ auto AppWindow::handle_get_min_max_info(LPARAM lParam) -> void
             mmi->ptMaxSize.x = work.right - work.left;
             mmi->ptMaxSize.y = work.bottom - work.top;
 
-            // Minimum size (you can customize)
-            const QSize min_size = minimumSize();
-            mmi->ptMinTrackSize.x = min_size.width();
-            mmi->ptMinTrackSize.y = min_size.height();
+            // Minimum size: minimumSize() is in logical pixels, the track size in native pixels
+            const QSize min_size = m_in_live_resize ? m_live_resize_minimum_size : minimumSize();
+            const int dpi = static_cast<int>(m_non_client_metrics.dpi);
+            mmi->ptMinTrackSize.x = MulDiv(min_size.width(), dpi, 96);
+            mmi->ptMinTrackSize.y = MulDiv(min_size.height(), dpi, 96);
         }
     }
 }
@@ -1006,8 +1318,11 @@ auto AppWindow::handle_get_min_max_info(LPARAM lParam) -> void
  */
 auto AppWindow::nativeEvent(const QByteArray& eventType, void* message, qintptr* result) -> bool
 {
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("window", "AppWindow::nativeEvent");
+
     Q_UNUSED(eventType);
     MSG* msg = static_cast<MSG*>(message);
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("native", native_message_name(msg->message));
 
     bool handled = false;
     LRESULT out_result = 0;
@@ -1027,30 +1342,82 @@ auto AppWindow::nativeEvent(const QByteArray& eventType, void* message, qintptr*
         handle_get_min_max_info(msg->lParam);
         handled = false;  // allow DefWindowProc to process it as well
     }
-    else if (msg->message == WM_SIZE || msg->message == WM_MOVE)
+    else if (msg->message == WM_SIZE)
+    {
+        // Size and maximized state are part of the hit-test regions
+        m_hit_test_regions.invalidate();
+
+        if (m_in_size_move && m_live_resize_throttling && !m_in_live_resize)
+        {
+            begin_live_resize();
+        }
+
+        if (m_in_live_resize)
+        {
+            ++m_pending_resize_steps;
+        }
+
+        handled = false;
+    }
+    else if (msg->message == WM_ENTERSIZEMOVE)
+    {
+        m_in_size_move = true;
+        handled = false;
+    }
+    else if (msg->message == WM_EXITSIZEMOVE)
+    {
+        m_in_size_move = false;
+
+        if (m_in_live_resize)
+        {
+            end_live_resize();
+        }
+
+        handled = false;
+    }
+    else if (msg->message == WM_MOVE)
     {
+        // Regions are relative to the window; only the origin changes
+        RECT wr{};
+        GetWindowRect(nativeWindowHandle(), &wr);
+        m_window_origin = QPoint(wr.left, wr.top);
         handled = false;
     }
     else if (msg->message == WM_DWMCOMPOSITIONCHANGED)
     {
-        extend_frame_into_client_area();
-        enable_win11_features();
+        // DWM may have dropped the frame and attributes, so apply all of them again
+        m_dwm_state.invalidate();
+        apply_dwm_attributes();
         handled = false;
     }
     else if (msg->message == WM_DPICHANGED)
     {
         RECT* const prc_new_window = reinterpret_cast<RECT*>(msg->lParam);
 
+        // Refresh first: SetWindowPos sends size and min/max messages that use the metrics
+        refresh_non_client_metrics();
+
         SetWindowPos(nativeWindowHandle(), nullptr, prc_new_window->left, prc_new_window->top,
                      prc_new_window->right - prc_new_window->left,
                      prc_new_window->bottom - prc_new_window->top, SWP_NOZORDER | SWP_NOACTIVATE);
 
-        // Also reapply frame margins and Win11 attributes
-        extend_frame_into_client_area();
-        enable_win11_features();
+        // The 1px frame margins and the DWM attributes do not depend on the DPI
+        apply_dwm_attributes();
+
+        // Native icons are per DPI; all other icon updates are served from the shared cache
+        if (!m_app_icon.isNull() && m_icon_dpi != m_non_client_metrics.dpi)
+        {
+            update_native_icons();
+        }
 
         handled = false;
     }
+    else if (msg->message == WM_SETTINGCHANGE)
+    {
+        // Border and caption metrics may follow accessibility or theme settings
+        refresh_non_client_metrics();
+        handled = false;
+    }
     else if (msg->message == WM_NCACTIVATE)
     {
         // Prevent Windows from drawing the standard non-client area when activation changes.
@@ -1105,6 +1472,32 @@ auto AppWindow::closeEvent(QCloseEvent* event) -> void
     QWidget::closeEvent(event);
 }
 
+/**
+ * @brief Trace the window's repaint passes.
+ *
+ * An update request repaints and flushes all dirty widgets of the window, so its duration is
+ * the frame time shown by the performance overlay.
+ *
+ * @param event The event.
+ * @return bool The result of QWidget::event().
+ */
+auto AppWindow::event(QEvent* event) -> bool
+{
+    bool result = false;
+
+    if (event->type() == QEvent::UpdateRequest)
+    {
+        QTWIDGETSCOMMONLIB_TRACE_SCOPE("paint", "AppWindow::repaint");
+        result = QWidget::event(event);
+    }
+    else
+    {
+        result = QWidget::event(event);
+    }
+
+    return result;
+}
+
 #ifndef Q_OS_WIN
 /**
  * @brief Native event handler (non-Windows platforms).
@@ -1119,6 +1512,8 @@ auto AppWindow::closeEvent(QCloseEvent* event) -> void
  */
 auto AppWindow::nativeEvent(const QByteArray& eventType, void* message, qintptr* result) -> bool
 {
+    QTWIDGETSCOMMONLIB_TRACE_SCOPE("window", "AppWindow::nativeEvent");
+
     bool call_result = QWidget::nativeEvent(eventType, message, result);
     return call_result;
 }
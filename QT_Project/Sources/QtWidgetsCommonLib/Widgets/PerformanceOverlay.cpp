@@ -0,0 +1,177 @@
+#include "QtWidgetsCommonLib/Widgets/PerformanceOverlay.h"
+
+#include <QColor>
+#include <QEvent>
+#include <QFontDatabase>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QTimer>
+#include <algorithm>
+#include <utility>
+
+#include "QtWidgetsCommonLib/Utils/Trace.h"
+
+namespace
+{
+
+constexpr int kDefaultUpdateIntervalMs = 1000;
+constexpr int kCornerMargin = 8;
+constexpr int kPadding = 6;
+
+}  // namespace
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @brief Constructs the overlay and takes the first (baseline) sample.
+ * @param parent The widget to overlay; the overlay follows its size.
+ */
+PerformanceOverlay::PerformanceOverlay(QWidget* parent)
+    : QWidget(parent), m_update_timer(new QTimer(this))
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setFocusPolicy(Qt::NoFocus);
+    setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    m_update_timer->setInterval(kDefaultUpdateIntervalMs);
+    connect(m_update_timer, &QTimer::timeout, this, &PerformanceOverlay::update_sample);
+    m_update_timer->start();
+
+    if (parent != nullptr)
+    {
+        parent->installEventFilter(this);
+    }
+
+    update_sample();
+    raise();
+}
+
+/**
+ * @brief Sets how often the counters are sampled and the overlay repainted.
+ * @param msecs The update interval in milliseconds.
+ */
+auto PerformanceOverlay::set_update_interval(int msecs) -> void
+{
+    m_update_timer->setInterval(std::max(msecs, 1));
+}
+
+/**
+ * @brief Returns the update interval in milliseconds.
+ * @return The update interval.
+ */
+auto PerformanceOverlay::get_update_interval() const -> int
+{
+    return m_update_timer->interval();
+}
+
+/**
+ * @brief Returns the text lines currently shown.
+ * @return The lines; a placeholder until the second sample.
+ */
+auto PerformanceOverlay::get_lines() const -> QStringList
+{
+    return m_lines;
+}
+
+/**
+ * @brief Samples the trace counters now and updates the shown lines.
+ *
+ * The frame line summarizes the window's repaint passes (`AppWindow::repaint`), the scope that
+ * covers painting and flushing all dirty widgets of one frame.
+ */
+auto PerformanceOverlay::update_sample() -> void
+{
+    m_lines.clear();
+    m_sampler.sample(Tracer::get_counters(), Tracer::now_ns());
+
+    if (!Tracer::is_compiled_in())
+    {
+        // The library's scopes are compiled out; only scopes of the application are counted
+        m_lines.append(QStringLiteral("Tracing is not compiled in"));
+        m_lines.append(QStringLiteral("(QTWIDGETSCOMMONLIB_ENABLE_TRACING)"));
+    }
+
+    if (m_sampler.get_interval_ms() > 0.0)
+    {
+        const TraceRate frame =
+            m_sampler.get_rate(QStringLiteral("paint"), QStringLiteral("AppWindow::repaint"));
+        m_lines.append(QStringLiteral("Frame %1 ms  %2 repaints/s")
+                           .arg(frame.average_ms, 0, 'f', 2)
+                           .arg(frame.count_per_second, 0, 'f', 0));
+        m_lines.append(m_sampler.to_lines());
+    }
+    else
+    {
+        m_lines.append(QStringLiteral("Sampling..."));
+    }
+
+    update_geometry();
+    update();
+}
+
+/**
+ * @brief Paints the lines on a translucent background.
+ * @param event The paint event.
+ */
+auto PerformanceOverlay::paintEvent(QPaintEvent* event) -> void
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(0, 0, 0, 190));
+    painter.setPen(Qt::white);
+
+    const QFontMetrics metrics(font());
+    int y = kPadding + metrics.ascent();
+
+    for (const QString& line: std::as_const(m_lines))
+    {
+        painter.drawText(kPadding, y, line);
+        y += metrics.lineSpacing();
+    }
+}
+
+/**
+ * @brief Keeps the overlay in the bottom-right corner when the parent is resized.
+ * @param watched The watched object (the parent).
+ * @param event The event being filtered.
+ * @return The result of QWidget::eventFilter(); events are never consumed.
+ */
+auto PerformanceOverlay::eventFilter(QObject* watched, QEvent* event) -> bool
+{
+    if (watched == parentWidget() && event->type() == QEvent::Resize)
+    {
+        update_geometry();
+    }
+
+    return QWidget::eventFilter(watched, event);
+}
+
+/**
+ * @brief Resizes the overlay to its lines and moves it to the parent's corner.
+ */
+auto PerformanceOverlay::update_geometry() -> void
+{
+    const QFontMetrics metrics(font());
+    int width = 0;
+
+    for (const QString& line: std::as_const(m_lines))
+    {
+        width = std::max(width, metrics.horizontalAdvance(line));
+    }
+
+    const QSize size(width + 2 * kPadding,
+                     static_cast<int>(m_lines.size()) * metrics.lineSpacing() + 2 * kPadding);
+    QPoint position(kCornerMargin, kCornerMargin);
+
+    if (const QWidget* parent = parentWidget(); parent != nullptr)
+    {
+        position = QPoint(std::max(0, parent->width() - size.width() - kCornerMargin),
+                          std::max(0, parent->height() - size.height() - kCornerMargin));
+    }
+
+    setGeometry(QRect(position, size));
+}
+
+}  // namespace QtWidgetsCommonLib
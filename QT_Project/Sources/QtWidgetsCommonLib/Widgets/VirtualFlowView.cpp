@@ -0,0 +1,630 @@
+#include "QtWidgetsCommonLib/Widgets/VirtualFlowView.h"
+
+#include <QResizeEvent>
+#include <QScrollBar>
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+
+/**
+ * @brief Returns the first row for which a monotonic predicate holds (binary search).
+ * @param row_count The number of rows.
+ * @param predicate False for a prefix of the rows, true for the rest.
+ * @return The first row satisfying the predicate, or row_count if none does.
+ */
+template <typename Predicate>
+[[nodiscard]] auto first_row_where(int row_count, Predicate predicate) -> int
+{
+    int low = 0;
+    int high = row_count;
+
+    while (low < high)
+    {
+        const int mid = low + (high - low) / 2;
+
+        if (predicate(mid))
+        {
+            high = mid;
+        }
+        else
+        {
+            low = mid + 1;
+        }
+    }
+
+    return low;
+}
+
+}  // namespace
+
+namespace QtWidgetsCommonLib
+{
+
+/**
+ * @brief Constructs an empty VirtualFlowView.
+ * @param parent The parent widget, or nullptr.
+ */
+VirtualFlowView::VirtualFlowView(QWidget* parent): QAbstractScrollArea(parent)
+{
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+}
+
+/**
+ * @brief Sets the factory used to create item widgets.
+ * @param factory The widget factory.
+ */
+auto VirtualFlowView::set_widget_factory(WidgetFactory factory) -> void
+{
+    m_widget_factory = std::move(factory);
+    update_visible_widgets();
+}
+
+/**
+ * @brief Sets the binder that fills a widget with the data of an item.
+ * @param binder The widget binder.
+ */
+auto VirtualFlowView::set_widget_binder(WidgetBinder binder) -> void
+{
+    m_widget_binder = std::move(binder);
+    refresh_items();
+}
+
+/**
+ * @brief Sets a per-item size provider; overrides the uniform item size.
+ * @param provider The size provider, or an empty function to use the uniform size.
+ */
+auto VirtualFlowView::set_size_provider(SizeProvider provider) -> void
+{
+    m_size_provider = std::move(provider);
+    invalidate_item_sizes();
+}
+
+/**
+ * @brief Sets the size used for all items when no size provider is set.
+ * @param size The uniform item size.
+ */
+auto VirtualFlowView::set_item_size(const QSize& size) -> void
+{
+    if (m_item_size != size)
+    {
+        m_item_size = size;
+        invalidate_item_sizes();
+    }
+}
+
+/**
+ * @brief Returns the uniform item size.
+ * @return The size used when no size provider is set.
+ */
+auto VirtualFlowView::get_item_size() const -> QSize
+{
+    return m_item_size;
+}
+
+/**
+ * @brief Sets the number of items; all visible widgets are re-bound.
+ *
+ * Indices of the old and the new item set are unrelated, so every materialized widget goes back
+ * to the pool and is bound again.
+ *
+ * @param count The number of items.
+ */
+auto VirtualFlowView::set_item_count(int count) -> void
+{
+    m_item_count = std::max(0, count);
+    recycle_all_widgets();
+    invalidate_item_sizes();
+}
+
+/**
+ * @brief Returns the number of items.
+ * @return The item count.
+ */
+auto VirtualFlowView::get_item_count() const -> int
+{
+    return m_item_count;
+}
+
+/**
+ * @brief Sets the row alignment.
+ * @param alignment The desired row alignment.
+ */
+auto VirtualFlowView::set_row_alignment(FlowLayout::RowAlignment alignment) -> void
+{
+    if (m_row_alignment != alignment)
+    {
+        m_row_alignment = alignment;
+        invalidate_geometry();
+    }
+}
+
+/**
+ * @brief Returns the row alignment.
+ * @return The current row alignment.
+ */
+auto VirtualFlowView::get_row_alignment() const -> FlowLayout::RowAlignment
+{
+    return m_row_alignment;
+}
+
+/**
+ * @brief Sets the spacing between items and rows.
+ * @param horizontal The horizontal spacing between items.
+ * @param vertical The vertical spacing between rows.
+ */
+auto VirtualFlowView::set_spacing(int horizontal, int vertical) -> void
+{
+    m_h_spacing = std::max(0, horizontal);
+    m_v_spacing = std::max(0, vertical);
+    invalidate_geometry();
+}
+
+/**
+ * @brief Returns the horizontal spacing between items.
+ * @return The horizontal spacing.
+ */
+auto VirtualFlowView::get_horizontal_spacing() const -> int
+{
+    return m_h_spacing;
+}
+
+/**
+ * @brief Returns the vertical spacing between rows.
+ * @return The vertical spacing.
+ */
+auto VirtualFlowView::get_vertical_spacing() const -> int
+{
+    return m_v_spacing;
+}
+
+/**
+ * @brief Sets how far beyond the viewport (in pixels) widgets are kept materialized.
+ * @param pixels The margin above and below the viewport.
+ */
+auto VirtualFlowView::set_overscan(int pixels) -> void
+{
+    m_overscan = std::max(0, pixels);
+    update_visible_widgets();
+}
+
+/**
+ * @brief Returns the overscan margin.
+ * @return The margin above and below the viewport in pixels.
+ */
+auto VirtualFlowView::get_overscan() const -> int
+{
+    return m_overscan;
+}
+
+/**
+ * @brief Re-queries all item sizes from the size provider and lays out again.
+ */
+auto VirtualFlowView::invalidate_item_sizes() -> void
+{
+    m_item_sizes_dirty = true;
+    invalidate_geometry();
+}
+
+/**
+ * @brief Re-binds all materialized widgets (e.g. after the item data changed).
+ */
+auto VirtualFlowView::refresh_items() -> void
+{
+    if (m_widget_binder)
+    {
+        for (auto it = m_active_widgets.cbegin(); it != m_active_widgets.cend(); ++it)
+        {
+            m_widget_binder(it.value(), it.key());
+        }
+    }
+}
+
+/**
+ * @brief Returns the rectangle of an item in content coordinates.
+ * @param index The item index.
+ * @return The item rectangle, or an invalid rectangle for an invalid index.
+ */
+auto VirtualFlowView::get_item_rect(int index) -> QRect
+{
+    QRect result;
+    ensure_geometry();
+
+    if (index >= 0 && index < m_item_count)
+    {
+        result = compute_item_rect(index);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns the widget currently showing an item.
+ * @param index The item index.
+ * @return The widget, or nullptr if the item is not materialized.
+ */
+auto VirtualFlowView::get_widget(int index) const -> QWidget*
+{
+    return m_active_widgets.value(index, nullptr);
+}
+
+/**
+ * @brief Returns the number of widgets currently bound to items.
+ * @return The number of materialized widgets.
+ */
+auto VirtualFlowView::get_materialized_count() const -> int
+{
+    return static_cast<int>(m_active_widgets.size());
+}
+
+/**
+ * @brief Returns the number of hidden widgets waiting to be recycled.
+ * @return The pool size.
+ */
+auto VirtualFlowView::get_pooled_count() const -> int
+{
+    return static_cast<int>(m_widget_pool.size());
+}
+
+/**
+ * @brief Scrolls so that an item is fully visible.
+ * @param index The item index.
+ */
+auto VirtualFlowView::scroll_to_index(int index) -> void
+{
+    const QRect rect = get_item_rect(index);
+
+    if (rect.isValid())
+    {
+        QScrollBar* scroll_bar = verticalScrollBar();
+        const int top = scroll_bar->value();
+        const int viewport_height = viewport()->height();
+
+        if (rect.top() < top)
+        {
+            scroll_bar->setValue(rect.top());
+        }
+        else if (rect.bottom() >= top + viewport_height)
+        {
+            scroll_bar->setValue(rect.bottom() + 1 - viewport_height);
+        }
+    }
+}
+
+/**
+ * @brief Re-flows the items for the new viewport size.
+ * @param event The resize event.
+ */
+void VirtualFlowView::resizeEvent(QResizeEvent* event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    update_visible_widgets();
+}
+
+/**
+ * @brief Repositions and recycles widgets after scrolling.
+ *
+ * The base implementation would scroll the viewport pixels; widgets are positioned explicitly
+ * instead.
+ *
+ * @param dx The horizontal scroll delta.
+ * @param dy The vertical scroll delta.
+ */
+void VirtualFlowView::scrollContentsBy(int dx, int dy)
+{
+    Q_UNUSED(dx);
+    Q_UNUSED(dy);
+    update_visible_widgets();
+}
+
+/**
+ * @brief Marks the flow geometry as outdated and updates the widgets.
+ */
+auto VirtualFlowView::invalidate_geometry() -> void
+{
+    m_geometry_dirty = true;
+    update_visible_widgets();
+}
+
+/**
+ * @brief Recomputes the flow geometry if it is outdated or the viewport width changed.
+ *
+ * Only item sizes are involved; no widget is touched. Sizes from the size provider are queried
+ * once and cached. Uniformly sized items need neither sizes nor rectangles per item: their rows
+ * are computed in constant time.
+ */
+auto VirtualFlowView::ensure_geometry() -> void
+{
+    const int width = viewport()->width();
+
+    if (m_item_sizes_dirty)
+    {
+        m_item_sizes.clear();
+
+        if (m_size_provider)
+        {
+            m_item_sizes.reserve(m_item_count);
+
+            for (int i = 0; i < m_item_count; ++i)
+            {
+                m_item_sizes.append(m_size_provider(i));
+            }
+        }
+
+        m_item_sizes_dirty = false;
+        m_geometry_dirty = true;
+    }
+
+    if (m_geometry_dirty || width != m_geometry_width)
+    {
+        if (m_size_provider)
+        {
+            m_geometry = FlowLayout::compute_geometry(m_item_sizes, width, QMargins(),
+                                                      m_h_spacing, m_v_spacing, m_row_alignment);
+        }
+        else
+        {
+            update_uniform_rows(width);
+        }
+
+        m_geometry_width = width;
+        m_geometry_dirty = false;
+    }
+}
+
+/**
+ * @brief Computes the rows of uniformly sized items for a width.
+ *
+ * Follows the rules of `FlowLayout::compute_geometry()`: an item starts a new row when its right
+ * edge would cross the last column, unless it is the first of its row (and rows without height
+ * never break). So every row but the last holds the same number of items, which only depends on
+ * the width, and the alignment offsets follow from the row widths.
+ *
+ * @param width The viewport width.
+ */
+auto VirtualFlowView::update_uniform_rows(int width) -> void
+{
+    const int item_width = m_item_size.width();
+    const int step_x = item_width + m_h_spacing;
+    int items_per_row = m_item_count;
+
+    if (m_item_size.height() > 0)
+    {
+        if (item_width > width - 1)
+        {
+            items_per_row = 1;
+        }
+        else if (step_x > 0)
+        {
+            items_per_row = (width - 1 - item_width) / step_x + 1;
+        }
+    }
+
+    UniformRows rows;
+    rows.items_per_row = std::max(1, std::min(items_per_row, m_item_count));
+    rows.row_count = (m_item_count + rows.items_per_row - 1) / rows.items_per_row;
+
+    const int first_row_items = std::min(rows.items_per_row, m_item_count);
+    const int last_row_items = m_item_count - (rows.row_count - 1) * rows.items_per_row;
+    const auto centered_offset = [width, step_x, this](int row_items) {
+        return (width - row_items * step_x + m_h_spacing) / 2;
+    };
+
+    if (m_row_alignment == FlowLayout::RowAlignment::Center)
+    {
+        rows.row_offset = centered_offset(rows.items_per_row);
+        rows.last_row_offset = centered_offset(last_row_items);
+    }
+    else if (m_row_alignment == FlowLayout::RowAlignment::CenterLeft)
+    {
+        rows.row_offset = centered_offset(first_row_items);
+        rows.last_row_offset = rows.row_offset;
+    }
+
+    m_uniform_rows = rows;
+    m_geometry = FlowLayout::LayoutResult();
+
+    if (rows.row_count > 0)
+    {
+        m_geometry.height = get_row_top(rows.row_count - 1) + std::max(0, m_item_size.height());
+    }
+}
+
+/**
+ * @brief Returns the number of rows of the current geometry.
+ * @return The row count.
+ */
+auto VirtualFlowView::get_row_count() const -> int
+{
+    return m_size_provider ? static_cast<int>(m_geometry.row_starts.size())
+                           : m_uniform_rows.row_count;
+}
+
+/**
+ * @brief Returns the index of the first item of a row.
+ * @param row The row, in [0, get_row_count()].
+ * @return The first item index; the item count for the row past the last one.
+ */
+auto VirtualFlowView::get_row_start(int row) const -> int
+{
+    int result = m_item_count;
+
+    if (row < get_row_count())
+    {
+        result = m_size_provider ? m_geometry.row_starts.at(row)
+                                 : row * m_uniform_rows.items_per_row;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns the top edge of a row in content coordinates.
+ * @param row The row.
+ * @return The top edge.
+ */
+auto VirtualFlowView::get_row_top(int row) const -> int
+{
+    return m_size_provider ? m_geometry.item_rects.at(m_geometry.row_starts.at(row)).top()
+                           : row * (m_item_size.height() + m_v_spacing);
+}
+
+/**
+ * @brief Returns the rectangle of an item of the current geometry.
+ * @param index The item index (valid).
+ * @return The item rectangle in content coordinates.
+ */
+auto VirtualFlowView::compute_item_rect(int index) const -> QRect
+{
+    QRect result;
+
+    if (m_size_provider)
+    {
+        result = m_geometry.item_rects.at(index);
+    }
+    else
+    {
+        const int row = index / m_uniform_rows.items_per_row;
+        const int column = index % m_uniform_rows.items_per_row;
+        const int offset = (row + 1 < m_uniform_rows.row_count) ? m_uniform_rows.row_offset
+                                                                : m_uniform_rows.last_row_offset;
+        result = QRect(QPoint(offset + column * (m_item_size.width() + m_h_spacing),
+                              get_row_top(row)),
+                       m_item_size);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Materializes, recycles and positions widgets for the visible range.
+ *
+ * The visible rows are found by binary search over the row tops, so the work per call is
+ * proportional to the number of visible items.
+ */
+auto VirtualFlowView::update_visible_widgets() -> void
+{
+    // Scroll bar range changes re-enter through scrollContentsBy()
+    if (!m_updating)
+    {
+        m_updating = true;
+        ensure_geometry();
+
+        QScrollBar* scroll_bar = verticalScrollBar();
+        const int viewport_height = viewport()->height();
+        scroll_bar->setRange(0, std::max(0, m_geometry.height - viewport_height));
+        scroll_bar->setPageStep(viewport_height);
+        scroll_bar->setSingleStep(std::max(1, m_item_size.height()));
+
+        const int scroll_y = scroll_bar->value();
+        const int area_top = scroll_y - m_overscan;
+        const int area_bottom = scroll_y + viewport_height + m_overscan;
+
+        const int row_count = get_row_count();
+        const auto row_bottom = [this, row_count](int row) {
+            return (row + 1 < row_count) ? get_row_top(row + 1) - m_v_spacing : m_geometry.height;
+        };
+
+        const int first_row =
+            first_row_where(row_count, [&](int row) { return row_bottom(row) >= area_top; });
+        const int end_row =
+            first_row_where(row_count, [&](int row) { return get_row_top(row) > area_bottom; });
+
+        int first_index = 0;
+        int end_index = 0;
+
+        if (first_row < end_row)
+        {
+            first_index = get_row_start(first_row);
+            end_index = get_row_start(end_row);
+        }
+
+        // Recycle widgets that left the visible range
+        auto it = m_active_widgets.begin();
+
+        while (it != m_active_widgets.end())
+        {
+            if (it.key() < first_index || it.key() >= end_index)
+            {
+                it.value()->hide();
+                m_widget_pool.append(it.value());
+                it = m_active_widgets.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        for (int index = first_index; index < end_index; ++index)
+        {
+            QWidget* widget = m_active_widgets.value(index, nullptr);
+
+            if (widget == nullptr)
+            {
+                widget = acquire_widget();
+
+                if (widget != nullptr)
+                {
+                    if (m_widget_binder)
+                    {
+                        m_widget_binder(widget, index);
+                    }
+
+                    m_active_widgets.insert(index, widget);
+                }
+            }
+
+            if (widget != nullptr)
+            {
+                widget->setGeometry(compute_item_rect(index).translated(0, -scroll_y));
+                widget->show();
+            }
+        }
+
+        m_updating = false;
+    }
+}
+
+/**
+ * @brief Hides all materialized widgets and moves them to the pool.
+ */
+auto VirtualFlowView::recycle_all_widgets() -> void
+{
+    for (QWidget* widget: std::as_const(m_active_widgets))
+    {
+        widget->hide();
+        m_widget_pool.append(widget);
+    }
+
+    m_active_widgets.clear();
+}
+
+/**
+ * @brief Returns a widget from the pool or creates a new one.
+ * @return The widget, or nullptr if no factory is set.
+ */
+auto VirtualFlowView::acquire_widget() -> QWidget*
+{
+    QWidget* result = nullptr;
+
+    if (!m_widget_pool.isEmpty())
+    {
+        result = m_widget_pool.takeLast();
+    }
+    else if (m_widget_factory)
+    {
+        result = m_widget_factory(viewport());
+
+        if (result != nullptr && result->parentWidget() != viewport())
+        {
+            result->setParent(viewport());
+        }
+    }
+
+    return result;
+}
+
+}  // namespace QtWidgetsCommonLib
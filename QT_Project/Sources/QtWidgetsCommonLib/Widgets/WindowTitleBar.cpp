@@ -10,7 +10,7 @@
 #include <QSize>
 #include <QVBoxLayout>
 
-#include "QtWidgetsCommonLib/Utils/UiUtils.h"
+#include "QtWidgetsCommonLib/Utils/TitleBarIconAtlas.h"
 
 namespace QtWidgetsCommonLib
 {
@@ -137,7 +137,7 @@ auto WindowTitleBar::set_menubar(QMenuBar* menubar) -> void
             m_menu_bar->setParent(this);
         }
 
-        rebuild_layout();
+        schedule_layout_update();
     }
 }
 
@@ -150,7 +150,7 @@ auto WindowTitleBar::set_menubar_row(RowPosition row) -> void
     if (m_menubar_row != row)
     {
         m_menubar_row = row;
-        rebuild_layout();
+        schedule_layout_update();
     }
 }
 
@@ -175,7 +175,7 @@ auto WindowTitleBar::set_custom_widget(QWidget* widget) -> void
             m_custom_widget->setParent(this);
         }
 
-        rebuild_layout();
+        schedule_layout_update();
     }
 }
 
@@ -188,7 +188,7 @@ auto WindowTitleBar::set_custom_widget_row(RowPosition row) -> void
     if (m_custom_row != row)
     {
         m_custom_row = row;
-        rebuild_layout();
+        schedule_layout_update();
     }
 }
 
@@ -363,6 +363,35 @@ bool WindowTitleBar::eventFilter(QObject* watched, QEvent* event)
     return handled;
 }
 
+/**
+ * @brief Applies pending menubar/custom widget placement changes immediately.
+ *
+ * Setters only schedule the update; call this when the final geometry is needed before control
+ * returns to the event loop.
+ */
+auto WindowTitleBar::apply_pending_layout() -> void
+{
+    if (m_layout_update_pending)
+    {
+        m_layout_update_pending = false;
+        rebuild_layout();
+    }
+}
+
+/**
+ * @brief Schedules one layout update for the next event loop turn.
+ *
+ * Several setter calls in the same turn result in a single update.
+ */
+auto WindowTitleBar::schedule_layout_update() -> void
+{
+    if (!m_layout_update_pending)
+    {
+        m_layout_update_pending = true;
+        QMetaObject::invokeMethod(this, [this]() { apply_pending_layout(); }, Qt::QueuedConnection);
+    }
+}
+
 /**
  * @brief Rebuild the layout to reflect current menubar/custom widget placement.
  *
@@ -370,80 +399,59 @@ bool WindowTitleBar::eventFilter(QObject* watched, QEvent* event)
  *  - Top row order is [Icon][Title][MenuBar?][Custom?][...][Min][Max][Close].
  *  - Bottom row order is [MenuBar?][Custom?].
  *  - When only one of them is set to Bottom, it appears alone on the second row.
+ *
+ * Only a widget that is not already at its target row and index is moved, so an unchanged
+ * widget does not cause a layout invalidation.
  */
 auto WindowTitleBar::rebuild_layout() -> void
 {
-    if (m_top_row != nullptr)
+    if (m_top_row != nullptr && m_bottom_row != nullptr)
     {
-        for (int i = m_top_row->count() - 1; i >= 0; --i)
-        {
-            QWidget* w = m_top_row->itemAt(i)->widget();
+        const int top_start = m_top_row->indexOf(m_title_label) + 1;
+        int top_index = top_start;
+        int bottom_index = 0;
 
-            if (w != nullptr)
+        if (m_menu_bar != nullptr)
+        {
+            if (m_menubar_row == RowPosition::Top)
             {
-                if (w == m_menu_bar || w == m_custom_widget)
-                {
-                    m_top_row->removeWidget(w);
-                }
+                place_widget(m_menu_bar, m_top_row, top_index);
+                top_index = top_index + 1;
             }
-        }
-    }
-
-    if (m_bottom_row != nullptr)
-    {
-        for (int i = m_bottom_row->count() - 1; i >= 0; --i)
-        {
-            QWidget* w = m_bottom_row->itemAt(i)->widget();
-
-            if (w != nullptr)
+            else
             {
-                if (w == m_menu_bar || w == m_custom_widget)
-                {
-                    m_bottom_row->removeWidget(w);
-                }
+                place_widget(m_menu_bar, m_bottom_row, bottom_index);
+                bottom_index = bottom_index + 1;
             }
         }
-    }
 
-    if (m_bottom_row != nullptr)
-    {
-        if (m_menubar_row == RowPosition::Bottom && m_menu_bar != nullptr)
-        {
-            m_bottom_row->addWidget(m_menu_bar);
-        }
-
-        if (m_custom_row == RowPosition::Bottom && m_custom_widget != nullptr)
-        {
-            m_bottom_row->addWidget(m_custom_widget);
-        }
-    }
-
-    if (m_top_row != nullptr)
-    {
-        int insert_index = m_top_row->count();
-
-        for (int i = 0; i < m_top_row->count(); ++i)
+        if (m_custom_widget != nullptr)
         {
-            QWidget* w = m_top_row->itemAt(i)->widget();
-
-            if (w == m_minimize_button)
+            if (m_custom_row == RowPosition::Top)
             {
-                insert_index = i;
-                i = m_top_row->count();
+                place_widget(m_custom_widget, m_top_row, top_index);
+            }
+            else
+            {
+                place_widget(m_custom_widget, m_bottom_row, bottom_index);
             }
         }
+    }
+}
 
-        if (m_menubar_row == RowPosition::Top && m_menu_bar != nullptr)
-        {
-            m_top_row->insertWidget(insert_index, m_menu_bar);
-            insert_index = insert_index + 1;
-        }
-
-        if (m_custom_row == RowPosition::Top && m_custom_widget != nullptr)
-        {
-            m_top_row->insertWidget(insert_index, m_custom_widget);
-            insert_index = insert_index + 1;
-        }
+/**
+ * @brief Moves a widget to an index of a row unless it is already there.
+ * @param widget The menubar or custom widget.
+ * @param row The target row layout.
+ * @param index The target index within the row.
+ */
+auto WindowTitleBar::place_widget(QWidget* widget, QHBoxLayout* row, int index) -> void
+{
+    if (row->indexOf(widget) != index)
+    {
+        m_top_row->removeWidget(widget);
+        m_bottom_row->removeWidget(widget);
+        row->insertWidget(index, widget);
     }
 }
 
@@ -472,23 +480,22 @@ auto WindowTitleBar::apply_button_icon_size() -> void
 
 /**
  * @brief Re-color and set all window button icons according to the current property.
+ *
+ * The icons come from the shared TitleBarIconAtlas, so windows with the same color and size
+ * reuse the same rendered glyphs.
  */
 auto WindowTitleBar::update_button_icons() -> void
 {
-    const QSize sz(m_window_button_icon_px, m_window_button_icon_px);
-
     if (m_minimize_button != nullptr)
     {
-        QIcon icon = QIcon(UiUtils::colored_svg_icon(":/Resources/Icons/titlebar-minimize.svg",
-                                                     m_window_button_color, sz));
-        m_minimize_button->setIcon(icon);
+        m_minimize_button->setIcon(TitleBarIconAtlas::get_icon(
+            TitleBarIconAtlas::Glyph::Minimize, m_window_button_color, m_window_button_icon_px));
     }
 
     if (m_close_button != nullptr)
     {
-        QIcon icon = QIcon(UiUtils::colored_svg_icon(":/Resources/Icons/titlebar-close.svg",
-                                                     m_window_button_color, sz));
-        m_close_button->setIcon(icon);
+        m_close_button->setIcon(TitleBarIconAtlas::get_icon(
+            TitleBarIconAtlas::Glyph::Close, m_window_button_color, m_window_button_icon_px));
     }
 
     update_maximize_restore_icon();
@@ -496,6 +503,8 @@ auto WindowTitleBar::update_button_icons() -> void
 
 /**
  * @brief Update the maximize/restore button icon based on the actual window state.
+ *
+ * Both glyphs are prebuilt in the shared atlas; the icon is only replaced if the state changed.
  */
 auto WindowTitleBar::update_maximize_restore_icon() -> void
 {
@@ -503,13 +512,16 @@ auto WindowTitleBar::update_maximize_restore_icon() -> void
     {
         QWidget* top = window();
         const bool maximized = (top != nullptr) ? top->isMaximized() : false;
+        const TitleBarIconAtlas::Glyph glyph =
+            maximized ? TitleBarIconAtlas::Glyph::Restore : TitleBarIconAtlas::Glyph::Maximize;
 
-        const QString path = maximized ? QString(":/Resources/Icons/titlebar-restore.svg")
-                                       : QString(":/Resources/Icons/titlebar-maximize.svg");
+        const QIcon icon =
+            TitleBarIconAtlas::get_icon(glyph, m_window_button_color, m_window_button_icon_px);
 
-        const QSize sz(m_window_button_icon_px, m_window_button_icon_px);
-        QIcon icon = QIcon(UiUtils::colored_svg_icon(path, m_window_button_color, sz));
-        m_maximize_button->setIcon(icon);
+        if (m_maximize_button->icon().cacheKey() != icon.cacheKey())
+        {
+            m_maximize_button->setIcon(icon);
+        }
     }
 }
 
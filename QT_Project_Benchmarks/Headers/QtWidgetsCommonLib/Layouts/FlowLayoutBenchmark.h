@@ -0,0 +1,32 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @file FlowLayoutBenchmark.h
+ * @brief Benchmarks for FlowLayout layout passes.
+ *
+ * Compares a full layout pass of the current implementation (spacing and size hints snapshotted
+ * once, each geometry set once) against the previous per-item implementation, and measures cached
+ * `heightForWidth()` queries, the incremental relayout after appending one item, and filtering the
+ * items with `set_visible_subset()` and `remove_widgets()`. Each benchmark runs for 100, 1k and
+ * 10k items.
+ */
+class FlowLayoutBenchmark: public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void set_geometry_data();
+        void set_geometry();
+        void legacy_set_geometry_data();
+        void legacy_set_geometry();
+        void append_item_data();
+        void append_item();
+        void cached_height_for_width_data();
+        void cached_height_for_width();
+        void filter_visible_subset_data();
+        void filter_visible_subset();
+        void remove_widgets_data();
+        void remove_widgets();
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QObject>
+#include <QTemporaryDir>
+
+/**
+ * @file TranslatorBenchmark.h
+ * @brief Benchmarks for switching the application language.
+ *
+ * Each iteration switches between two languages while a window of 200 widgets receives the
+ * `LanguageChange` events, once with both languages in the translator cache and once with a
+ * cache capacity of one, so every switch loads the .qm files again. The .qm files are copies of
+ * Qt's `qt_en.qm`, which the build places next to the benchmark executable.
+ */
+class TranslatorBenchmark: public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void initTestCase();
+        void cached_switch();
+        void uncached_switch();
+
+    private:
+        QTemporaryDir m_dir;
+};
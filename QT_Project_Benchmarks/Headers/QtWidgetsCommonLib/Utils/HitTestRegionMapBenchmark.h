@@ -0,0 +1,21 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @file HitTestRegionMapBenchmark.h
+ * @brief Benchmarks for non-client hit testing of a frameless window.
+ *
+ * Compares hit tests against a precomputed `HitTestRegionMap` with the previous approach of
+ * querying the title bar widgets (button and menubar geometry, `QMenuBar::actionAt()`) on every
+ * test. Each iteration runs a fixed number of hit tests over the title bar, so hit tests per
+ * second are that number divided by the reported time per iteration.
+ */
+class HitTestRegionMapBenchmark: public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void cached_hit_test();
+        void widget_hit_test();
+};
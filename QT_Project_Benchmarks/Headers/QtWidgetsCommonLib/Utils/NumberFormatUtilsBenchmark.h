@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QObject>
+
+/**
+ * @file NumberFormatUtilsBenchmark.h
+ * @brief Benchmarks for abbreviated number formatting.
+ *
+ * Compares the previous `QString::number`/`prepend`/`chop` implementation with the `QString`,
+ * caller-buffer and batch overloads of `NumberFormatUtils`. Each iteration formats a fixed column
+ * of values, as a table model does for one column while scrolling or sorting.
+ */
+class NumberFormatUtilsBenchmark: public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void legacy_format();
+        void string_format();
+        void buffer_format();
+        void batch_format();
+};
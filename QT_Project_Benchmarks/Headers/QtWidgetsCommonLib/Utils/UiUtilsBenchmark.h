@@ -0,0 +1,28 @@
+#pragma once
+
+#include <QObject>
+#include <QTemporaryDir>
+
+/**
+ * @file UiUtilsBenchmark.h
+ * @brief Benchmarks for colored SVG icon rendering.
+ *
+ * Measures `UiUtils::colored_svg_icon()` with a cleared cache (parse, render and tint) and with
+ * a warm cache (key lookup only), at 24 and 64 px.
+ */
+class UiUtilsBenchmark: public QObject
+{
+        Q_OBJECT
+
+    private slots:
+        void initTestCase();
+        void uncached_icon_data();
+        void uncached_icon();
+        void cached_icon_data();
+        void cached_icon();
+        void cleanupTestCase();
+
+    private:
+        QTemporaryDir m_dir;
+        QString m_svg_path;
+};
@@ -0,0 +1,335 @@
+#include "QtWidgetsCommonLib/Layouts/FlowLayoutBenchmark.h"
+
+#include <QLabel>
+#include <QList>
+#include <QRect>
+#include <QSet>
+#include <QStyle>
+#include <QTest>
+#include <QWidget>
+#include <algorithm>
+#include <memory>
+
+#include "QtWidgetsCommonLib/Layouts/FlowLayout.h"
+
+using QtWidgetsCommonLib::FlowLayout;
+
+namespace
+{
+
+constexpr int kLayoutWidth = 800;
+
+/**
+ * @brief Creates a parent widget with a centered FlowLayout holding `item_count` labels.
+ *
+ * Spacing is left at -1 so it is taken from the style, as in typical use.
+ *
+ * @param item_count The number of labels to add.
+ * @return The parent widget owning the layout and all labels.
+ */
+auto create_populated_widget(int item_count) -> std::unique_ptr<QWidget>
+{
+    auto widget = std::make_unique<QWidget>();
+    auto* layout = new FlowLayout(widget.get(), 0, -1, -1, FlowLayout::RowAlignment::Center);
+
+    for (int i = 0; i < item_count; ++i)
+    {
+        layout->addWidget(new QLabel(QStringLiteral("Tag %1").arg(i), widget.get()));
+    }
+
+    return widget;
+}
+
+/**
+ * @brief Adds the 100 / 1k / 10k item rows shared by all benchmarks.
+ */
+auto add_item_count_rows() -> void
+{
+    QTest::addColumn<int>("item_count");
+    QTest::newRow("100") << 100;
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+}
+
+/**
+ * @brief Returns the style spacing the way FlowLayout::smart_spacing() does.
+ * @param parent The layout's parent widget.
+ * @param pm The pixel metric.
+ * @return The spacing, clamped to 0.
+ */
+auto legacy_spacing(QWidget* parent, QStyle::PixelMetric pm) -> int
+{
+    return std::max(0, parent->style()->pixelMetric(pm, nullptr, parent));
+}
+
+/**
+ * @brief Previous FlowLayout::do_layout() (centered rows), kept as baseline.
+ *
+ * Queries spacing and size hints per item (twice for the size hint), collects each row in a
+ * temporary list and sets every geometry twice: once unaligned, once with the row offset.
+ *
+ * @param items The layout items.
+ * @param rect The layout rectangle.
+ * @param parent The layout's parent widget (source of the style spacing).
+ * @return The total height used.
+ */
+auto legacy_do_layout(const QList<QLayoutItem*>& items, const QRect& rect, QWidget* parent) -> int
+{
+    int x = rect.x();
+    int y = rect.y();
+    int line_height = 0;
+    const int start_x = x;
+    const int max_width = rect.width();
+
+    QList<QLayoutItem*> line_items;
+    int line_width = 0;
+
+    const auto align_line = [&](int space_x) {
+        const int offset_x = (max_width - line_width + space_x) / 2;
+
+        for (QLayoutItem* line_item: line_items)
+        {
+            QRect geom = line_item->geometry();
+            geom.moveLeft(geom.left() + offset_x);
+            line_item->setGeometry(geom);
+        }
+    };
+
+    for (QLayoutItem* item: items)
+    {
+        int space_x = legacy_spacing(parent, QStyle::PM_LayoutHorizontalSpacing);
+        int space_y = legacy_spacing(parent, QStyle::PM_LayoutVerticalSpacing);
+        int item_width = item->sizeHint().width();
+        int item_height = item->sizeHint().height();
+        int next_x = x + item_width + space_x;
+
+        if ((next_x - space_x > rect.right()) && (line_height > 0))
+        {
+            align_line(space_x);
+            line_items.clear();
+            line_width = 0;
+
+            x = start_x;
+            y += line_height + space_y;
+            next_x = x + item_width + space_x;
+            line_height = 0;
+        }
+
+        item->setGeometry(QRect(QPoint(x, y), item->sizeHint()));
+        line_items.append(item);
+        line_width += item_width + space_x;
+        x = next_x;
+        line_height = std::max(line_height, item_height);
+    }
+
+    if (!line_items.isEmpty())
+    {
+        align_line(legacy_spacing(parent, QStyle::PM_LayoutHorizontalSpacing));
+    }
+
+    return y + line_height - rect.y();
+}
+
+}  // namespace
+
+/**
+ * @brief Rows for set_geometry().
+ */
+void FlowLayoutBenchmark::set_geometry_data()
+{
+    add_item_count_rows();
+}
+
+/**
+ * @brief Measures a full layout pass.
+ *
+ * Every pass uses a new width (as during a resize drag), cycling through more widths than the
+ * layout caches, so no cached rows are reused.
+ */
+void FlowLayoutBenchmark::set_geometry()
+{
+    QFETCH(int, item_count);
+    const std::unique_ptr<QWidget> widget = create_populated_widget(item_count);
+    auto* layout = static_cast<FlowLayout*>(widget->layout());
+    int pass = 0;
+
+    QBENCHMARK
+    {
+        layout->invalidate();
+        layout->setGeometry(QRect(0, 0, kLayoutWidth - (pass % 64), 100000));
+        ++pass;
+    }
+
+    QCOMPARE(layout->count(), item_count);
+}
+
+/**
+ * @brief Rows for legacy_set_geometry().
+ */
+void FlowLayoutBenchmark::legacy_set_geometry_data()
+{
+    add_item_count_rows();
+}
+
+/**
+ * @brief Measures the previous per-item layout pass on the same items, as baseline.
+ */
+void FlowLayoutBenchmark::legacy_set_geometry()
+{
+    QFETCH(int, item_count);
+    const std::unique_ptr<QWidget> widget = create_populated_widget(item_count);
+    QLayout* layout = widget->layout();
+    const QRect rect(0, 0, kLayoutWidth, 100000);
+
+    QList<QLayoutItem*> items;
+    items.reserve(item_count);
+
+    for (int i = 0; i < layout->count(); ++i)
+    {
+        items.append(layout->itemAt(i));
+    }
+
+    int height = 0;
+
+    QBENCHMARK
+    {
+        height = legacy_do_layout(items, rect, widget.get());
+    }
+
+    QVERIFY(height > 0);
+}
+
+/**
+ * @brief Rows for append_item().
+ */
+void FlowLayoutBenchmark::append_item_data()
+{
+    add_item_count_rows();
+}
+
+/**
+ * @brief Measures appending one item to a laid out layout and laying it out again.
+ *
+ * Only the last row is re-flowed and only the new item's geometry is set.
+ */
+void FlowLayoutBenchmark::append_item()
+{
+    QFETCH(int, item_count);
+    const std::unique_ptr<QWidget> widget = create_populated_widget(item_count);
+    auto* layout = static_cast<FlowLayout*>(widget->layout());
+    const QRect rect(0, 0, kLayoutWidth, 100000);
+    layout->setGeometry(rect);
+
+    QBENCHMARK
+    {
+        layout->addWidget(new QLabel(QStringLiteral("Tag"), widget.get()));
+        layout->setGeometry(rect);
+    }
+
+    QVERIFY(layout->count() > item_count);
+}
+
+/**
+ * @brief Rows for cached_height_for_width().
+ */
+void FlowLayoutBenchmark::cached_height_for_width_data()
+{
+    add_item_count_rows();
+}
+
+/**
+ * @brief Measures repeated heightForWidth() queries at one width (served from the cache).
+ */
+void FlowLayoutBenchmark::cached_height_for_width()
+{
+    QFETCH(int, item_count);
+    const std::unique_ptr<QWidget> widget = create_populated_widget(item_count);
+    auto* layout = static_cast<FlowLayout*>(widget->layout());
+    int height = layout->heightForWidth(kLayoutWidth);
+
+    QBENCHMARK
+    {
+        height = layout->heightForWidth(kLayoutWidth);
+    }
+
+    QVERIFY(height > 0);
+}
+
+/**
+ * @brief Rows for filter_visible_subset().
+ */
+void FlowLayoutBenchmark::filter_visible_subset_data()
+{
+    add_item_count_rows();
+}
+
+/**
+ * @brief Measures switching between two filters that each show every other item, and laying out.
+ */
+void FlowLayoutBenchmark::filter_visible_subset()
+{
+    QFETCH(int, item_count);
+    const std::unique_ptr<QWidget> widget = create_populated_widget(item_count);
+    auto* layout = static_cast<FlowLayout*>(widget->layout());
+    const QRect rect(0, 0, kLayoutWidth, 100000);
+    QSet<const QWidget*> even_widgets;
+    QSet<const QWidget*> odd_widgets;
+
+    for (int i = 0; i < layout->count(); ++i)
+    {
+        const QWidget* item_widget = layout->itemAt(i)->widget();
+
+        if (i % 2 == 0)
+        {
+            even_widgets.insert(item_widget);
+        }
+        else
+        {
+            odd_widgets.insert(item_widget);
+        }
+    }
+
+    layout->setGeometry(rect);
+    bool even = true;
+
+    QBENCHMARK
+    {
+        layout->set_visible_subset(even ? even_widgets : odd_widgets);
+        layout->setGeometry(rect);
+        even = !even;
+    }
+
+    QVERIFY(layout->count() == item_count);
+}
+
+/**
+ * @brief Rows for remove_widgets().
+ */
+void FlowLayoutBenchmark::remove_widgets_data()
+{
+    add_item_count_rows();
+}
+
+/**
+ * @brief Measures removing every other widget in one batch and re-adding them.
+ */
+void FlowLayoutBenchmark::remove_widgets()
+{
+    QFETCH(int, item_count);
+    const std::unique_ptr<QWidget> widget = create_populated_widget(item_count);
+    auto* layout = static_cast<FlowLayout*>(widget->layout());
+    QList<QWidget*> removed_widgets;
+
+    for (int i = 0; i < layout->count(); i += 2)
+    {
+        removed_widgets.append(layout->itemAt(i)->widget());
+    }
+
+    QBENCHMARK
+    {
+        layout->remove_widgets(removed_widgets);
+        layout->add_widgets(removed_widgets);
+    }
+
+    QVERIFY(layout->count() == item_count);
+}
@@ -0,0 +1,104 @@
+#include "QtWidgetsCommonLib/Services/TranslatorBenchmark.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QLabel>
+#include <QLocale>
+#include <QTest>
+#include <QVBoxLayout>
+#include <QWidget>
+#include <memory>
+
+#include "QtWidgetsCommonLib/Services/Translator.h"
+
+using QtWidgetsCommonLib::Translator;
+
+namespace
+{
+
+constexpr int kWidgetCount = 200;
+
+/**
+ * @brief Creates a window of labels that receive the `LanguageChange` events.
+ * @return The window owning all labels.
+ */
+auto create_window() -> std::unique_ptr<QWidget>
+{
+    auto window = std::make_unique<QWidget>();
+    auto* layout = new QVBoxLayout(window.get());
+
+    for (int i = 0; i < kWidgetCount; ++i)
+    {
+        layout->addWidget(new QLabel(QStringLiteral("Label %1").arg(i), window.get()));
+    }
+
+    return window;
+}
+
+/**
+ * @brief Switches between German and English once per iteration, including event delivery.
+ * @param translator The translator to switch.
+ * @return true if every switch succeeded, false otherwise.
+ */
+auto run_switch_benchmark(Translator& translator) -> bool
+{
+    const QLocale german(QLocale::German);
+    const QLocale english(QLocale::English);
+    bool result = true;
+    bool use_german = false;
+
+    QBENCHMARK
+    {
+        use_german = !use_german;
+        result = translator.load_translation(use_german ? german : english) && result;
+        QCoreApplication::sendPostedEvents();
+    }
+
+    return result;
+}
+
+}  // namespace
+
+/**
+ * @brief Creates app_* and qt_* .qm files for German and English from Qt's qt_en.qm.
+ */
+void TranslatorBenchmark::initTestCase()
+{
+    const QString qt_en_src =
+        QCoreApplication::applicationDirPath() + QStringLiteral("/translations/qt_en.qm");
+    QVERIFY(QFile::exists(qt_en_src));
+    QVERIFY(m_dir.isValid());
+
+    for (const QString& name: {QStringLiteral("app_de.qm"), QStringLiteral("qt_de.qm"),
+                               QStringLiteral("app_en.qm"), QStringLiteral("qt_en.qm")})
+    {
+        QVERIFY(QFile::copy(qt_en_src, m_dir.filePath(name)));
+    }
+}
+
+/**
+ * @brief Measures a language switch with both languages in the translator cache.
+ */
+void TranslatorBenchmark::cached_switch()
+{
+    const std::unique_ptr<QWidget> window = create_window();
+    Translator translator;
+    translator.set_translations_path(m_dir.path());
+    QVERIFY(translator.preload_translation(QLocale(QLocale::German)));
+    QVERIFY(translator.preload_translation(QLocale(QLocale::English)));
+
+    QVERIFY(run_switch_benchmark(translator));
+}
+
+/**
+ * @brief Measures a language switch that has to load the .qm files again.
+ */
+void TranslatorBenchmark::uncached_switch()
+{
+    const std::unique_ptr<QWidget> window = create_window();
+    Translator translator;
+    translator.set_translations_path(m_dir.path());
+    translator.set_cache_capacity(1);
+
+    QVERIFY(run_switch_benchmark(translator));
+}
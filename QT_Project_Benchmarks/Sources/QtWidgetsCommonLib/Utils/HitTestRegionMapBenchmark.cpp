@@ -0,0 +1,187 @@
+#include "QtWidgetsCommonLib/Utils/HitTestRegionMapBenchmark.h"
+
+#include <QAction>
+#include <QApplication>
+#include <QLayout>
+#include <QList>
+#include <QMenuBar>
+#include <QPoint>
+#include <QPushButton>
+#include <QRect>
+#include <QTest>
+#include <memory>
+
+#include "QtWidgetsCommonLib/Utils/HitTestRegionMap.h"
+#include "QtWidgetsCommonLib/Widgets/WindowTitleBar.h"
+
+using QtWidgetsCommonLib::HitTestRegionMap;
+using QtWidgetsCommonLib::WindowTitleBar;
+
+namespace
+{
+
+constexpr int kTitleBarWidth = 1200;
+constexpr int kResizeBorder = 8;
+constexpr int kProbeCount = 10000;
+
+/**
+ * @brief Creates a shown title bar with a top-row menubar of a few menus.
+ * @return The title bar.
+ */
+auto create_title_bar() -> std::unique_ptr<WindowTitleBar>
+{
+    auto title_bar = std::make_unique<WindowTitleBar>();
+    auto* menubar = new QMenuBar();
+
+    for (const QString& title: {QStringLiteral("File"), QStringLiteral("Edit"),
+                                QStringLiteral("View"), QStringLiteral("Help")})
+    {
+        menubar->addMenu(title);
+    }
+
+    title_bar->set_menubar(menubar);
+    title_bar->apply_pending_layout();
+    title_bar->resize(kTitleBarWidth, 40);
+    title_bar->show();
+    title_bar->layout()->activate();
+    QApplication::processEvents();
+
+    return title_bar;
+}
+
+/**
+ * @brief Returns probe points spread evenly over the title bar, including the borders.
+ * @param title_bar The title bar.
+ * @return kProbeCount points in title bar coordinates.
+ */
+auto create_probe_points(const WindowTitleBar& title_bar) -> QList<QPoint>
+{
+    QList<QPoint> points;
+    points.reserve(kProbeCount);
+
+    for (int i = 0; i < kProbeCount; ++i)
+    {
+        points.append(QPoint((i * 37) % title_bar.width(), (i * 11) % title_bar.height()));
+    }
+
+    return points;
+}
+
+/**
+ * @brief Builds the hit-test region map of a title bar as `AppWindow` does.
+ * @param title_bar The title bar, at the window's top-left corner.
+ * @return The region map.
+ */
+auto create_region_map(const WindowTitleBar& title_bar) -> HitTestRegionMap
+{
+    QList<QRect> interactive_rects;
+
+    for (QPushButton* button: {title_bar.get_minimize_button(), title_bar.get_maximize_button(),
+                               title_bar.get_close_button()})
+    {
+        interactive_rects.append(button->geometry());
+    }
+
+    QMenuBar* menubar = title_bar.get_menubar();
+
+    for (QAction* action: menubar->actions())
+    {
+        interactive_rects.append(menubar->actionGeometry(action).translated(menubar->pos()));
+    }
+
+    HitTestRegionMap map;
+    map.update(QSize(title_bar.width(), 800), kResizeBorder, title_bar.rect(), interactive_rects);
+
+    return map;
+}
+
+/**
+ * @brief Previous per-message hit test (without the WinAPI calls), kept as baseline.
+ *
+ * Queries the button and menubar geometry and `QMenuBar::actionAt()` on every call.
+ *
+ * @param title_bar The title bar, at the window's top-left corner.
+ * @param local The point in title bar coordinates.
+ * @return The region under the point.
+ */
+auto legacy_hit_test(const WindowTitleBar& title_bar, const QPoint& local)
+    -> HitTestRegionMap::Region
+{
+    const bool on_left = local.x() < kResizeBorder;
+    const bool on_right = local.x() >= title_bar.width() - kResizeBorder;
+    const bool on_top = local.y() < kResizeBorder;
+    bool over_button = title_bar.get_minimize_button()->geometry().contains(local) ||
+                       title_bar.get_maximize_button()->geometry().contains(local) ||
+                       title_bar.get_close_button()->geometry().contains(local);
+
+    QMenuBar* menubar = title_bar.get_menubar();
+
+    if (!over_button && menubar->isVisible() && menubar->geometry().contains(local))
+    {
+        const bool menubar_on_top_row = menubar->geometry().center().y() < title_bar.height() / 2;
+        over_button = menubar->actionAt(menubar->mapFrom(&title_bar, local)) != nullptr ||
+                      !menubar_on_top_row;
+    }
+
+    HitTestRegionMap::Region result = HitTestRegionMap::Region::Client;
+
+    if (on_top || on_left || on_right)
+    {
+        result = HitTestRegionMap::Region::Top;
+    }
+    else if (!over_button && title_bar.rect().contains(local))
+    {
+        result = HitTestRegionMap::Region::Caption;
+    }
+
+    return result;
+}
+
+}  // namespace
+
+/**
+ * @brief Measures kProbeCount hit tests against the precomputed region map.
+ */
+void HitTestRegionMapBenchmark::cached_hit_test()
+{
+    const std::unique_ptr<WindowTitleBar> title_bar = create_title_bar();
+    const QList<QPoint> points = create_probe_points(*title_bar);
+    const HitTestRegionMap map = create_region_map(*title_bar);
+    int captions = 0;
+
+    QBENCHMARK
+    {
+        captions = 0;
+
+        for (const QPoint& point: points)
+        {
+            captions += map.hit_test(point) == HitTestRegionMap::Region::Caption ? 1 : 0;
+        }
+    }
+
+    QVERIFY(captions > 0);
+}
+
+/**
+ * @brief Measures kProbeCount hit tests that query the title bar widgets, as baseline.
+ */
+void HitTestRegionMapBenchmark::widget_hit_test()
+{
+    const std::unique_ptr<WindowTitleBar> title_bar = create_title_bar();
+    const QList<QPoint> points = create_probe_points(*title_bar);
+    int captions = 0;
+
+    QBENCHMARK
+    {
+        captions = 0;
+
+        for (const QPoint& point: points)
+        {
+            captions += legacy_hit_test(*title_bar, point) == HitTestRegionMap::Region::Caption
+                            ? 1
+                            : 0;
+        }
+    }
+
+    QVERIFY(captions > 0);
+}
@@ -0,0 +1,167 @@
+#include "QtWidgetsCommonLib/Utils/NumberFormatUtilsBenchmark.h"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QTest>
+#include <array>
+#include <cmath>
+#include <span>
+
+#include "QtWidgetsCommonLib/Utils/NumberFormatUtils.h"
+
+using QtWidgetsCommonLib::NumberFormatUtils;
+
+namespace
+{
+
+constexpr int kValueCount = 50000;
+
+/**
+ * @brief Returns values spread over all suffixes, including negative and fractional ones.
+ * @return kValueCount values.
+ */
+auto create_values() -> QList<double>
+{
+    QList<double> values;
+    values.reserve(kValueCount);
+
+    for (int i = 0; i < kValueCount; ++i)
+    {
+        const double magnitude = std::pow(10.0, i % 14);
+        const double sign = (i % 7 == 0) ? -1.0 : 1.0;
+        values.append(sign * magnitude * (1.0 + (i % 97) / 10.0));
+    }
+
+    return values;
+}
+
+/**
+ * @brief Previous implementation of `format_number_abbreviated(double)`, kept as baseline.
+ * @param value The number to format.
+ * @return Abbreviated string representation.
+ */
+auto legacy_format_number_abbreviated(double value) -> QString
+{
+    constexpr const char* suffixes[] = {"", "K", "M", "B", "T"};
+    constexpr int num_suffixes = sizeof(suffixes) / sizeof(suffixes[0]);
+
+    double abs_value = std::abs(value);
+    int suffix_index = 0;
+    int decimals = 0;
+    QString number_str;
+
+    if (abs_value < 1000.0)
+    {
+        decimals = (abs_value != static_cast<int>(abs_value)) ? 1 : 0;
+        number_str = QString::number(value, 'f', decimals);
+    }
+    else
+    {
+        while (abs_value >= 1000.0 && suffix_index < num_suffixes - 1)
+        {
+            abs_value /= 1000.0;
+            ++suffix_index;
+        }
+
+        decimals = (abs_value < 10.0 && suffix_index > 0) ? 1 : 0;
+        number_str = QString::number(abs_value, 'f', decimals);
+
+        if (value < 0.0)
+        {
+            number_str.prepend('-');
+        }
+
+        number_str += suffixes[suffix_index];
+    }
+
+    if (number_str.endsWith(".0"))
+    {
+        number_str.chop(2);
+    }
+
+    return number_str;
+}
+
+}  // namespace
+
+/**
+ * @brief Measures kValueCount calls of the previous implementation, as baseline.
+ */
+void NumberFormatUtilsBenchmark::legacy_format()
+{
+    const QList<double> values = create_values();
+    qsizetype total_length = 0;
+
+    QBENCHMARK
+    {
+        total_length = 0;
+
+        for (const double value: values)
+        {
+            total_length += legacy_format_number_abbreviated(value).size();
+        }
+    }
+
+    QVERIFY(total_length > 0);
+}
+
+/**
+ * @brief Measures kValueCount calls of the `QString` overload.
+ */
+void NumberFormatUtilsBenchmark::string_format()
+{
+    const QList<double> values = create_values();
+    qsizetype total_length = 0;
+
+    QBENCHMARK
+    {
+        total_length = 0;
+
+        for (const double value: values)
+        {
+            total_length += NumberFormatUtils::format_number_abbreviated(value).size();
+        }
+    }
+
+    QVERIFY(total_length > 0);
+}
+
+/**
+ * @brief Measures kValueCount calls of the caller-buffer overload (no allocations).
+ */
+void NumberFormatUtilsBenchmark::buffer_format()
+{
+    const QList<double> values = create_values();
+    std::array<char16_t, NumberFormatUtils::kMaxAbbreviatedLength> buffer{};
+    qsizetype total_length = 0;
+
+    QBENCHMARK
+    {
+        total_length = 0;
+
+        for (const double value: values)
+        {
+            total_length += NumberFormatUtils::format_number_abbreviated(value, buffer);
+        }
+    }
+
+    QVERIFY(total_length > 0);
+}
+
+/**
+ * @brief Measures one batch call formatting all kValueCount values.
+ */
+void NumberFormatUtilsBenchmark::batch_format()
+{
+    const QList<double> values = create_values();
+    QStringList formatted;
+
+    QBENCHMARK
+    {
+        formatted = NumberFormatUtils::format_numbers_abbreviated(
+            std::span<const double>(values.constData(), values.size()));
+    }
+
+    QCOMPARE(formatted.size(), values.size());
+}
@@ -0,0 +1,192 @@
+#include "QtWidgetsCommonLib/Utils/StylesheetLoaderBenchmark.h"
+
+#include <QLabel>
+#include <QMap>
+#include <QPushButton>
+#include <QString>
+#include <QTest>
+#include <QVBoxLayout>
+#include <QWidget>
+#include <memory>
+
+#include "QtWidgetsCommonLib/Utils/CompiledStylesheet.h"
+#include "QtWidgetsCommonLib/Utils/StylesheetLoader.h"
+
+using QtWidgetsCommonLib::CompiledStylesheet;
+using QtWidgetsCommonLib::StylesheetLoader;
+using QtWidgetsCommonLib::VariableResolution;
+
+namespace
+{
+
+constexpr int kVariableCount = 40;
+constexpr int kWidgetCount = 200;
+
+/**
+ * @brief Generates a stylesheet with a default block, "Dark" and "Light" themes and rules.
+ *
+ * Half of the variables reference another variable, as accent and hover colors typically do;
+ * every rule uses three variables.
+ *
+ * @param rule_count The number of rules after the @Variables blocks.
+ * @return The raw stylesheet.
+ */
+auto create_stylesheet(int rule_count) -> QString
+{
+    QString result = QStringLiteral("@Variables {\n");
+
+    for (int i = 0; i < kVariableCount; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            const int rgb = i * 4099 % 0xFFFFFF;
+            const QString hex = QStringLiteral("%1").arg(rgb, 6, 16, QLatin1Char('0'));
+            result += QStringLiteral("    @Color%1: #%2;\n").arg(i).arg(hex);
+        }
+        else
+        {
+            result += QStringLiteral("    @Color%1: @Color%2;\n").arg(i).arg(i - 1);
+        }
+    }
+
+    result += QStringLiteral("}\n@Variables[Name=\"Dark\"] {\n    @Color0: #202020;\n}\n");
+    result += QStringLiteral("@Variables[Name=\"Light\"] {\n    @Color0: #f0f0f0;\n}\n");
+
+    for (int i = 0; i < rule_count; ++i)
+    {
+        result += QStringLiteral(
+                      "QWidget#item%1:hover {\n    color: @Color%2;\n    background: @Color%3;\n"
+                      "    border: 1px solid @Color%4;\n    padding: 2px 4px;\n}\n")
+                      .arg(i)
+                      .arg(i % kVariableCount)
+                      .arg((i + 7) % kVariableCount)
+                      .arg((i + 13) % kVariableCount);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Adds the 200 / 2000 rule rows shared by all benchmarks.
+ */
+auto add_rule_count_rows() -> void
+{
+    QTest::addColumn<int>("rule_count");
+    QTest::newRow("200 rules") << 200;
+    QTest::newRow("2000 rules") << 2000;
+}
+
+/**
+ * @brief Creates a widget tree with labels and buttons to apply the stylesheet to.
+ * @return The root widget owning all children.
+ */
+auto create_widget_tree() -> std::unique_ptr<QWidget>
+{
+    auto root = std::make_unique<QWidget>();
+    auto* layout = new QVBoxLayout(root.get());
+
+    for (int i = 0; i < kWidgetCount; ++i)
+    {
+        QWidget* child = nullptr;
+
+        if (i % 2 == 0)
+        {
+            child = new QLabel(QStringLiteral("Label"), root.get());
+        }
+        else
+        {
+            child = new QPushButton(QStringLiteral("Button"), root.get());
+        }
+
+        child->setObjectName(QStringLiteral("item%1").arg(i));
+        layout->addWidget(child);
+    }
+
+    return root;
+}
+
+}  // namespace
+
+/**
+ * @brief Rows for compile().
+ */
+void StylesheetLoaderBenchmark::compile_data()
+{
+    add_rule_count_rows();
+}
+
+/**
+ * @brief Measures parsing the raw text into variable tables and a slot template.
+ */
+void StylesheetLoaderBenchmark::compile()
+{
+    QFETCH(int, rule_count);
+    const QString source = create_stylesheet(rule_count);
+    qsizetype slot_count = 0;
+
+    QBENCHMARK
+    {
+        const CompiledStylesheet compiled(source);
+        slot_count = compiled.get_slot_names().size();
+    }
+
+    QCOMPARE(slot_count, static_cast<qsizetype>(kVariableCount));
+}
+
+/**
+ * @brief Rows for substitute().
+ */
+void StylesheetLoaderBenchmark::substitute_data()
+{
+    add_rule_count_rows();
+}
+
+/**
+ * @brief Measures resolving a theme's variables and rendering the body with them.
+ */
+void StylesheetLoaderBenchmark::substitute()
+{
+    QFETCH(int, rule_count);
+    const CompiledStylesheet compiled(create_stylesheet(rule_count));
+    const QMap<QString, QString> variables =
+        compiled.get_theme_variables(QStringLiteral("Dark"));
+    QString stylesheet;
+
+    QBENCHMARK
+    {
+        const VariableResolution resolution = CompiledStylesheet::resolve_variables(variables);
+        stylesheet = compiled.render(resolution.values);
+    }
+
+    QVERIFY(!stylesheet.contains(QLatin1Char('@')));
+}
+
+/**
+ * @brief Rows for switch_theme().
+ */
+void StylesheetLoaderBenchmark::switch_theme_data()
+{
+    add_rule_count_rows();
+}
+
+/**
+ * @brief Measures a theme switch: substitution plus applying the result to a widget tree.
+ */
+void StylesheetLoaderBenchmark::switch_theme()
+{
+    QFETCH(int, rule_count);
+    const std::unique_ptr<QWidget> root = create_widget_tree();
+    StylesheetLoader loader;
+    loader.set_apply_target(root.get());
+    QVERIFY(loader.load_stylesheet_from_data(create_stylesheet(rule_count),
+                                             QStringLiteral("Dark")));
+    bool dark = true;
+
+    QBENCHMARK
+    {
+        dark = !dark;
+        QVERIFY(loader.set_theme(dark ? QStringLiteral("Dark") : QStringLiteral("Light")));
+    }
+
+    QCOMPARE(root->styleSheet(), loader.get_current_stylesheet());
+}
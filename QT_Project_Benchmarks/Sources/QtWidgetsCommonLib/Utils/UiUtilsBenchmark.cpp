@@ -0,0 +1,108 @@
+#include "QtWidgetsCommonLib/Utils/UiUtilsBenchmark.h"
+
+#include <QColor>
+#include <QFile>
+#include <QPixmap>
+#include <QSize>
+#include <QTest>
+
+#include "QtWidgetsCommonLib/Utils/UiUtils.h"
+
+using QtWidgetsCommonLib::UiUtils;
+
+namespace
+{
+
+/**
+ * @brief A title bar style icon: a few paths and a circle, as in typical icon sets.
+ */
+constexpr char kSvgData[] =
+    R"(<svg xmlns="http://www.w3.org/2000/svg" viewBox="0 0 24 24">)"
+    R"(<path d="M3 6h18M3 12h18M3 18h18" stroke="#000" stroke-width="2" fill="none"/>)"
+    R"(<circle cx="18" cy="6" r="3" fill="#000"/>)"
+    R"(<path d="M12 2a10 10 0 1 0 0.01 0z" fill="none" stroke="#000"/>)"
+    R"(</svg>)";
+
+/**
+ * @brief Adds the 24 px / 64 px rows shared by all benchmarks.
+ */
+auto add_icon_size_rows() -> void
+{
+    QTest::addColumn<int>("icon_size");
+    QTest::newRow("24px") << 24;
+    QTest::newRow("64px") << 64;
+}
+
+}  // namespace
+
+/**
+ * @brief Writes the SVG used by all benchmarks.
+ */
+void UiUtilsBenchmark::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    m_svg_path = m_dir.filePath(QStringLiteral("icon.svg"));
+
+    QFile file(m_svg_path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(kSvgData);
+}
+
+/**
+ * @brief Rows for uncached_icon().
+ */
+void UiUtilsBenchmark::uncached_icon_data()
+{
+    add_icon_size_rows();
+}
+
+/**
+ * @brief Measures parsing, rendering and tinting an icon that is not cached.
+ */
+void UiUtilsBenchmark::uncached_icon()
+{
+    QFETCH(int, icon_size);
+    const QSize size(icon_size, icon_size);
+    QPixmap pixmap;
+
+    QBENCHMARK
+    {
+        UiUtils::clear_icon_cache();
+        pixmap = UiUtils::colored_svg_icon(m_svg_path, QColor(Qt::red), size);
+    }
+
+    QCOMPARE(pixmap.width(), icon_size);
+}
+
+/**
+ * @brief Rows for cached_icon().
+ */
+void UiUtilsBenchmark::cached_icon_data()
+{
+    add_icon_size_rows();
+}
+
+/**
+ * @brief Measures requesting an icon that is already cached.
+ */
+void UiUtilsBenchmark::cached_icon()
+{
+    QFETCH(int, icon_size);
+    const QSize size(icon_size, icon_size);
+    QPixmap pixmap = UiUtils::colored_svg_icon(m_svg_path, QColor(Qt::red), size);
+
+    QBENCHMARK
+    {
+        pixmap = UiUtils::colored_svg_icon(m_svg_path, QColor(Qt::red), size);
+    }
+
+    QCOMPARE(pixmap.width(), icon_size);
+}
+
+/**
+ * @brief Drops the cached icons of the temporary SVG.
+ */
+void UiUtilsBenchmark::cleanupTestCase()
+{
+    UiUtils::clear_icon_cache();
+}
@@ -0,0 +1,143 @@
+#include <QApplication>
+#include <QDir>
+#include <QLoggingCategory>
+#include <QStringList>
+#include <QTest>
+
+#include "QtWidgetsCommonLib/Layouts/FlowLayoutBenchmark.h"
+#include "QtWidgetsCommonLib/Services/TranslatorBenchmark.h"
+#include "QtWidgetsCommonLib/Utils/HitTestRegionMapBenchmark.h"
+#include "QtWidgetsCommonLib/Utils/NumberFormatUtilsBenchmark.h"
+#include "QtWidgetsCommonLib/Utils/StylesheetLoaderBenchmark.h"
+#include "QtWidgetsCommonLib/Utils/UiUtilsBenchmark.h"
+
+namespace
+{
+
+/**
+ * @struct BenchmarkArguments
+ * @brief Command-line arguments split into runner options and QtTest arguments.
+ */
+struct BenchmarkArguments {
+        QStringList qtest_arguments;
+        QString output_dir;
+        QString output_format = QStringLiteral("xml");
+};
+
+/**
+ * @brief Extracts `-outputdir <dir>` and `-outputformat <format>` from the arguments.
+ * @param arguments All command-line arguments, including the program name.
+ * @return The runner options and the remaining arguments for QtTest.
+ */
+auto parse_arguments(const QStringList& arguments) -> BenchmarkArguments
+{
+    BenchmarkArguments result;
+    qsizetype i = 0;
+
+    while (i < arguments.size())
+    {
+        const QString& argument = arguments[i];
+        const bool has_value = i + 1 < arguments.size();
+
+        if (argument == QStringLiteral("-outputdir") && has_value)
+        {
+            result.output_dir = arguments[i + 1];
+            i += 2;
+        }
+        else if (argument == QStringLiteral("-outputformat") && has_value)
+        {
+            result.output_format = arguments[i + 1];
+            i += 2;
+        }
+        else
+        {
+            result.qtest_arguments.append(argument);
+            ++i;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Runs one suite, writing its results to `<output_dir>/<suite>.<ext>` if requested.
+ *
+ * The console keeps the plain text log, so a run can be watched and archived at the same time.
+ *
+ * @param suite The benchmark suite.
+ * @param arguments The parsed command-line arguments.
+ * @return 0 if the suite passed, otherwise non-zero.
+ */
+auto run_suite(QObject& suite, const BenchmarkArguments& arguments) -> int
+{
+    QStringList qtest_arguments = arguments.qtest_arguments;
+
+    if (!arguments.output_dir.isEmpty())
+    {
+        const QString extension = (arguments.output_format == QStringLiteral("junitxml"))
+                                      ? QStringLiteral("xml")
+                                      : arguments.output_format;
+        const QString file_name = QStringLiteral("%1.%2").arg(
+            QString::fromLatin1(suite.metaObject()->className()), extension);
+        const QString file_path = QDir(arguments.output_dir).filePath(file_name);
+
+        qtest_arguments << QStringLiteral("-o")
+                        << QStringLiteral("%1,%2").arg(file_path, arguments.output_format)
+                        << QStringLiteral("-o") << QStringLiteral("-,txt");
+    }
+
+    return QTest::qExec(&suite, qtest_arguments);
+}
+
+}  // namespace
+
+/**
+ * @brief Runs all QtTest benchmark suites.
+ *
+ * Command-line arguments are forwarded to every suite (e.g. `-iterations 50`, `-tickcounter`).
+ * `-outputdir <dir>` additionally writes one machine-readable result file per suite into
+ * `<dir>`, in the QtTest format given by `-outputformat` (xml, csv, junitxml, tap or txt;
+ * default: xml). Library debug messages are disabled so they do not end up in the results.
+ *
+ * @param argc Number of command-line arguments.
+ * @param argv Array of command-line arguments.
+ * @return 0 if all suites passed, otherwise non-zero.
+ */
+auto main(int argc, char* argv[]) -> int
+{
+    QApplication app(argc, argv);
+    app.setApplicationName(QStringLiteral("QtWidgetsBenchmarks"));
+    app.setOrganizationName(QStringLiteral("QtWidgetsTemplate_Benchmarks"));
+    app.setOrganizationDomain(QStringLiteral("AdrianHelbig.de"));
+
+    QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false"));
+
+    const BenchmarkArguments arguments = parse_arguments(QCoreApplication::arguments());
+
+    if (!arguments.output_dir.isEmpty())
+    {
+        QDir().mkpath(arguments.output_dir);
+    }
+
+    int result = 0;
+
+    FlowLayoutBenchmark flow_layout_benchmark;
+    result |= run_suite(flow_layout_benchmark, arguments);
+
+    HitTestRegionMapBenchmark hit_test_region_map_benchmark;
+    result |= run_suite(hit_test_region_map_benchmark, arguments);
+
+    NumberFormatUtilsBenchmark number_format_utils_benchmark;
+    result |= run_suite(number_format_utils_benchmark, arguments);
+
+    StylesheetLoaderBenchmark stylesheet_loader_benchmark;
+    result |= run_suite(stylesheet_loader_benchmark, arguments);
+
+    TranslatorBenchmark translator_benchmark;
+    result |= run_suite(translator_benchmark, arguments);
+
+    UiUtilsBenchmark ui_utils_benchmark;
+    result |= run_suite(ui_utils_benchmark, arguments);
+
+    return result;
+}
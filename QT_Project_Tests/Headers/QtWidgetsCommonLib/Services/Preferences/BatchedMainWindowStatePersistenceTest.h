@@ -0,0 +1,63 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <QByteArray>
+
+#include "QtWidgetsCommonLib/Services/Preferences/BatchedMainWindowStatePersistence.h"
+#include "QtWidgetsCommonLib/Services/Preferences/IMainWindowStatePersistence.h"
+#include "QtWidgetsCommonLib/Services/Preferences/IPreferencesTransaction.h"
+
+/**
+ * @class RecordingWindowStatePersistence
+ * @brief In-memory window state persistence that counts writes and transactions.
+ */
+class RecordingWindowStatePersistence: public QtWidgetsCommonLib::IMainWindowStatePersistence,
+                                       public QtWidgetsCommonLib::IPreferencesTransaction
+{
+    public:
+        auto get_mainwindow_geometry() -> QByteArray override { return m_geometry; }
+        auto set_mainwindow_geometry(const QByteArray& geometry) -> void override
+        {
+            m_geometry = geometry;
+            ++m_writes;
+        }
+        auto get_mainwindow_state() -> QByteArray override { return m_state; }
+        auto set_mainwindow_state(const QByteArray& state) -> void override
+        {
+            m_state = state;
+            ++m_writes;
+        }
+        auto get_mainwindow_windowstate() -> int override { return m_window_state; }
+        auto set_mainwindow_windowstate(int state) -> void override
+        {
+            m_window_state = state;
+            ++m_writes;
+        }
+        auto begin_transaction() -> void override { ++m_transactions; }
+        auto commit_transaction() -> void override { ++m_commits; }
+
+        QByteArray m_geometry;
+        QByteArray m_state;
+        int m_window_state = 0;
+        int m_writes = 0;
+        int m_transactions = 0;
+        int m_commits = 0;
+};
+
+/**
+ * @file BatchedMainWindowStatePersistenceTest.h
+ * @brief Test fixture for BatchedMainWindowStatePersistence.
+ */
+class BatchedMainWindowStatePersistenceTest: public ::testing::Test
+{
+    protected:
+        BatchedMainWindowStatePersistenceTest() = default;
+        ~BatchedMainWindowStatePersistenceTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+
+        RecordingWindowStatePersistence m_target;
+        QtWidgetsCommonLib::BatchedMainWindowStatePersistence* m_persistence = nullptr;
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "QtWidgetsCommonLib/Utils/AbbreviatedNumberFormatter.h"
+
+/**
+ * @file AbbreviatedNumberFormatterTest.h
+ * @brief Test fixture for AbbreviatedNumberFormatter.
+ */
+class AbbreviatedNumberFormatterTest: public ::testing::Test
+{
+    protected:
+        AbbreviatedNumberFormatterTest() = default;
+        ~AbbreviatedNumberFormatterTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+};
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "QtWidgetsCommonLib/Utils/CompiledStylesheet.h"
+
+/**
+ * @file CompiledStylesheetTest.h
+ * @brief Test fixture for CompiledStylesheet.
+ */
+class CompiledStylesheetTest: public ::testing::Test
+{
+    protected:
+        CompiledStylesheetTest() = default;
+        ~CompiledStylesheetTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "QtWidgetsCommonLib/Utils/DwmAttributeState.h"
+
+/**
+ * @file DwmAttributeStateTest.h
+ * @brief Test fixture for DwmAttributeState.
+ */
+class DwmAttributeStateTest: public ::testing::Test
+{
+    protected:
+        DwmAttributeStateTest() = default;
+        ~DwmAttributeStateTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+
+        QtWidgetsCommonLib::DwmAttributeState m_state;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "QtWidgetsCommonLib/Utils/HitTestRegionMap.h"
+
+/**
+ * @file HitTestRegionMapTest.h
+ * @brief Test fixture for HitTestRegionMap.
+ */
+class HitTestRegionMapTest: public ::testing::Test
+{
+    protected:
+        HitTestRegionMapTest() = default;
+        ~HitTestRegionMapTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+
+        /**
+         * @brief 800x600 window, 8 px borders, 40 px caption with one button at the right.
+         */
+        QtWidgetsCommonLib::HitTestRegionMap m_map;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <QList>
+#include <memory>
+
+#include "QtWidgetsCommonLib/Utils/NativeIconCache.h"
+
+/**
+ * @file NativeIconCacheTest.h
+ * @brief Test fixture for NativeIconCache.
+ *
+ * The cache under test uses fake handles (heap-allocated ints) and records every created and
+ * destroyed handle, so the reference counting can be tested on every platform.
+ */
+class NativeIconCacheTest: public ::testing::Test
+{
+    protected:
+        NativeIconCacheTest() = default;
+        ~NativeIconCacheTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+
+        std::unique_ptr<QtWidgetsCommonLib::NativeIconCache> m_cache;
+        QList<QtWidgetsCommonLib::NativeIconCache::Handle> m_created;
+        QList<QtWidgetsCommonLib::NativeIconCache::Handle> m_destroyed;
+};
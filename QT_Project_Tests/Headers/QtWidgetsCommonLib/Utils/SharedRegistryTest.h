@@ -0,0 +1,24 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <QString>
+
+#include "QtWidgetsCommonLib/Utils/SharedRegistry.h"
+
+/**
+ * @file SharedRegistryTest.h
+ * @brief Test fixture for SharedRegistry.
+ */
+class SharedRegistryTest: public ::testing::Test
+{
+    protected:
+        SharedRegistryTest() = default;
+        ~SharedRegistryTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+
+        QtWidgetsCommonLib::SharedRegistry<QString, const QString> m_registry;
+        int m_create_calls = 0;
+};
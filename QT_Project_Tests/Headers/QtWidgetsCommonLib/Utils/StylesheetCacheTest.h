@@ -0,0 +1,23 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+
+#include "QtWidgetsCommonLib/Utils/StylesheetCache.h"
+
+/**
+ * @file StylesheetCacheTest.h
+ * @brief Test fixture for StylesheetCache.
+ */
+class StylesheetCacheTest: public ::testing::Test
+{
+    protected:
+        StylesheetCacheTest() = default;
+        ~StylesheetCacheTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+
+        QTemporaryDir* m_temp_dir = nullptr;
+};
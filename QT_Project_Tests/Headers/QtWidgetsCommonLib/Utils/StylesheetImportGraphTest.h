@@ -0,0 +1,33 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <QString>
+#include <QTemporaryDir>
+
+#include "QtWidgetsCommonLib/Utils/StylesheetImportGraph.h"
+
+/**
+ * @file StylesheetImportGraphTest.h
+ * @brief Test fixture for StylesheetImportGraph.
+ */
+class StylesheetImportGraphTest: public ::testing::Test
+{
+    protected:
+        StylesheetImportGraphTest() = default;
+        ~StylesheetImportGraphTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+
+        /**
+         * @brief Writes a file below the temporary directory, creating sub directories.
+         * @param relative_path The path relative to the temporary directory.
+         * @param content The file content.
+         * @return The absolute, normalized path of the written file.
+         */
+        [[nodiscard]] auto write_file(const QString& relative_path,
+                                      const QString& content) -> QString;
+
+        QTemporaryDir* m_temp_dir = nullptr;
+};
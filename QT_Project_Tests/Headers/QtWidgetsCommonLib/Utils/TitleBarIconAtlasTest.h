@@ -0,0 +1,19 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "QtWidgetsCommonLib/Utils/TitleBarIconAtlas.h"
+
+/**
+ * @file TitleBarIconAtlasTest.h
+ * @brief Test fixture for TitleBarIconAtlas.
+ */
+class TitleBarIconAtlasTest: public ::testing::Test
+{
+    protected:
+        TitleBarIconAtlasTest() = default;
+        ~TitleBarIconAtlasTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+};
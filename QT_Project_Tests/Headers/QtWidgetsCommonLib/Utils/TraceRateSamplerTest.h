@@ -0,0 +1,21 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "QtWidgetsCommonLib/Utils/TraceRateSampler.h"
+
+/**
+ * @file TraceRateSamplerTest.h
+ * @brief Test fixture for TraceRateSampler.
+ */
+class TraceRateSamplerTest: public ::testing::Test
+{
+    protected:
+        TraceRateSamplerTest() = default;
+        ~TraceRateSamplerTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+
+        QtWidgetsCommonLib::TraceRateSampler m_sampler;
+};
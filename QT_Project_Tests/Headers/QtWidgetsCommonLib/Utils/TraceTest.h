@@ -0,0 +1,19 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "QtWidgetsCommonLib/Utils/Trace.h"
+
+/**
+ * @file TraceTest.h
+ * @brief Test fixture for Tracer and TraceScope.
+ */
+class TraceTest: public ::testing::Test
+{
+    protected:
+        TraceTest() = default;
+        ~TraceTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <QWidget>
+
+#include "QtWidgetsCommonLib/Widgets/PerformanceOverlay.h"
+
+/**
+ * @file PerformanceOverlayTest.h
+ * @brief Test fixture for PerformanceOverlay.
+ */
+class PerformanceOverlayTest: public ::testing::Test
+{
+    protected:
+        PerformanceOverlayTest() = default;
+        ~PerformanceOverlayTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+
+        QWidget* m_parent_widget = nullptr;
+};
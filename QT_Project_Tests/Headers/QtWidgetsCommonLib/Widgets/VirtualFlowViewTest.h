@@ -0,0 +1,22 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "QtWidgetsCommonLib/Widgets/VirtualFlowView.h"
+
+/**
+ * @file VirtualFlowViewTest.h
+ * @brief Test fixture for VirtualFlowView.
+ */
+class VirtualFlowViewTest: public ::testing::Test
+{
+    protected:
+        VirtualFlowViewTest() = default;
+        ~VirtualFlowViewTest() override = default;
+
+        void SetUp() override;
+        void TearDown() override;
+
+        QtWidgetsCommonLib::VirtualFlowView* m_view = nullptr;
+        int m_created_widgets = 0;
+};
@@ -1,5 +1,7 @@
 #include "QtWidgetsCommonLib/Layouts/FlowLayoutTest.h"
 
+#include <QApplication>
+#include <QElapsedTimer>
 #include <QLabel>
 
 using QtWidgetsCommonLib::FlowLayout;
@@ -318,3 +320,319 @@ TEST_F(FlowLayoutTest, HiddenWidgetsNotLaidOut)
     EXPECT_TRUE(label2->geometry().isValid());  // Geometry is set, but widget is hidden
     EXPECT_TRUE(label2->isHidden());
 }
+
+/**
+ * @brief Tests that heightForWidth grows when the width forces additional rows.
+ */
+TEST_F(FlowLayoutTest, HeightForWidthGrowsWithNarrowerWidth)
+{
+    for (int i = 0; i < 6; ++i)
+    {
+        auto* label = new QLabel(QString::number(i), m_parent_widget);
+        label->setFixedSize(40, 20);
+        m_layout->addWidget(label);
+    }
+
+    EXPECT_TRUE(m_layout->hasHeightForWidth());
+
+    // 6 * 40 + 5 * 8 = 280 fits into one row, 100 fits two items per row
+    EXPECT_EQ(m_layout->heightForWidth(300), 20);
+    EXPECT_EQ(m_layout->heightForWidth(100), 3 * 20 + 2 * 4);
+
+    // Repeated queries at the same width return the cached result
+    EXPECT_EQ(m_layout->heightForWidth(100), 3 * 20 + 2 * 4);
+}
+
+/**
+ * @brief Tests that cached layout results are discarded when items are added or removed.
+ */
+TEST_F(FlowLayoutTest, LayoutCacheInvalidatedOnItemChanges)
+{
+    auto* label1 = new QLabel("A", m_parent_widget);
+    auto* label2 = new QLabel("B", m_parent_widget);
+    label1->setFixedSize(40, 20);
+    label2->setFixedSize(40, 20);
+    m_layout->addWidget(label1);
+    m_layout->addWidget(label2);
+
+    EXPECT_EQ(m_layout->heightForWidth(60), 2 * 20 + 4);
+    EXPECT_EQ(m_layout->sizeHint(), QSize(40, 20));
+
+    auto* label3 = new QLabel("C", m_parent_widget);
+    label3->setFixedSize(50, 30);
+    m_layout->addWidget(label3);
+
+    EXPECT_EQ(m_layout->heightForWidth(60), 2 * 20 + 30 + 2 * 4);
+    EXPECT_EQ(m_layout->sizeHint(), QSize(50, 30));
+
+    delete m_layout->takeAt(2);
+    delete label3;
+    EXPECT_EQ(m_layout->heightForWidth(60), 2 * 20 + 4);
+
+    // Geometry uses the same cached rows, translated to the layout rectangle
+    m_layout->setGeometry(QRect(5, 7, 60, 100));
+    EXPECT_EQ(label1->geometry(), QRect(5, 7, 40, 20));
+    EXPECT_EQ(label2->geometry(), QRect(5, 7 + 20 + 4, 40, 20));
+}
+
+/**
+ * @brief Tests exact item positions of centered rows, including the wrapped last row.
+ */
+TEST_F(FlowLayoutTest, CenteredRowsExactGeometry)
+{
+    QList<QLabel*> labels;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        auto* label = new QLabel(QString::number(i), m_parent_widget);
+        label->setFixedSize(40, 20);
+        m_layout->addWidget(label);
+        labels.append(label);
+    }
+
+    m_layout->set_row_alignment(FlowLayout::RowAlignment::Center);
+    m_layout->setGeometry(QRect(0, 0, 200, 100));
+
+    // First row: 4 items, (200 - 4 * 48 + 8) / 2 = 8
+    EXPECT_EQ(labels.at(0)->geometry(), QRect(8, 0, 40, 20));
+    EXPECT_EQ(labels.at(3)->geometry(), QRect(8 + 3 * 48, 0, 40, 20));
+
+    // Second row: 1 item, (200 - 48 + 8) / 2 = 80
+    EXPECT_EQ(labels.at(4)->geometry(), QRect(80, 24, 40, 20));
+}
+
+/**
+ * @brief Tests that appending items one by one yields the same geometry as a full layout.
+ */
+TEST_F(FlowLayoutTest, IncrementalAppendMatchesFullLayout)
+{
+    QList<QLabel*> labels;
+    QList<QSize> sizes;
+    m_layout->set_row_alignment(FlowLayout::RowAlignment::CenterLeft);
+
+    for (int i = 0; i < 12; ++i)
+    {
+        auto* label = new QLabel(QString::number(i), m_parent_widget);
+        label->setFixedSize(30 + (i % 4) * 10, 20 + (i % 3) * 5);
+        m_layout->addWidget(label);
+        m_layout->setGeometry(QRect(0, 0, 150, 300));
+        labels.append(label);
+        sizes.append(label->size());
+    }
+
+    const FlowLayout::LayoutResult expected = FlowLayout::compute_geometry(
+        sizes, 150, QMargins(), 8, 4, FlowLayout::RowAlignment::CenterLeft);
+
+    for (int i = 0; i < labels.size(); ++i)
+    {
+        EXPECT_EQ(labels.at(i)->geometry(), expected.item_rects.at(i));
+    }
+
+    EXPECT_EQ(m_layout->heightForWidth(150), expected.height);
+}
+
+/**
+ * @brief Tests that removing the first item of a row lets the next item move up a row.
+ */
+TEST_F(FlowLayoutTest, TakeAtRowStartReflowsPreviousRow)
+{
+    QList<QLabel*> labels;
+
+    for (const int width: {40, 30, 50, 20})
+    {
+        auto* label = new QLabel(m_parent_widget);
+        label->setFixedSize(width, 20);
+        m_layout->addWidget(label);
+        labels.append(label);
+    }
+
+    // 40 + 8 + 30 + 8 + 50 exceeds 120: the 50 starts the second row
+    m_layout->setGeometry(QRect(0, 0, 120, 100));
+    EXPECT_EQ(m_layout->heightForWidth(120), 2 * 20 + 4);
+    EXPECT_EQ(labels.at(3)->geometry(), QRect(58, 24, 20, 20));
+
+    delete m_layout->takeAt(2);
+    delete labels.at(2);
+    m_layout->setGeometry(QRect(0, 0, 120, 100));
+
+    EXPECT_EQ(m_layout->heightForWidth(120), 20);
+    EXPECT_EQ(labels.at(3)->geometry(), QRect(86, 0, 20, 20));
+}
+
+/**
+ * @brief Tests adding a batch of widgets with add_widgets().
+ */
+TEST_F(FlowLayoutTest, AddWidgetsBatch)
+{
+    QList<QWidget*> widgets;
+    QList<QSize> sizes;
+
+    for (int i = 0; i < 30; ++i)
+    {
+        auto* label = new QLabel(QString::number(i), m_parent_widget);
+        label->setFixedSize(40, 20);
+        widgets.append(label);
+        sizes.append(label->size());
+    }
+
+    m_layout->add_widgets(widgets);
+    EXPECT_EQ(m_layout->count(), 30);
+    EXPECT_EQ(m_layout->itemAt(29)->widget(), widgets.at(29));
+
+    m_layout->setGeometry(QRect(0, 0, 200, 400));
+    const FlowLayout::LayoutResult expected =
+        FlowLayout::compute_geometry(sizes, 200, QMargins(), 8, 4, FlowLayout::RowAlignment::Left);
+
+    for (int i = 0; i < widgets.size(); ++i)
+    {
+        EXPECT_EQ(widgets.at(i)->geometry(), expected.item_rects.at(i));
+    }
+}
+
+/**
+ * @brief Tests that an animated reflow moves items gradually and ends at the final geometry.
+ */
+TEST_F(FlowLayoutTest, AnimatedReflowReachesFinalGeometry)
+{
+    QList<QLabel*> labels;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        auto* label = new QLabel(QString::number(i), m_parent_widget);
+        label->setFixedSize(40, 20);
+        m_layout->addWidget(label);
+        labels.append(label);
+    }
+
+    EXPECT_FALSE(m_layout->get_animation_enabled());
+
+    m_parent_widget->resize(300, 100);
+    m_parent_widget->show();
+    QApplication::processEvents();
+    m_layout->setGeometry(QRect(0, 0, 300, 100));
+    EXPECT_EQ(labels.at(3)->geometry(), QRect(3 * 48, 0, 40, 20));
+
+    m_layout->set_animation_duration(80);
+    m_layout->set_animation_enabled(true);
+    m_layout->setGeometry(QRect(0, 0, 100, 100));
+
+    // Nothing moves before the first frame of the shared clock
+    EXPECT_TRUE(m_layout->is_animating());
+    EXPECT_EQ(labels.at(3)->geometry(), QRect(3 * 48, 0, 40, 20));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (m_layout->is_animating() && timer.elapsed() < 2000)
+    {
+        QApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+
+    EXPECT_FALSE(m_layout->is_animating());
+    EXPECT_EQ(labels.at(2)->geometry(), QRect(0, 24, 40, 20));
+    EXPECT_EQ(labels.at(3)->geometry(), QRect(48, 24, 40, 20));
+}
+
+/**
+ * @brief Tests that indexOf() follows insertions and removals.
+ */
+TEST_F(FlowLayoutTest, IndexOfTracksRemovals)
+{
+    QList<QWidget*> labels;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        labels.append(new QLabel(QString::number(i), m_parent_widget));
+    }
+
+    m_layout->add_widgets(labels);
+    EXPECT_EQ(m_layout->indexOf(labels.at(4)), 4);
+
+    delete m_layout->takeAt(1);
+    EXPECT_EQ(m_layout->indexOf(labels.at(1)), -1);
+    EXPECT_EQ(m_layout->indexOf(labels.at(2)), 1);
+    EXPECT_EQ(m_layout->indexOf(labels.at(4)), 3);
+
+    m_layout->removeWidget(labels.at(0));
+    EXPECT_EQ(m_layout->indexOf(labels.at(2)), 0);
+    EXPECT_EQ(m_layout->indexOf(m_layout->itemAt(2)), 2);
+}
+
+/**
+ * @brief Tests removing a batch of widgets with remove_widgets().
+ */
+TEST_F(FlowLayoutTest, RemoveWidgetsBatch)
+{
+    QList<QWidget*> labels;
+    QList<QSize> sizes;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        auto* label = new QLabel(QString::number(i), m_parent_widget);
+        label->setFixedSize(40, 20);
+        labels.append(label);
+    }
+
+    m_layout->add_widgets(labels);
+    m_layout->setGeometry(QRect(0, 0, 200, 400));
+
+    auto* other = new QLabel(QStringLiteral("Other"), m_parent_widget);
+    EXPECT_EQ(m_layout->remove_widgets({labels.at(1), labels.at(4), labels.at(4), other}), 2);
+    EXPECT_EQ(m_layout->count(), 8);
+    EXPECT_EQ(m_layout->indexOf(labels.at(4)), -1);
+    EXPECT_EQ(m_layout->indexOf(labels.at(9)), 7);
+    EXPECT_EQ(labels.at(4)->parentWidget(), m_parent_widget);  // Widgets are not deleted
+
+    m_layout->setGeometry(QRect(0, 0, 200, 400));
+
+    for (int i = 0; i < 8; ++i)
+    {
+        sizes.append(QSize(40, 20));
+    }
+
+    const FlowLayout::LayoutResult expected =
+        FlowLayout::compute_geometry(sizes, 200, QMargins(), 8, 4, FlowLayout::RowAlignment::Left);
+
+    for (int i = 0; i < m_layout->count(); ++i)
+    {
+        EXPECT_EQ(m_layout->itemAt(i)->geometry(), expected.item_rects.at(i));
+    }
+}
+
+/**
+ * @brief Tests that items hidden with set_visible_subset() are skipped and shown again in place.
+ */
+TEST_F(FlowLayoutTest, VisibleSubsetSkipsHiddenItems)
+{
+    QList<QWidget*> labels;
+
+    for (int i = 0; i < 6; ++i)
+    {
+        auto* label = new QLabel(QString::number(i), m_parent_widget);
+        label->setFixedSize(40, 20);
+        labels.append(label);
+    }
+
+    m_layout->add_widgets(labels);
+    m_parent_widget->show();
+    m_layout->setGeometry(QRect(0, 0, 200, 400));
+    EXPECT_EQ(labels.at(4)->geometry(), QRect(0, 24, 40, 20));
+
+    m_layout->set_visible_subset({labels.at(0), labels.at(4), labels.at(5)});
+    m_layout->setGeometry(QRect(0, 0, 200, 400));
+
+    EXPECT_EQ(m_layout->count(), 6);
+    EXPECT_TRUE(m_layout->is_widget_hidden(labels.at(1)));
+    EXPECT_TRUE(labels.at(1)->isHidden());
+    EXPECT_FALSE(m_layout->is_widget_hidden(labels.at(4)));
+    EXPECT_EQ(labels.at(4)->geometry(), QRect(48, 0, 40, 20));
+    EXPECT_EQ(labels.at(5)->geometry(), QRect(96, 0, 40, 20));
+
+    m_layout->set_widget_hidden(labels.at(1), false);
+    m_layout->setGeometry(QRect(0, 0, 200, 400));
+
+    EXPECT_FALSE(labels.at(1)->isHidden());
+    EXPECT_EQ(labels.at(1)->geometry(), QRect(48, 0, 40, 20));
+    EXPECT_EQ(labels.at(4)->geometry(), QRect(96, 0, 40, 20));
+    EXPECT_EQ(m_layout->indexOf(labels.at(4)), 4);
+}
@@ -0,0 +1,104 @@
+#include "QtWidgetsCommonLib/Services/Preferences/BatchedMainWindowStatePersistenceTest.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+using QtWidgetsCommonLib::BatchedMainWindowStatePersistence;
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void BatchedMainWindowStatePersistenceTest::SetUp()
+{
+    m_target.m_geometry = QByteArrayLiteral("geometry-0");
+    m_persistence = new BatchedMainWindowStatePersistence(&m_target);
+    m_persistence->set_flush_delay(-1);
+}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void BatchedMainWindowStatePersistenceTest::TearDown()
+{
+    delete m_persistence;
+    m_persistence = nullptr;
+}
+
+/**
+ * @brief Tests that changes are written together on flush and unchanged values are skipped.
+ */
+TEST_F(BatchedMainWindowStatePersistenceTest, FlushWritesChangedValuesInOneTransaction)
+{
+    EXPECT_EQ(m_persistence->get_mainwindow_geometry(), QByteArrayLiteral("geometry-0"));
+
+    m_persistence->set_mainwindow_geometry(QByteArrayLiteral("geometry-1"));
+    m_persistence->set_mainwindow_state(QByteArrayLiteral("state-1"));
+    m_persistence->set_mainwindow_windowstate(2);
+
+    EXPECT_EQ(m_target.m_writes, 0);
+    EXPECT_TRUE(m_persistence->has_pending_writes());
+    EXPECT_EQ(m_persistence->get_mainwindow_state(), QByteArrayLiteral("state-1"));
+
+    EXPECT_TRUE(m_persistence->flush());
+    EXPECT_EQ(m_target.m_writes, 3);
+    EXPECT_EQ(m_target.m_transactions, 1);
+    EXPECT_EQ(m_target.m_commits, 1);
+    EXPECT_EQ(m_target.m_geometry, QByteArrayLiteral("geometry-1"));
+
+    // The same snapshot again is not written
+    m_persistence->set_mainwindow_geometry(QByteArrayLiteral("geometry-1"));
+    m_persistence->set_mainwindow_state(QByteArrayLiteral("state-1"));
+    m_persistence->set_mainwindow_windowstate(2);
+    EXPECT_FALSE(m_persistence->has_pending_writes());
+    EXPECT_FALSE(m_persistence->flush());
+
+    // Only the changed value is written
+    m_persistence->set_mainwindow_windowstate(0);
+    EXPECT_TRUE(m_persistence->flush());
+    EXPECT_EQ(m_target.m_writes, 4);
+    EXPECT_EQ(m_persistence->get_write_batch_count(), 2);
+}
+
+/**
+ * @brief Tests the automatic delayed flush and periodic snapshots.
+ */
+TEST_F(BatchedMainWindowStatePersistenceTest, DelayedFlushAndSnapshots)
+{
+    m_persistence->set_flush_delay(0);
+    m_persistence->set_mainwindow_geometry(QByteArrayLiteral("geometry-1"));
+    m_persistence->set_mainwindow_geometry(QByteArrayLiteral("geometry-2"));
+    EXPECT_EQ(m_target.m_writes, 0);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (m_target.m_writes == 0 && timer.elapsed() < 5000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+
+    EXPECT_EQ(m_target.m_writes, 1);
+    EXPECT_EQ(m_target.m_geometry, QByteArrayLiteral("geometry-2"));
+
+    int snapshots = 0;
+    QObject::connect(m_persistence, &BatchedMainWindowStatePersistence::snapshotRequested,
+                     m_persistence, [this, &snapshots]() {
+                         ++snapshots;
+                         m_persistence->set_mainwindow_windowstate(snapshots);
+                     });
+    m_persistence->set_flush_delay(-1);
+    m_persistence->set_snapshot_interval(5);
+    EXPECT_EQ(m_persistence->get_snapshot_interval(), 5);
+
+    timer.restart();
+
+    while (snapshots < 2 && timer.elapsed() < 5000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+
+    m_persistence->set_snapshot_interval(0);
+    ASSERT_GE(snapshots, 2);
+    EXPECT_EQ(m_target.m_window_state, snapshots);
+    EXPECT_FALSE(m_persistence->has_pending_writes());
+}
@@ -6,12 +6,20 @@
 #include "QtWidgetsCommonLib/Services/TranslatorTest.h"
 
 #include <QApplication>
+#include <QByteArray>
+#include <QDataStream>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QEvent>
 #include <QFile>
+#include <QList>
 #include <QLocale>
 #include <QMap>
 #include <QSignalSpy>
 #include <QStringList>
+#include <QTemporaryDir>
+#include <QWidget>
+#include <utility>
 
 #include "QtWidgetsCommonLib/Services/Translator.h"
 
@@ -462,3 +470,461 @@ TEST_F(TranslatorTest, LoadLogsWhenAppTranslatorMissingButQtTranslatorPresent)
     // Cleanup
     QFile::remove(qt_en);
 }
+
+/**
+ * @test Switching back to a cached locale does not read the .qm files again, and the cache
+ * capacity releases least recently used locales but never the installed one.
+ *
+ * Provides app_en.qm, app_de.qm and qt_de.qm (copied from qt_en.qm), loads "en" and "de", then
+ * removes the files and switches back to "en".
+ */
+TEST_F(TranslatorTest, SwitchBackToCachedLocaleSkipsDisk)
+{
+    const QString base_dir = QCoreApplication::applicationDirPath();
+    const QString translations_dir = base_dir + QStringLiteral("/translations");
+    QDir dir(translations_dir);
+    ASSERT_TRUE(dir.exists());
+
+    const QString qt_en_src = translations_dir + QStringLiteral("/qt_en.qm");
+    ASSERT_TRUE(QFile::exists(qt_en_src));
+
+    const QString app_en_dst = translations_dir + QStringLiteral("/app_en.qm");
+    const QString app_de_dst = translations_dir + QStringLiteral("/app_de.qm");
+    const QString qt_de_dst = translations_dir + QStringLiteral("/qt_de.qm");
+
+    if (QFile::exists(app_en_dst)) EXPECT_TRUE(QFile::remove(app_en_dst));
+    if (QFile::exists(app_de_dst)) EXPECT_TRUE(QFile::remove(app_de_dst));
+    if (QFile::exists(qt_de_dst)) EXPECT_TRUE(QFile::remove(qt_de_dst));
+
+    EXPECT_TRUE(QFile::copy(qt_en_src, app_en_dst));
+    EXPECT_TRUE(QFile::copy(qt_en_src, app_de_dst));
+    EXPECT_TRUE(QFile::copy(qt_en_src, qt_de_dst));
+
+    delete m_translator;
+    m_translator = new Translator();
+    EXPECT_EQ(m_translator->get_cache_capacity(), 4);
+
+    QSignalSpy spy(m_translator, &Translator::languageChanged);
+    ASSERT_TRUE(spy.isValid());
+
+    EXPECT_TRUE(m_translator->load_translation(QStringLiteral("en")));
+    EXPECT_TRUE(m_translator->load_translation(QStringLiteral("de")));
+    EXPECT_TRUE(m_translator->is_translation_cached(QLocale(QStringLiteral("en"))));
+
+    // Without the app files only the cache can serve the switch
+    QFile::remove(app_en_dst);
+    QFile::remove(app_de_dst);
+    QFile::remove(qt_de_dst);
+
+    EXPECT_TRUE(m_translator->load_translation(QStringLiteral("en")));
+    EXPECT_EQ(spy.count(), 3);
+    EXPECT_TRUE(m_translator->get_current_language_code().contains(QStringLiteral("en")));
+
+    // Capacity 1 keeps only the installed locale
+    m_translator->set_cache_capacity(0);
+    EXPECT_EQ(m_translator->get_cache_capacity(), 1);
+    EXPECT_TRUE(m_translator->is_translation_cached(QLocale(QStringLiteral("en"))));
+    EXPECT_FALSE(m_translator->is_translation_cached(QLocale(QStringLiteral("de"))));
+}
+
+/**
+ * @test Preloading caches a locale without installing it or emitting languageChanged.
+ */
+TEST_F(TranslatorTest, PreloadCachesWithoutInstalling)
+{
+    const QString base_dir = QCoreApplication::applicationDirPath();
+    const QString translations_dir = base_dir + QStringLiteral("/translations");
+    QDir dir(translations_dir);
+    ASSERT_TRUE(dir.exists());
+
+    const QString qt_en_src = translations_dir + QStringLiteral("/qt_en.qm");
+    ASSERT_TRUE(QFile::exists(qt_en_src));
+
+    const QString app_en_dst = translations_dir + QStringLiteral("/app_en.qm");
+    if (QFile::exists(app_en_dst)) EXPECT_TRUE(QFile::remove(app_en_dst));
+    EXPECT_TRUE(QFile::copy(qt_en_src, app_en_dst));
+
+    delete m_translator;
+    m_translator = new Translator();
+
+    QSignalSpy spy(m_translator, &Translator::languageChanged);
+    ASSERT_TRUE(spy.isValid());
+
+    const QString before = m_translator->get_current_language_code();
+    EXPECT_TRUE(m_translator->preload_translation(QLocale(QStringLiteral("en"))));
+    EXPECT_TRUE(m_translator->is_translation_cached(QLocale(QStringLiteral("en"))));
+    EXPECT_EQ(spy.count(), 0);
+    EXPECT_EQ(m_translator->get_current_language_code(), before);
+
+    // Missing files are reported and not cached
+    EXPECT_FALSE(m_translator->preload_translation(QLocale(QStringLiteral("fr"))));
+    EXPECT_FALSE(m_translator->is_translation_cached(QLocale(QStringLiteral("fr"))));
+
+    QFile::remove(app_en_dst);
+}
+
+/**
+ * @test The language catalog answers code/name lookups in both directions, including native names,
+ * and picks up new files on refresh_language_catalog().
+ */
+TEST_F(TranslatorTest, LanguageCatalogLooksUpCodesAndNames)
+{
+    const QString base_dir = QCoreApplication::applicationDirPath();
+    const QString translations_dir = base_dir + QStringLiteral("/translations");
+    QDir dir(translations_dir);
+    if (!dir.exists())
+    {
+        EXPECT_TRUE(QDir().mkpath(translations_dir));
+    }
+
+    const QString de_file = translations_dir + QStringLiteral("/app_de.qm");
+    const QString fr_file = translations_dir + QStringLiteral("/app_fr.qm");
+    QFile::remove(de_file);
+    QFile::remove(fr_file);
+
+    QFile f_de(de_file);
+    EXPECT_TRUE(f_de.open(QIODevice::WriteOnly));
+    f_de.write("dummy");
+    f_de.close();
+
+    delete m_translator;
+    m_translator = new Translator();
+
+    const QString german = QLocale::languageToString(QLocale(QStringLiteral("de")).language());
+    const QString deutsch = QLocale(QStringLiteral("de")).nativeLanguageName();
+
+    EXPECT_EQ(m_translator->get_language_name(QStringLiteral("de")), german);
+    EXPECT_EQ(m_translator->get_native_language_name(QStringLiteral("de")), deutsch);
+    EXPECT_EQ(m_translator->get_language_code(german.toUpper()), QStringLiteral("de"));
+    EXPECT_EQ(m_translator->get_language_code(deutsch), QStringLiteral("de"));
+    EXPECT_TRUE(m_translator->get_available_native_language_names().contains(deutsch));
+    EXPECT_TRUE(m_translator->get_language_code(QStringLiteral("Klingon")).isEmpty());
+
+    // A file added later is listed after an explicit refresh
+    QSignalSpy spy(m_translator, &Translator::availableLanguagesChanged);
+    ASSERT_TRUE(spy.isValid());
+
+    QFile f_fr(fr_file);
+    EXPECT_TRUE(f_fr.open(QIODevice::WriteOnly));
+    f_fr.write("dummy");
+    f_fr.close();
+
+    m_translator->refresh_language_catalog();
+    EXPECT_TRUE(m_translator->get_available_language_codes().contains(QStringLiteral("fr")));
+    EXPECT_GE(spy.count(), 1);
+
+    QFile::remove(de_file);
+    QFile::remove(fr_file);
+}
+
+namespace
+{
+
+/**
+ * @brief Widget that records its LanguageChange events in a shared list.
+ */
+class RetranslationRecorder: public QWidget
+{
+    public:
+        RetranslationRecorder(const QString& name, QStringList* log): m_name(name), m_log(log) {}
+
+    protected:
+        void changeEvent(QEvent* event) override
+        {
+            if (event->type() == QEvent::LanguageChange)
+            {
+                m_log->append(m_name);
+            }
+
+            QWidget::changeEvent(event);
+        }
+
+    private:
+        QString m_name;
+        QStringList* m_log = nullptr;
+};
+
+}  // namespace
+
+/**
+ * @test Asynchronous loading installs the translators on the GUI thread and reports the result;
+ * staged retranslation reaches the visible window before the hidden one, each exactly once.
+ */
+TEST_F(TranslatorTest, AsyncLoadWithStagedRetranslation)
+{
+    const QString base_dir = QCoreApplication::applicationDirPath();
+    const QString translations_dir = base_dir + QStringLiteral("/translations");
+    QDir dir(translations_dir);
+    ASSERT_TRUE(dir.exists());
+
+    const QString qt_en_src = translations_dir + QStringLiteral("/qt_en.qm");
+    ASSERT_TRUE(QFile::exists(qt_en_src));
+
+    const QString app_en_dst = translations_dir + QStringLiteral("/app_en.qm");
+    if (QFile::exists(app_en_dst)) EXPECT_TRUE(QFile::remove(app_en_dst));
+    EXPECT_TRUE(QFile::copy(qt_en_src, app_en_dst));
+
+    delete m_translator;
+    m_translator = new Translator();
+    m_translator->set_staged_retranslation(true);
+
+    QStringList log;
+    RetranslationRecorder hidden(QStringLiteral("hidden"), &log);
+    RetranslationRecorder visible(QStringLiteral("visible"), &log);
+    visible.show();
+    QApplication::processEvents();
+    log.clear();
+
+    QSignalSpy finished_spy(m_translator, &Translator::translationLoadFinished);
+    QSignalSpy changed_spy(m_translator, &Translator::languageChanged);
+    ASSERT_TRUE(finished_spy.isValid());
+    ASSERT_TRUE(changed_spy.isValid());
+
+    m_translator->load_translation_async(QStringLiteral("en"));
+    EXPECT_TRUE(m_translator->is_loading_translation());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while ((finished_spy.count() == 0 || m_translator->get_pending_retranslation_count() > 0 ||
+            log.size() < 2) &&
+           timer.elapsed() < 5000)
+    {
+        QApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+
+    ASSERT_EQ(finished_spy.count(), 1);
+    EXPECT_TRUE(finished_spy.at(0).at(0).toBool());
+    EXPECT_EQ(changed_spy.count(), 1);
+    EXPECT_FALSE(m_translator->is_loading_translation());
+    EXPECT_TRUE(m_translator->is_translation_cached(QLocale(QStringLiteral("en"))));
+    EXPECT_EQ(log, QStringList({QStringLiteral("visible"), QStringLiteral("hidden")}));
+
+    QFile::remove(app_en_dst);
+}
+
+/**
+ * @test set_translations_path() switches the catalog and loading to another directory; an archive
+ * that cannot be registered leaves the path unchanged.
+ */
+TEST_F(TranslatorTest, TranslationsPathCanBeChanged)
+{
+    const QString base_dir = QCoreApplication::applicationDirPath();
+    const QString qt_en_src = base_dir + QStringLiteral("/translations/qt_en.qm");
+    ASSERT_TRUE(QFile::exists(qt_en_src));
+
+    QTemporaryDir temp_dir;
+    ASSERT_TRUE(temp_dir.isValid());
+    EXPECT_TRUE(QFile::copy(qt_en_src, temp_dir.filePath(QStringLiteral("qt_en.qm"))));
+    EXPECT_TRUE(QFile::copy(qt_en_src, temp_dir.filePath(QStringLiteral("app_en.qm"))));
+
+    m_translator->set_translations_path(temp_dir.path());
+    EXPECT_EQ(m_translator->get_translations_path(), temp_dir.path());
+    EXPECT_EQ(m_translator->get_available_language_codes(), QStringList({QStringLiteral("en")}));
+    EXPECT_TRUE(m_translator->load_translation(QStringLiteral("en")));
+
+    EXPECT_FALSE(m_translator->register_translations_archive(
+        temp_dir.filePath(QStringLiteral("missing.rcc"))));
+    EXPECT_EQ(m_translator->get_translations_path(), temp_dir.path());
+}
+
+/**
+ * @test Several Translator instances (one per window) share the translators of a locale; they are
+ * released with the last instance caching them.
+ */
+TEST_F(TranslatorTest, InstancesShareLoadedTranslations)
+{
+    const QString base_dir = QCoreApplication::applicationDirPath();
+    const QString qt_en_src = base_dir + QStringLiteral("/translations/qt_en.qm");
+    ASSERT_TRUE(QFile::exists(qt_en_src));
+
+    QTemporaryDir temp_dir;
+    ASSERT_TRUE(temp_dir.isValid());
+    EXPECT_TRUE(QFile::copy(qt_en_src, temp_dir.filePath(QStringLiteral("qt_en.qm"))));
+    EXPECT_TRUE(QFile::copy(qt_en_src, temp_dir.filePath(QStringLiteral("app_en.qm"))));
+
+    const qsizetype shared_before = Translator::get_shared_translation_count();
+
+    {
+        Translator first;
+        Translator second;
+        first.set_translations_path(temp_dir.path());
+        second.set_translations_path(temp_dir.path());
+
+        ASSERT_TRUE(first.load_translation(QStringLiteral("en")));
+        EXPECT_EQ(Translator::get_shared_translation_count(), shared_before + 1);
+
+        // The second instance reuses the loaded pair even if the files are gone meanwhile
+        EXPECT_TRUE(QFile::remove(temp_dir.filePath(QStringLiteral("app_en.qm"))));
+        EXPECT_TRUE(second.load_translation(QStringLiteral("en")));
+        EXPECT_EQ(Translator::get_shared_translation_count(), shared_before + 1);
+    }
+
+    EXPECT_EQ(Translator::get_shared_translation_count(), shared_before);
+}
+
+namespace
+{
+
+/**
+ * @brief Writes a .qm file from its blocks.
+ * @param path The file to write.
+ * @param blocks The block tags and contents, in file order.
+ * @return True if the file was written.
+ */
+auto write_qm_file(const QString& path, const QList<std::pair<quint8, QByteArray>>& blocks) -> bool
+{
+    static const char kMagic[] = {'\x3c', '\xb8', '\x64', '\x18', '\xca', '\xef',
+                                  '\x9c', '\x95', '\xcd', '\x21', '\x1c', '\xbf',
+                                  '\x60', '\xa1', '\xbd', '\xdd'};
+
+    QByteArray data(kMagic, sizeof(kMagic));
+    QDataStream stream(&data, QIODevice::WriteOnly | QIODevice::Append);
+
+    for (const auto& [tag, block]: blocks)
+    {
+        stream << tag << static_cast<quint32>(block.size());
+        stream.writeRawData(block.constData(), static_cast<int>(block.size()));
+    }
+
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+/**
+ * @brief Writes a .qm meta catalog that only refers to other .qm files, like Qt's qt_*.qm.
+ * @param path The file to write.
+ * @param dependency The base name of the catalog it depends on (e.g. "qtbase_de").
+ * @return True if the file was written.
+ */
+auto write_meta_catalog(const QString& path, const QString& dependency) -> bool
+{
+    constexpr quint8 kDependenciesTag = 0x96;
+
+    QByteArray dependencies;
+    QDataStream stream(&dependencies, QIODevice::WriteOnly);
+    stream << dependency;
+
+    return write_qm_file(path, {{kDependenciesTag, dependencies}});
+}
+
+/**
+ * @brief Writes a .qm file translating one source text in any context.
+ * @param path The file to write.
+ * @param source_text The Latin-1 source text.
+ * @param translation Its translation.
+ * @return True if the file was written.
+ */
+auto write_message_catalog(const QString& path, const QByteArray& source_text,
+                           const QString& translation) -> bool
+{
+    constexpr quint8 kHashesTag = 0x42;
+    constexpr quint8 kMessagesTag = 0x69;
+    constexpr quint8 kEndTag = 1;
+    constexpr quint8 kTranslationTag = 3;
+    constexpr quint8 kSourceTextTag = 6;
+
+    QByteArray messages;
+    QDataStream message_stream(&messages, QIODevice::WriteOnly);
+    message_stream << kSourceTextTag << static_cast<quint32>(source_text.size());
+    message_stream.writeRawData(source_text.constData(), static_cast<int>(source_text.size()));
+    message_stream << kTranslationTag << static_cast<quint32>(translation.size() * 2);
+
+    for (const QChar character: translation)
+    {
+        message_stream << static_cast<quint16>(character.unicode());
+    }
+
+    message_stream << kEndTag;
+
+    // The lookup hash is the ELF hash of the source text and the (empty) comment
+    quint32 hash = 0;
+
+    for (const char character: source_text)
+    {
+        hash = (hash << 4) + static_cast<uchar>(character);
+        const quint32 high = hash & 0xf0000000;
+        hash ^= high >> 24;
+        hash &= ~high;
+    }
+
+    QByteArray hashes;
+    QDataStream hash_stream(&hashes, QIODevice::WriteOnly);
+    hash_stream << (hash != 0 ? hash : 1) << static_cast<quint32>(0);
+
+    return write_qm_file(path, {{kHashesTag, hashes}, {kMessagesTag, messages}});
+}
+
+}  // namespace
+
+/**
+ * @test Asynchronous loading resolves the dependencies of a meta catalog (qt_de.qm referring to
+ * qtbase_de.qm) in the translations directory, like loading from the file does.
+ */
+TEST_F(TranslatorTest, AsyncLoadResolvesCatalogDependencies)
+{
+    const QString base_dir = QCoreApplication::applicationDirPath();
+    const QString qt_en_src = base_dir + QStringLiteral("/translations/qt_en.qm");
+    ASSERT_TRUE(QFile::exists(qt_en_src));
+
+    QTemporaryDir temp_dir;
+    ASSERT_TRUE(temp_dir.isValid());
+    ASSERT_TRUE(write_meta_catalog(temp_dir.filePath(QStringLiteral("qt_de.qm")),
+                                   QStringLiteral("qtbase_de")));
+    EXPECT_TRUE(QFile::copy(qt_en_src, temp_dir.filePath(QStringLiteral("qtbase_de.qm"))));
+    EXPECT_TRUE(QFile::copy(qt_en_src, temp_dir.filePath(QStringLiteral("app_de.qm"))));
+
+    m_translator->set_translations_path(temp_dir.path());
+    QSignalSpy finished_spy(m_translator, &Translator::translationLoadFinished);
+    ASSERT_TRUE(finished_spy.isValid());
+
+    m_translator->load_translation_async(QStringLiteral("de"));
+    EXPECT_TRUE(finished_spy.wait(5000));
+
+    ASSERT_EQ(finished_spy.count(), 1);
+    EXPECT_TRUE(finished_spy.at(0).at(0).toBool());
+    EXPECT_TRUE(m_translator->is_translation_cached(QLocale(QStringLiteral("de"))));
+    EXPECT_EQ(m_translator->get_current_language_code(), QLocale(QStringLiteral("de")).name());
+}
+
+/**
+ * @test Instances sharing a locale install translators of their own: switching one instance to
+ * another locale leaves the translators of the other instance installed.
+ */
+TEST_F(TranslatorTest, InstancesSwitchLocalesIndependently)
+{
+    const QString base_dir = QCoreApplication::applicationDirPath();
+    const QString qt_en_src = base_dir + QStringLiteral("/translations/qt_en.qm");
+    ASSERT_TRUE(QFile::exists(qt_en_src));
+
+    QTemporaryDir temp_dir;
+    ASSERT_TRUE(temp_dir.isValid());
+    EXPECT_TRUE(QFile::copy(qt_en_src, temp_dir.filePath(QStringLiteral("qt_en.qm"))));
+    EXPECT_TRUE(QFile::copy(qt_en_src, temp_dir.filePath(QStringLiteral("qt_de.qm"))));
+    ASSERT_TRUE(write_message_catalog(temp_dir.filePath(QStringLiteral("app_en.qm")),
+                                      QByteArrayLiteral("greeting"), QStringLiteral("Hello")));
+    ASSERT_TRUE(write_message_catalog(temp_dir.filePath(QStringLiteral("app_de.qm")),
+                                      QByteArrayLiteral("greeting"), QStringLiteral("Hallo")));
+
+    const auto translate = []() {
+        return QCoreApplication::translate("TranslatorTest", "greeting");
+    };
+
+    Translator second;
+    second.set_translations_path(temp_dir.path());
+
+    {
+        Translator first;
+        first.set_translations_path(temp_dir.path());
+
+        ASSERT_TRUE(first.load_translation(QStringLiteral("en")));
+        ASSERT_TRUE(second.load_translation(QStringLiteral("en")));
+        EXPECT_EQ(translate(), QStringLiteral("Hello"));
+
+        ASSERT_TRUE(first.load_translation(QStringLiteral("de")));
+        EXPECT_EQ(translate(), QStringLiteral("Hallo"));
+    }
+
+    // Destroying the first instance uninstalls its German translators only
+    EXPECT_EQ(translate(), QStringLiteral("Hello"));
+}
@@ -0,0 +1,104 @@
+#include "QtWidgetsCommonLib/Utils/AbbreviatedNumberFormatterTest.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QList>
+#include <QSignalSpy>
+#include <QStringView>
+#include <QTemporaryDir>
+#include <array>
+
+#include "QtWidgetsCommonLib/Services/Translator.h"
+#include "QtWidgetsCommonLib/Utils/NumberFormatUtils.h"
+
+using QtWidgetsCommonLib::AbbreviatedNumberFormatter;
+using QtWidgetsCommonLib::AbbreviatedNumberOptions;
+using QtWidgetsCommonLib::NumberFormatUtils;
+using QtWidgetsCommonLib::Translator;
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void AbbreviatedNumberFormatterTest::SetUp() {}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void AbbreviatedNumberFormatterTest::TearDown() {}
+
+/**
+ * @brief Tests that the C locale with metric options matches NumberFormatUtils.
+ */
+TEST_F(AbbreviatedNumberFormatterTest, MatchesNumberFormatUtilsInCLocale)
+{
+    const AbbreviatedNumberFormatter formatter(QLocale::c());
+    const QList<double> values = {0.0,    5.04,   -0.5,       999.9,    999.96,
+                                  1000.0, 9999.0, -1500000.0, 123456.0, 1.0e12};
+
+    for (const double value: values)
+    {
+        EXPECT_EQ(formatter.format(value), NumberFormatUtils::format_number_abbreviated(value));
+    }
+}
+
+/**
+ * @brief Tests locale separators, byte units, precision and the buffer overload.
+ */
+TEST_F(AbbreviatedNumberFormatterTest, LocaleBytesAndPrecision)
+{
+    const AbbreviatedNumberFormatter german(QLocale(QLocale::German, QLocale::Germany));
+    EXPECT_EQ(german.format(1500.0), QStringLiteral("1,5K"));
+    EXPECT_EQ(german.format(-2500000.0), QStringLiteral("-2,5M"));
+    EXPECT_EQ(german.format(12.34), QStringLiteral("12,3"));
+
+    const AbbreviatedNumberFormatter bytes(QLocale::c(),
+                                           AbbreviatedNumberFormatter::byte_options());
+    EXPECT_EQ(bytes.format(512.0), QStringLiteral("512 B"));
+    EXPECT_EQ(bytes.format(1536.0), QStringLiteral("1.5 KiB"));
+    EXPECT_EQ(bytes.format(3.0 * 1024.0 * 1024.0 * 1024.0), QStringLiteral("3.0 GiB"));
+
+    AbbreviatedNumberOptions options;
+    options.decimals = 2;
+    const AbbreviatedNumberFormatter precise(QLocale::c(), options);
+    EXPECT_EQ(precise.format(1234.0), QStringLiteral("1.23K"));
+    EXPECT_EQ(precise.format(2.5), QStringLiteral("2.5"));
+
+    std::array<char16_t, 8> buffer{};
+    const qsizetype length = german.format(1500.0, buffer);
+    ASSERT_EQ(length, 4);
+    EXPECT_EQ(QStringView(buffer.data(), length), QStringLiteral("1,5K"));
+
+    std::array<char16_t, 2> small{};
+    EXPECT_EQ(german.format(1500.0, small), -1);
+}
+
+/**
+ * @brief Tests that a formatter bound to a translator follows its language.
+ */
+TEST_F(AbbreviatedNumberFormatterTest, FollowsTranslatorLanguage)
+{
+    const QString qt_en_src =
+        QCoreApplication::applicationDirPath() + QStringLiteral("/translations/qt_en.qm");
+    ASSERT_TRUE(QFile::exists(qt_en_src));
+
+    QTemporaryDir temp_dir;
+    ASSERT_TRUE(temp_dir.isValid());
+    EXPECT_TRUE(QFile::copy(qt_en_src, temp_dir.filePath(QStringLiteral("qt_de.qm"))));
+    EXPECT_TRUE(QFile::copy(qt_en_src, temp_dir.filePath(QStringLiteral("app_de.qm"))));
+
+    Translator translator;
+    translator.set_translations_path(temp_dir.path());
+
+    AbbreviatedNumberFormatter formatter(QLocale::c());
+    formatter.follow_translator(&translator);
+    QSignalSpy spy(&formatter, &AbbreviatedNumberFormatter::formatChanged);
+    ASSERT_TRUE(spy.isValid());
+
+    ASSERT_TRUE(translator.load_translation(QStringLiteral("de")));
+    EXPECT_EQ(spy.count(), 1);
+    EXPECT_EQ(formatter.format(1500.0), QStringLiteral("1,5K"));
+
+    formatter.follow_translator(nullptr);
+    formatter.set_locale(QLocale::c());
+    EXPECT_EQ(formatter.format(1500.0), QStringLiteral("1.5K"));
+}
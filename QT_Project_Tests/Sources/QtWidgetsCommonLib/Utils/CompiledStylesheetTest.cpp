@@ -0,0 +1,249 @@
+#include "QtWidgetsCommonLib/Utils/CompiledStylesheetTest.h"
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+using QtWidgetsCommonLib::CompiledStylesheet;
+using QtWidgetsCommonLib::UnresolvedVariable;
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void CompiledStylesheetTest::SetUp() {}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void CompiledStylesheetTest::TearDown() {}
+
+/**
+ * @brief Tests that a default-constructed template is empty and renders an empty string.
+ */
+TEST_F(CompiledStylesheetTest, DefaultConstructedIsEmpty)
+{
+    const CompiledStylesheet compiled;
+
+    EXPECT_TRUE(compiled.is_empty());
+    EXPECT_TRUE(compiled.get_available_themes().isEmpty());
+    EXPECT_TRUE(compiled.get_slot_names().isEmpty());
+    EXPECT_TRUE(compiled.render({}).isEmpty());
+}
+
+/**
+ * @brief Tests that theme tables merge the default block with the theme block.
+ */
+TEST_F(CompiledStylesheetTest, ThemeVariablesOverrideDefaults)
+{
+    const CompiledStylesheet compiled(R"(
+@Variables { @Color: #abc; @Border: 1px; }
+@Variables[Name="Dark"] { @Color: #000; }
+QWidget { color: @Color; border-width: @Border; }
+)");
+
+    const QStringList expected_themes = {"Dark", "Default"};
+    EXPECT_EQ(compiled.get_available_themes(), expected_themes);
+
+    const QMap<QString, QString> dark = compiled.get_theme_variables("Dark");
+    EXPECT_EQ(dark.value("Color"), "#000");
+    EXPECT_EQ(dark.value("Border"), "1px");
+
+    const QMap<QString, QString> fallback = compiled.get_theme_variables("Unknown");
+    EXPECT_EQ(fallback.value("Color"), "#abc");
+    EXPECT_EQ(compiled.get_theme_variables(QString()), fallback);
+}
+
+/**
+ * @brief Tests that the first block of a theme wins and empty theme names are ignored.
+ */
+TEST_F(CompiledStylesheetTest, FirstNamedBlockWinsAndEmptyNameIgnored)
+{
+    const CompiledStylesheet compiled(R"(
+@Variables[Name="A"] { @X: 1; }
+@Variables[Name="A"] { @X: 2; }
+@Variables[Name=""] { @X: 3; }
+QWidget { width: @X; }
+)");
+
+    EXPECT_EQ(compiled.get_theme_variables("A").value("X"), "1");
+    EXPECT_TRUE(compiled.get_theme_variables(QString()).isEmpty());
+    EXPECT_EQ(compiled.get_available_themes(), QStringList {"A"});
+}
+
+/**
+ * @brief Tests that the body keeps one slot per distinct name and renders every occurrence.
+ */
+TEST_F(CompiledStylesheetTest, RenderFillsAllSlotsAndStripsBlocks)
+{
+    const CompiledStylesheet compiled(R"(@Variables { @A: 1; }
+QWidget { margin: @A @B @A; }
+)");
+
+    const QStringList expected_slots = {"A", "B"};
+    EXPECT_EQ(compiled.get_slot_names(), expected_slots);
+
+    const QMap<QString, QString> variables = {{"A", "1px"}, {"B", "2px"}};
+    const QString rendered = compiled.render(variables);
+
+    EXPECT_FALSE(rendered.contains("@Variables"));
+    EXPECT_TRUE(rendered.contains("margin: 1px 2px 1px;"));
+}
+
+/**
+ * @brief Tests that slots without a value keep their placeholder when rendering.
+ */
+TEST_F(CompiledStylesheetTest, RenderKeepsPlaceholderForMissingVariables)
+{
+    const CompiledStylesheet compiled("QWidget { color: @Known; background: @Unknown; }");
+
+    const QString rendered = compiled.render({{"Known", "red"}});
+
+    EXPECT_EQ(rendered, "QWidget { color: red; background: @Unknown; }");
+}
+
+/**
+ * @brief Tests that rendering reports unresolved slots with their line in the source.
+ */
+TEST_F(CompiledStylesheetTest, RenderReportsUnresolvedVariablesWithLines)
+{
+    const CompiledStylesheet compiled("@Variables {\n    @Known: red;\n}\n"
+                                      "QWidget {\n    color: @Known;\n"
+                                      "    background: @Missing;\n}\n"
+                                      "QLabel { border-color: @Missing; }\n");
+    QList<UnresolvedVariable> unresolved = {{"Stale", 99}};
+
+    const QString rendered = compiled.render({{"Known", "red"}}, &unresolved);
+
+    EXPECT_TRUE(rendered.contains("background: @Missing;"));
+    EXPECT_EQ(unresolved, QList<UnresolvedVariable>({{"Missing", 6}, {"Missing", 8}}));
+
+    // Parts keep their lines relative to the concatenated source
+    const CompiledStylesheet merged = CompiledStylesheet::concatenate(
+        {CompiledStylesheet("QWidget {}\n"), CompiledStylesheet("\nQLabel { color: @Late; }")});
+    static_cast<void>(merged.render({}, &unresolved));
+    EXPECT_EQ(unresolved, QList<UnresolvedVariable>({{"Late", 3}}));
+
+    // With origins, parts keep the file and line they were read from
+    const CompiledStylesheet composed = CompiledStylesheet::concatenate(
+        {CompiledStylesheet("QWidget { color: @Early; }\n"),
+         CompiledStylesheet("\nQLabel { color: @Late; }")},
+        {{"main.qss", 1}, {"label.qss", 5}});
+    static_cast<void>(composed.render({}, &unresolved));
+    EXPECT_EQ(unresolved, QList<UnresolvedVariable>(
+                              {{"Early", 1, "main.qss"}, {"Late", 6, "label.qss"}}));
+}
+
+/**
+ * @brief Tests that layered references (palette -> semantic -> component) resolve fully.
+ */
+TEST_F(CompiledStylesheetTest, ResolveVariablesLayeredReferences)
+{
+    const QMap<QString, QString> variables = {{"Blue500", "#2060ff"},
+                                              {"Primary", "@Blue500"},
+                                              {"ButtonBorder", "1px solid @Primary"},
+                                              {"ButtonBorderHover", "2px solid @Primary"}};
+
+    const auto resolution = CompiledStylesheet::resolve_variables(variables);
+
+    EXPECT_EQ(resolution.values.value("Primary"), "#2060ff");
+    EXPECT_EQ(resolution.values.value("ButtonBorder"), "1px solid #2060ff");
+    EXPECT_EQ(resolution.values.value("ButtonBorderHover"), "2px solid #2060ff");
+    EXPECT_TRUE(resolution.cycles.isEmpty());
+    EXPECT_TRUE(resolution.undefined_references.isEmpty());
+}
+
+/**
+ * @brief Tests that cycles (including self references) are reported and resolve to empty values,
+ * while dependents outside the cycle still resolve.
+ */
+TEST_F(CompiledStylesheetTest, ResolveVariablesReportsCycles)
+{
+    const QMap<QString, QString> variables = {{"A", "@B"},         {"B", "x @A"},
+                                              {"Self", "@Self"},   {"Uses", "left @A right"},
+                                              {"Plain", "#ffffff"}};
+
+    const auto resolution = CompiledStylesheet::resolve_variables(variables);
+
+    ASSERT_EQ(resolution.cycles.size(), 2);
+    EXPECT_EQ(resolution.cycles.at(0), QStringList({"A", "B"}));
+    EXPECT_EQ(resolution.cycles.at(1), QStringList({"Self"}));
+
+    EXPECT_TRUE(resolution.values.value("A").isEmpty());
+    EXPECT_TRUE(resolution.values.value("B").isEmpty());
+    EXPECT_TRUE(resolution.values.value("Self").isEmpty());
+    EXPECT_EQ(resolution.values.value("Uses"), "left  right");
+    EXPECT_EQ(resolution.values.value("Plain"), "#ffffff");
+}
+
+/**
+ * @brief Tests that undefined references are reported once and replaced by empty strings.
+ */
+TEST_F(CompiledStylesheetTest, ResolveVariablesReportsUndefinedReferences)
+{
+    const QMap<QString, QString> variables = {{"A", "@Missing @Other"}, {"B", "@Missing"}};
+
+    const auto resolution = CompiledStylesheet::resolve_variables(variables);
+
+    EXPECT_EQ(resolution.undefined_references, QStringList({"Missing", "Other"}));
+    EXPECT_EQ(resolution.values.value("A"), " ");
+    EXPECT_TRUE(resolution.values.value("B").isEmpty());
+}
+
+/**
+ * @brief Tests that a very deep reference chain resolves without recursion.
+ */
+TEST_F(CompiledStylesheetTest, ResolveVariablesDeepChain)
+{
+    constexpr int kDepth = 20000;
+    QMap<QString, QString> variables;
+
+    for (int i = 0; i < kDepth; ++i)
+    {
+        variables.insert(QString("V%1").arg(i), QString("@V%1").arg(i + 1));
+    }
+
+    variables.insert(QString("V%1").arg(kDepth), "#010203");
+
+    const auto resolution = CompiledStylesheet::resolve_variables(variables);
+
+    EXPECT_EQ(resolution.values.value("V0"), "#010203");
+    EXPECT_EQ(resolution.values.size(), kDepth + 1);
+    EXPECT_TRUE(resolution.cycles.isEmpty());
+}
+
+/**
+ * @brief Tests that concatenating compiled parts equals compiling the concatenated source.
+ */
+TEST_F(CompiledStylesheetTest, ConcatenateMatchesCompiledConcatenation)
+{
+    const QString first = R"(
+@Variables[Name="Dark"] { @Accent: #111111; }
+QWidget { color: @Accent; }
+)";
+    const QString second = R"(
+@Variables { @Accent: #222222; @Border: 1px; }
+@Variables[Name="Dark"] { @Accent: #333333; }
+@Variables[Name="Light"] { @Border: 2px; }
+QLabel { color: @Accent; border-width: @Border; }
+)";
+
+    const CompiledStylesheet merged =
+        CompiledStylesheet::concatenate({CompiledStylesheet(first), CompiledStylesheet(second)});
+    const CompiledStylesheet reference(first + second);
+
+    EXPECT_EQ(merged.get_source(), reference.get_source());
+    EXPECT_EQ(merged.get_available_themes(), reference.get_available_themes());
+    EXPECT_EQ(merged.get_slot_names(), reference.get_slot_names());
+
+    for (const QString& theme: {QString(), QString("Dark"), QString("Light")})
+    {
+        EXPECT_EQ(merged.get_theme_variables(theme), reference.get_theme_variables(theme));
+        EXPECT_EQ(merged.render(merged.get_theme_variables(theme)),
+                  reference.render(reference.get_theme_variables(theme)));
+    }
+
+    // The first Dark block wins, even though the default block comes from the second part
+    EXPECT_EQ(merged.get_theme_variables("Dark").value("Accent"), "#111111");
+    EXPECT_EQ(merged.get_theme_variables("Dark").value("Border"), "1px");
+    EXPECT_TRUE(CompiledStylesheet::concatenate({}).is_empty());
+}
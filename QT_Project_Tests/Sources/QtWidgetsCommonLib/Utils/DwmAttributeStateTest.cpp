@@ -0,0 +1,81 @@
+#include "QtWidgetsCommonLib/Utils/DwmAttributeStateTest.h"
+
+using QtWidgetsCommonLib::DwmAttributeState;
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void DwmAttributeStateTest::SetUp()
+{
+    m_state = DwmAttributeState();
+}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void DwmAttributeStateTest::TearDown() {}
+
+/**
+ * @brief Tests that every attribute is pending until the first update was applied.
+ */
+TEST_F(DwmAttributeStateTest, InitiallyEverythingPending)
+{
+    const DwmAttributeState::Changes changes = m_state.get_pending_changes();
+
+    EXPECT_FALSE(m_state.get_applied().has_value());
+    EXPECT_TRUE(changes.frame);
+    EXPECT_TRUE(changes.corner_preference);
+    EXPECT_TRUE(changes.dark_mode);
+    EXPECT_TRUE(changes.backdrop);
+
+    m_state.mark_applied(changes);
+
+    EXPECT_FALSE(m_state.get_pending_changes().any());
+    EXPECT_EQ(m_state.get_applied(), m_state.get_desired());
+    EXPECT_EQ(m_state.get_applied_count(), 4);
+}
+
+/**
+ * @brief Tests that only the attribute that changed is reported, and unchanged values are not.
+ */
+TEST_F(DwmAttributeStateTest, OnlyChangedAttributesPending)
+{
+    m_state.mark_applied(m_state.get_pending_changes());
+
+    DwmAttributeState::Attributes desired = m_state.get_desired();
+    desired.mica = true;
+    m_state.set_desired(desired);
+
+    DwmAttributeState::Changes changes = m_state.get_pending_changes();
+    EXPECT_TRUE(changes.backdrop);
+    EXPECT_FALSE(changes.frame);
+    EXPECT_FALSE(changes.corner_preference);
+    EXPECT_FALSE(changes.dark_mode);
+
+    m_state.mark_applied(changes);
+    EXPECT_EQ(m_state.get_applied_count(), 5);
+
+    // Toggling a value back and forth before the update results in no call at all
+    desired.rounded_corners = false;
+    m_state.set_desired(desired);
+    desired.rounded_corners = true;
+    m_state.set_desired(desired);
+    EXPECT_FALSE(m_state.get_pending_changes().any());
+}
+
+/**
+ * @brief Tests that invalidate() makes every attribute pending again.
+ */
+TEST_F(DwmAttributeStateTest, InvalidateReappliesEverything)
+{
+    m_state.mark_applied(m_state.get_pending_changes());
+
+    m_state.invalidate();
+    const DwmAttributeState::Changes changes = m_state.get_pending_changes();
+
+    EXPECT_FALSE(m_state.get_applied().has_value());
+    EXPECT_TRUE(changes.frame);
+    EXPECT_TRUE(changes.corner_preference);
+    EXPECT_TRUE(changes.dark_mode);
+    EXPECT_TRUE(changes.backdrop);
+}
@@ -0,0 +1,71 @@
+#include "QtWidgetsCommonLib/Utils/HitTestRegionMapTest.h"
+
+#include <QList>
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+
+using QtWidgetsCommonLib::HitTestRegionMap;
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void HitTestRegionMapTest::SetUp()
+{
+    m_map.update(QSize(800, 600), 8, QRect(0, 0, 800, 40), {QRect(740, 0, 60, 40)});
+}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void HitTestRegionMapTest::TearDown()
+{
+    m_map.invalidate();
+}
+
+/**
+ * @brief Tests caption, interactive and client areas away from the borders.
+ */
+TEST_F(HitTestRegionMapTest, CaptionExcludesInteractiveRects)
+{
+    EXPECT_TRUE(m_map.is_valid());
+    EXPECT_EQ(m_map.get_interactive_rect_count(), 1);
+
+    EXPECT_EQ(m_map.hit_test(QPoint(400, 20)), HitTestRegionMap::Region::Caption);
+    EXPECT_EQ(m_map.hit_test(QPoint(760, 20)), HitTestRegionMap::Region::Client);
+    EXPECT_EQ(m_map.hit_test(QPoint(400, 300)), HitTestRegionMap::Region::Client);
+}
+
+/**
+ * @brief Tests that resize borders win over the caption and interactive rects.
+ */
+TEST_F(HitTestRegionMapTest, ResizeBordersWin)
+{
+    EXPECT_EQ(m_map.hit_test(QPoint(2, 2)), HitTestRegionMap::Region::TopLeft);
+    EXPECT_EQ(m_map.hit_test(QPoint(797, 2)), HitTestRegionMap::Region::TopRight);
+    EXPECT_EQ(m_map.hit_test(QPoint(400, 2)), HitTestRegionMap::Region::Top);
+    EXPECT_EQ(m_map.hit_test(QPoint(2, 300)), HitTestRegionMap::Region::Left);
+    EXPECT_EQ(m_map.hit_test(QPoint(797, 300)), HitTestRegionMap::Region::Right);
+    EXPECT_EQ(m_map.hit_test(QPoint(400, 597)), HitTestRegionMap::Region::Bottom);
+    EXPECT_EQ(m_map.hit_test(QPoint(2, 597)), HitTestRegionMap::Region::BottomLeft);
+    EXPECT_EQ(m_map.hit_test(QPoint(797, 597)), HitTestRegionMap::Region::BottomRight);
+}
+
+/**
+ * @brief Tests that a zero border (maximized window) turns the edges into caption.
+ */
+TEST_F(HitTestRegionMapTest, NoBorderWhenResizeDisabled)
+{
+    m_map.invalidate();
+    EXPECT_FALSE(m_map.is_valid());
+
+    // The second rect lies outside the caption and is dropped
+    m_map.update(QSize(800, 600), 0, QRect(0, 0, 800, 40),
+                 {QRect(740, 0, 60, 40), QRect(0, 100, 50, 50)});
+
+    EXPECT_TRUE(m_map.is_valid());
+    EXPECT_EQ(m_map.get_interactive_rect_count(), 1);
+    EXPECT_EQ(m_map.hit_test(QPoint(0, 0)), HitTestRegionMap::Region::Caption);
+    EXPECT_EQ(m_map.hit_test(QPoint(0, 300)), HitTestRegionMap::Region::Client);
+    EXPECT_EQ(m_map.hit_test(QPoint(799, 0)), HitTestRegionMap::Region::Client);
+}
@@ -0,0 +1,126 @@
+#include "QtWidgetsCommonLib/Utils/NativeIconCacheTest.h"
+
+#include <QColor>
+#include <QIcon>
+#include <QPixmap>
+
+using QtWidgetsCommonLib::NativeIconCache;
+
+namespace
+{
+
+/**
+ * @brief Creates an icon from a filled pixmap.
+ * @param color The fill color.
+ * @return The icon (each call has its own cache key).
+ */
+auto create_icon(const QColor& color) -> QIcon
+{
+    QPixmap pixmap(32, 32);
+    pixmap.fill(color);
+    return QIcon(pixmap);
+}
+
+}  // namespace
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void NativeIconCacheTest::SetUp()
+{
+    m_created.clear();
+    m_destroyed.clear();
+    m_cache = std::make_unique<NativeIconCache>(
+        [this](const QPixmap& pixmap) -> NativeIconCache::Handle {
+            NativeIconCache::Handle handle = new int(pixmap.width());
+            m_created.append(handle);
+            return handle;
+        },
+        [this](NativeIconCache::Handle handle) {
+            m_destroyed.append(handle);
+            delete static_cast<int*>(handle);
+        });
+}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void NativeIconCacheTest::TearDown()
+{
+    m_cache.reset();
+}
+
+/**
+ * @brief Tests that windows acquiring the same icon, size and DPI share one handle.
+ */
+TEST_F(NativeIconCacheTest, SameIconSharesHandle)
+{
+    const QIcon icon = create_icon(Qt::red);
+
+    NativeIconCache::Handle first = m_cache->acquire(icon, 16, 96);
+    NativeIconCache::Handle second = m_cache->acquire(icon, 16, 96);
+
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(m_cache->get_reference_count(first), 2);
+    EXPECT_EQ(m_cache->get_created_count(), 1);
+    EXPECT_EQ(*static_cast<int*>(first), 16);
+
+    // Another size or DPI is another handle
+    NativeIconCache::Handle big = m_cache->acquire(icon, 32, 96);
+    NativeIconCache::Handle scaled = m_cache->acquire(icon, 16, 144);
+    EXPECT_NE(big, first);
+    EXPECT_NE(scaled, first);
+    EXPECT_EQ(m_cache->get_created_count(), 3);
+
+    EXPECT_EQ(m_cache->acquire(QIcon(), 16, 96), nullptr);
+}
+
+/**
+ * @brief Tests that unreferenced handles are reused, then destroyed beyond the capacity.
+ */
+TEST_F(NativeIconCacheTest, ReleasedHandlesAreEvicted)
+{
+    m_cache->set_unused_capacity(1);
+    const QIcon plain = create_icon(Qt::red);
+    const QIcon badge = create_icon(Qt::blue);
+
+    NativeIconCache::Handle plain_handle = m_cache->acquire(plain, 16, 96);
+    m_cache->release(plain_handle);
+    EXPECT_EQ(m_cache->get_reference_count(plain_handle), 0);
+    EXPECT_TRUE(m_destroyed.isEmpty());
+
+    // Toggling back to a recently used icon does not create a new handle
+    EXPECT_EQ(m_cache->acquire(plain, 16, 96), plain_handle);
+    EXPECT_EQ(m_cache->get_created_count(), 1);
+    m_cache->release(plain_handle);
+
+    NativeIconCache::Handle badge_handle = m_cache->acquire(badge, 16, 96);
+    m_cache->release(badge_handle);
+    ASSERT_EQ(m_destroyed.size(), 1);
+    EXPECT_EQ(m_destroyed.first(), plain_handle);
+    EXPECT_EQ(m_cache->get_entry_count(), 1);
+
+    m_cache->clear_unused();
+    EXPECT_EQ(m_destroyed.size(), 2);
+    EXPECT_EQ(m_cache->get_entry_count(), 0);
+
+    // Unknown and null handles are ignored
+    m_cache->release(nullptr);
+    m_cache->release(badge_handle);
+    EXPECT_EQ(m_destroyed.size(), 2);
+}
+
+/**
+ * @brief Tests that destroying the cache destroys referenced handles as well.
+ */
+TEST_F(NativeIconCacheTest, DestructorDestroysAllHandles)
+{
+    static_cast<void>(m_cache->acquire(create_icon(Qt::red), 16, 96));
+    static_cast<void>(m_cache->acquire(create_icon(Qt::green), 32, 96));
+
+    m_cache.reset();
+
+    EXPECT_EQ(m_destroyed.size(), 2);
+    EXPECT_EQ(m_created.size(), 2);
+}
@@ -1,5 +1,9 @@
 #include "QtWidgetsCommonLib/Utils/NumberFormatUtilsTest.h"
 
+#include <QList>
+#include <QStringView>
+#include <array>
+
 #include "QtWidgetsCommonLib/Utils/NumberFormatUtils.h"
 
 using QtWidgetsCommonLib::NumberFormatUtils;
@@ -63,3 +67,43 @@ TEST_F(NumberFormatUtilsTest, FormatNumberAbbreviated_EdgeCases)
     EXPECT_EQ(NumberFormatUtils::format_number_abbreviated(-1500000).toStdString(),
               std::string("-1.5M"));
 }
+
+/**
+ * @brief Tests that the buffer overload produces the same text as the QString overload.
+ */
+TEST_F(NumberFormatUtilsTest, FormatNumberAbbreviated_Buffer)
+{
+    const QList<double> values = {0.0,    5.04,    -0.5,       999.9,     999.96,
+                                  1000.0, 9999.0,  -1500000.0, 123456.78, 1234567890.0,
+                                  1.0e12, 1.0e15,  1.7e308,    -999.0,    42.0};
+    std::array<char16_t, NumberFormatUtils::kMaxAbbreviatedLength> buffer{};
+
+    for (const double value: values)
+    {
+        const qsizetype length = NumberFormatUtils::format_number_abbreviated(value, buffer);
+        ASSERT_GE(length, 0);
+        EXPECT_EQ(QStringView(buffer.data(), length).toString(),
+                  NumberFormatUtils::format_number_abbreviated(value));
+    }
+
+    std::array<char16_t, 4> small{};
+    EXPECT_EQ(NumberFormatUtils::format_number_abbreviated(1500, small), 4);
+    EXPECT_EQ(QStringView(small.data(), 4), QStringLiteral("1.5K"));
+    EXPECT_EQ(NumberFormatUtils::format_number_abbreviated(-1500, small), -1);
+}
+
+/**
+ * @brief Tests batch formatting of double and integer spans.
+ */
+TEST_F(NumberFormatUtilsTest, FormatNumbersAbbreviated_Batch)
+{
+    const std::array<double, 3> doubles = {999.9, 1500.0, -2500000.0};
+    const std::array<int, 3> ints = {7, 10000, 1234567890};
+
+    EXPECT_EQ(NumberFormatUtils::format_numbers_abbreviated(doubles),
+              QStringList({QStringLiteral("999.9"), QStringLiteral("1.5K"),
+                           QStringLiteral("-2.5M")}));
+    EXPECT_EQ(NumberFormatUtils::format_numbers_abbreviated(ints),
+              QStringList({QStringLiteral("7"), QStringLiteral("10K"), QStringLiteral("1.2B")}));
+    EXPECT_TRUE(NumberFormatUtils::format_numbers_abbreviated(std::span<const int>()).isEmpty());
+}
@@ -0,0 +1,80 @@
+#include "QtWidgetsCommonLib/Utils/SharedRegistryTest.h"
+
+#include <memory>
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void SharedRegistryTest::SetUp()
+{
+    m_create_calls = 0;
+}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void SharedRegistryTest::TearDown() {}
+
+/**
+ * @brief Tests that users of the same key share one value, created once.
+ */
+TEST_F(SharedRegistryTest, SameKeySharesValue)
+{
+    const auto create = [this]() {
+        ++m_create_calls;
+        return std::make_shared<const QString>(QStringLiteral("parsed"));
+    };
+
+    const std::shared_ptr<const QString> first = m_registry.acquire(QStringLiteral("a"), create);
+    const std::shared_ptr<const QString> second = m_registry.acquire(QStringLiteral("a"), create);
+    const std::shared_ptr<const QString> other = m_registry.acquire(QStringLiteral("b"), create);
+
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, other);
+    EXPECT_EQ(m_create_calls, 2);
+    EXPECT_EQ(m_registry.get_entry_count(), 2);
+    EXPECT_EQ(m_registry.get_created_count(), 2);
+    EXPECT_EQ(m_registry.find(QStringLiteral("a")), first);
+
+    // An existing value wins over an inserted one
+    EXPECT_EQ(m_registry.insert(QStringLiteral("a"), std::make_shared<const QString>()), first);
+}
+
+/**
+ * @brief Tests that a value is released with its last user and created again afterwards.
+ */
+TEST_F(SharedRegistryTest, ValueIsReleasedWithLastUser)
+{
+    const auto create = [this]() {
+        ++m_create_calls;
+        return std::make_shared<const QString>(QStringLiteral("parsed"));
+    };
+
+    std::shared_ptr<const QString> value = m_registry.acquire(QStringLiteral("a"), create);
+    EXPECT_TRUE(m_registry.contains(QStringLiteral("a")));
+
+    value.reset();
+    EXPECT_FALSE(m_registry.contains(QStringLiteral("a")));
+    EXPECT_EQ(m_registry.get_entry_count(), 0);
+
+    value = m_registry.acquire(QStringLiteral("a"), create);
+    EXPECT_NE(value, nullptr);
+    EXPECT_EQ(m_create_calls, 2);
+}
+
+/**
+ * @brief Tests that failed creations are not stored, so the next acquire tries again.
+ */
+TEST_F(SharedRegistryTest, FailedCreationIsRetried)
+{
+    const auto fail = [this]() {
+        ++m_create_calls;
+        return std::shared_ptr<const QString>();
+    };
+
+    EXPECT_EQ(m_registry.acquire(QStringLiteral("a"), fail), nullptr);
+    EXPECT_EQ(m_registry.acquire(QStringLiteral("a"), fail), nullptr);
+    EXPECT_EQ(m_create_calls, 2);
+    EXPECT_EQ(m_registry.get_created_count(), 0);
+}
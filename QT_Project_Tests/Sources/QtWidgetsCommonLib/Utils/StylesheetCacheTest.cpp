@@ -0,0 +1,172 @@
+#include "QtWidgetsCommonLib/Utils/StylesheetCacheTest.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+
+#include "QtWidgetsCommonLib/Utils/StylesheetLoader.h"
+
+using QtWidgetsCommonLib::StylesheetCache;
+using QtWidgetsCommonLib::StylesheetCacheEntry;
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void StylesheetCacheTest::SetUp()
+{
+    m_temp_dir = new QTemporaryDir();
+    ASSERT_TRUE(m_temp_dir->isValid());
+}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void StylesheetCacheTest::TearDown()
+{
+    delete m_temp_dir;
+    m_temp_dir = nullptr;
+}
+
+/**
+ * @brief Tests that keys differ by source and theme and are stable for equal input.
+ */
+TEST_F(StylesheetCacheTest, MakeKeyDependsOnSourceAndTheme)
+{
+    const QString key = StylesheetCache::make_key("QWidget {}", "Dark");
+
+    EXPECT_EQ(key, StylesheetCache::make_key("QWidget {}", "Dark"));
+    EXPECT_NE(key, StylesheetCache::make_key("QWidget {}", "Light"));
+    EXPECT_NE(key, StylesheetCache::make_key("QLabel {}", "Dark"));
+    EXPECT_FALSE(key.isEmpty());
+}
+
+/**
+ * @brief Tests that keys derived from a source digest equal the keys of the source.
+ */
+TEST_F(StylesheetCacheTest, ThemeKeyFromSourceKeyMatchesMakeKey)
+{
+    const QString source_key = StylesheetCache::make_source_key("QWidget {}");
+
+    EXPECT_EQ(source_key, StylesheetCache::make_source_key("QWidget {}"));
+    EXPECT_NE(source_key, StylesheetCache::make_source_key("QLabel {}"));
+    EXPECT_NE(source_key, StylesheetCache::make_source_key("QWidget {}", {{"main.qss", 1}}));
+    EXPECT_EQ(StylesheetCache::make_theme_key(source_key, "Dark"),
+              StylesheetCache::make_key("QWidget {}", "Dark"));
+    EXPECT_NE(StylesheetCache::make_theme_key(source_key, "Dark"),
+              StylesheetCache::make_theme_key(source_key, "Light"));
+}
+
+/**
+ * @brief Tests that a stored entry is read back unchanged.
+ */
+TEST_F(StylesheetCacheTest, StoreAndLoadRoundTrip)
+{
+    const StylesheetCache cache(m_temp_dir->path());
+    const StylesheetCacheEntry stored {"QWidget { color: #123456; }",
+                                       {"Dark", "Default"},
+                                       {{"Color", "#123456"}},
+                                       true,
+                                       {},
+                                       {},
+                                       {{"Missing", 4, "main.qss"}}};
+    const QString key = StylesheetCache::make_key("source", "Dark");
+
+    ASSERT_TRUE(cache.store(key, stored));
+
+    StylesheetCacheEntry loaded;
+    ASSERT_TRUE(cache.load(key, loaded));
+    EXPECT_EQ(loaded.stylesheet, stored.stylesheet);
+    EXPECT_EQ(loaded.available_themes, stored.available_themes);
+    EXPECT_EQ(loaded.variables, stored.variables);
+    EXPECT_TRUE(loaded.has_unresolved_variables);
+    EXPECT_EQ(loaded.unresolved_variables, stored.unresolved_variables);
+}
+
+/**
+ * @brief Tests that missing and corrupt entries are rejected and clear() removes entries.
+ */
+TEST_F(StylesheetCacheTest, RejectsMissingAndCorruptEntries)
+{
+    const StylesheetCache cache(m_temp_dir->path());
+    StylesheetCacheEntry entry;
+
+    EXPECT_FALSE(cache.load("does-not-exist", entry));
+
+    const QString key = StylesheetCache::make_key("source", QString());
+    ASSERT_TRUE(cache.store(key, StylesheetCacheEntry {"QWidget {}", {}, {}, false}));
+
+    QFile file(QDir(m_temp_dir->path()).filePath(key + ".qsscache"));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write("not a cache file");
+    file.close();
+
+    EXPECT_FALSE(cache.load(key, entry));
+    EXPECT_TRUE(cache.clear());
+    EXPECT_FALSE(QFile::exists(file.fileName()));
+}
+
+/**
+ * @brief Tests that storing beyond the maximum entry count removes the oldest entries.
+ */
+TEST_F(StylesheetCacheTest, StoreRemovesOldestEntriesBeyondLimit)
+{
+    StylesheetCache cache(m_temp_dir->path());
+    cache.set_max_entry_count(2);
+    EXPECT_EQ(cache.get_max_entry_count(), 2);
+
+    const QString oldest = StylesheetCache::make_key("first", QString());
+    const QString older = StylesheetCache::make_key("second", QString());
+    const QString newest = StylesheetCache::make_key("third", QString());
+    const QDir dir(m_temp_dir->path());
+    const QDateTime now = QDateTime::currentDateTime();
+
+    ASSERT_TRUE(cache.store(oldest, StylesheetCacheEntry {"QWidget {}"}));
+    ASSERT_TRUE(cache.store(older, StylesheetCacheEntry {"QLabel {}"}));
+
+    // Modification times of files written within the same second may compare equal
+    QFile oldest_file(dir.filePath(oldest + ".qsscache"));
+    QFile older_file(dir.filePath(older + ".qsscache"));
+    ASSERT_TRUE(oldest_file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(older_file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(oldest_file.setFileTime(now.addSecs(-120), QFileDevice::FileModificationTime));
+    ASSERT_TRUE(older_file.setFileTime(now.addSecs(-60), QFileDevice::FileModificationTime));
+    oldest_file.close();
+    older_file.close();
+
+    ASSERT_TRUE(cache.store(newest, StylesheetCacheEntry {"QPushButton {}"}));
+
+    StylesheetCacheEntry entry;
+    EXPECT_FALSE(cache.load(oldest, entry));
+    EXPECT_TRUE(cache.load(older, entry));
+    EXPECT_TRUE(cache.load(newest, entry));
+    EXPECT_EQ(dir.entryList({"*.qsscache"}, QDir::Files).size(), 2);
+}
+
+/**
+ * @brief Tests that a second loader applies the cached result and still supports theme switches.
+ */
+TEST_F(StylesheetCacheTest, LoaderUsesCacheAndCompilesLazily)
+{
+    const QString qss = R"(
+@Variables[Name="Dark"] { @Color: #000000; }
+@Variables[Name="Light"] { @Color: #ffffff; }
+QWidget { color: @Color; }
+)";
+
+    QtWidgetsCommonLib::StylesheetLoader first;
+    first.enable_disk_cache(true, m_temp_dir->path());
+    ASSERT_TRUE(first.load_stylesheet_from_data(qss, "Dark"));
+    EXPECT_EQ(QDir(m_temp_dir->path()).entryList({"*.qsscache"}, QDir::Files).size(), 1);
+
+    QtWidgetsCommonLib::StylesheetLoader second;
+    second.enable_disk_cache(true, m_temp_dir->path());
+    EXPECT_TRUE(second.is_disk_cache_enabled());
+    ASSERT_TRUE(second.load_stylesheet_from_data(qss, "Dark"));
+
+    EXPECT_EQ(second.get_current_stylesheet(), first.get_current_stylesheet());
+    EXPECT_EQ(second.get_available_themes(), first.get_available_themes());
+    EXPECT_EQ(second.get_variables(), first.get_variables());
+
+    ASSERT_TRUE(second.set_theme("Light"));
+    EXPECT_TRUE(second.get_current_stylesheet().contains("#ffffff"));
+}
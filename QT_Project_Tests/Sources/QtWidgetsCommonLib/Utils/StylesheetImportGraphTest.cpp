@@ -0,0 +1,190 @@
+#include "QtWidgetsCommonLib/Utils/StylesheetImportGraphTest.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+
+#include "QtWidgetsCommonLib/Utils/CompiledStylesheet.h"
+
+using QtWidgetsCommonLib::CompiledStylesheet;
+using QtWidgetsCommonLib::SourceOrigin;
+using QtWidgetsCommonLib::StylesheetImportGraph;
+using QtWidgetsCommonLib::UnresolvedVariable;
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void StylesheetImportGraphTest::SetUp()
+{
+    m_temp_dir = new QTemporaryDir();
+    ASSERT_TRUE(m_temp_dir->isValid());
+}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void StylesheetImportGraphTest::TearDown()
+{
+    delete m_temp_dir;
+    m_temp_dir = nullptr;
+}
+
+/**
+ * @brief Writes a file below the temporary directory, creating sub directories.
+ */
+auto StylesheetImportGraphTest::write_file(const QString& relative_path,
+                                           const QString& content) -> QString
+{
+    QString result;
+    const QString path = m_temp_dir->filePath(relative_path);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile file(path);
+
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        file.write(content.toUtf8());
+        file.close();
+        result = StylesheetImportGraph::normalize_path(path);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Tests that imports are expanded in place and resolved relative to the importing file.
+ */
+TEST_F(StylesheetImportGraphTest, ComposesImportsRelativeToImporter)
+{
+    const QString colors =
+        write_file("parts/colors.qss", "@Variables { @Accent: #123456; }\n@import \"button.qss\";");
+    const QString button = write_file("parts/button.qss", "QPushButton { color: @Accent; }\n");
+    const QString root =
+        write_file("main.qss", "QWidget { margin: 0; }\n@import \"parts/colors.qss\";\nQLabel {}");
+
+    StylesheetImportGraph graph;
+    ASSERT_TRUE(graph.load(root));
+
+    EXPECT_EQ(graph.get_root_path(), root);
+    EXPECT_EQ(graph.get_files(), QStringList({root, colors, button}));
+    EXPECT_FALSE(graph.get_source().contains("@import"));
+    EXPECT_LT(graph.get_source().indexOf("QWidget"), graph.get_source().indexOf("QPushButton"));
+    EXPECT_LT(graph.get_source().indexOf("QPushButton"), graph.get_source().indexOf("QLabel"));
+
+    // Composing the per-file compiled chunks equals compiling the composed text
+    CompiledStylesheet compiled = graph.compile();
+    const CompiledStylesheet reference(graph.get_source());
+    EXPECT_EQ(compiled.get_source(), reference.get_source());
+    EXPECT_EQ(compiled.get_available_themes(), reference.get_available_themes());
+    EXPECT_EQ(compiled.render(compiled.get_theme_variables(QString())),
+              reference.render(reference.get_theme_variables(QString())));
+    EXPECT_TRUE(compiled.render(compiled.get_theme_variables(QString())).contains("#123456"));
+}
+
+/**
+ * @brief Tests that unresolved variables are reported by the file and line they are written at.
+ */
+TEST_F(StylesheetImportGraphTest, ReportsUnresolvedVariablesPerFile)
+{
+    const QString button =
+        write_file("parts/button.qss", "QPushButton {\n    color: @ButtonText;\n}\n");
+    const QString root = write_file("main.qss", "QWidget {}\n@import \"parts/button.qss\";\n"
+                                                "QLabel {\n    color: @LabelText;\n}\n");
+
+    StylesheetImportGraph graph;
+    ASSERT_TRUE(graph.load(root));
+    EXPECT_EQ(graph.get_origins(), QList<SourceOrigin>({{root, 1}, {button, 1}, {root, 2}}));
+
+    QList<UnresolvedVariable> unresolved;
+    static_cast<void>(graph.compile().render({}, &unresolved));
+    EXPECT_EQ(unresolved,
+              QList<UnresolvedVariable>({{"ButtonText", 2, button}, {"LabelText", 4, root}}));
+}
+
+/**
+ * @brief Tests that loading again only re-reads invalidated or modified files.
+ */
+TEST_F(StylesheetImportGraphTest, ReparsesOnlyChangedFiles)
+{
+    const QString child = write_file("child.qss", "QLabel { color: red; }");
+    const QString root = write_file("root.qss", "@import \"child.qss\";\nQWidget {}");
+
+    StylesheetImportGraph graph;
+    ASSERT_TRUE(graph.load(root));
+    EXPECT_EQ(graph.get_reparsed_files(), QStringList({root, child}));
+
+    ASSERT_TRUE(graph.load(root));
+    EXPECT_TRUE(graph.get_reparsed_files().isEmpty());
+
+    ASSERT_FALSE(write_file("child.qss", "QLabel { color: blue; }").isEmpty());
+    graph.invalidate(child);
+    ASSERT_TRUE(graph.load(root));
+    EXPECT_EQ(graph.get_reparsed_files(), QStringList({child}));
+    EXPECT_TRUE(graph.get_source().contains("blue"));
+    EXPECT_TRUE(graph.contains(child));
+}
+
+/**
+ * @brief Tests that cycles and repeated imports are included once and missing imports skipped.
+ */
+TEST_F(StylesheetImportGraphTest, SkipsCyclesDuplicatesAndMissingImports)
+{
+    const QString shared = write_file("shared.qss", "/* shared */");
+    const QString other =
+        write_file("other.qss", "@import \"shared.qss\";\n@import \"root.qss\";\n/* other */");
+    const QString root = write_file(
+        "root.qss", "@import \"other.qss\";\n@import \"shared.qss\";\n@import \"missing.qss\";");
+
+    StylesheetImportGraph graph;
+    ASSERT_TRUE(graph.load(root));
+
+    EXPECT_EQ(graph.get_files(), QStringList({root, other, shared}));
+    EXPECT_EQ(graph.get_source().count("/* shared */"), 1);
+    EXPECT_FALSE(graph.contains(m_temp_dir->filePath("missing.qss")));
+}
+
+/**
+ * @brief Tests that import directives inside comments are inert.
+ */
+TEST_F(StylesheetImportGraphTest, IgnoresCommentedOutImports)
+{
+    const QString used = write_file("used.qss", "QLabel { color: @Used; }\n");
+    ASSERT_FALSE(write_file("unused.qss", "QPushButton {}").isEmpty());
+    const QString root =
+        write_file("root.qss", "/* @import \"unused.qss\"; */\n/*\n@import \"unused.qss\";\n*/\n"
+                               "@import \"used.qss\";\nQWidget { color: @Root; }\n"
+                               "/* unterminated @import \"unused.qss\";");
+
+    StylesheetImportGraph graph;
+    ASSERT_TRUE(graph.load(root));
+
+    EXPECT_EQ(graph.get_files(), QStringList({root, used}));
+    EXPECT_FALSE(graph.get_source().contains("QPushButton"));
+    EXPECT_EQ(graph.get_source().count("@import"), 3);
+    EXPECT_EQ(graph.get_origins(), QList<SourceOrigin>({{root, 1}, {used, 1}, {root, 5}}));
+
+    // Lines after the comments still match the file
+    QList<UnresolvedVariable> unresolved;
+    static_cast<void>(graph.compile().render({}, &unresolved));
+    EXPECT_EQ(unresolved, QList<UnresolvedVariable>({{"Used", 1, used}, {"Root", 6, root}}));
+}
+
+/**
+ * @brief Tests that an unreadable root fails and keeps the previous state.
+ */
+TEST_F(StylesheetImportGraphTest, MissingRootFailsAndKeepsState)
+{
+    const QString root = write_file("root.qss", "QWidget {}");
+
+    StylesheetImportGraph graph;
+    ASSERT_TRUE(graph.load(root));
+    EXPECT_FALSE(graph.load(m_temp_dir->filePath("does_not_exist.qss")));
+
+    EXPECT_FALSE(graph.get_error_string().isEmpty());
+    EXPECT_EQ(graph.get_root_path(), root);
+    EXPECT_EQ(graph.get_source(), "QWidget {}");
+
+    graph.clear();
+    EXPECT_TRUE(graph.is_empty());
+    EXPECT_TRUE(graph.get_files().isEmpty());
+}
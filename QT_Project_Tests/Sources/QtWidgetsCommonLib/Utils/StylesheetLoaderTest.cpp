@@ -1,10 +1,14 @@
 #include "QtWidgetsCommonLib/Utils/StylesheetLoaderTest.h"
 
 #include <QApplication>
+#include <QColor>
 #include <QElapsedTimer>
 #include <QFile>
+#include <QHash>
+#include <QImage>
 #include <QRegularExpression>
 #include <QString>
+#include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QTextStream>
 #include <QThread>
@@ -469,8 +473,8 @@ QWidget { color: @A; border-color: @B; }
 }
 
 /**
- * @brief Exercises substitute_variables iteration over multiple keys with varied lengths
- *        to ensure length-descending sort avoids partial replacements.
+ * @brief Exercises substitution of multiple keys sharing a common prefix to ensure no partial
+ *        replacements happen.
  */
 TEST_F(StylesheetLoaderTest, SubstituteVariablesMultipleKeysIteration)
 {
@@ -1150,3 +1154,401 @@ QWidget { color: @Color; }
     EXPECT_TRUE(applied.contains("#aabbcc"));
     EXPECT_FALSE(applied.contains("should-not-appear"));
 }
+
+/**
+ * @brief Tests that substitution matches whole tokens only, keeps unknown tokens and handles
+ * adjacent and hyphenated placeholders.
+ */
+TEST_F(StylesheetLoaderTest, SubstituteVariablesMatchesWholeTokensOnly)
+{
+    const QString qss = R"(
+@Variables[Name="Test"] {
+    @Pad: 4px;
+    @Pad-Large: 12px;
+}
+QWidget { padding: @Pad @Pad-Large @Padding; margin: @Pad@Pad; }
+)";
+    ASSERT_TRUE(m_loader->load_stylesheet_from_data(qss, "Test"));
+
+    const QString applied = m_loader->get_current_stylesheet();
+    EXPECT_TRUE(applied.contains("padding: 4px 12px @Padding;"));
+    EXPECT_TRUE(applied.contains("margin: 4px4px;"));
+}
+
+/**
+ * @brief Tests that set_theme keeps the loaded file path so reload still targets the file.
+ */
+TEST_F(StylesheetLoaderTest, SetThemeKeepsSourcePathForReload)
+{
+    const QString qss = R"(
+@Variables[Name="Dark"] { @Color: #111; }
+@Variables[Name="Light"] { @Color: #eee; }
+QWidget { color: @Color; }
+)";
+    const QString path = create_temp_qss(qss);
+    ASSERT_FALSE(path.isEmpty());
+
+    ASSERT_TRUE(m_loader->load_stylesheet(path, "Dark"));
+    ASSERT_TRUE(m_loader->set_theme("Light"));
+    EXPECT_TRUE(m_loader->get_current_stylesheet().contains("#eee"));
+
+    ASSERT_TRUE(m_loader->reload_stylesheet());
+    EXPECT_EQ(m_loader->get_current_theme_name(), "Light");
+    EXPECT_TRUE(m_loader->get_current_stylesheet().contains("#eee"));
+
+    QFile::remove(path);
+}
+
+/**
+ * @brief Tests that set_variables coalesces several calls into one deferred apply.
+ */
+TEST_F(StylesheetLoaderTest, SetVariablesCoalescesIntoSingleDeferredApply)
+{
+    const QString qss = R"(
+@Variables[Name="Test"] {
+    @Accent: #101010;
+    @Border: #202020;
+}
+QWidget { color: @Accent; border-color: @Border; }
+)";
+    ASSERT_TRUE(m_loader->load_stylesheet_from_data(qss, "Test"));
+    const QString applied_before = qApp->styleSheet();
+
+    m_loader->set_variables({{"Accent", "#aaaaaa"}});
+    m_loader->set_variables({{"Accent", "#bbbbbb"}, {"Border", "#cccccc"}});
+
+    // Not applied yet, but visible through the loader
+    EXPECT_TRUE(m_loader->has_pending_changes());
+    EXPECT_EQ(qApp->styleSheet(), applied_before);
+    EXPECT_TRUE(m_loader->get_current_stylesheet().contains("#bbbbbb"));
+
+    QCoreApplication::processEvents();
+
+    EXPECT_FALSE(m_loader->has_pending_changes());
+    const QString applied_after = qApp->styleSheet();
+    EXPECT_TRUE(applied_after.contains("#bbbbbb"));
+    EXPECT_TRUE(applied_after.contains("#cccccc"));
+    EXPECT_FALSE(applied_after.contains("#aaaaaa"));
+}
+
+/**
+ * @brief Tests that flush_pending_changes applies immediately and reports whether work was done.
+ */
+TEST_F(StylesheetLoaderTest, FlushPendingChangesAppliesImmediately)
+{
+    const QString qss = R"(
+@Variables[Name="Test"] { @Accent: #101010; }
+QWidget { color: @Accent; }
+)";
+    ASSERT_TRUE(m_loader->load_stylesheet_from_data(qss, "Test"));
+    EXPECT_FALSE(m_loader->flush_pending_changes());
+
+    m_loader->set_variables({{"Accent", "#abcdef"}});
+    EXPECT_TRUE(m_loader->flush_pending_changes());
+    EXPECT_FALSE(m_loader->has_pending_changes());
+    EXPECT_TRUE(qApp->styleSheet().contains("#abcdef"));
+}
+
+/**
+ * @brief Tests that an apply target receives the stylesheet instead of the application.
+ */
+TEST_F(StylesheetLoaderTest, ApplyTargetScopesStylesheetToWidget)
+{
+    const QString qss = R"(
+@Variables[Name="Test"] { @Accent: #123123; }
+QWidget { color: @Accent; }
+)";
+    QWidget target;
+    const QString app_sheet_before = qApp->styleSheet();
+
+    m_loader->set_apply_target(&target);
+    EXPECT_EQ(m_loader->get_apply_target(), &target);
+    ASSERT_TRUE(m_loader->load_stylesheet_from_data(qss, "Test"));
+
+    EXPECT_TRUE(target.styleSheet().contains("#123123"));
+    EXPECT_EQ(qApp->styleSheet(), app_sheet_before);
+
+    m_loader->set_variable("Accent", "#321321");
+    EXPECT_TRUE(target.styleSheet().contains("#321321"));
+
+    // Resetting the target applies application-wide again
+    m_loader->set_apply_target(nullptr);
+    EXPECT_EQ(m_loader->get_apply_target(), nullptr);
+    EXPECT_TRUE(qApp->styleSheet().contains("#321321"));
+}
+
+/**
+ * @brief Tests that changing a variable not referenced by the stylesheet does not re-apply.
+ */
+TEST_F(StylesheetLoaderTest, UnreferencedVariableChangeDoesNotReapply)
+{
+    const QString qss = R"(
+@Variables[Name="Test"] { @Accent: #123123; @Unused: 1px; }
+QWidget { color: @Accent; }
+)";
+    QWidget target;
+    m_loader->set_apply_target(&target);
+    ASSERT_TRUE(m_loader->load_stylesheet_from_data(qss, "Test"));
+
+    // Clear the applied sheet externally; an apply would restore it
+    target.setStyleSheet(QString());
+
+    m_loader->set_variable("Unused", "2px");
+    m_loader->set_variables({{"Unused", "3px"}});
+    EXPECT_FALSE(m_loader->has_pending_changes());
+    EXPECT_TRUE(target.styleSheet().isEmpty());
+    EXPECT_EQ(m_loader->get_variables().value("Unused"), "3px");
+}
+
+/**
+ * @brief Tests that cycles and undefined references are exposed through the diagnostics API.
+ */
+TEST_F(StylesheetLoaderTest, VariableDiagnosticsReportCyclesAndUndefinedReferences)
+{
+    const QString qss = R"(
+@Variables[Name="Diag"] {
+    @A: @B;
+    @B: @A;
+    @C: @Nowhere;
+    @D: #123456;
+}
+QWidget { color: @A; background: @C; border-color: @D; }
+)";
+    ASSERT_TRUE(m_loader->load_stylesheet_from_data(qss, "Diag"));
+
+    const QList<QStringList> cycles = m_loader->get_variable_cycles();
+    ASSERT_EQ(cycles.size(), 1);
+    EXPECT_EQ(cycles.first(), QStringList({"A", "B"}));
+    EXPECT_EQ(m_loader->get_undefined_variable_references(), QStringList({"Nowhere"}));
+    EXPECT_TRUE(m_loader->get_current_stylesheet().contains("#123456"));
+
+    // A clean theme clears the diagnostics
+    ASSERT_TRUE(m_loader->load_stylesheet_from_data("QWidget { color: red; }"));
+    EXPECT_TRUE(m_loader->get_variable_cycles().isEmpty());
+    EXPECT_TRUE(m_loader->get_undefined_variable_references().isEmpty());
+}
+
+/**
+ * @brief Tests that an asynchronous load applies the stylesheet and emits stylesheetReady(true).
+ */
+TEST_F(StylesheetLoaderTest, LoadStylesheetAsyncAppliesAndEmitsReady)
+{
+    const QString qss = R"(
+@Variables[Name="Test"] { @Accent: #0a0b0c; }
+QWidget { color: @Accent; }
+)";
+    const QString path = create_temp_qss(qss);
+    ASSERT_FALSE(path.isEmpty());
+
+    QList<bool> ready_results;
+    QObject::connect(m_loader, &QtWidgetsCommonLib::StylesheetLoader::stylesheetReady,
+                     [&ready_results](bool success) { ready_results.append(success); });
+
+    m_loader->load_stylesheet_async(path, "Test");
+    EXPECT_TRUE(m_loader->is_loading());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (m_loader->is_loading() && timer.elapsed() < 5000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+    }
+
+    ASSERT_EQ(ready_results, QList<bool>({true}));
+    EXPECT_TRUE(qApp->styleSheet().contains("#0a0b0c"));
+    EXPECT_EQ(m_loader->get_current_theme_name(), "Test");
+    EXPECT_EQ(m_loader->get_variables().value("Accent"), "#0a0b0c");
+
+    // The async load also records the path for synchronous reloads
+    EXPECT_TRUE(m_loader->reload_stylesheet());
+
+    QFile::remove(path);
+}
+
+/**
+ * @brief Tests that a superseded asynchronous load is dropped and a missing file reports failure.
+ */
+TEST_F(StylesheetLoaderTest, LoadStylesheetAsyncDropsStaleResults)
+{
+    const QString path = create_temp_qss("QWidget { color: #111111; }");
+    ASSERT_FALSE(path.isEmpty());
+
+    QList<bool> ready_results;
+    QObject::connect(m_loader, &QtWidgetsCommonLib::StylesheetLoader::stylesheetReady,
+                     [&ready_results](bool success) { ready_results.append(success); });
+
+    // The synchronous load starts a newer generation, so the async result must be ignored
+    m_loader->load_stylesheet_async(path);
+    ASSERT_TRUE(m_loader->load_stylesheet_from_data("QWidget { color: #222222; }"));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (m_loader->is_loading() && timer.elapsed() < 5000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+    }
+
+    EXPECT_TRUE(ready_results.isEmpty());
+    EXPECT_TRUE(qApp->styleSheet().contains("#222222"));
+
+    m_loader->load_stylesheet_async(path + ".missing");
+    timer.restart();
+
+    while (m_loader->is_loading() && timer.elapsed() < 5000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+    }
+
+    EXPECT_EQ(ready_results, QList<bool>({false}));
+    EXPECT_TRUE(qApp->styleSheet().contains("#222222"));
+
+    QFile::remove(path);
+}
+
+/**
+ * @brief Tests that auto-reload watches imported files and applies changes made to them.
+ */
+TEST_F(StylesheetLoaderTest, AutoReloadTracksImportedFiles)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString colors_path = dir.filePath("colors.qss");
+    const QString root_path = dir.filePath("root.qss");
+    write_file_and_wait(colors_path, "@Variables[Name=\"Test\"] { @Accent: #0f0f0f; }");
+    write_file_and_wait(root_path, "@import \"colors.qss\";\nQWidget { color: @Accent; }");
+
+    ASSERT_TRUE(m_loader->load_stylesheet(root_path, "Test"));
+    EXPECT_EQ(m_loader->get_available_themes(), QStringList({"Test"}));
+    EXPECT_TRUE(m_loader->get_current_stylesheet().contains("#0f0f0f"));
+    EXPECT_FALSE(m_loader->get_current_stylesheet().contains("@import"));
+    ASSERT_TRUE(m_loader->enable_auto_reload(true));
+
+    write_file_and_wait(colors_path, "@Variables[Name=\"Test\"] { @Accent: #f0f0f0; }");
+
+    QElapsedTimer timer;
+    timer.start();
+    bool seen_update = false;
+
+    while (!seen_update && timer.elapsed() < 5000)
+    {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+        seen_update = m_loader->get_current_stylesheet().contains("#f0f0f0");
+    }
+
+    EXPECT_TRUE(seen_update) << "Change to an imported file was not applied within timeout.";
+    m_loader->enable_auto_reload(false);
+}
+
+/**
+ * @brief Tests that loaders of several windows share one compiled stylesheet per source.
+ */
+TEST_F(StylesheetLoaderTest, LoadersShareCompiledStylesheet)
+{
+    using QtWidgetsCommonLib::StylesheetLoader;
+
+    const QString qss = R"(
+@Variables[Name="Dark"] { @Shared: #101010; }
+@Variables[Name="Light"] { @Shared: #efefef; }
+QWidget#shared { color: @Shared; }
+)";
+    const qsizetype shared_before = StylesheetLoader::get_shared_stylesheet_count();
+
+    {
+        QWidget first_window;
+        QWidget second_window;
+        StylesheetLoader first;
+        StylesheetLoader second;
+        first.set_apply_target(&first_window);
+        second.set_apply_target(&second_window);
+
+        ASSERT_TRUE(first.load_stylesheet_from_data(qss, "Dark"));
+        ASSERT_TRUE(second.load_stylesheet_from_data(qss, "Dark"));
+        ASSERT_TRUE(first.set_theme("Light"));
+        ASSERT_TRUE(second.set_theme("Light"));
+
+        EXPECT_EQ(StylesheetLoader::get_shared_stylesheet_count(), shared_before + 1);
+        EXPECT_EQ(second_window.styleSheet(), first_window.styleSheet());
+        EXPECT_TRUE(second.get_current_stylesheet().contains("#efefef"));
+
+        // Per-window overrides do not leak into the shared state
+        second.set_variable("Shared", "#00ff00");
+        EXPECT_TRUE(first.get_current_stylesheet().contains("#efefef"));
+        EXPECT_TRUE(second.get_current_stylesheet().contains("#00ff00"));
+    }
+
+    // The compiled stylesheet is released with the last loader using it
+    EXPECT_EQ(StylesheetLoader::get_shared_stylesheet_count(), shared_before);
+}
+
+/**
+ * @brief Tests that unresolved references are exposed with lines and follow batched changes.
+ */
+TEST_F(StylesheetLoaderTest, UnresolvedVariablesFollowPendingChanges)
+{
+    const QString qss = "@Variables[Name=\"Test\"] { @Accent: #123123; }\n"
+                        "QWidget { color: @Accent; }\n"
+                        "QLabel { color: @Missing; }\n";
+    QWidget target;
+    m_loader->set_apply_target(&target);
+    ASSERT_TRUE(m_loader->load_stylesheet_from_data(qss, "Test"));
+
+    const QList<QtWidgetsCommonLib::UnresolvedVariable> unresolved =
+        m_loader->get_unresolved_variables();
+    ASSERT_EQ(unresolved.size(), 1);
+    EXPECT_EQ(unresolved.first().name, "Missing");
+    EXPECT_EQ(unresolved.first().line, 3);
+
+    // A pending value is reflected before the deferred apply, and rendered only once
+    m_loader->set_variables({{"Missing", "#456456"}});
+    ASSERT_TRUE(m_loader->has_pending_changes());
+    EXPECT_TRUE(m_loader->get_unresolved_variables().isEmpty());
+    const QString pending = m_loader->get_current_stylesheet();
+    EXPECT_TRUE(pending.contains("#456456"));
+    EXPECT_EQ(pending.constData(), m_loader->get_current_stylesheet().constData());
+    EXPECT_FALSE(target.styleSheet().contains("#456456"));
+
+    ASSERT_TRUE(m_loader->flush_pending_changes());
+    EXPECT_EQ(target.styleSheet(), pending);
+}
+
+/**
+ * @brief Tests that theme previews are rendered offscreen, cached, and leave qApp untouched.
+ */
+TEST_F(StylesheetLoaderTest, ThemePreviewsRenderOffscreenAndAreCached)
+{
+    const QString qss = R"(
+@Variables[Name="Dark"] { @Background: #000000; }
+@Variables[Name="Light"] { @Background: #ffffff; }
+QWidget#theme_preview { background-color: @Background; }
+)";
+    QWidget target;
+    m_loader->set_apply_target(&target);
+    ASSERT_TRUE(m_loader->load_stylesheet_from_data(qss, "Dark"));
+    const QString app_stylesheet = qApp->styleSheet();
+    const QString target_stylesheet = target.styleSheet();
+
+    QWidget preview;
+    preview.setObjectName("theme_preview");
+    preview.setAttribute(Qt::WA_StyledBackground);
+    preview.setStyleSheet("QWidget { border: none; }");
+    preview.resize(8, 8);
+    QtWidgetsCommonLib::StylesheetLoader::clear_theme_preview_cache();
+
+    const QHash<QString, QImage> previews =
+        m_loader->render_theme_previews(&preview, {"Dark", "Light", "Unknown"});
+
+    ASSERT_EQ(previews.size(), 2);
+    EXPECT_EQ(previews.value("Dark").pixelColor(4, 4), QColor(Qt::black));
+    EXPECT_EQ(previews.value("Light").pixelColor(4, 4), QColor(Qt::white));
+    EXPECT_EQ(qApp->styleSheet(), app_stylesheet);
+    EXPECT_EQ(target.styleSheet(), target_stylesheet);
+    EXPECT_EQ(preview.styleSheet(), "QWidget { border: none; }");
+    EXPECT_EQ(m_loader->get_current_theme_name(), "Dark");
+
+    // A later request is served from the cache
+    const QImage light = m_loader->render_theme_preview(&preview, "Light");
+    EXPECT_EQ(light.cacheKey(), previews.value("Light").cacheKey());
+    EXPECT_TRUE(m_loader->render_theme_preview(&preview, "Unknown").isNull());
+}
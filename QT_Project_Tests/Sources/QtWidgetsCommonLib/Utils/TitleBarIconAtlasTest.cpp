@@ -0,0 +1,89 @@
+#include "QtWidgetsCommonLib/Utils/TitleBarIconAtlasTest.h"
+
+#include <QColor>
+#include <QList>
+#include <QPixmap>
+#include <QPushButton>
+
+#include "QtWidgetsCommonLib/Utils/UiUtils.h"
+#include "QtWidgetsCommonLib/Widgets/WindowTitleBar.h"
+
+using QtWidgetsCommonLib::TitleBarIconAtlas;
+using QtWidgetsCommonLib::UiUtils;
+using QtWidgetsCommonLib::WindowTitleBar;
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void TitleBarIconAtlasTest::SetUp()
+{
+    TitleBarIconAtlas::clear();
+}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void TitleBarIconAtlasTest::TearDown()
+{
+    TitleBarIconAtlas::clear();
+}
+
+/**
+ * @brief Tests that all glyphs of one color and size come from one shared atlas entry.
+ */
+TEST_F(TitleBarIconAtlasTest, GlyphsShareOneEntry)
+{
+    const QColor color("#336699");
+    const QIcon maximize =
+        TitleBarIconAtlas::get_icon(TitleBarIconAtlas::Glyph::Maximize, color, 18);
+    const QIcon restore =
+        TitleBarIconAtlas::get_icon(TitleBarIconAtlas::Glyph::Restore, color, 18);
+
+    EXPECT_EQ(TitleBarIconAtlas::get_entry_count(), 1);
+    EXPECT_FALSE(maximize.isNull());
+    EXPECT_NE(maximize.cacheKey(), restore.cacheKey());
+
+    // Repeated lookups return the same shared icon
+    const QIcon again =
+        TitleBarIconAtlas::get_icon(TitleBarIconAtlas::Glyph::Maximize, color, 18);
+    EXPECT_EQ(again.cacheKey(), maximize.cacheKey());
+
+    const QIcon red_close =
+        TitleBarIconAtlas::get_icon(TitleBarIconAtlas::Glyph::Close, QColor("#ff0000"), 18);
+    EXPECT_FALSE(red_close.isNull());
+    EXPECT_EQ(TitleBarIconAtlas::get_entry_count(), 2);
+}
+
+/**
+ * @brief Tests the atlas layout: all glyphs side by side per device pixel ratio.
+ */
+TEST_F(TitleBarIconAtlasTest, AtlasHoldsAllGlyphsSideBySide)
+{
+    const QList<qreal> ratios = UiUtils::get_screen_device_pixel_ratios();
+    ASSERT_FALSE(ratios.isEmpty());
+
+    const QPixmap atlas = TitleBarIconAtlas::get_atlas(QColor("#000000"), 20, ratios.at(0));
+    ASSERT_FALSE(atlas.isNull());
+    EXPECT_EQ(atlas.size(), QSize(4 * 20, 20) * ratios.at(0));
+    EXPECT_EQ(atlas.devicePixelRatio(), ratios.at(0));
+
+    EXPECT_EQ(TitleBarIconAtlas::get_glyph_rect(TitleBarIconAtlas::Glyph::Minimize, 20),
+              QRect(0, 0, 20, 20));
+    EXPECT_EQ(TitleBarIconAtlas::get_glyph_rect(TitleBarIconAtlas::Glyph::Close, 20),
+              QRect(60, 0, 20, 20));
+}
+
+/**
+ * @brief Tests that several title bars with equal settings share the same button icons.
+ */
+TEST_F(TitleBarIconAtlasTest, TitleBarsShareIcons)
+{
+    WindowTitleBar first;
+    WindowTitleBar second;
+
+    EXPECT_EQ(first.get_close_button()->icon().cacheKey(),
+              second.get_close_button()->icon().cacheKey());
+    EXPECT_EQ(first.get_maximize_button()->icon().cacheKey(),
+              second.get_maximize_button()->icon().cacheKey());
+    EXPECT_EQ(TitleBarIconAtlas::get_entry_count(), 1);
+}
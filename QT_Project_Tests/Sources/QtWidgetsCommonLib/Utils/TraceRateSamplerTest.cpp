@@ -0,0 +1,97 @@
+#include "QtWidgetsCommonLib/Utils/TraceRateSamplerTest.h"
+
+using QtWidgetsCommonLib::TraceCounter;
+using QtWidgetsCommonLib::TraceRate;
+
+namespace
+{
+
+constexpr qint64 kSecondNs = 1000000000;
+
+/**
+ * @brief Returns a cumulative counter.
+ * @param name The trace name literal (category "test").
+ * @param count The number of scopes.
+ * @param total_ms The total duration in milliseconds.
+ * @return The counter.
+ */
+auto make_counter(const char* name, qint64 count, qint64 total_ms) -> TraceCounter
+{
+    return {QStringLiteral("test"), QString::fromLatin1(name), count, total_ms * 1000000, 0, 0};
+}
+
+}  // namespace
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void TraceRateSamplerTest::SetUp()
+{
+    m_sampler.reset();
+}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void TraceRateSamplerTest::TearDown() {}
+
+/**
+ * @brief Tests that the rates describe the interval between the last two samples.
+ */
+TEST_F(TraceRateSamplerTest, RatesCoverLastInterval)
+{
+    m_sampler.sample({make_counter("a", 10, 5)}, 0);
+    EXPECT_TRUE(m_sampler.get_rates().isEmpty());
+    EXPECT_EQ(m_sampler.get_interval_ms(), 0.0);
+
+    m_sampler.sample({make_counter("a", 30, 25), make_counter("b", 4, 2)}, 2 * kSecondNs);
+    ASSERT_EQ(m_sampler.get_rates().size(), 2);
+    EXPECT_DOUBLE_EQ(m_sampler.get_interval_ms(), 2000.0);
+
+    const TraceRate a = m_sampler.get_rate(QStringLiteral("test"), QStringLiteral("a"));
+    EXPECT_DOUBLE_EQ(a.count_per_second, 10.0);
+    EXPECT_DOUBLE_EQ(a.average_ms, 1.0);
+    EXPECT_DOUBLE_EQ(a.busy_ms_per_second, 10.0);
+
+    const TraceRate b = m_sampler.get_rate(QStringLiteral("test"), QStringLiteral("b"));
+    EXPECT_DOUBLE_EQ(b.count_per_second, 2.0);
+    EXPECT_DOUBLE_EQ(b.average_ms, 0.5);
+}
+
+/**
+ * @brief Tests that idle scopes are left out and counters reset by the tracer start from zero.
+ */
+TEST_F(TraceRateSamplerTest, IdleAndRestartedCounters)
+{
+    m_sampler.sample({make_counter("a", 10, 5), make_counter("b", 8, 8)}, 0);
+    m_sampler.sample({make_counter("a", 10, 5), make_counter("b", 2, 4)}, kSecondNs);
+
+    const QList<TraceRate> rates = m_sampler.get_rates();
+    ASSERT_EQ(rates.size(), 1);
+    EXPECT_EQ(rates.at(0).name, QStringLiteral("b"));
+    EXPECT_DOUBLE_EQ(rates.at(0).count_per_second, 2.0);
+    EXPECT_DOUBLE_EQ(rates.at(0).average_ms, 2.0);
+    EXPECT_EQ(m_sampler.get_rate(QStringLiteral("test"), QStringLiteral("a")).count_per_second,
+              0.0);
+}
+
+/**
+ * @brief Tests that the text lines group the scopes under a category header.
+ */
+TEST_F(TraceRateSamplerTest, LinesAreGroupedByCategory)
+{
+    TraceCounter other = make_counter("c", 0, 0);
+    other.category = QStringLiteral("other");
+    m_sampler.sample({make_counter("a", 0, 0), other}, 0);
+
+    other.count = 1;
+    other.total_ns = 3000000;
+    m_sampler.sample({make_counter("a", 4, 2), other}, kSecondNs);
+
+    const QStringList lines = m_sampler.to_lines();
+    ASSERT_EQ(lines.size(), 4);
+    EXPECT_EQ(lines.at(0), QStringLiteral("other"));
+    EXPECT_EQ(lines.at(1), QStringLiteral("  c  1/s  3.00 ms  3.0 ms/s"));
+    EXPECT_EQ(lines.at(2), QStringLiteral("test"));
+    EXPECT_EQ(lines.at(3), QStringLiteral("  a  4/s  0.50 ms  2.0 ms/s"));
+}
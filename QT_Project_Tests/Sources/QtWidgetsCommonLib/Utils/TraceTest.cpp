@@ -0,0 +1,95 @@
+#include "QtWidgetsCommonLib/Utils/TraceTest.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+using QtWidgetsCommonLib::TraceCounter;
+using QtWidgetsCommonLib::Tracer;
+using QtWidgetsCommonLib::TraceScope;
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void TraceTest::SetUp()
+{
+    Tracer::reset();
+    Tracer::set_enabled(true);
+    Tracer::set_event_recording(false);
+}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void TraceTest::TearDown()
+{
+    Tracer::set_event_recording(false);
+    Tracer::set_enabled(true);
+    Tracer::reset();
+}
+
+/**
+ * @brief Tests that scopes are aggregated per category and name and skipped while disabled.
+ */
+TEST_F(TraceTest, ScopesAreAggregated)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        const TraceScope scope("test", "aggregated");
+    }
+
+    {
+        const TraceScope scope("test", "other");
+    }
+
+    Tracer::set_enabled(false);
+
+    {
+        const TraceScope scope("test", "aggregated");
+    }
+
+    const QList<TraceCounter> counters = Tracer::get_counters();
+    ASSERT_EQ(counters.size(), 2);
+    EXPECT_EQ(counters[0].name, QStringLiteral("aggregated"));
+    EXPECT_EQ(counters[0].category, QStringLiteral("test"));
+    EXPECT_EQ(counters[0].count, 3);
+    EXPECT_GE(counters[0].total_ns, counters[0].max_ns);
+    EXPECT_LE(counters[0].min_ns, counters[0].max_ns);
+    EXPECT_EQ(counters[1].name, QStringLiteral("other"));
+    EXPECT_EQ(counters[1].count, 1);
+    EXPECT_EQ(Tracer::get_event_count(), 0);
+}
+
+/**
+ * @brief Tests that recorded events are exported as Chrome trace-event JSON.
+ */
+TEST_F(TraceTest, EventsAreExportedAsChromeTrace)
+{
+    Tracer::set_event_recording(true);
+    Tracer::record("test", "exported", 2000, 1500);
+
+    ASSERT_EQ(Tracer::get_event_count(), 1);
+
+    const QJsonObject root = QJsonDocument::fromJson(Tracer::to_chrome_trace_json()).object();
+    const QJsonArray events = root.value(QStringLiteral("traceEvents")).toArray();
+    ASSERT_EQ(events.size(), 1);
+
+    const QJsonObject event = events.first().toObject();
+    EXPECT_EQ(event.value(QStringLiteral("name")).toString(), QStringLiteral("exported"));
+    EXPECT_EQ(event.value(QStringLiteral("cat")).toString(), QStringLiteral("test"));
+    EXPECT_EQ(event.value(QStringLiteral("ph")).toString(), QStringLiteral("X"));
+    EXPECT_DOUBLE_EQ(event.value(QStringLiteral("ts")).toDouble(), 2.0);
+    EXPECT_DOUBLE_EQ(event.value(QStringLiteral("dur")).toDouble(), 1.5);
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString file_path = dir.filePath(QStringLiteral("trace.json"));
+    EXPECT_TRUE(Tracer::write_chrome_trace(file_path));
+    EXPECT_TRUE(QFile::exists(file_path));
+
+    Tracer::reset();
+    EXPECT_EQ(Tracer::get_event_count(), 0);
+    EXPECT_TRUE(Tracer::get_counters().isEmpty());
+}
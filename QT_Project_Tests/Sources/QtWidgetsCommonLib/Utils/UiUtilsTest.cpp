@@ -5,10 +5,16 @@
 
 #include "QtWidgetsCommonLib/Utils/UiUtilsTest.h"
 
+#include <QApplication>
 #include <QColor>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QIcon>
 #include <QImage>
 #include <QPixmap>
+#include <QStringList>
+#include <QTemporaryDir>
 
 #include "QtWidgetsCommonLib/Utils/UiUtils.h"
 
@@ -21,6 +27,10 @@ void UiUtilsTest::SetUp()
     {
         m_temp_svg.close();
     }
+
+    // Temporary file names may repeat across tests; start with empty icon caches
+    UiUtils::clear_icon_cache();
+    UiUtils::reset_icon_cache_stats();
 }
 
 void UiUtilsTest::TearDown()
@@ -119,3 +129,182 @@ TEST_F(UiUtilsTest, InvalidPathReturnsPixmapOfRequestedSize)
     ASSERT_FALSE(pm.isNull());
     EXPECT_EQ(pm.size(), target_size);
 }
+
+/**
+ * @test Serves repeated requests from the pixmap cache and re-colors without re-parsing.
+ */
+TEST_F(UiUtilsTest, CachesRenderedIconsAndParsedSvgs)
+{
+    const QByteArray svg =
+        R"(<?xml version="1.0" encoding="UTF-8"?>
+<svg width="24" height="24" viewBox="0 0 24 24" xmlns="http://www.w3.org/2000/svg">
+  <rect x="2" y="2" width="20" height="20" fill="#000000"/>
+</svg>)";
+
+    const QString svg_path = create_temp_svg(svg);
+    ASSERT_FALSE(svg_path.isEmpty());
+
+    const QPixmap first = UiUtils::colored_svg_icon(svg_path, QColor("#ff0000"));
+    const QPixmap second = UiUtils::colored_svg_icon(svg_path, QColor("#ff0000"));
+    EXPECT_EQ(first.cacheKey(), second.cacheKey());
+
+    UiUtils::IconCacheStats stats = UiUtils::get_icon_cache_stats();
+    EXPECT_EQ(stats.pixmap_misses, 1u);
+    EXPECT_EQ(stats.pixmap_hits, 1u);
+    EXPECT_EQ(stats.renderer_misses, 1u);
+
+    // Another color renders a new pixmap from the already parsed SVG
+    const QPixmap blue = UiUtils::colored_svg_icon(svg_path, QColor("#0000ff"));
+    EXPECT_NE(blue.cacheKey(), first.cacheKey());
+    EXPECT_EQ(QColor::fromRgb(blue.toImage().pixel(12, 12)).blue(), 255);
+
+    stats = UiUtils::get_icon_cache_stats();
+    EXPECT_EQ(stats.pixmap_misses, 2u);
+    EXPECT_EQ(stats.renderer_misses, 1u);
+    EXPECT_EQ(stats.renderer_hits, 1u);
+
+    UiUtils::clear_icon_cache();
+    const QPixmap again = UiUtils::colored_svg_icon(svg_path, QColor("#ff0000"));
+    EXPECT_FALSE(again.isNull());
+    EXPECT_EQ(UiUtils::get_icon_cache_stats().pixmap_misses, 3u);
+    EXPECT_EQ(UiUtils::get_icon_cache_stats().renderer_misses, 2u);
+}
+
+/**
+ * @test Evicts the least recently used parsed SVG once the renderer cache is full.
+ */
+TEST_F(UiUtilsTest, EvictsLeastRecentlyUsedRenderer)
+{
+    const QByteArray svg =
+        R"(<?xml version="1.0" encoding="UTF-8"?>
+<svg width="24" height="24" viewBox="0 0 24 24" xmlns="http://www.w3.org/2000/svg">
+  <rect x="2" y="2" width="20" height="20" fill="#000000"/>
+</svg>)";
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QStringList paths;
+
+    // One more SVG than the renderer cache holds (64)
+    for (int i = 0; i < 65; ++i)
+    {
+        QFile file(dir.filePath(QStringLiteral("icon_%1.svg").arg(i)));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(svg);
+        paths.append(file.fileName());
+    }
+
+    // A new color per call bypasses the pixmap cache, so every call uses a renderer
+    int color = 0;
+    const auto render = [&color](const QString& path) {
+        static_cast<void>(UiUtils::colored_svg_icon(path, QColor::fromRgb(++color)));
+    };
+
+    for (int i = 0; i < 64; ++i)
+    {
+        render(paths.at(i));
+    }
+
+    render(paths.at(0));
+    render(paths.at(64));
+    EXPECT_EQ(UiUtils::get_icon_cache_stats().renderer_misses, 65u);
+
+    // The first SVG was used recently and survived; the second one was evicted
+    render(paths.at(0));
+    EXPECT_EQ(UiUtils::get_icon_cache_stats().renderer_hits, 2u);
+    render(paths.at(1));
+    EXPECT_EQ(UiUtils::get_icon_cache_stats().renderer_misses, 66u);
+}
+
+/**
+ * @test Renders one icon per batch request with a pixmap for every screen pixel ratio.
+ */
+TEST_F(UiUtilsTest, BatchRendersIconPerRequestForAllScreenRatios)
+{
+    const QByteArray svg =
+        R"(<?xml version="1.0" encoding="UTF-8"?>
+<svg width="24" height="24" viewBox="0 0 24 24" xmlns="http://www.w3.org/2000/svg">
+  <rect x="2" y="2" width="20" height="20" fill="#000000"/>
+</svg>)";
+
+    const QString svg_path = create_temp_svg(svg);
+    ASSERT_FALSE(svg_path.isEmpty());
+
+    const QList<qreal> ratios = UiUtils::get_screen_device_pixel_ratios();
+    ASSERT_FALSE(ratios.isEmpty());
+
+    const QList<QIcon> icons =
+        UiUtils::colored_svg_icons({{svg_path, QColor("#ff0000"), QSize(16, 16)},
+                                    {svg_path, QColor("#00ff00"), QSize(32, 32)}});
+
+    ASSERT_EQ(icons.size(), 2);
+    EXPECT_FALSE(icons.at(0).isNull());
+    EXPECT_FALSE(icons.at(1).isNull());
+
+    const QImage image = icons.at(1).pixmap(QSize(32, 32), ratios.constLast()).toImage();
+    EXPECT_EQ(image.size(), QSize(32, 32) * ratios.constLast());
+    EXPECT_EQ(QColor::fromRgb(image.pixel(image.width() / 2, image.height() / 2)).green(), 255);
+
+    // Same SVG for both requests: parsed once
+    EXPECT_EQ(UiUtils::get_icon_cache_stats().renderer_misses, 1u);
+}
+
+/**
+ * @test Renders a batch on a worker thread and fills the pixmap cache on delivery.
+ */
+TEST_F(UiUtilsTest, AsyncBatchDeliversIconsAndFillsCache)
+{
+    const QByteArray svg =
+        R"(<?xml version="1.0" encoding="UTF-8"?>
+<svg width="24" height="24" viewBox="0 0 24 24" xmlns="http://www.w3.org/2000/svg">
+  <circle cx="12" cy="12" r="10" fill="#000000"/>
+</svg>)";
+
+    const QString svg_path = create_temp_svg(svg);
+    ASSERT_FALSE(svg_path.isEmpty());
+
+    QObject context;
+    QList<QIcon> icons;
+    bool delivered = false;
+
+    UiUtils::colored_svg_icons_async({{svg_path, QColor("#0000ff"), QSize(24, 24)}}, &context,
+                                     [&](const QList<QIcon>& result) {
+                                         icons = result;
+                                         delivered = true;
+                                     });
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!delivered && timer.elapsed() < 5000)
+    {
+        QApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+
+    ASSERT_TRUE(delivered);
+    ASSERT_EQ(icons.size(), 1);
+    EXPECT_FALSE(icons.at(0).isNull());
+
+    const qreal ratio = UiUtils::get_screen_device_pixel_ratios().at(0);
+    const QPixmap cached =
+        UiUtils::colored_svg_icon(svg_path, QColor("#0000ff"), QSize(24, 24), ratio);
+    EXPECT_EQ(UiUtils::get_icon_cache_stats().pixmap_hits, 1u);
+
+    const QImage image = cached.toImage();
+    EXPECT_EQ(QColor::fromRgb(image.pixel(image.width() / 2, image.height() / 2)).blue(), 255);
+}
+
+/**
+ * @test Rejects an asynchronous batch without a context instead of rendering it.
+ */
+TEST_F(UiUtilsTest, AsyncBatchWithoutContextIsIgnored)
+{
+    bool delivered = false;
+
+    UiUtils::colored_svg_icons_async({{QStringLiteral(":/missing.svg"), QColor("#0000ff")}},
+                                     nullptr, [&](const QList<QIcon>&) { delivered = true; });
+    QApplication::processEvents();
+
+    EXPECT_FALSE(delivered);
+    EXPECT_EQ(UiUtils::get_icon_cache_stats().renderer_misses, 0u);
+}
@@ -3,6 +3,7 @@
 #include <QFile>
 #include <QTemporaryFile>
 
+#include "QtWidgetsCommonLib/Services/Preferences/BatchedMainWindowStatePersistence.h"
 #include "QtWidgetsCommonLib/Utils/StylesheetLoader.h"
 
 using QtWidgetsCommonLib::AppMainWindow;
@@ -67,18 +68,30 @@ TEST_F(AppMainWindowTest, ConstructionAndStylesheetLoader)
 {
     EXPECT_NE(m_window, nullptr);
     EXPECT_NE(m_window->get_stylesheet_loader(), nullptr);
+    EXPECT_FALSE(m_window->is_stylesheet_disk_cache_enabled());
 }
 
 /**
- * @brief Tests that saving window settings calls the preferences methods.
+ * @brief Tests that saving window settings calls the preferences methods once per change.
+ *
+ * The values are written on flush; saving the same state again writes nothing.
  */
 TEST_F(AppMainWindowTest, SaveWindowSettingsCallsPreferences)
 {
+    ON_CALL(*m_mock_prefs, get_mainwindow_windowstate())
+        .WillByDefault(testing::Return(static_cast<int>(Qt::WindowMaximized)));
     EXPECT_CALL(*m_mock_prefs, set_mainwindow_geometry(testing::_)).Times(1);
     EXPECT_CALL(*m_mock_prefs, set_mainwindow_state(testing::_)).Times(1);
     EXPECT_CALL(*m_mock_prefs, set_mainwindow_windowstate(testing::_)).Times(1);
 
+    auto* persistence = m_window->get_window_state_persistence();
+    ASSERT_NE(persistence, nullptr);
+
+    m_window->save_window_settings();
+    EXPECT_TRUE(persistence->flush());
+
     m_window->save_window_settings();
+    EXPECT_FALSE(persistence->flush());
 }
 
 /**
@@ -129,3 +142,31 @@ QWidget { background: @PrimaryColor; }
     EXPECT_TRUE(loader->get_current_stylesheet().contains("#abcdef"));
     EXPECT_FALSE(loader->get_current_stylesheet().contains("@PrimaryColor"));
 }
+
+/**
+ * @brief Tests that the startup pipeline applies the configured stylesheet with the preferences'
+ *        theme when the window is polished, before it is shown.
+ */
+TEST_F(AppMainWindowTest, StartupStylesheetAppliedBeforeShow)
+{
+    ON_CALL(*m_mock_prefs, get_theme()).WillByDefault(testing::Return(QStringLiteral("Light")));
+
+    QString qss = R"(
+@Variables[Name="Light"] {
+    @PrimaryColor: #fedcba;
+}
+QWidget { background: @PrimaryColor; }
+)";
+    m_temp_qss_path = create_temp_qss(qss);
+    ASSERT_FALSE(m_temp_qss_path.isEmpty());
+
+    m_window->set_stylesheet_path(m_temp_qss_path);
+    EXPECT_EQ(m_window->get_stylesheet_path(), m_temp_qss_path);
+
+    m_window->ensurePolished();
+
+    auto* loader = m_window->get_stylesheet_loader();
+    EXPECT_FALSE(loader->is_loading());
+    EXPECT_EQ(loader->get_current_theme_name(), "Light");
+    EXPECT_TRUE(loader->get_current_stylesheet().contains("#fedcba"));
+}
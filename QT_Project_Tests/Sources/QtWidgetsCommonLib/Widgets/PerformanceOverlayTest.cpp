@@ -0,0 +1,108 @@
+/**
+ * @file PerformanceOverlayTest.cpp
+ * @brief Implements tests for the PerformanceOverlay widget and its AppWindow toggle.
+ */
+
+#include "QtWidgetsCommonLib/Widgets/PerformanceOverlayTest.h"
+
+#include <QApplication>
+#include <QKeySequence>
+#include <QThread>
+
+#include "QtWidgetsCommonLib/Utils/Trace.h"
+#include "QtWidgetsCommonLib/Widgets/AppWindow.h"
+
+using QtWidgetsCommonLib::AppWindow;
+using QtWidgetsCommonLib::PerformanceOverlay;
+using QtWidgetsCommonLib::Tracer;
+using QtWidgetsCommonLib::TraceScope;
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void PerformanceOverlayTest::SetUp()
+{
+    Tracer::reset();
+    Tracer::set_enabled(true);
+    m_parent_widget = new QWidget();
+    m_parent_widget->resize(400, 300);
+}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void PerformanceOverlayTest::TearDown()
+{
+    delete m_parent_widget;
+    m_parent_widget = nullptr;
+    Tracer::reset();
+}
+
+/**
+ * @brief Tests that the overlay shows the scopes recorded since the previous sample.
+ */
+TEST_F(PerformanceOverlayTest, ShowsScopesOfLastInterval)
+{
+    auto* overlay = new PerformanceOverlay(m_parent_widget);
+    EXPECT_EQ(overlay->get_update_interval(), 1000);
+    EXPECT_TRUE(overlay->get_lines().contains(QStringLiteral("Sampling...")));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const TraceScope scope("overlaytest", "OverlayTest::scope");
+    }
+
+    QThread::msleep(5);
+    overlay->update_sample();
+
+    const QStringList lines = overlay->get_lines();
+    EXPECT_TRUE(lines.contains(QStringLiteral("overlaytest")));
+    EXPECT_EQ(lines.filter(QStringLiteral("OverlayTest::scope")).size(), 1);
+    EXPECT_EQ(lines.filter(QStringLiteral("repaints/s")).size(), 1);
+
+    // Nothing ran since the last sample
+    overlay->update_sample();
+    EXPECT_FALSE(overlay->get_lines().contains(QStringLiteral("overlaytest")));
+}
+
+/**
+ * @brief Tests that the overlay stays in the bottom-right corner of its parent.
+ */
+TEST_F(PerformanceOverlayTest, FollowsParentCorner)
+{
+    auto* overlay = new PerformanceOverlay(m_parent_widget);
+    EXPECT_TRUE(overlay->testAttribute(Qt::WA_TransparentForMouseEvents));
+    EXPECT_EQ(overlay->geometry().right(), 400 - 8 - 1);
+    EXPECT_EQ(overlay->geometry().bottom(), 300 - 8 - 1);
+
+    m_parent_widget->show();
+    QApplication::processEvents();
+    m_parent_widget->resize(600, 500);
+    EXPECT_EQ(overlay->geometry().right(), 600 - 8 - 1);
+    EXPECT_EQ(overlay->geometry().bottom(), 500 - 8 - 1);
+}
+
+/**
+ * @brief Tests enabling the overlay and its shortcut on an AppWindow.
+ */
+TEST_F(PerformanceOverlayTest, AppWindowToggle)
+{
+    AppWindow window;
+    EXPECT_FALSE(window.get_performance_overlay_enabled());
+    EXPECT_EQ(window.findChild<PerformanceOverlay*>(), nullptr);
+
+    window.set_performance_overlay_enabled(true);
+    EXPECT_TRUE(window.get_performance_overlay_enabled());
+    EXPECT_NE(window.findChild<PerformanceOverlay*>(), nullptr);
+
+    window.set_performance_overlay_enabled(false);
+    EXPECT_FALSE(window.get_performance_overlay_enabled());
+    EXPECT_EQ(window.findChild<PerformanceOverlay*>(), nullptr);
+
+    EXPECT_TRUE(window.get_performance_overlay_shortcut().isEmpty());
+    const QKeySequence shortcut(QStringLiteral("Ctrl+Shift+F12"));
+    window.set_performance_overlay_shortcut(shortcut);
+    EXPECT_EQ(window.get_performance_overlay_shortcut(), shortcut);
+    window.set_performance_overlay_shortcut(QKeySequence());
+    EXPECT_TRUE(window.get_performance_overlay_shortcut().isEmpty());
+}
@@ -0,0 +1,154 @@
+#include "QtWidgetsCommonLib/Widgets/VirtualFlowViewTest.h"
+
+#include <QApplication>
+#include <QLabel>
+#include <QList>
+#include <QScrollBar>
+#include <QSize>
+#include <algorithm>
+
+using QtWidgetsCommonLib::FlowLayout;
+using QtWidgetsCommonLib::VirtualFlowView;
+
+/**
+ * @brief Sets up the test fixture for each test.
+ */
+void VirtualFlowViewTest::SetUp()
+{
+    m_created_widgets = 0;
+    m_view = new VirtualFlowView();
+    m_view->set_spacing(10, 10);
+    m_view->set_overscan(0);
+    m_view->set_item_size(QSize(50, 20));
+    m_view->set_widget_factory([this](QWidget* parent) {
+        ++m_created_widgets;
+        return new QLabel(parent);
+    });
+    m_view->set_widget_binder([](QWidget* widget, int index) {
+        static_cast<QLabel*>(widget)->setText(QString::number(index));
+    });
+    m_view->resize(300, 200);
+    m_view->show();
+    QApplication::processEvents();
+}
+
+/**
+ * @brief Tears down the test fixture after each test.
+ */
+void VirtualFlowViewTest::TearDown()
+{
+    delete m_view;
+    m_view = nullptr;
+}
+
+/**
+ * @brief Tests that only the items intersecting the viewport get a widget.
+ */
+TEST_F(VirtualFlowViewTest, MaterializesOnlyVisibleItems)
+{
+    m_view->set_item_count(20000);
+    QApplication::processEvents();
+
+    EXPECT_GT(m_view->get_materialized_count(), 0);
+    EXPECT_LT(m_view->get_materialized_count(), 100);
+    EXPECT_LE(m_created_widgets, 100);
+
+    QWidget* first = m_view->get_widget(0);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(static_cast<QLabel*>(first)->text(), QStringLiteral("0"));
+    EXPECT_EQ(first->geometry(), m_view->get_item_rect(0));
+    EXPECT_EQ(m_view->get_widget(19999), nullptr);
+}
+
+/**
+ * @brief Tests that scrolling re-binds pooled widgets instead of creating new ones.
+ */
+TEST_F(VirtualFlowViewTest, RecyclesWidgetsOnScroll)
+{
+    m_view->set_item_count(20000);
+    QApplication::processEvents();
+    const int created_before = m_created_widgets;
+
+    m_view->scroll_to_index(19999);
+    QApplication::processEvents();
+
+    QWidget* last = m_view->get_widget(19999);
+    ASSERT_NE(last, nullptr);
+    EXPECT_EQ(static_cast<QLabel*>(last)->text(), QStringLiteral("19999"));
+    EXPECT_EQ(m_view->get_widget(0), nullptr);
+    EXPECT_LE(m_created_widgets, created_before + 10);
+
+    const QRect rect = m_view->get_item_rect(19999);
+    EXPECT_EQ(last->geometry(), rect.translated(0, -m_view->verticalScrollBar()->value()));
+}
+
+/**
+ * @brief Tests that item rects match the shared FlowLayout geometry for variable sizes.
+ */
+TEST_F(VirtualFlowViewTest, VariableSizesMatchFlowLayoutGeometry)
+{
+    const auto size_of = [](int index) {
+        return QSize(30 + (index % 5) * 20, 20 + (index % 3) * 5);
+    };
+
+    m_view->set_row_alignment(FlowLayout::RowAlignment::Center);
+    m_view->set_size_provider(size_of);
+    m_view->set_item_count(500);
+    QApplication::processEvents();
+
+    QList<QSize> sizes;
+
+    for (int i = 0; i < 500; ++i)
+    {
+        sizes.append(size_of(i));
+    }
+
+    const FlowLayout::LayoutResult expected = FlowLayout::compute_geometry(
+        sizes, m_view->viewport()->width(), QMargins(), 10, 10, FlowLayout::RowAlignment::Center);
+
+    ASSERT_EQ(expected.item_rects.size(), 500);
+
+    for (int i = 0; i < 500; ++i)
+    {
+        EXPECT_EQ(m_view->get_item_rect(i), expected.item_rects.at(i));
+    }
+
+    EXPECT_EQ(m_view->verticalScrollBar()->maximum(),
+              std::max(0, expected.height - m_view->viewport()->height()));
+}
+
+/**
+ * @brief Tests that the closed-form rows of uniform items match the shared FlowLayout geometry.
+ */
+TEST_F(VirtualFlowViewTest, UniformSizesMatchFlowLayoutGeometry)
+{
+    const QList<FlowLayout::RowAlignment> alignments = {FlowLayout::RowAlignment::Left,
+                                                        FlowLayout::RowAlignment::Center,
+                                                        FlowLayout::RowAlignment::CenterLeft};
+    const QList<int> view_widths = {40, 120, 300, 517};
+    const QList<QSize> sizes(103, QSize(50, 20));
+
+    m_view->set_item_count(static_cast<int>(sizes.size()));
+
+    for (const FlowLayout::RowAlignment alignment: alignments)
+    {
+        m_view->set_row_alignment(alignment);
+
+        for (const int view_width: view_widths)
+        {
+            m_view->resize(view_width, 200);
+            QApplication::processEvents();
+
+            const FlowLayout::LayoutResult expected = FlowLayout::compute_geometry(
+                sizes, m_view->viewport()->width(), QMargins(), 10, 10, alignment);
+
+            for (int i = 0; i < sizes.size(); ++i)
+            {
+                EXPECT_EQ(m_view->get_item_rect(i), expected.item_rects.at(i));
+            }
+
+            EXPECT_EQ(m_view->verticalScrollBar()->maximum(),
+                      std::max(0, expected.height - m_view->viewport()->height()));
+        }
+    }
+}
@@ -15,6 +15,7 @@
 #include <QPixmap>
 #include <QPushButton>
 #include <QSignalSpy>
+#include <QVBoxLayout>
 
 using QtWidgetsCommonLib::WindowTitleBar;
 
@@ -239,3 +240,37 @@ TEST_F(WindowTitleBarTest, DoubleClickMaximizeVsRestore)
     QApplication::processEvents();
     EXPECT_GE(restore_spy.count(), 1);
 }
+
+/**
+ * @test Setter calls in one event loop turn are applied together, in the documented order.
+ */
+TEST_F(WindowTitleBarTest, PlacementUpdatesAreCoalesced)
+{
+    auto* root = qobject_cast<QVBoxLayout*>(m_title_bar->layout());
+    ASSERT_NE(root, nullptr);
+    QLayout* top_row = root->itemAt(0)->layout();
+    QLayout* bottom_row = root->itemAt(1)->layout();
+    ASSERT_NE(top_row, nullptr);
+    ASSERT_NE(bottom_row, nullptr);
+
+    auto* menubar = new QMenuBar();
+    auto* custom = new QWidget();
+    m_title_bar->set_menubar(menubar);
+    m_title_bar->set_custom_widget(custom);
+    m_title_bar->set_menubar_row(WindowTitleBar::RowPosition::Bottom);
+
+    // Nothing is placed before the event loop runs
+    EXPECT_EQ(top_row->indexOf(menubar), -1);
+    EXPECT_EQ(bottom_row->indexOf(menubar), -1);
+
+    QApplication::processEvents();
+    EXPECT_EQ(bottom_row->indexOf(menubar), 0);
+    EXPECT_EQ(top_row->indexOf(custom), top_row->indexOf(m_title_bar->get_minimize_button()) - 1);
+
+    // Moving one widget leaves the other one in place
+    m_title_bar->set_custom_widget_row(WindowTitleBar::RowPosition::Bottom);
+    m_title_bar->apply_pending_layout();
+    EXPECT_EQ(bottom_row->indexOf(menubar), 0);
+    EXPECT_EQ(bottom_row->indexOf(custom), 1);
+    EXPECT_EQ(top_row->indexOf(custom), -1);
+}